@@ -46,6 +46,7 @@ either expressed or implied, of the Regents of The University of Michigan.
 #include "common/zmaxheap.h"
 #include "common/postscript_utils.h"
 #include "common/math_util.h"
+#include "common/simd.h"
 
 #ifdef _WIN32
 static inline long int random(void)
@@ -1093,6 +1094,173 @@ static void do_quad_task(void *p)
     }
 }
 
+// Min and max of each 4x4 tile of the 4 image rows starting at row0,
+// for the tw full tiles of the row.
+static void tile_minmax_row(const uint8_t *row0, int s, int tw, uint8_t *tmax, uint8_t *tmin)
+{
+    const int tilesz = 4;
+    int tx = 0;
+#if APRILTAG_USE_SSE
+    for (; tx + 4 <= tw; tx += 4) {
+        const uint8_t *p = &row0[tx*tilesz];
+        __m128i r0 = _mm_loadu_si128((const __m128i *)p);
+        __m128i r1 = _mm_loadu_si128((const __m128i *)(p + s));
+        __m128i r2 = _mm_loadu_si128((const __m128i *)(p + 2*s));
+        __m128i r3 = _mm_loadu_si128((const __m128i *)(p + 3*s));
+        __m128i mx = _mm_max_epu8(_mm_max_epu8(r0, r1), _mm_max_epu8(r2, r3));
+        __m128i mn = _mm_min_epu8(_mm_min_epu8(r0, r1), _mm_min_epu8(r2, r3));
+        // reduce the 4 bytes of each tile into the low byte of its 32-bit lane
+        mx = _mm_max_epu8(mx, _mm_srli_epi32(mx, 8));
+        mx = _mm_max_epu8(mx, _mm_srli_epi32(mx, 16));
+        mn = _mm_min_epu8(mn, _mm_srli_epi32(mn, 8));
+        mn = _mm_min_epu8(mn, _mm_srli_epi32(mn, 16));
+        const __m128i mask = _mm_set1_epi32(0x000000ff);
+        mx = _mm_packs_epi32(_mm_and_si128(mx, mask), _mm_setzero_si128());
+        mn = _mm_packs_epi32(_mm_and_si128(mn, mask), _mm_setzero_si128());
+        int vmax = _mm_cvtsi128_si32(_mm_packus_epi16(mx, mx));
+        int vmin = _mm_cvtsi128_si32(_mm_packus_epi16(mn, mn));
+        memcpy(&tmax[tx], &vmax, 4);
+        memcpy(&tmin[tx], &vmin, 4);
+    }
+#elif APRILTAG_USE_NEON
+    for (; tx + 4 <= tw; tx += 4) {
+        const uint8_t *p = &row0[tx*tilesz];
+        uint8x16_t r0 = vld1q_u8(p), r1 = vld1q_u8(p + s), r2 = vld1q_u8(p + 2*s), r3 = vld1q_u8(p + 3*s);
+        uint8x16_t mx = vmaxq_u8(vmaxq_u8(r0, r1), vmaxq_u8(r2, r3));
+        uint8x16_t mn = vminq_u8(vminq_u8(r0, r1), vminq_u8(r2, r3));
+        uint8x8_t mx8 = vpmax_u8(vget_low_u8(mx), vget_high_u8(mx));
+        uint8x8_t mn8 = vpmin_u8(vget_low_u8(mn), vget_high_u8(mn));
+        mx8 = vpmax_u8(mx8, mx8);
+        mn8 = vpmin_u8(mn8, mn8);
+        vst1_lane_u32((uint32_t *)(void *)&tmax[tx], vreinterpret_u32_u8(mx8), 0);
+        vst1_lane_u32((uint32_t *)(void *)&tmin[tx], vreinterpret_u32_u8(mn8), 0);
+    }
+#endif
+    for (; tx < tw; tx++) {
+        uint8_t max = 0, min = 255;
+
+        for (int dy = 0; dy < tilesz; dy++) {
+            for (int dx = 0; dx < tilesz; dx++) {
+                uint8_t v = row0[dy*s + tx*tilesz + dx];
+                if (v < min)
+                    min = v;
+                if (v > max)
+                    max = v;
+            }
+        }
+
+        tmax[tx] = max;
+        tmin[tx] = min;
+    }
+}
+
+static inline uint8_t minmax2(uint8_t a, uint8_t b, bool is_max)
+{
+    return is_max ? (a < b ? b : a) : (a < b ? a : b);
+}
+
+// out[i] = max(a[i], b[i], c[i]) (or min when is_max is false)
+static void minmax3(const uint8_t *a, const uint8_t *b, const uint8_t *c, uint8_t *out, int n, bool is_max)
+{
+    int i = 0;
+#if APRILTAG_USE_SSE
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *)&a[i]);
+        __m128i vb = _mm_loadu_si128((const __m128i *)&b[i]);
+        __m128i vc = _mm_loadu_si128((const __m128i *)&c[i]);
+        __m128i r = is_max ? _mm_max_epu8(_mm_max_epu8(va, vb), vc) : _mm_min_epu8(_mm_min_epu8(va, vb), vc);
+        _mm_storeu_si128((__m128i *)&out[i], r);
+    }
+#elif APRILTAG_USE_NEON
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t va = vld1q_u8(&a[i]), vb = vld1q_u8(&b[i]), vc = vld1q_u8(&c[i]);
+        vst1q_u8(&out[i], is_max ? vmaxq_u8(vmaxq_u8(va, vb), vc) : vminq_u8(vminq_u8(va, vb), vc));
+    }
+#endif
+    for (; i < n; i++)
+        out[i] = minmax2(minmax2(a[i], b[i], is_max), c[i], is_max);
+}
+
+// 3x3 max (or min) filter over the tile statistics, ignoring the
+// neighbours that fall outside of the tw x th grid. The filter is
+// separable: a horizontal pass into tmp, then a vertical pass into out.
+static void tile_filter3x3(const uint8_t *in, uint8_t *tmp, uint8_t *out, int tw, int th, bool is_max)
+{
+    if (tw == 0)
+        return;
+
+    for (int ty = 0; ty < th; ty++) {
+        const uint8_t *a = &in[ty*tw];
+        uint8_t *t = &tmp[ty*tw];
+        if (tw == 1) {
+            t[0] = a[0];
+            continue;
+        }
+        t[0] = minmax2(a[0], a[1], is_max);
+        minmax3(a, a + 1, a + 2, t + 1, tw - 2, is_max);
+        t[tw-1] = minmax2(a[tw-2], a[tw-1], is_max);
+    }
+
+    for (int ty = 0; ty < th; ty++) {
+        const uint8_t *prev = &tmp[(ty > 0 ? ty - 1 : ty)*tw];
+        const uint8_t *next = &tmp[(ty + 1 < th ? ty + 1 : ty)*tw];
+        minmax3(prev, &tmp[ty*tw], next, &out[ty*tw], tw, is_max);
+    }
+}
+
+// Binarize one image row covered by full tiles: pixels of low contrast
+// tiles (lowc[tx] == 0xff) become 127, the others 255 when above the
+// tile threshold and 0 otherwise.
+static void threshold_row(const uint8_t *in, uint8_t *out, int tw, const uint8_t *thresh, const uint8_t *lowc)
+{
+    const int tilesz = 4;
+    int tx = 0;
+#if APRILTAG_USE_SSE
+    const __m128i sign = _mm_set1_epi8((char)0x80);
+    const __m128i gray = _mm_set1_epi8(127);
+    for (; tx + 4 <= tw; tx += 4) {
+        int t4, l4;
+        memcpy(&t4, &thresh[tx], 4);
+        memcpy(&l4, &lowc[tx], 4);
+        // replicate each tile value over its 4 pixels
+        __m128i t = _mm_cvtsi32_si128(t4);
+        t = _mm_unpacklo_epi8(t, t);
+        t = _mm_unpacklo_epi16(t, t);
+        __m128i l = _mm_cvtsi32_si128(l4);
+        l = _mm_unpacklo_epi8(l, l);
+        l = _mm_unpacklo_epi16(l, l);
+
+        __m128i v = _mm_loadu_si128((const __m128i *)&in[tx*tilesz]);
+        __m128i gt = _mm_cmpgt_epi8(_mm_xor_si128(v, sign), _mm_xor_si128(t, sign));
+        __m128i r = _mm_or_si128(_mm_and_si128(l, gray), _mm_andnot_si128(l, gt));
+        _mm_storeu_si128((__m128i *)&out[tx*tilesz], r);
+    }
+#elif APRILTAG_USE_NEON
+    const uint8x16_t gray = vdupq_n_u8(127);
+    for (; tx + 4 <= tw; tx += 4) {
+        uint8x8_t t = vld1_u8(&thresh[tx]);
+        uint8x8_t l = vld1_u8(&lowc[tx]);
+        // replicate each tile value over its 4 pixels
+        t = vzip1_u8(t, t);
+        l = vzip1_u8(l, l);
+        uint8x16_t tq = vcombine_u8(vzip1_u8(t, t), vzip2_u8(t, t));
+        uint8x16_t lq = vcombine_u8(vzip1_u8(l, l), vzip2_u8(l, l));
+
+        uint8x16_t gt = vcgtq_u8(vld1q_u8(&in[tx*tilesz]), tq);
+        vst1q_u8(&out[tx*tilesz], vbslq_u8(lq, gray, gt));
+    }
+#endif
+    for (; tx < tw; tx++) {
+        for (int dx = 0; dx < tilesz; dx++) {
+            int x = tx*tilesz + dx;
+            if (lowc[tx])
+                out[x] = 127;
+            else
+                out[x] = in[x] > thresh[tx] ? 255 : 0;
+        }
+    }
+}
+
 image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
 {
     int w = im->width, h = im->height, s = im->stride;
@@ -1136,105 +1304,50 @@ image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
     uint8_t *im_min = (uint8_t *)calloc(tw*th, sizeof(uint8_t));
 
     // first, collect min/max statistics for each tile
-    for (int ty = 0; ty < th; ty++) {
-        for (int tx = 0; tx < tw; tx++) {
-            uint8_t max = 0, min = 255;
-
-            for (int dy = 0; dy < tilesz; dy++) {
-
-                for (int dx = 0; dx < tilesz; dx++) {
-
-                    uint8_t v = im->buf[(ty*tilesz+dy)*s + tx*tilesz + dx];
-                    if (v < min)
-                        min = v;
-                    if (v > max)
-                        max = v;
-                }
-            }
-
-            im_max[ty*tw+tx] = max;
-            im_min[ty*tw+tx] = min;
-        }
-    }
+    for (int ty = 0; ty < th; ty++)
+        tile_minmax_row(&im->buf[ty*tilesz*s], s, tw, &im_max[ty*tw], &im_min[ty*tw]);
 
     // second, apply 3x3 max/min convolution to "blur" these values
     // over larger areas. This reduces artifacts due to abrupt changes
     // in the threshold value.
     if (1) {
+        uint8_t *im_tmp = (uint8_t *)calloc(tw*th, sizeof(uint8_t));
         uint8_t *im_max_tmp = (uint8_t *)calloc(tw*th, sizeof(uint8_t));
         uint8_t *im_min_tmp = (uint8_t *)calloc(tw*th, sizeof(uint8_t));
 
-        for (int ty = 0; ty < th; ty++) {
-            for (int tx = 0; tx < tw; tx++) {
-                uint8_t max = 0, min = 255;
+        tile_filter3x3(im_max, im_tmp, im_max_tmp, tw, th, true);
+        tile_filter3x3(im_min, im_tmp, im_min_tmp, tw, th, false);
 
-                for (int dy = -1; dy <= 1; dy++) {
-                    if (ty+dy < 0 || ty+dy >= th)
-                        continue;
-                    for (int dx = -1; dx <= 1; dx++) {
-                        if (tx+dx < 0 || tx+dx >= tw)
-                            continue;
-
-                        uint8_t m = im_max[(ty+dy)*tw+tx+dx];
-                        if (m > max)
-                            max = m;
-                        m = im_min[(ty+dy)*tw+tx+dx];
-                        if (m < min)
-                            min = m;
-                    }
-                }
-
-                im_max_tmp[ty*tw + tx] = max;
-                im_min_tmp[ty*tw + tx] = min;
-            }
-        }
+        free(im_tmp);
         free(im_max);
         free(im_min);
         im_max = im_max_tmp;
         im_min = im_min_tmp;
     }
 
-    for (int ty = 0; ty < th; ty++) {
-        for (int tx = 0; tx < tw; tx++) {
-
-            int min = im_min[ty*tw + tx];
-            int max = im_max[ty*tw + tx];
-
-            // low contrast region? (no edges)
-            if (max - min < td->qtp.min_white_black_diff) {
-                for (int dy = 0; dy < tilesz; dy++) {
-                    int y = ty*tilesz + dy;
-
-                    for (int dx = 0; dx < tilesz; dx++) {
-                        int x = tx*tilesz + dx;
-
-                        threshim->buf[y*s+x] = 127;
-                    }
-                }
-                continue;
-            }
-
-            // otherwise, actually threshold this tile.
-
-            // argument for biasing towards dark; specular highlights
-            // can be substantially brighter than white tag parts
-            uint8_t thresh = min + (max - min) / 2;
-
-            for (int dy = 0; dy < tilesz; dy++) {
-                int y = ty*tilesz + dy;
-
-                for (int dx = 0; dx < tilesz; dx++) {
-                    int x = tx*tilesz + dx;
+    // per-tile threshold, and 0xff for low contrast regions (no edges)
+    // that are marked with value 127 so that we can skip future work on
+    // these areas too.
+    uint8_t *im_thresh = (uint8_t *)calloc(tw*th + 4, sizeof(uint8_t));
+    uint8_t *im_lowc = (uint8_t *)calloc(tw*th + 4, sizeof(uint8_t));
+    for (int i = 0; i < tw*th; i++) {
+        int min = im_min[i];
+        int max = im_max[i];
+
+        // argument for biasing towards dark; specular highlights
+        // can be substantially brighter than white tag parts
+        im_thresh[i] = min + (max - min) / 2;
+        im_lowc[i] = (max - min < td->qtp.min_white_black_diff) ? 0xff : 0;
+    }
 
-                    uint8_t v = im->buf[y*s+x];
-                    if (v > thresh)
-                        threshim->buf[y*s+x] = 255;
-                    else
-                        threshim->buf[y*s+x] = 0;
-                }
-            }
+    for (int ty = 0; ty < th; ty++) {
+        for (int dy = 0; dy < tilesz; dy++) {
+            int y = ty*tilesz + dy;
+            threshold_row(&im->buf[y*s], &threshim->buf[y*s], tw, &im_thresh[ty*tw], &im_lowc[ty*tw]);
         }
     }
+    free(im_thresh);
+    free(im_lowc);
 
     // we skipped over the non-full-sized tiles above. Fix those now.
     if (1) {
@@ -35,6 +35,7 @@ either expressed or implied, of the Regents of The University of Michigan.
 #include "common/image_u8.h"
 #include "common/pnm.h"
 #include "common/math_util.h"
+#include "common/simd.h"
 
 // least common multiple of 64 (sandy bridge cache line) and 24 (stride
 // needed for RGB in 8-wide vector processing)
@@ -302,7 +303,30 @@ static void convolve(const uint8_t *x, uint8_t *y, int sz, const uint8_t *k, int
     for (int i = 0; i < ksz/2 && i < sz; i++)
         y[i] = x[i];
 
-    for (int i = 0; i < sz - ksz; i++) {
+    // The kernel built by image_u8_gaussian_blur() sums to at most 255,
+    // so the accumulator fits in 16 bits for 8 outputs per vector.
+    int i = 0;
+#if APRILTAG_USE_SSE
+    for (; i + 8 <= sz - ksz; i += 8) {
+        __m128i acc = _mm_setzero_si128();
+        const __m128i zero = _mm_setzero_si128();
+        for (int j = 0; j < ksz; j++) {
+            __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&x[i+j]), zero);
+            acc = _mm_add_epi16(acc, _mm_mullo_epi16(v, _mm_set1_epi16(k[j])));
+        }
+        acc = _mm_srli_epi16(acc, 8);
+        _mm_storel_epi64((__m128i *)&y[ksz/2 + i], _mm_packus_epi16(acc, acc));
+    }
+#elif APRILTAG_USE_NEON
+    for (; i + 8 <= sz - ksz; i += 8) {
+        uint16x8_t acc = vmull_u8(vld1_u8(&x[i]), vdup_n_u8(k[0]));
+        for (int j = 1; j < ksz; j++)
+            acc = vmlal_u8(acc, vld1_u8(&x[i+j]), vdup_n_u8(k[j]));
+        vst1_u8(&y[ksz/2 + i], vshrn_n_u16(acc, 8));
+    }
+#endif
+
+    for (; i < sz - ksz; i++) {
         uint32_t acc = 0;
 
         for (int j = 0; j < ksz; j++)
@@ -315,33 +339,73 @@ static void convolve(const uint8_t *x, uint8_t *y, int sz, const uint8_t *k, int
         y[i] = x[i];
 }
 
+// Vertical pass of image_u8_convolve_2D(): out[o] is computed from the
+// ksz input rows in[o-ksz/2] .. in[o+ksz/2], column by column.
+static void convolve_rows(const uint8_t *in, int stride, uint8_t *out, int width, int o, const uint8_t *k, int ksz)
+{
+    const uint8_t *src = &in[(o - ksz/2)*stride];
+    int x = 0;
+#if APRILTAG_USE_SSE
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 16 <= width; x += 16) {
+        __m128i acc_lo = _mm_setzero_si128(), acc_hi = _mm_setzero_si128();
+        for (int j = 0; j < ksz; j++) {
+            __m128i v = _mm_loadu_si128((const __m128i *)&src[j*stride + x]);
+            __m128i kj = _mm_set1_epi16(k[j]);
+            acc_lo = _mm_add_epi16(acc_lo, _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), kj));
+            acc_hi = _mm_add_epi16(acc_hi, _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), kj));
+        }
+        _mm_storeu_si128((__m128i *)&out[x], _mm_packus_epi16(_mm_srli_epi16(acc_lo, 8), _mm_srli_epi16(acc_hi, 8)));
+    }
+#elif APRILTAG_USE_NEON
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t v = vld1q_u8(&src[x]);
+        uint16x8_t acc_lo = vmull_u8(vget_low_u8(v), vdup_n_u8(k[0]));
+        uint16x8_t acc_hi = vmull_u8(vget_high_u8(v), vdup_n_u8(k[0]));
+        for (int j = 1; j < ksz; j++) {
+            v = vld1q_u8(&src[j*stride + x]);
+            acc_lo = vmlal_u8(acc_lo, vget_low_u8(v), vdup_n_u8(k[j]));
+            acc_hi = vmlal_u8(acc_hi, vget_high_u8(v), vdup_n_u8(k[j]));
+        }
+        vst1q_u8(&out[x], vcombine_u8(vshrn_n_u16(acc_lo, 8), vshrn_n_u16(acc_hi, 8)));
+    }
+#endif
+    for (; x < width; x++) {
+        uint32_t acc = 0;
+
+        for (int j = 0; j < ksz; j++)
+            acc += k[j]*src[j*stride + x];
+
+        out[x] = acc >> 8;
+    }
+}
+
 void image_u8_convolve_2D(image_u8_t *im, const uint8_t *k, int ksz)
 {
     assert((ksz & 1) == 1); // ksz must be odd.
 
+    uint8_t *x = (uint8_t *)malloc(sizeof(uint8_t)*im->stride);
     for (int y = 0; y < im->height; y++) {
-
-        uint8_t *x = (uint8_t *)malloc(sizeof(uint8_t)*im->stride);
         memcpy(x, &im->buf[y*im->stride], im->stride);
 
         convolve(x, &im->buf[y*im->stride], im->width, k, ksz);
-        free(x);
     }
+    free(x);
 
-    for (int x = 0; x < im->width; x++) {
-        uint8_t *xb = (uint8_t *)malloc(sizeof(uint8_t)*im->height);
-        uint8_t *yb = (uint8_t *)malloc(sizeof(uint8_t)*im->height);
+    // The vertical pass works on whole rows of a copy of the image
+    // instead of gathering each column, so that it can be vectorized.
+    // Rows closer than ksz/2 to the borders are left unchanged, as in
+    // convolve().
+    if (im->height <= ksz)
+        return;
 
-        for (int y = 0; y < im->height; y++)
-            xb[y] = im->buf[y*im->stride + x];
+    uint8_t *in = (uint8_t *)malloc((size_t)(im->height)*(size_t)(im->stride)*sizeof(uint8_t));
+    memcpy(in, im->buf, (size_t)(im->height)*(size_t)(im->stride)*sizeof(uint8_t));
 
-        convolve(xb, yb, im->height, k, ksz);
-        free(xb);
+    for (int o = ksz/2; o < im->height - ksz + ksz/2; o++)
+        convolve_rows(in, im->stride, &im->buf[o*im->stride], im->width, o, k, ksz);
 
-        for (int y = 0; y < im->height; y++)
-            im->buf[y*im->stride + x] = yb[y];
-        free(yb);
-    }
+    free(in);
 }
 
 void image_u8_gaussian_blur(image_u8_t *im, double sigma, int ksz)
@@ -496,9 +560,38 @@ image_u8_t *image_u8_decimate(image_u8_t *im, float ffactor)
     image_u8_t *decim = image_u8_create(swidth, sheight);
     int sy = 0;
     for (int y = 0; y < height; y += factor) {
+        const uint8_t *src = &im->buf[y*im->stride];
+        uint8_t *dst = &decim->buf[sy*decim->stride];
         int sx = 0;
-        for (int x = 0; x < width; x += factor) {
-            decim->buf[sy*decim->stride + sx] = im->buf[y*im->stride + x];
+#if APRILTAG_USE_SSE
+        if (factor == 2) {
+            const __m128i mask = _mm_set1_epi16(0x00ff);
+            for (; 2*sx + 32 <= width; sx += 16) {
+                __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[2*sx]), mask);
+                __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[2*sx + 16]), mask);
+                _mm_storeu_si128((__m128i *)&dst[sx], _mm_packus_epi16(a, b));
+            }
+        } else if (factor == 4) {
+            const __m128i mask = _mm_set1_epi32(0x000000ff);
+            for (; 4*sx + 64 <= width; sx += 16) {
+                __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[4*sx]), mask);
+                __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[4*sx + 16]), mask);
+                __m128i c = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[4*sx + 32]), mask);
+                __m128i d = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[4*sx + 48]), mask);
+                _mm_storeu_si128((__m128i *)&dst[sx], _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+            }
+        }
+#elif APRILTAG_USE_NEON
+        if (factor == 2) {
+            for (; 2*sx + 32 <= width; sx += 16)
+                vst1q_u8(&dst[sx], vld2q_u8(&src[2*sx]).val[0]);
+        } else if (factor == 4) {
+            for (; 4*sx + 64 <= width; sx += 16)
+                vst1q_u8(&dst[sx], vld4q_u8(&src[4*sx]).val[0]);
+        }
+#endif
+        for (int x = sx*factor; x < width; x += factor) {
+            dst[sx] = src[x];
             sx++;
         }
         sy++;
@@ -173,25 +173,39 @@ public:
     g = (unsigned char)dg;
     b = (unsigned char)db;
   }
-  static void YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
   static void YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsigned int size);
   static void YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
   static void YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
   static void YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
-  static void YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
-  static void YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
+  static void YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads = 0);
+  static void YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads = 0);
   static void YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
-  static void YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                           unsigned int nThreads = 0);
+  static void YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                          unsigned int nThreads = 0);
   static void YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
 
   static void YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
   static void YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
   static void YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
 
-  static void YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
-  static void YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
+  static void NV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void NV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
+  static void NV21ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nThreads = 0);
+  static void NV21ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nThreads = 0);
   static void YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
   static void YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
   static void RGBToRGBa(unsigned char *rgb, unsigned char *rgba, unsigned int size);
@@ -227,8 +241,8 @@ public:
   static void YCbCrToGrey(unsigned char *ycbcr, unsigned char *grey, unsigned int size);
   static void YCrCbToRGB(unsigned char *ycrcb, unsigned char *rgb, unsigned int size);
   static void YCrCbToRGBa(unsigned char *ycrcb, unsigned char *rgb, unsigned int size);
-  static void MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size);
-  static void MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size);
+  static void MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size, unsigned int nThreads = 0);
+  static void MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size, unsigned int nThreads = 0);
 
   static void HSVToRGBa(const double *hue, const double *saturation, const double *value, unsigned char *rgba,
                         unsigned int size);
@@ -43,10 +43,12 @@
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpMatrix.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <math.h>
 #include <string.h>
+#include <vector>
 
 /*!
   \class vpImageMorphology
@@ -417,34 +419,82 @@ void vpImageMorphology::imageOperation(vpImage<T> &I, const T &(*operation)(cons
 
   const int width_in = I.getWidth();
   const int height_in = I.getHeight();
-  int halfKernelSize = size / 2;
-  vpImage<T> J = I;
-
-  for (int r = 0; r < height_in; r++) {
-    // Computing the rows we can explore without going outside the limits of the image
-    int r_iterator_start = -halfKernelSize, r_iterator_stop = halfKernelSize + 1;
-    if (r - halfKernelSize < 0) {
-      r_iterator_start = -r;
-    }
-    else if (r + halfKernelSize >= height_in) {
-      r_iterator_stop = height_in - r;
-    }
-    for (int c = 0; c < width_in; c++) {
-      T value = I[r][c];
-      // Computing the columns we can explore without going outside the limits of the image
-      int c_iterator_start = -halfKernelSize, c_iterator_stop = halfKernelSize + 1;
-      if (c - halfKernelSize < 0) {
-        c_iterator_start = -c;
+  if (width_in == 0 || height_in == 0) {
+    return;
+  }
+  const int halfKernelSize = size / 2;
+
+  // The square structuring element is separated into a horizontal and a vertical pass, each one
+  // computed with the van Herk/Gil-Werman algorithm: the image is cut into blocks of size pixels,
+  // in which running prefix and suffix results are computed. A window [a, b], clipped to the image,
+  // covers at most two consecutive blocks and its result is operation(suffix[a], prefix[b]).
+  // The cost is then about 3 operations per pixel and per pass whatever the kernel size.
+  vpImage<T> J(height_in, width_in);
+
+  // Horizontal pass, from I to J
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    std::vector<T> prefix(width_in), suffix(width_in);
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (int r = 0; r < height_in; r++) {
+      const T *src = I[r];
+      T *dst = J[r];
+      for (int c = 0; c < width_in; c++) {
+        prefix[c] = (c % size == 0) ? src[c] : operation(prefix[c - 1], src[c]);
       }
-      else if (c + halfKernelSize >= width_in) {
-        c_iterator_stop = width_in - c;
+      for (int c = width_in - 1; c >= 0; c--) {
+        suffix[c] = (c % size == size - 1 || c == width_in - 1) ? src[c] : operation(suffix[c + 1], src[c]);
       }
-      for (int r_iterator = r_iterator_start; r_iterator < r_iterator_stop; r_iterator++) {
-        for (int c_iterator = c_iterator_start; c_iterator < c_iterator_stop; c_iterator++) {
-          value = operation(value, J[r + r_iterator][c + c_iterator]);
+      for (int c = 0; c < width_in; c++) {
+        const int a = std::max(0, c - halfKernelSize), b = std::min(width_in - 1, c + halfKernelSize);
+        if (a / size != b / size) {
+          dst[c] = operation(suffix[a], prefix[b]);
+        }
+        else {
+          dst[c] = (a % size == 0) ? prefix[b] : suffix[a];
         }
       }
-      I[r][c] = value;
+    }
+  }
+
+  // Vertical pass, from J to I, the prefix and suffix rows being computed block by block
+  vpImage<T> prefix(height_in, width_in), suffix(height_in, width_in);
+  const int nbBlocks = (height_in + size - 1) / size;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (int block = 0; block < nbBlocks; block++) {
+    const int first = block * size, last = std::min(height_in, first + size) - 1;
+    memcpy(prefix[first], J[first], width_in * sizeof(T));
+    for (int r = first + 1; r <= last; r++) {
+      for (int c = 0; c < width_in; c++) {
+        prefix[r][c] = operation(prefix[r - 1][c], J[r][c]);
+      }
+    }
+    memcpy(suffix[last], J[last], width_in * sizeof(T));
+    for (int r = last - 1; r >= first; r--) {
+      for (int c = 0; c < width_in; c++) {
+        suffix[r][c] = operation(suffix[r + 1][c], J[r][c]);
+      }
+    }
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (int r = 0; r < height_in; r++) {
+    const int a = std::max(0, r - halfKernelSize), b = std::min(height_in - 1, r + halfKernelSize);
+    if (a / size != b / size) {
+      for (int c = 0; c < width_in; c++) {
+        I[r][c] = operation(suffix[a][c], prefix[b][c]);
+      }
+    }
+    else {
+      memcpy(I[r], (a % size == 0) ? prefix[b] : suffix[a], width_in * sizeof(T));
     }
   }
 }
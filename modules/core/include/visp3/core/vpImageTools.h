@@ -81,6 +81,33 @@ public:
     INTERPOLATION_AREA     /*!< Area interpolation (optimized by SIMD lib if enabled). */
   };
 
+  enum vpTemplateMatchingMethod
+  {
+    TEMPLATE_MATCHING_DIRECT, /*!< Correlation computed in the spatial domain using integral images. */
+    TEMPLATE_MATCHING_FFT,    /*!< Correlation computed by blocks in the frequency domain (large templates). */
+    TEMPLATE_MATCHING_AUTO    /*!< Direct or FFT correlation, chosen from the template size and the steps. */
+  };
+
+  /*!
+    Parameters of templateMatching(const vpImage<unsigned char> &, const vpImage<unsigned char> &, vpImage<double> &,
+    const vpTemplateMatchingOptions &).
+  */
+  struct vpTemplateMatchingOptions
+  {
+    vpTemplateMatchingOptions()
+      : m_method(TEMPLATE_MATCHING_AUTO), m_stepU(1), m_stepV(1), m_nbPyramidLevels(1), m_nbCandidates(5),
+      m_searchRadius(2), m_nbThreads(0)
+    { }
+
+    vpTemplateMatchingMethod m_method; //!< Method used for the exhaustive search.
+    unsigned int m_stepU;              //!< Step in u-direction of the exhaustive search.
+    unsigned int m_stepV;              //!< Step in v-direction of the exhaustive search.
+    unsigned int m_nbPyramidLevels;    //!< Number of pyramid levels, 1 to search only at full resolution.
+    unsigned int m_nbCandidates;       //!< Number of candidates refined from one pyramid level to the next.
+    unsigned int m_searchRadius;       //!< Refinement radius in pixels around each upsampled candidate.
+    unsigned int m_nbThreads;          //!< Number of OpenMP threads, 0 to keep the OpenMP default.
+  };
+
   template <class Type>
   static inline void binarise(vpImage<Type> &I, Type threshold1, Type threshold2, Type value1, Type value2, Type value3,
                               bool useLUT = true);
@@ -103,6 +130,16 @@ public:
   static void crop(const unsigned char *bitmap, unsigned int width, unsigned int height, const vpRect &roi,
                    vpImage<Type> &crop, unsigned int v_scale = 1, unsigned int h_scale = 1);
 
+  static void cropResize(const vpImage<unsigned char> &I, const vpRect &roi, vpImage<unsigned char> &Ires,
+                         unsigned int width, unsigned int height,
+                         const vpImageInterpolationType &method = INTERPOLATION_LINEAR, unsigned int nThreads = 0);
+  static void cropResize(const vpImage<vpRGBa> &I, const vpRect &roi, vpImage<vpRGBa> &Ires, unsigned int width,
+                         unsigned int height, const vpImageInterpolationType &method = INTERPOLATION_LINEAR,
+                         unsigned int nThreads = 0);
+  static void cropResize(const vpImage<vpRGBa> &I, const vpRect &roi, vpImage<unsigned char> &Ires,
+                         unsigned int width, unsigned int height,
+                         const vpImageInterpolationType &method = INTERPOLATION_LINEAR, unsigned int nThreads = 0);
+
   static void extract(const vpImage<unsigned char> &Src, vpImage<unsigned char> &Dst, const vpRectOriented &r);
   static void extract(const vpImage<unsigned char> &Src, vpImage<double> &Dst, const vpRectOriented &r);
 
@@ -154,6 +191,8 @@ public:
   static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
                                bool useOptimized = true);
+  static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                               vpImage<double> &I_score, const vpTemplateMatchingOptions &options);
 
   template <class Type>
   static void undistort(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &newI,
@@ -190,6 +229,19 @@ private:
 
   static int coordCast(double x);
 
+  static void cropResizeRoi(const vpRect &roi, unsigned int imgWidth, unsigned int imgHeight, unsigned int width,
+                            unsigned int height, unsigned int &top, unsigned int &left, unsigned int &roiWidth,
+                            unsigned int &roiHeight);
+
+  template <class Type>
+  static void cropResizeRow(const vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int roiWidth,
+                            unsigned int roiHeight, unsigned int width, unsigned int height, unsigned int i,
+                            const vpImageInterpolationType &method, Type *dst);
+
+  template <class Type>
+  static void cropResizeTpl(const vpImage<Type> &I, const vpRect &roi, vpImage<Type> &Ires, unsigned int width,
+                            unsigned int height, const vpImageInterpolationType &method, unsigned int nThreads);
+
   // Linear interpolation
   static double lerp(double A, double B, double t);
   static float lerp(float A, float B, float t);
@@ -199,6 +251,10 @@ private:
                                       const vpImage<double> &IIsq, const vpImage<double> &II_tpl,
                                       const vpImage<double> &IIsq_tpl, unsigned int i0, unsigned int j0);
 
+  static void templateMatchingExhaustive(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                         vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
+                                         vpTemplateMatchingMethod method, unsigned int nbThreads);
+
   template <class Type>
   static void resizeBicubic(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int i, unsigned int j, float u,
                             float v, float xFrac, float yFrac);
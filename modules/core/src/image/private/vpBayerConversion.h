@@ -72,6 +72,66 @@ template <typename T> T demosaicCrossBilinear(const T *bayer, unsigned int width
                         0.25f * bayer[i * width + j + 1] + 0.25f * bayer[(i + 1) * width + j]);
 }
 
+// Bilinear interpolation of the pixels 1 to width-2 of the row i, processed by pairs of columns (odd, even). The row
+// holds either red or blue pixels, its green pixels being on the odd or on the even columns
+template <typename T, bool redRow, bool greenOdd>
+void demosaicRowBilinear(const T *bayer, T *rgba, unsigned int width, unsigned int i)
+{
+  for (unsigned int j = 1; j < width - 1; j += 2) {
+    for (unsigned int k = 0; k < 2; k++) {
+      const unsigned int jk = j + k;
+      T *dst = rgba + (i * width + jk) * 4;
+      if ((k == 0) == greenOdd) {
+        dst[0] = redRow ? demosaicThetaBilinear(bayer, width, i, jk) : demosaicPhiBilinear(bayer, width, i, jk);
+        dst[1] = bayer[i * width + jk];
+        dst[2] = redRow ? demosaicPhiBilinear(bayer, width, i, jk) : demosaicThetaBilinear(bayer, width, i, jk);
+      }
+      else {
+        dst[0] = redRow ? bayer[i * width + jk] : demosaicCheckerBilinear(bayer, width, i, jk);
+        dst[1] = demosaicCrossBilinear(bayer, width, i, jk);
+        dst[2] = redRow ? demosaicCheckerBilinear(bayer, width, i, jk) : bayer[i * width + jk];
+      }
+    }
+  }
+}
+
+// Bilinear interpolation of the pixels that are not on the image border. The even rows hold the red pixels when
+// evenRowRed is true and their green pixels are on the odd columns when evenRowGreenOdd is true, the odd rows being
+// the other way round
+template <typename T>
+void demosaicInteriorBilinear(const T *bayer, T *rgba, unsigned int width, unsigned int height, bool evenRowRed,
+                              bool evenRowGreenOdd, unsigned int nThreads)
+{
+#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
+#endif
+  for (unsigned int i = 1; i < height - 1; i++) {
+    const bool redRow = ((i % 2) == 0) == evenRowRed;
+    const bool greenOdd = ((i % 2) == 0) == evenRowGreenOdd;
+    if (redRow) {
+      if (greenOdd) {
+        demosaicRowBilinear<T, true, true>(bayer, rgba, width, i);
+      }
+      else {
+        demosaicRowBilinear<T, true, false>(bayer, rgba, width, i);
+      }
+    }
+    else {
+      if (greenOdd) {
+        demosaicRowBilinear<T, false, true>(bayer, rgba, width, i);
+      }
+      else {
+        demosaicRowBilinear<T, false, false>(bayer, rgba, width, i);
+      }
+    }
+  }
+}
+
 // Malvar
 template <typename T> T demosaicPhiMalvar(const T *bayer, unsigned int width, unsigned int i, unsigned int j)
 {
@@ -200,38 +260,7 @@ void demosaicBGGRToRGBaBilinearTpl(const T *bggr, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; i++) {
-    for (unsigned int j = 1; j < width - 1; j++) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = bggr[i * width + j];
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(bggr, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(bggr, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = bggr[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(bggr, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(bggr, width, i, j);
-      }
-    }
-  }
+  demosaicInteriorBilinear(bggr, rgba, width, height, false, true, nThreads);
 }
 
 template <typename T>
@@ -324,38 +353,7 @@ void demosaicGBRGToRGBaBilinearTpl(const T *gbrg, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; i++) {
-    for (unsigned int j = 1; j < width - 1; j++) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(gbrg, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = gbrg[i * width + j];
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(gbrg, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(gbrg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = gbrg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(gbrg, width, i, j);
-      }
-    }
-  }
+  demosaicInteriorBilinear(gbrg, rgba, width, height, false, false, nThreads);
 }
 
 template <typename T>
@@ -448,38 +446,7 @@ void demosaicGRBGToRGBaBilinearTpl(const T *grbg, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; i++) {
-    for (unsigned int j = 1; j < width - 1; j++) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(grbg, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(grbg, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = grbg[i * width + j];
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(grbg, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = grbg[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(grbg, width, i, j);
-      }
-    }
-  }
+  demosaicInteriorBilinear(grbg, rgba, width, height, true, false, nThreads);
 }
 
 template <typename T>
@@ -572,38 +539,7 @@ void demosaicRGGBToRGBaBilinearTpl(const T *rggb, T *rgba, unsigned int width, u
     }
   }
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-#pragma omp parallel for schedule(dynamic)
-#else
-  (void)nThreads;
-#endif
-  for (unsigned int i = 1; i < height - 1; i++) {
-    for (unsigned int j = 1; j < width - 1; j++) {
-      if (i % 2 == 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = demosaicCheckerBilinear(rggb, width, i, j);
-      }
-      else if (i % 2 == 0 && j % 2 != 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicThetaBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicPhiBilinear(rggb, width, i, j);
-      }
-      else if (i % 2 != 0 && j % 2 == 0) {
-        rgba[(i * width + j) * 4 + 0] = demosaicPhiBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = rggb[i * width + j];
-        rgba[(i * width + j) * 4 + 2] = demosaicThetaBilinear(rggb, width, i, j);
-      }
-      else {
-        rgba[(i * width + j) * 4 + 0] = demosaicCheckerBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 1] = demosaicCrossBilinear(rggb, width, i, j);
-        rgba[(i * width + j) * 4 + 2] = rggb[i * width + j];
-      }
-    }
-  }
+  demosaicInteriorBilinear(rggb, rgba, width, height, true, true, nThreads);
 }
 
 // Malvar
@@ -998,13 +998,139 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 
 #endif
 
-#define vpSAT(c)                                                                                                       \
-  if (c & (~255)) {                                                                                                    \
-    if (c < 0)                                                                                                         \
-      c = 0;                                                                                                           \
-    else                                                                                                               \
-      c = 255;                                                                                                         \
+namespace
+{
+// Saturation to [0, 255] of the color components computed by the YUV conversions, that lie in [-256, 511]
+struct vpYUVSaturationTable
+{
+  static const int offset = 256;
+  unsigned char m_table[768];
+
+  vpYUVSaturationTable()
+  {
+    for (int i = 0; i < 768; ++i) {
+      m_table[i] = vpMath::saturate<unsigned char>(i - offset);
+    }
+  }
+};
+const vpYUVSaturationTable g_yuvSaturation;
+
+// Color of a pixel whose luminance is Y, from the chrominance terms dr, dg and db of its red, green and blue
+// components, saturated by a table look-up instead of branches. The alpha component is set to vpRGBa::alpha_default
+// for a RGBa image (nbChannels = 4)
+template <unsigned int nbChannels> inline void vpYUVToRGBPixel(int Y, int dr, int dg, int db, unsigned char *rgb)
+{
+  const unsigned char *saturate = g_yuvSaturation.m_table + vpYUVSaturationTable::offset;
+  rgb[0] = saturate[Y + dr];
+  rgb[1] = saturate[Y + dg];
+  rgb[2] = saturate[Y + db];
+  if (nbChannels == 4) {
+    rgb[3] = vpRGBa::alpha_default;
+  }
+}
+
+// Conversion of a YUYV 4:2:2 image into a RGB (nbChannels = 3) or RGBa (nbChannels = 4) image, by bands of rows
+template <unsigned int nbChannels>
+void vpYUYVToRGB(const unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height,
+                 unsigned int nThreads)
+{
+  const unsigned int nbPairs = width / 2;
+  const int nbRows = static_cast<int>(height);
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < nbRows; ++i) {
+    const unsigned char *src = yuyv + (static_cast<size_t>(i) * nbPairs * 4);
+    unsigned char *dst = rgb + (static_cast<size_t>(i) * nbPairs * 2 * nbChannels);
+    for (unsigned int j = 0; j < nbPairs; ++j) {
+      const int u = src[(4 * j) + 1] - 128;
+      const int v = src[(4 * j) + 3] - 128;
+      const int cb = (u * 454) >> 8;
+      const int cg = ((u * 88) + (v * 183)) >> 8;
+      const int cr = (v * 359) >> 8;
+      vpYUVToRGBPixel<nbChannels>(src[4 * j], cr, -cg, cb, dst + (2 * j * nbChannels));
+      vpYUVToRGBPixel<nbChannels>(src[(4 * j) + 2], cr, -cg, cb, dst + (((2 * j) + 1) * nbChannels));
+    }
   }
+}
+
+// Chrominance terms of the approximation R = Y + 1.402 V, G = Y - 0.344 U - 0.714 V, B = Y + 1.772 U used by the
+// YUV 4:2:2 and 4:2:0 conversions. For 8-bits chrominances, (c * 354) / 1000 and (c * 707) / 1000 are exactly the
+// truncations of c * 0.354 and c * 0.707
+inline void vpYUVChromaTerms(unsigned char u, unsigned char v, int &dr, int &dg, int &db)
+{
+  const int U = ((u - 128) * 354) / 1000;
+  const int V = ((v - 128) * 707) / 1000;
+  dr = 2 * V;
+  dg = -U - V;
+  db = 5 * U;
+}
+
+// Conversion of a YUV 4:2:2 (u y0 v y1) image into a RGB (nbChannels = 3) or RGBa (nbChannels = 4) image
+template <unsigned int nbChannels>
+void vpUYVYToRGB(const unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads)
+{
+  const int nbPairs = static_cast<int>(size / 2);
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for
+#else
+  (void)nThreads;
+#endif
+  for (int k = 0; k < nbPairs; ++k) {
+    const unsigned char *src = yuv + (4 * static_cast<size_t>(k));
+    unsigned char *dst = rgb + (2 * nbChannels * static_cast<size_t>(k));
+    int dr, dg, db;
+    vpYUVChromaTerms(src[0], src[2], dr, dg, db);
+    vpYUVToRGBPixel<nbChannels>(src[1], dr, dg, db, dst);
+    vpYUVToRGBPixel<nbChannels>(src[3], dr, dg, db, dst + nbChannels);
+  }
+}
+
+// Conversion of a YUV 4:2:0 image, planar or semi-planar, into a RGB (nbChannels = 3) or RGBa (nbChannels = 4) image,
+// by bands of pairs of rows. The chrominances of a pair of rows start at u + i * uvRowStep and v + i * uvRowStep,
+// with a chrominance every uvStep bytes
+template <unsigned int nbChannels>
+void vpYUV420ToRGB(const unsigned char *yuv, const unsigned char *u, const unsigned char *v, unsigned int uvStep,
+                   unsigned int uvRowStep, unsigned char *rgb, unsigned int width, unsigned int height,
+                   unsigned int nThreads)
+{
+  const unsigned int nbPairs = width / 2;
+  const int nbRowPairs = static_cast<int>(height / 2);
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < nbRowPairs; ++i) {
+    const unsigned char *y0 = yuv + (2 * static_cast<size_t>(i) * width);
+    const unsigned char *y1 = y0 + width;
+    const unsigned char *ui = u + (static_cast<size_t>(i) * uvRowStep);
+    const unsigned char *vi = v + (static_cast<size_t>(i) * uvRowStep);
+    unsigned char *d0 = rgb + (2 * static_cast<size_t>(i) * width * nbChannels);
+    unsigned char *d1 = d0 + (width * nbChannels);
+    for (unsigned int j = 0; j < nbPairs; ++j) {
+      int dr, dg, db;
+      vpYUVChromaTerms(ui[j * uvStep], vi[j * uvStep], dr, dg, db);
+      vpYUVToRGBPixel<nbChannels>(y0[2 * j], dr, dg, db, d0 + (2 * j * nbChannels));
+      vpYUVToRGBPixel<nbChannels>(y0[(2 * j) + 1], dr, dg, db, d0 + (((2 * j) + 1) * nbChannels));
+      vpYUVToRGBPixel<nbChannels>(y1[2 * j], dr, dg, db, d1 + (2 * j * nbChannels));
+      vpYUVToRGBPixel<nbChannels>(y1[(2 * j) + 1], dr, dg, db, d1 + (((2 * j) + 1) * nbChannels));
+    }
+  }
+}
+} // namespace
+
 /*!
   Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB32.
   Destination rgba memory area has to be allocated before.
@@ -1014,51 +1140,14 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
   \param[in] yuyv : Pointer to the bitmap containing the YUYV 4:2:2 data.
   \param[out] rgba : Pointer to the RGB32 bitmap that should be allocated with a size of \e width * \e height * 4.
   \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUV422ToRGBa()
 */
-void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r) vpSAT(g) vpSAT(b)
-
-        *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r) vpSAT(g) vpSAT(b)
-
-        *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-    }
-  }
+  vpYUYVToRGB<4>(yuyv, rgba, width, height, nThreads);
 }
 
 /*!
@@ -1068,49 +1157,14 @@ void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsign
   \param[in] yuyv : Pointer to the bitmap containing the YUYV 4:2:2 data.
   \param[out] rgb : Pointer to the RGB32 bitmap that should be allocated with a size of \e width * \e height * 3.
   \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUV422ToRGB()
 */
-void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height)
+void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int h, w;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgb;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r) vpSAT(g) vpSAT(b)
-
-        *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r) vpSAT(g) vpSAT(b)
-
-        *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-    }
-  }
+  vpYUYVToRGB<3>(yuyv, rgb, width, height, nThreads);
 }
 
 /*!
@@ -1305,95 +1359,13 @@ void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:2 data.
   \param[out] rgba : Pointer to the RGBA 32-bits bitmap that should be allocated with a size of width * height * 4.
   \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUYVToRGBa()
 */
-void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
+void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size, unsigned int nThreads)
 {
-
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGBa()" << std::endl;
-  for (unsigned int i = size / 2; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y1 = *yuv++;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-  }
-
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 2], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    YUVToRGB(yuv[j + 3], yuv[j], yuv[j + 2], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-    j += 4;
-  }
-#endif
+  vpUYVYToRGB<4>(yuv, rgba, size, nThreads);
 }
 
 /*!
@@ -1426,90 +1398,13 @@ void vpImageConvert::YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:2 data.
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] size : Image size corresponding to width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
   \sa YUYVToRGB()
 */
-void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
+void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size, unsigned int nThreads)
 {
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGB()" << std::endl;
-  for (unsigned int i = size / 2; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y1 = *yuv++;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-  }
-
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 2], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-
-    YUVToRGB(yuv[j + 3], yuv[j], yuv[j + 2], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-    j += 4;
-  }
-#endif
+  vpUYVYToRGB<3>(yuv, rgb, size, nThreads);
 }
 
 /*!
@@ -1696,134 +1591,14 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:0 data.
   \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
 */
-void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                  unsigned int nThreads)
 {
-  //  std::cout << "call optimized ConvertYUV420ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  const unsigned int size = width * height;
+  vpYUV420ToRGB<4>(yuv, yuv + size, yuv + ((5 * size) / 4), 1, width / 2, rgba, width, height, nThreads);
 }
 
 /*!
@@ -1832,130 +1607,14 @@ void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
   \param[in] yuv : Pointer to the bitmap containing the YUV 4:2:0 data.
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
 */
-void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height)
+void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                                 unsigned int nThreads)
 {
-  //  std::cout << "call optimized ConvertYUV420ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 5;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb - 3 * width + 1;
-    }
-    yuv += width;
-    rgb += 3 * width;
-  }
+  const unsigned int size = width * height;
+  vpYUV420ToRGB<3>(yuv, yuv + size, yuv + ((5 * size) / 4), 1, width / 2, rgb, width, height, nThreads);
 }
 
 /*!
@@ -2089,134 +1748,14 @@ void vpImageConvert::YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsig
   \param[in] yuv : Pointer to the bitmap containing the YV 1:2 data.
   \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
   \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
 */
-void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = 0;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  const unsigned int size = width * height;
+  vpYUV420ToRGB<4>(yuv, yuv + ((5 * size) / 4), yuv + size, 1, width / 2, rgba, width, height, nThreads);
 }
 
 /*!
@@ -2225,130 +1764,88 @@ void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
   \param[in] yuv : Pointer to the bitmap containing the YV 1:2 data.
   \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
   \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
 */
-void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int height, unsigned int width)
+void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
+  const unsigned int size = width * height;
+  vpYUV420ToRGB<3>(yuv, yuv + ((5 * size) / 4), yuv + size, 1, width / 2, rgb, width, height, nThreads);
+}
 
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
+/*!
+  Convert a NV12 [Y(NxM), interleaved UV(N/2xM/2)] image, the YUV 4:2:0 semi-planar format of most hardware video
+  decoders and mobile cameras, into a RGBa image.
 
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
 
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
+  \param[in] yuv : Pointer to the bitmap containing the NV12 data.
+  \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
+  \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
+  \sa NV21ToRGBa(), YUV420ToRGBa()
+*/
+void vpImageConvert::NV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
+{
+  const unsigned char *uv = yuv + (width * height);
+  vpYUV420ToRGB<4>(yuv, uv, uv + 1, 2, width, rgba, width, height, nThreads);
+}
 
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
+/*!
+  Convert a NV12 [Y(NxM), interleaved UV(N/2xM/2)] image into a RGB image.
 
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 5;
+  \param[in] yuv : Pointer to the bitmap containing the NV12 data.
+  \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
+  \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
+  \sa NV21ToRGB(), YUV420ToRGB()
+*/
+void vpImageConvert::NV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
+{
+  const unsigned char *uv = yuv + (width * height);
+  vpYUV420ToRGB<3>(yuv, uv, uv + 1, 2, width, rgb, width, height, nThreads);
+}
 
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
+/*!
+  Convert a NV21 [Y(NxM), interleaved VU(N/2xM/2)] image, the default preview format of Android cameras, into a RGBa
+  image.
 
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
 
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
+  \param[in] yuv : Pointer to the bitmap containing the NV21 data.
+  \param[out] rgba : Pointer to the 32-bits RGBA bitmap that should be allocated with a size of width * height * 4.
+  \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
+  \sa NV12ToRGBa()
+*/
+void vpImageConvert::NV21ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height,
+                                unsigned int nThreads)
+{
+  const unsigned char *vu = yuv + (width * height);
+  vpYUV420ToRGB<4>(yuv, vu + 1, vu, 2, width, rgba, width, height, nThreads);
+}
 
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
+/*!
+  Convert a NV21 [Y(NxM), interleaved VU(N/2xM/2)] image into a RGB image.
 
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
+  \param[in] yuv : Pointer to the bitmap containing the NV21 data.
+  \param[out] rgb : Pointer to the 24-bits RGB bitmap that should be allocated with a size of width * height * 3.
+  \param[in] width, height : Image size.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb - 3 * width + 1;
-    }
-    yuv += width;
-    rgb += 3 * width;
-  }
+  \sa NV12ToRGB()
+*/
+void vpImageConvert::NV21ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nThreads)
+{
+  const unsigned char *vu = yuv + (width * height);
+  vpYUV420ToRGB<3>(yuv, vu + 1, vu, 2, width, rgb, width, height, nThreads);
 }
 
 /*!
@@ -4249,16 +3746,23 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
   \param[out] grey : Pointer to the 8-bit grey image (one byte per pixel) that should
   be allocated with a size of width * height.
   \param[in] size : The image size or the number of pixels corresponding to the image width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 
 */
-void vpImageConvert::MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size)
+void vpImageConvert::MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size, unsigned int nThreads)
 {
-  int i = (((int)size) << 1) - 1;
-  int j = (int)size - 1;
-
-  while (i >= 0) {
-    int y = grey16[i--];
-    grey[j--] = static_cast<unsigned char>((y + (grey16[i--] << 8)) >> 8);
+  // Only the most significant byte, that comes first, is kept
+  const int nbPixels = static_cast<int>(size);
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < nbPixels; ++i) {
+    grey[i] = grey16[2 * i];
   }
 }
 
@@ -4272,19 +3776,26 @@ void vpImageConvert::MONO16ToGrey(unsigned char *grey16, unsigned char *grey, un
   \param[out] rgba : Pointer to the 32-bit RGBA image that should
   be allocated with a size of width * height * 4.
   \param[in] size : The image size or the number of pixels corresponding to the image width * height.
+  \param[in] nThreads : When > 0, the value is used to set the number of OpenMP threads used for the conversion.
 */
-void vpImageConvert::MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size)
+void vpImageConvert::MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size, unsigned int nThreads)
 {
-  int i = (((int)size) << 1) - 1;
-  int j = (int)(size * 4 - 1);
-
-  while (i >= 0) {
-    int y = grey16[i--];
-    unsigned char v = static_cast<unsigned char>((y + (grey16[i--] << 8)) >> 8);
-    rgba[j--] = vpRGBa::alpha_default;
-    rgba[j--] = v;
-    rgba[j--] = v;
-    rgba[j--] = v;
+  // Only the most significant byte, that comes first, is kept
+  const int nbPixels = static_cast<int>(size);
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < nbPixels; ++i) {
+    const unsigned char v = grey16[2 * i];
+    rgba[4 * i] = v;
+    rgba[(4 * i) + 1] = v;
+    rgba[(4 * i) + 2] = v;
+    rgba[(4 * i) + 3] = vpRGBa::alpha_default;
   }
 }
 
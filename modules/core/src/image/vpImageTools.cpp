@@ -35,12 +35,16 @@
 
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImageTools.h>
 
 #if defined(VISP_HAVE_SIMDLIB)
 #include <Simd/SimdLib.hpp>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 /*!
   Change the look up table (LUT) of an image. Considering pixel gray
   level values \f$ l \f$ in the range \f$[A, B]\f$, this method allows
@@ -765,6 +769,471 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
   }
 }
 
+namespace
+{
+// Radix-2 complex FFT of a power of two size, on split real and imaginary parts. The inverse transform is not
+// normalized.
+class vpTemplateMatchingFFT
+{
+public:
+  explicit vpTemplateMatchingFFT(unsigned int n) : m_n(n), m_bitrev(n), m_cos(n / 2), m_sin(n / 2)
+  {
+    unsigned int nbBits = 0;
+    while ((1u << nbBits) < n) {
+      nbBits++;
+    }
+    for (unsigned int i = 0; i < n; i++) {
+      unsigned int r = 0;
+      for (unsigned int b = 0; b < nbBits; b++) {
+        if (i & (1u << b)) {
+          r |= 1u << (nbBits - 1 - b);
+        }
+      }
+      m_bitrev[i] = r;
+    }
+    for (unsigned int k = 0; k < n / 2; k++) {
+      m_cos[k] = cos(2.0 * M_PI * k / n);
+      m_sin[k] = -sin(2.0 * M_PI * k / n);
+    }
+  }
+
+  // Transform of one contiguous sequence of n values
+  void transform(double *re, double *im, bool inverse) const
+  {
+    for (unsigned int i = 0; i < m_n; i++) {
+      const unsigned int j = m_bitrev[i];
+      if (i < j) {
+        std::swap(re[i], re[j]);
+        std::swap(im[i], im[j]);
+      }
+    }
+
+    const double sign = inverse ? -1.0 : 1.0;
+    for (unsigned int len = 2; len <= m_n; len <<= 1) {
+      const unsigned int half = len / 2, stride = m_n / len;
+      for (unsigned int start = 0; start < m_n; start += len) {
+        double *re0 = re + start, *im0 = im + start;
+        double *re1 = re0 + half, *im1 = im0 + half;
+        for (unsigned int k = 0; k < half; k++) {
+          const double wr = m_cos[k * stride], wi = sign * m_sin[k * stride];
+          const double tr = re1[k] * wr - im1[k] * wi;
+          const double ti = re1[k] * wi + im1[k] * wr;
+          re1[k] = re0[k] - tr;
+          im1[k] = im0[k] - ti;
+          re0[k] += tr;
+          im0[k] += ti;
+        }
+      }
+    }
+  }
+
+  // Transform of all the columns of a row-major n x cols matrix; the butterflies combine whole rows so that the
+  // memory accesses stay contiguous
+  void transformColumns(double *re, double *im, unsigned int cols, bool inverse) const
+  {
+    for (unsigned int i = 0; i < m_n; i++) {
+      const unsigned int j = m_bitrev[i];
+      if (i < j) {
+        std::swap_ranges(re + i * cols, re + (i + 1) * cols, re + j * cols);
+        std::swap_ranges(im + i * cols, im + (i + 1) * cols, im + j * cols);
+      }
+    }
+
+    const double sign = inverse ? -1.0 : 1.0;
+    for (unsigned int len = 2; len <= m_n; len <<= 1) {
+      const unsigned int half = len / 2, stride = m_n / len;
+      for (unsigned int start = 0; start < m_n; start += len) {
+        for (unsigned int k = 0; k < half; k++) {
+          const double wr = m_cos[k * stride], wi = sign * m_sin[k * stride];
+          double *re0 = re + (start + k) * cols, *im0 = im + (start + k) * cols;
+          double *re1 = re0 + half * cols, *im1 = im0 + half * cols;
+          for (unsigned int c = 0; c < cols; c++) {
+            const double tr = re1[c] * wr - im1[c] * wi;
+            const double ti = re1[c] * wi + im1[c] * wr;
+            re1[c] = re0[c] - tr;
+            im1[c] = im0[c] - ti;
+            re0[c] += tr;
+            im0[c] += ti;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  unsigned int m_n;
+  std::vector<unsigned int> m_bitrev;
+  std::vector<double> m_cos;
+  std::vector<double> m_sin;
+};
+
+unsigned int nextPowerOfTwo(unsigned int n)
+{
+  unsigned int p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+
+// Size of the overlap-save blocks along one dimension: large enough so that most of each block gives valid
+// correlation values, but not larger than the image itself
+unsigned int correlationBlockSize(unsigned int tplSize, unsigned int imgSize)
+{
+  return std::min(nextPowerOfTwo(2 * tplSize), nextPowerOfTwo(imgSize));
+}
+
+// Rough cost ratio between the FFT and the direct correlation for one valid position, used to select the method
+bool useCorrelationFFT(unsigned int height, unsigned int width, unsigned int height_tpl, unsigned int width_tpl,
+                       unsigned int step_u, unsigned int step_v)
+{
+  const unsigned int N = correlationBlockSize(height_tpl, height), M = correlationBlockSize(width_tpl, width);
+  const double nbValid = static_cast<double>(N - height_tpl + 1) * (M - width_tpl + 1);
+  // Forward and inverse 2D transforms, two blocks being packed in one complex transform
+  const double costFFT = 3.0 * N * M * (log(static_cast<double>(N) * M) / log(2.0)) / nbValid;
+  const double costDirect = static_cast<double>(height_tpl) * width_tpl / (static_cast<double>(step_u) * step_v);
+  return costFFT < costDirect;
+}
+
+// Cross-correlation of I with the (zero-mean) template I_tpl for all the positions of the score image, computed by
+// overlap-save blocks in the frequency domain. Both signals being real, two image blocks are transformed at once,
+// packed in the real and imaginary parts.
+void correlationFFT(const vpImage<double> &I, const vpImage<double> &I_tpl, vpImage<double> &I_corr)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int height_tpl = I_tpl.getHeight(), width_tpl = I_tpl.getWidth();
+  const unsigned int height_corr = height - height_tpl, width_corr = width - width_tpl;
+  I_corr.resize(height_corr, width_corr, 0.0);
+
+  const unsigned int N = correlationBlockSize(height_tpl, height), M = correlationBlockSize(width_tpl, width);
+  const unsigned int validRows = N - height_tpl + 1, validCols = M - width_tpl + 1;
+  const unsigned int nbBlocksV = (height_corr + validRows - 1) / validRows;
+  const unsigned int nbBlocksU = (width_corr + validCols - 1) / validCols;
+  const int nbBlocks = static_cast<int>(nbBlocksV * nbBlocksU);
+  const vpTemplateMatchingFFT fftRows(M), fftCols(N);
+
+  std::vector<double> tplRe(N * M, 0.0), tplIm(N * M, 0.0);
+  for (unsigned int i = 0; i < height_tpl; i++) {
+    std::copy(I_tpl[i], I_tpl[i] + width_tpl, tplRe.begin() + i * M);
+  }
+  for (unsigned int i = 0; i < height_tpl; i++) {
+    fftRows.transform(&tplRe[i * M], &tplIm[i * M], false);
+  }
+  fftCols.transformColumns(tplRe.data(), tplIm.data(), M, false);
+
+  const double scale = 1.0 / (static_cast<double>(N) * M);
+  const int nbPairs = (nbBlocks + 1) / 2;
+
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    std::vector<double> re(N * M), im(N * M);
+
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for (int p = 0; p < nbPairs; p++) {
+      std::fill(re.begin(), re.end(), 0.0);
+      std::fill(im.begin(), im.end(), 0.0);
+
+      unsigned int nbRows = 0;
+      for (int k = 0; k < 2 && 2 * p + k < nbBlocks; k++) {
+        const unsigned int b = static_cast<unsigned int>(2 * p + k);
+        const unsigned int i0 = (b / nbBlocksU) * validRows, j0 = (b % nbBlocksU) * validCols;
+        const unsigned int rows = std::min(N, height - i0), cols = std::min(M, width - j0);
+        double *dst = (k == 0) ? re.data() : im.data();
+        for (unsigned int i = 0; i < rows; i++) {
+          std::copy(I[i0 + i] + j0, I[i0 + i] + j0 + cols, dst + i * M);
+        }
+        nbRows = std::max(nbRows, rows);
+      }
+
+      for (unsigned int i = 0; i < nbRows; i++) {
+        fftRows.transform(&re[i * M], &im[i * M], false);
+      }
+      fftCols.transformColumns(re.data(), im.data(), M, false);
+
+      // Product with the conjugate of the template spectrum
+      for (unsigned int idx = 0; idx < N * M; idx++) {
+        const double a = re[idx], b = im[idx];
+        re[idx] = a * tplRe[idx] + b * tplIm[idx];
+        im[idx] = b * tplRe[idx] - a * tplIm[idx];
+      }
+
+      fftCols.transformColumns(re.data(), im.data(), M, true);
+      for (unsigned int i = 0; i < validRows; i++) {
+        fftRows.transform(&re[i * M], &im[i * M], true);
+      }
+
+      for (int k = 0; k < 2 && 2 * p + k < nbBlocks; k++) {
+        const unsigned int b = static_cast<unsigned int>(2 * p + k);
+        const unsigned int i0 = (b / nbBlocksU) * validRows, j0 = (b % nbBlocksU) * validCols;
+        const unsigned int rows = std::min(validRows, height_corr - i0), cols = std::min(validCols, width_corr - j0);
+        const double *src = (k == 0) ? re.data() : im.data();
+        for (unsigned int i = 0; i < rows; i++) {
+          for (unsigned int j = 0; j < cols; j++) {
+            I_corr[i0 + i][j0 + j] = src[i * M + j] * scale;
+          }
+        }
+      }
+    }
+  }
+}
+
+struct vpTemplateMatchingCandidate
+{
+  double m_score;
+  unsigned int m_i;
+  unsigned int m_j;
+};
+
+// The normalized cross-correlation is bounded, larger values come from the rounding errors on almost uniform windows
+bool isValidTemplateMatchingScore(double score) { return vpMath::isFinite(score) && std::fabs(score) <= 1.0 + 1e-6; }
+
+bool compareTemplateMatchingCandidates(const vpTemplateMatchingCandidate &a, const vpTemplateMatchingCandidate &b)
+{
+  return a.m_score > b.m_score;
+}
+
+// Keep the nb best candidates, discarding those closer than minDist to a better one
+std::vector<vpTemplateMatchingCandidate> selectCandidates(std::vector<vpTemplateMatchingCandidate> &candidates,
+                                                          unsigned int nb, unsigned int minDist)
+{
+  std::sort(candidates.begin(), candidates.end(), compareTemplateMatchingCandidates);
+
+  std::vector<vpTemplateMatchingCandidate> selected;
+  for (size_t k = 0; k < candidates.size() && selected.size() < nb; k++) {
+    bool isolated = true;
+    for (size_t l = 0; l < selected.size() && isolated; l++) {
+      const unsigned int di = std::max(candidates[k].m_i, selected[l].m_i) - std::min(candidates[k].m_i, selected[l].m_i);
+      const unsigned int dj = std::max(candidates[k].m_j, selected[l].m_j) - std::min(candidates[k].m_j, selected[l].m_j);
+      isolated = (di >= minDist) || (dj >= minDist);
+    }
+    if (isolated) {
+      selected.push_back(candidates[k]);
+    }
+  }
+
+  return selected;
+}
+} // namespace
+
+/*!
+  Accelerated template matching using the normalized cross-correlation (see
+  templateMatching(const vpImage<unsigned char> &, const vpImage<unsigned char> &, vpImage<double> &, unsigned int,
+  unsigned int, bool) for the score definition).
+
+  The exhaustive search is done either in the spatial domain with integral images
+  (vpImageTools::TEMPLATE_MATCHING_DIRECT) or by blocks in the frequency domain (vpImageTools::TEMPLATE_MATCHING_FFT),
+  which is much faster for large templates. With vpImageTools::TEMPLATE_MATCHING_AUTO, the cheapest one is selected
+  from the template size and the steps. Rows, respectively blocks, are processed in parallel when OpenMP is available.
+
+  When more than one pyramid level is requested, the exhaustive search (with the steps) is only done at the coarsest
+  level. The best candidates are then refined from one level to the next in a small neighborhood around their
+  upsampled location. Levels are dropped when the template would become smaller than 8 pixels. In that case, only
+  the evaluated locations of the full resolution score image are set, the other ones being 0.
+
+  \param I : Input image.
+  \param I_tpl : Template image.
+  \param I_score : Output template matching score, of size (I.getHeight() - I_tpl.getHeight()) x (I.getWidth() -
+  I_tpl.getWidth()).
+  \param options : Search parameters.
+*/
+void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                    vpImage<double> &I_score, const vpTemplateMatchingOptions &options)
+{
+  if (I.getSize() == 0) {
+    std::cerr << "Error, input image is empty." << std::endl;
+    return;
+  }
+
+  if (I_tpl.getSize() == 0) {
+    std::cerr << "Error, template image is empty." << std::endl;
+    return;
+  }
+
+  if (I_tpl.getHeight() > I.getHeight() || I_tpl.getWidth() > I.getWidth()) {
+    std::cerr << "Error, template image is bigger than input image." << std::endl;
+    return;
+  }
+
+  if (options.m_stepU == 0 || options.m_stepV == 0) {
+    throw vpException(vpException::badValue,
+                      "Error: in vpImageTools::templateMatching(): "
+                      "steps must be strictly positive (step_u=%u, step_v=%u)",
+                      options.m_stepU, options.m_stepV);
+  }
+
+  // Image pyramid, stopping before the template gets too small to be discriminant
+  const unsigned int minTplSize = 8;
+  const unsigned int nbLevels = std::max(options.m_nbPyramidLevels, 1u);
+  std::vector<vpImage<unsigned char> > pyr_I(nbLevels), pyr_tpl(nbLevels);
+  std::vector<const vpImage<unsigned char> *> levels_I(1, &I), levels_tpl(1, &I_tpl);
+  for (unsigned int l = 1; l < nbLevels; l++) {
+    if (levels_tpl.back()->getHeight() / 2 < minTplSize || levels_tpl.back()->getWidth() / 2 < minTplSize) {
+      break;
+    }
+    vpImageFilter::getGaussPyramidal(*levels_I.back(), pyr_I[l]);
+    vpImageFilter::getGaussPyramidal(*levels_tpl.back(), pyr_tpl[l]);
+    if (pyr_tpl[l].getHeight() >= pyr_I[l].getHeight() || pyr_tpl[l].getWidth() >= pyr_I[l].getWidth()) {
+      break;
+    }
+    levels_I.push_back(&pyr_I[l]);
+    levels_tpl.push_back(&pyr_tpl[l]);
+  }
+
+  const unsigned int coarsest = static_cast<unsigned int>(levels_I.size() - 1);
+  if (coarsest == 0) {
+    templateMatchingExhaustive(I, I_tpl, I_score, options.m_stepU, options.m_stepV, options.m_method,
+                               options.m_nbThreads);
+    return;
+  }
+
+  vpImage<double> I_level_score;
+  templateMatchingExhaustive(*levels_I[coarsest], *levels_tpl[coarsest], I_level_score, options.m_stepU,
+                             options.m_stepV, options.m_method, options.m_nbThreads);
+
+  const unsigned int nbCandidates = std::max(options.m_nbCandidates, 1u);
+  std::vector<vpTemplateMatchingCandidate> candidates;
+  for (unsigned int i = 0; i < I_level_score.getHeight(); i += options.m_stepV) {
+    for (unsigned int j = 0; j < I_level_score.getWidth(); j += options.m_stepU) {
+      if (isValidTemplateMatchingScore(I_level_score[i][j])) {
+        vpTemplateMatchingCandidate candidate = { I_level_score[i][j], i, j };
+        candidates.push_back(candidate);
+      }
+    }
+  }
+  unsigned int minDist =
+    std::max(std::min(levels_tpl[coarsest]->getHeight(), levels_tpl[coarsest]->getWidth()) / 2, 1u);
+  candidates = selectCandidates(candidates, nbCandidates, minDist);
+
+  for (int l = static_cast<int>(coarsest) - 1; l >= 0; l--) {
+    const vpImage<unsigned char> &I_l = *levels_I[l], &I_tpl_l = *levels_tpl[l];
+    const unsigned int height_tpl = I_tpl_l.getHeight(), width_tpl = I_tpl_l.getWidth();
+
+    vpImage<double> I_double, I_tpl_double;
+    vpImageConvert::convert(I_l, I_double);
+    vpImageConvert::convert(I_tpl_l, I_tpl_double);
+
+    vpImage<double> II, IIsq, II_tpl, IIsq_tpl;
+    integralImage(I_l, II, IIsq);
+    integralImage(I_tpl_l, II_tpl, IIsq_tpl);
+
+    const double sum2 = (II_tpl[height_tpl][width_tpl] + II_tpl[0][0] - II_tpl[0][width_tpl] - II_tpl[height_tpl][0]);
+    const double mean2 = sum2 / I_tpl_l.getSize();
+    for (unsigned int cpt = 0; cpt < I_tpl_double.getSize(); cpt++) {
+      I_tpl_double.bitmap[cpt] -= mean2;
+    }
+
+    vpImage<double> &I_score_l = (l == 0) ? I_score : I_level_score;
+    I_score_l.resize(I_l.getHeight() - height_tpl, I_l.getWidth() - width_tpl, 0.0);
+
+    // Search around the upsampled location of each candidate: the true location is either 2*i or 2*i+1
+    const unsigned int radius = options.m_searchRadius;
+    std::vector<vpTemplateMatchingCandidate> refined;
+    for (size_t k = 0; k < candidates.size(); k++) {
+      const unsigned int i_min = 2 * candidates[k].m_i > radius ? 2 * candidates[k].m_i - radius : 0;
+      const unsigned int j_min = 2 * candidates[k].m_j > radius ? 2 * candidates[k].m_j - radius : 0;
+      const unsigned int i_max = std::min(2 * candidates[k].m_i + 1 + radius, I_score_l.getHeight() - 1);
+      const unsigned int j_max = std::min(2 * candidates[k].m_j + 1 + radius, I_score_l.getWidth() - 1);
+
+      vpTemplateMatchingCandidate best = { 0.0, 0, 0 };
+      bool found = false;
+      for (unsigned int i = i_min; i <= i_max; i++) {
+        for (unsigned int j = j_min; j <= j_max; j++) {
+          I_score_l[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, i, j);
+          if (isValidTemplateMatchingScore(I_score_l[i][j]) && (!found || I_score_l[i][j] > best.m_score)) {
+            best.m_score = I_score_l[i][j];
+            best.m_i = i;
+            best.m_j = j;
+            found = true;
+          }
+        }
+      }
+      if (found) {
+        refined.push_back(best);
+      }
+    }
+
+    minDist = std::max(std::min(height_tpl, width_tpl) / 2, 1u);
+    candidates = selectCandidates(refined, nbCandidates, minDist);
+  }
+}
+
+void vpImageTools::templateMatchingExhaustive(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                              vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
+                                              vpTemplateMatchingMethod method, unsigned int nbThreads)
+{
+  vpImage<double> I_double, I_tpl_double;
+  vpImageConvert::convert(I, I_double);
+  vpImageConvert::convert(I_tpl, I_tpl_double);
+
+  const unsigned int height_tpl = I_tpl.getHeight(), width_tpl = I_tpl.getWidth();
+  I_score.resize(I.getHeight() - height_tpl, I.getWidth() - width_tpl, 0.0);
+
+  vpImage<double> II, IIsq, II_tpl, IIsq_tpl;
+  integralImage(I, II, IIsq);
+  integralImage(I_tpl, II_tpl, IIsq_tpl);
+
+  // zero-mean template image
+  const double sum2 = (II_tpl[height_tpl][width_tpl] + II_tpl[0][0] - II_tpl[0][width_tpl] - II_tpl[height_tpl][0]);
+  const double mean2 = sum2 / I_tpl.getSize();
+  for (unsigned int cpt = 0; cpt < I_tpl_double.getSize(); cpt++) {
+    I_tpl_double.bitmap[cpt] -= mean2;
+  }
+
+  if (method == TEMPLATE_MATCHING_AUTO) {
+    method = useCorrelationFFT(I.getHeight(), I.getWidth(), height_tpl, width_tpl, step_u, step_v)
+      ? TEMPLATE_MATCHING_FFT
+      : TEMPLATE_MATCHING_DIRECT;
+  }
+
+#if defined(_OPENMP)
+  if (nbThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nbThreads));
+  }
+#else
+  (void)nbThreads;
+#endif
+
+  const int nbRows = static_cast<int>((I_score.getHeight() + step_v - 1) / step_v);
+  if (method == TEMPLATE_MATCHING_FFT) {
+    vpImage<double> I_corr;
+    correlationFFT(I_double, I_tpl_double, I_corr);
+
+    const double b2 = ((IIsq_tpl[height_tpl][width_tpl] + IIsq_tpl[0][0] - IIsq_tpl[0][width_tpl] -
+                        IIsq_tpl[height_tpl][0]) -
+                       (1.0 / I_tpl.getSize()) * vpMath::sqr(sum2));
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int r = 0; r < nbRows; r++) {
+      const unsigned int i = static_cast<unsigned int>(r) * step_v;
+      for (unsigned int j = 0; j < I_score.getWidth(); j += step_u) {
+        const double sum1 =
+          (II[i + height_tpl][j + width_tpl] + II[i][j] - II[i][j + width_tpl] - II[i + height_tpl][j]);
+        const double a2 = ((IIsq[i + height_tpl][j + width_tpl] + IIsq[i][j] - IIsq[i][j + width_tpl] -
+                            IIsq[i + height_tpl][j]) -
+                           (1.0 / I_tpl.getSize()) * vpMath::sqr(sum1));
+        I_score[i][j] = I_corr[i][j] / sqrt(a2 * b2);
+      }
+    }
+  }
+  else {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int r = 0; r < nbRows; r++) {
+      const unsigned int i = static_cast<unsigned int>(r) * step_v;
+      for (unsigned int j = 0; j < I_score.getWidth(); j += step_u) {
+        I_score[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, i, j);
+      }
+    }
+  }
+}
+
 // Reference:
 // http://blog.demofox.org/2015/08/15/resizing-images-with-bicubic-interpolation/
 // t is a value that goes from 0 to 1 to interpolate in a C1 continuous way
@@ -959,6 +1428,272 @@ void vpImageTools::resizeSimdlib(const vpImage<unsigned char> &Isrc, unsigned in
 }
 #endif
 
+void vpImageTools::cropResizeRoi(const vpRect &roi, unsigned int imgWidth, unsigned int imgHeight, unsigned int width,
+                                 unsigned int height, unsigned int &top, unsigned int &left, unsigned int &roiWidth,
+                                 unsigned int &roiHeight)
+{
+  // Same ROI clipping as crop(const vpImage<Type> &, const vpRect &, vpImage<Type> &)
+  const double roi_top = roi.getTop();
+  const double roi_left = roi.getLeft();
+  const unsigned int roi_height = static_cast<unsigned int>(roi.getHeight());
+  const unsigned int roi_width = static_cast<unsigned int>(roi.getWidth());
+  const int i_min = std::max<int>(static_cast<int>(ceil(roi_top)), 0);
+  const int j_min = std::max<int>(static_cast<int>(ceil(roi_left)), 0);
+  const int i_max = std::min<int>(static_cast<int>(ceil(roi_top + roi_height)), static_cast<int>(imgHeight));
+  const int j_max = std::min<int>(static_cast<int>(ceil(roi_left + roi_width)), static_cast<int>(imgWidth));
+
+  if (i_max <= i_min || j_max <= j_min) {
+    throw(vpException(vpException::badValue, "Cannot crop and resize: the ROI does not intersect the image"));
+  }
+  if (width == 0 || height == 0) {
+    throw(vpException(vpException::badValue, "Cannot crop and resize to a %dx%d image", width, height));
+  }
+
+  top = static_cast<unsigned int>(i_min);
+  left = static_cast<unsigned int>(j_min);
+  roiHeight = static_cast<unsigned int>(i_max - i_min);
+  roiWidth = static_cast<unsigned int>(j_max - j_min);
+}
+
+/*
+  Compute the row \e i of the resized ROI directly from the input image. The sampling coordinates and
+  the interpolation formulas are the ones of resize(), so that the result is the same as the one of a
+  crop() followed by a resize(). Only instantiated for unsigned char and vpRGBa.
+*/
+template <class Type>
+void vpImageTools::cropResizeRow(const vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int roiWidth,
+                                 unsigned int roiHeight, unsigned int width, unsigned int height, unsigned int i,
+                                 const vpImageInterpolationType &method, Type *dst)
+{
+  const unsigned int nbChannels = (sizeof(Type) == 1) ? 1 : 3;
+  const float scaleY = roiHeight / static_cast<float>(height);
+  const float scaleX = roiWidth / static_cast<float>(width);
+  const float half = 0.5f;
+  const int maxU = static_cast<int>(roiWidth) - 1;
+  const int maxV = static_cast<int>(roiHeight) - 1;
+
+  const float v = (i + half) * scaleY - half;
+  const int v0 = static_cast<int>(v);
+  const float yFrac = v - v0;
+
+  if (method == INTERPOLATION_NEAREST) {
+    const int y = std::max<int>(0, std::min<int>(vpMath::round(v), maxV));
+    const Type *src = I[top + y] + left;
+    for (unsigned int j = 0; j < width; j++) {
+      const float u = (j + half) * scaleX - half;
+      dst[j] = src[std::max<int>(0, std::min<int>(vpMath::round(u), maxU))];
+    }
+  }
+  else if (method == INTERPOLATION_LINEAR) {
+    const unsigned char *src0 = reinterpret_cast<const unsigned char *>(I[top + v0] + left);
+    const unsigned char *src1 = reinterpret_cast<const unsigned char *>(I[top + std::min<int>(maxV, v0 + 1)] + left);
+    for (unsigned int j = 0; j < width; j++) {
+      const float u = (j + half) * scaleX - half;
+      const int u0 = static_cast<int>(u);
+      const float xFrac = u - u0;
+      const int u1 = std::min<int>(maxU, u0 + 1);
+
+      unsigned char *d = reinterpret_cast<unsigned char *>(dst + j);
+      for (unsigned int c = 0; c < nbChannels; c++) {
+        float col0 = lerp(static_cast<float>(src0[sizeof(Type) * u0 + c]), static_cast<float>(src0[sizeof(Type) * u1 + c]),
+                          xFrac);
+        float col1 = lerp(static_cast<float>(src1[sizeof(Type) * u0 + c]), static_cast<float>(src1[sizeof(Type) * u1 + c]),
+                          xFrac);
+        d[c] = vpMath::saturate<unsigned char>(lerp(col0, col1, yFrac));
+      }
+      if (nbChannels == 3) {
+        d[3] = vpRGBa::alpha_default;
+      }
+    }
+  }
+  else if (method == INTERPOLATION_CUBIC) {
+    const unsigned char *src[4];
+    for (int k = 0; k < 4; k++) {
+      const int y = std::max<int>(0, std::min<int>(vpMath::round(v + (k - 1)), maxV));
+      src[k] = reinterpret_cast<const unsigned char *>(I[top + y] + left);
+    }
+    for (unsigned int j = 0; j < width; j++) {
+      const float u = (j + half) * scaleX - half;
+      const float xFrac = u - static_cast<int>(u);
+      unsigned int x[4];
+      for (int k = 0; k < 4; k++) {
+        x[k] = sizeof(Type) * static_cast<unsigned int>(std::max<int>(0, std::min<int>(vpMath::round(u + (k - 1)), maxU)));
+      }
+
+      unsigned char *d = reinterpret_cast<unsigned char *>(dst + j);
+      for (unsigned int c = 0; c < nbChannels; c++) {
+        float col[4];
+        for (int k = 0; k < 4; k++) {
+          col[k] = cubicHermite(static_cast<float>(src[k][x[0] + c]), static_cast<float>(src[k][x[1] + c]),
+                                static_cast<float>(src[k][x[2] + c]), static_cast<float>(src[k][x[3] + c]), xFrac);
+        }
+        d[c] = vpMath::saturate<unsigned char>(cubicHermite(col[0], col[1], col[2], col[3], yFrac));
+      }
+      if (nbChannels == 3) {
+        d[3] = vpRGBa::alpha_default;
+      }
+    }
+  }
+}
+
+template <class Type>
+void vpImageTools::cropResizeTpl(const vpImage<Type> &I, const vpRect &roi, vpImage<Type> &Ires, unsigned int width,
+                                 unsigned int height, const vpImageInterpolationType &method,
+                                 unsigned int
+#if defined(_OPENMP)
+                                     nThreads
+#endif
+)
+{
+  unsigned int top, left, roiWidth, roiHeight;
+  cropResizeRoi(roi, I.getWidth(), I.getHeight(), width, height, top, left, roiWidth, roiHeight);
+  Ires.resize(height, width);
+
+  if (method == INTERPOLATION_LINEAR || method == INTERPOLATION_AREA) {
+#if defined(VISP_HAVE_SIMDLIB)
+    // The ROI is wrapped as a view on the input bitmap: no copy is needed for the crop
+    typedef Simd::View<Simd::Allocator> View;
+    const View::Format format = (sizeof(Type) == 1) ? View::Gray8 : View::Bgra32;
+    View src(roiWidth, roiHeight, I.getWidth() * sizeof(Type), format,
+             const_cast<Type *>(I.bitmap + top * I.getWidth() + left));
+    View dst(width, height, width * sizeof(Type), format, Ires.bitmap);
+    Simd::Resize(src, dst, method == INTERPOLATION_LINEAR ? SimdResizeMethodBilinear : SimdResizeMethodArea);
+    return;
+#else
+    if (method == INTERPOLATION_AREA) {
+      throw(vpException(vpException::functionNotImplementedError,
+                        "INTERPOLATION_AREA requires the third-party Simd library"));
+    }
+#endif
+  }
+
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < static_cast<int>(height); i++) {
+    cropResizeRow(I, top, left, roiWidth, roiHeight, width, height, static_cast<unsigned int>(i), method, Ires[i]);
+  }
+}
+
+/*!
+  Crop a region of interest (ROI) in a grayscale image and resize it in a single pass, without
+  building the cropped image.
+
+  The result is the same as the one obtained with crop(const vpImage<Type> &, const vpRect &, vpImage<Type> &)
+  followed by resize(const vpImage<Type> &, vpImage<Type> &, unsigned int, unsigned int, const vpImageInterpolationType &, unsigned int).
+
+  \param I : Input image.
+  \param roi : Region of interest in image \e I. It is clipped to the image as in crop().
+  \param Ires : Output image resized to \e width, \e height.
+  \param width : Resized width.
+  \param height : Resized height.
+  \param method : Interpolation method.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \exception vpException::badValue : If the ROI does not intersect the image or if the output size is null.
+  \exception vpException::functionNotImplementedError : With INTERPOLATION_AREA when ViSP is built without the
+  Simd library.
+
+  \note With INTERPOLATION_LINEAR and INTERPOLATION_AREA, the SIMD lib resizes the ROI directly from the input
+  bitmap and \e nThreads is not used.
+*/
+void vpImageTools::cropResize(const vpImage<unsigned char> &I, const vpRect &roi, vpImage<unsigned char> &Ires,
+                              unsigned int width, unsigned int height, const vpImageInterpolationType &method,
+                              unsigned int nThreads)
+{
+  cropResizeTpl(I, roi, Ires, width, height, method, nThreads);
+}
+
+/*!
+  Crop a region of interest (ROI) in a color image and resize it in a single pass, without
+  building the cropped image.
+
+  \param I : Input image.
+  \param roi : Region of interest in image \e I. It is clipped to the image as in crop().
+  \param Ires : Output image resized to \e width, \e height.
+  \param width : Resized width.
+  \param height : Resized height.
+  \param method : Interpolation method.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \sa cropResize(const vpImage<unsigned char> &, const vpRect &, vpImage<unsigned char> &, unsigned int, unsigned int, const vpImageInterpolationType &, unsigned int)
+*/
+void vpImageTools::cropResize(const vpImage<vpRGBa> &I, const vpRect &roi, vpImage<vpRGBa> &Ires, unsigned int width,
+                              unsigned int height, const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  cropResizeTpl(I, roi, Ires, width, height, method, nThreads);
+}
+
+/*!
+  Crop a region of interest (ROI) in a color image, resize it and convert it to grayscale in a
+  single pass.
+
+  The result is the same as the one obtained with crop(), resize() and
+  vpImageConvert::convert(const vpImage<vpRGBa> &, vpImage<unsigned char> &, unsigned int) called in sequence,
+  but neither the cropped image nor the resized color image are built: each output row is interpolated in a
+  small per-thread color buffer and converted at once.
+
+  \param I : Input image.
+  \param roi : Region of interest in image \e I. It is clipped to the image as in crop().
+  \param Ires : Output grayscale image resized to \e width, \e height.
+  \param width : Resized width.
+  \param height : Resized height.
+  \param method : Interpolation method.
+  \param nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \note With INTERPOLATION_LINEAR and INTERPOLATION_AREA, the SIMD lib resizes the ROI directly from the input
+  bitmap into a color image of the output size that is then converted to grayscale.
+
+  \sa cropResize(const vpImage<unsigned char> &, const vpRect &, vpImage<unsigned char> &, unsigned int, unsigned int, const vpImageInterpolationType &, unsigned int)
+*/
+void vpImageTools::cropResize(const vpImage<vpRGBa> &I, const vpRect &roi, vpImage<unsigned char> &Ires,
+                              unsigned int width, unsigned int height, const vpImageInterpolationType &method,
+                              unsigned int nThreads)
+{
+#if defined(VISP_HAVE_SIMDLIB)
+  if (method == INTERPOLATION_LINEAR || method == INTERPOLATION_AREA) {
+    vpImage<vpRGBa> Icolor;
+    cropResizeTpl(I, roi, Icolor, width, height, method, nThreads);
+    vpImageConvert::convert(Icolor, Ires, nThreads);
+    return;
+  }
+#else
+  if (method == INTERPOLATION_AREA) {
+    throw(vpException(vpException::functionNotImplementedError,
+                      "INTERPOLATION_AREA requires the third-party Simd library"));
+  }
+#endif
+
+  unsigned int top, left, roiWidth, roiHeight;
+  cropResizeRoi(roi, I.getWidth(), I.getHeight(), width, height, top, left, roiWidth, roiHeight);
+  Ires.resize(height, width);
+
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel
+#else
+  (void)nThreads;
+#endif
+  {
+    std::vector<vpRGBa> row(width);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(height); i++) {
+      cropResizeRow(I, top, left, roiWidth, roiHeight, width, height, static_cast<unsigned int>(i), method, &row[0]);
+      vpImageConvert::RGBaToGrey(reinterpret_cast<unsigned char *>(&row[0]), Ires[i], width);
+    }
+  }
+}
+
 bool vpImageTools::checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine)
 {
   double a0 = T[0][0];
@@ -309,6 +309,161 @@ TEST_CASE("Benchmark bgra to rgba (ViSP)", "[benchmark]")
   };
 }
 
+TEST_CASE("Benchmark yuv to rgba (ViSP)", "[benchmark]")
+{
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+
+  // Raw frames made of the bytes of the color image, with an even size as required by the chroma subsampling
+  const unsigned int width = (I.getWidth() / 2) * 2, height = (I.getHeight() / 2) * 2, size = width * height;
+  std::vector<unsigned char> raw(reinterpret_cast<unsigned char *>(I.bitmap),
+                                 reinterpret_cast<unsigned char *>(I.bitmap) + 2 * size);
+
+  vpImage<vpRGBa> I_rgba(height, width);
+  unsigned char *rgba = reinterpret_cast<unsigned char *>(I_rgba.bitmap);
+
+  SECTION("Check multi-threaded conversions")
+  {
+    vpImage<vpRGBa> ref(height, width);
+    unsigned char *rgba_ref = reinterpret_cast<unsigned char *>(ref.bitmap);
+    vpImageConvert::YUYVToRGBa(raw.data(), rgba_ref, width, height, 1);
+    vpImageConvert::YUYVToRGBa(raw.data(), rgba, width, height, 4);
+    CHECK((I_rgba == ref));
+    vpImageConvert::YUV422ToRGBa(raw.data(), rgba_ref, size, 1);
+    vpImageConvert::YUV422ToRGBa(raw.data(), rgba, size, 4);
+    CHECK((I_rgba == ref));
+    vpImageConvert::YUV420ToRGBa(raw.data(), rgba_ref, width, height, 1);
+    vpImageConvert::YUV420ToRGBa(raw.data(), rgba, width, height, 4);
+    CHECK((I_rgba == ref));
+    vpImageConvert::MONO16ToRGBa(raw.data(), rgba_ref, size, 1);
+    vpImageConvert::MONO16ToRGBa(raw.data(), rgba, size, 4);
+    CHECK((I_rgba == ref));
+  }
+
+  SECTION("Check NV12 / NV21 to RGBa conversion")
+  {
+    // Same chrominances as the planar YUV 4:2:0 frame, interleaved
+    std::vector<unsigned char> nv12(raw.begin(), raw.begin() + (3 * size) / 2), nv21 = nv12;
+    for (unsigned int k = 0; k < size / 4; k++) {
+      nv12[size + 2 * k] = nv21[size + 2 * k + 1] = raw[size + k];
+      nv12[size + 2 * k + 1] = nv21[size + 2 * k] = raw[size + size / 4 + k];
+    }
+
+    vpImage<vpRGBa> ref(height, width);
+    vpImageConvert::YUV420ToRGBa(raw.data(), reinterpret_cast<unsigned char *>(ref.bitmap), width, height);
+    vpImageConvert::NV12ToRGBa(nv12.data(), rgba, width, height);
+    CHECK((I_rgba == ref));
+    vpImageConvert::NV21ToRGBa(nv21.data(), rgba, width, height);
+    CHECK((I_rgba == ref));
+  }
+
+  BENCHMARK("Benchmark yuyv to rgba (ViSP)")
+  {
+    vpImageConvert::YUYVToRGBa(raw.data(), rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark yuv422 to rgba (ViSP)")
+  {
+    vpImageConvert::YUV422ToRGBa(raw.data(), rgba, size, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark yuv420 to rgba (ViSP)")
+  {
+    vpImageConvert::YUV420ToRGBa(raw.data(), rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark yv12 to rgba (ViSP)")
+  {
+    vpImageConvert::YV12ToRGBa(raw.data(), rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark nv12 to rgba (ViSP)")
+  {
+    vpImageConvert::NV12ToRGBa(raw.data(), rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark nv21 to rgba (ViSP)")
+  {
+    vpImageConvert::NV21ToRGBa(raw.data(), rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark mono16 to rgba (ViSP)")
+  {
+    vpImageConvert::MONO16ToRGBa(raw.data(), rgba, size, nThreads);
+    return I_rgba;
+  };
+
+  vpImage<unsigned char> I_gray(height, width);
+  BENCHMARK("Benchmark mono16 to grayscale (ViSP)")
+  {
+    vpImageConvert::MONO16ToGrey(raw.data(), I_gray.bitmap, size, nThreads);
+    return I_gray;
+  };
+}
+
+TEST_CASE("Benchmark bayer to rgba (ViSP)", "[benchmark]")
+{
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+
+  // Bayer patterns require an even size
+  const unsigned int width = (I.getWidth() / 2) * 2, height = (I.getHeight() / 2) * 2;
+  vpImage<unsigned char> I_bayer(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I_bayer[i][j] = I[i][j];
+    }
+  }
+
+  vpImage<vpRGBa> I_rgba(height, width);
+  uint8_t *rgba = reinterpret_cast<uint8_t *>(I_rgba.bitmap);
+
+  SECTION("Check multi-threaded conversions")
+  {
+    vpImage<vpRGBa> ref(height, width);
+    vpImageConvert::demosaicBGGRToRGBaBilinear(I_bayer.bitmap, reinterpret_cast<uint8_t *>(ref.bitmap), width, height,
+                                               1);
+    vpImageConvert::demosaicBGGRToRGBaBilinear(I_bayer.bitmap, rgba, width, height, 4);
+    CHECK((I_rgba == ref));
+  }
+
+  BENCHMARK("Benchmark bggr to rgba bilinear (ViSP)")
+  {
+    vpImageConvert::demosaicBGGRToRGBaBilinear(I_bayer.bitmap, rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark gbrg to rgba bilinear (ViSP)")
+  {
+    vpImageConvert::demosaicGBRGToRGBaBilinear(I_bayer.bitmap, rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark grbg to rgba bilinear (ViSP)")
+  {
+    vpImageConvert::demosaicGRBGToRGBaBilinear(I_bayer.bitmap, rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark rggb to rgba bilinear (ViSP)")
+  {
+    vpImageConvert::demosaicRGGBToRGBaBilinear(I_bayer.bitmap, rgba, width, height, nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark rggb to rgba Malvar (ViSP)")
+  {
+    vpImageConvert::demosaicRGGBToRGBaMalvar(I_bayer.bitmap, rgba, width, height, nThreads);
+    return I_rgba;
+  };
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -129,6 +129,48 @@ TEST_CASE("Benchmark binary image morphology", "[benchmark]")
   }
 }
 
+TEST_CASE("Benchmark large kernel gray image morphology", "[benchmark]")
+{
+  std::string imagePath = vpIoTools::createFilePath(ipath, "Klimt/Klimt.pgm");
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePath);
+
+  const int size = 21;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
+  cv::Mat img, imgMorph;
+  vpImageConvert::convert(I, img);
+  cv::Mat rect_SE = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(size, size));
+#endif
+
+  BENCHMARK("Benchmark dilatation 21x21 (ViSP)")
+  {
+    vpImage<unsigned char> I_morpho = I;
+    vpImageMorphology::dilatation<unsigned char>(I_morpho, size);
+    return I_morpho;
+  };
+
+  BENCHMARK("Benchmark erosion 21x21 (ViSP)")
+  {
+    vpImage<unsigned char> I_morpho = I;
+    vpImageMorphology::erosion<unsigned char>(I_morpho, size);
+    return I_morpho;
+  };
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
+  BENCHMARK("Benchmark dilatation 21x21 (OpenCV)")
+  {
+    cv::morphologyEx(img, imgMorph, cv::MORPH_DILATE, rect_SE);
+    return imgMorph;
+  };
+
+  BENCHMARK("Benchmark erosion 21x21 (OpenCV)")
+  {
+    cv::morphologyEx(img, imgMorph, cv::MORPH_ERODE, rect_SE);
+    return imgMorph;
+  };
+#endif
+}
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
 TEST_CASE("Benchmark gray image morphology", "[benchmark]")
 {
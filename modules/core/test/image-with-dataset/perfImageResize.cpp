@@ -42,6 +42,7 @@
 
 #include "common.hpp"
 #include <thread>
+#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/io/vpImageIo.h>
@@ -255,6 +256,46 @@ TEST_CASE("Bicubic image resize (ViSP)", "[benchmark]")
   }
 }
 
+TEST_CASE("Crop, resize and convert (ViSP)", "[benchmark]")
+{
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+  const vpRect roi(I.getWidth() / 8., I.getHeight() / 8., 3 * I.getWidth() / 4., 3 * I.getHeight() / 4.);
+  const unsigned int nThreads = std::thread::hardware_concurrency();
+
+  const vpImageTools::vpImageInterpolationType methods[] = {
+      vpImageTools::INTERPOLATION_NEAREST, vpImageTools::INTERPOLATION_LINEAR, vpImageTools::INTERPOLATION_CUBIC };
+  const std::string names[] = { "Nearest Neighbor", "Bilinear", "Bicubic" };
+
+  for (size_t m = 0; m < 3; m++) {
+    vpImage<vpRGBa> Icrop, Iresize;
+    vpImage<unsigned char> Igray_chained, Igray_fused;
+    vpImageTools::crop(I, roi, Icrop);
+    vpImageTools::resize(Icrop, Iresize, g_resize_width, g_resize_height, methods[m]);
+    vpImageConvert::convert(Iresize, Igray_chained);
+    vpImageTools::cropResize(I, roi, Igray_fused, g_resize_width, g_resize_height, methods[m]);
+    CHECK((Igray_fused == Igray_chained));
+
+    std::stringstream buffer;
+    buffer << "Benchmark " << names[m] << " crop + resize + convert (ViSP chained) (" << nThreads << " threads)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::crop(I, roi, Icrop);
+      vpImageTools::resize(Icrop, Iresize, g_resize_width, g_resize_height, methods[m], nThreads);
+      vpImageConvert::convert(Iresize, Igray_chained, nThreads);
+      return Igray_chained;
+    };
+
+    buffer.str("");
+    buffer << "Benchmark " << names[m] << " crop + resize + convert (ViSP fused) (" << nThreads << " threads)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::cropResize(I, roi, Igray_fused, g_resize_width, g_resize_height, methods[m], nThreads);
+      return Igray_fused;
+    };
+  }
+}
+
 #if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGCODECS) && defined(HAVE_OPENCV_IMGPROC)
 TEST_CASE("Nearest Neighbor image resize (OpenCV)", "[benchmark]")
 {
@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark template matching.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 1280;
+int g_height = 720;
+
+// Smooth random texture: upsampled noise plus a small amount of fine noise
+void generateTexture(vpImage<unsigned char> &I, unsigned int height, unsigned int width)
+{
+  vpUniRand rng(42);
+  vpImage<unsigned char> I_coarse(height / 16 + 1, width / 16 + 1);
+  for (unsigned int i = 0; i < I_coarse.getSize(); i++) {
+    I_coarse.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 216));
+  }
+  vpImageTools::resize(I_coarse, I, width, height, vpImageTools::INTERPOLATION_LINEAR);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(I.bitmap[i] + rng.uniform(0, 40));
+  }
+}
+
+void getBestLocation(const vpImage<double> &I_score, unsigned int &i_best, unsigned int &j_best)
+{
+  double best = -2.0;
+  for (unsigned int i = 0; i < I_score.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_score.getWidth(); j++) {
+      if (vpMath::isFinite(I_score[i][j]) && I_score[i][j] > best) {
+        best = I_score[i][j];
+        i_best = i;
+        j_best = j;
+      }
+    }
+  }
+}
+
+double maxDifference(const vpImage<double> &I1, const vpImage<double> &I2)
+{
+  double diff = 0.0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (vpMath::isFinite(I1.bitmap[i]) && vpMath::isFinite(I2.bitmap[i])) {
+      diff = std::max(diff, std::fabs(I1.bitmap[i] - I2.bitmap[i]));
+    }
+  }
+  return diff;
+}
+} // namespace
+
+TEST_CASE("Template matching methods", "[template_matching]")
+{
+  vpImage<unsigned char> I;
+  generateTexture(I, 240, 320);
+  const unsigned int i_tpl = 57, j_tpl = 101;
+  vpImage<unsigned char> I_tpl;
+  vpImageTools::crop(I, i_tpl, j_tpl, 40, 52, I_tpl);
+
+  vpImage<double> I_score_ref;
+  vpImageTools::templateMatching(I, I_tpl, I_score_ref, 1, 1);
+
+  vpImageTools::vpTemplateMatchingOptions options;
+  SECTION("Direct")
+  {
+    options.m_method = vpImageTools::TEMPLATE_MATCHING_DIRECT;
+    vpImage<double> I_score;
+    vpImageTools::templateMatching(I, I_tpl, I_score, options);
+    CHECK((I_score == I_score_ref));
+
+    options.m_nbThreads = 2;
+    vpImageTools::templateMatching(I, I_tpl, I_score, options);
+    CHECK((I_score == I_score_ref));
+
+    options.m_stepU = 3;
+    options.m_stepV = 2;
+    vpImage<double> I_score_step_ref;
+    vpImageTools::templateMatching(I, I_tpl, I_score_step_ref, options.m_stepU, options.m_stepV);
+    vpImageTools::templateMatching(I, I_tpl, I_score, options);
+    CHECK((I_score == I_score_step_ref));
+  }
+
+  SECTION("FFT")
+  {
+    options.m_method = vpImageTools::TEMPLATE_MATCHING_FFT;
+    vpImage<double> I_score;
+    vpImageTools::templateMatching(I, I_tpl, I_score, options);
+    REQUIRE(I_score.getHeight() == I_score_ref.getHeight());
+    REQUIRE(I_score.getWidth() == I_score_ref.getWidth());
+    CHECK(maxDifference(I_score, I_score_ref) < 1e-6);
+
+    unsigned int i_best = 0, j_best = 0;
+    getBestLocation(I_score, i_best, j_best);
+    CHECK(i_best == i_tpl);
+    CHECK(j_best == j_tpl);
+
+    vpImage<double> I_score_mt;
+    options.m_nbThreads = 2;
+    vpImageTools::templateMatching(I, I_tpl, I_score_mt, options);
+    CHECK((I_score_mt == I_score));
+  }
+
+  SECTION("Pyramid")
+  {
+    for (unsigned int nbLevels = 2; nbLevels <= 3; nbLevels++) {
+      options.m_nbPyramidLevels = nbLevels;
+      // The steps are applied at the coarsest level
+      options.m_stepU = options.m_stepV = (nbLevels == 2) ? 2 : 1;
+      vpImage<double> I_score;
+      vpImageTools::templateMatching(I, I_tpl, I_score, options);
+      REQUIRE(I_score.getHeight() == I_score_ref.getHeight());
+      REQUIRE(I_score.getWidth() == I_score_ref.getWidth());
+
+      unsigned int i_best = 0, j_best = 0;
+      getBestLocation(I_score, i_best, j_best);
+      CHECK(i_best == i_tpl);
+      CHECK(j_best == j_tpl);
+      CHECK(I_score[i_best][j_best] == Approx(I_score_ref[i_tpl][j_tpl]).margin(1e-9));
+    }
+  }
+}
+
+TEST_CASE("Template matching benchmark", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    vpImage<unsigned char> I;
+    generateTexture(I, static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width));
+    vpImage<unsigned char> I_tpl;
+    vpImageTools::crop(I, I.getHeight() / 3, I.getWidth() / 2, I.getHeight() / 8, I.getHeight() / 8, I_tpl);
+    vpImage<double> I_score;
+
+    BENCHMARK("Template matching (direct, step 4)")
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, 4, 4);
+      return I_score;
+    };
+
+    vpImageTools::vpTemplateMatchingOptions options;
+    options.m_method = vpImageTools::TEMPLATE_MATCHING_FFT;
+    BENCHMARK("Template matching (FFT)")
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, options);
+      return I_score;
+    };
+
+    options.m_method = vpImageTools::TEMPLATE_MATCHING_AUTO;
+    options.m_nbPyramidLevels = 3;
+    BENCHMARK("Template matching (auto, 3 pyramid levels)")
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, options);
+      return I_score;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -418,6 +418,52 @@ TEST_CASE("Gray image morphology", "[image_morphology]")
   }
 }
 
+namespace
+{
+// Min or max over the size x size window clipped to the image, computed pixel by pixel
+void imageOperationRef(vpImage<float> &I, bool erosion, int size)
+{
+  const int half = size / 2;
+  const vpImage<float> J = I;
+  for (int r = 0; r < static_cast<int>(I.getHeight()); r++) {
+    for (int c = 0; c < static_cast<int>(I.getWidth()); c++) {
+      float value = J[r][c];
+      for (int i = std::max(0, r - half); i <= std::min(static_cast<int>(I.getHeight()) - 1, r + half); i++) {
+        for (int j = std::max(0, c - half); j <= std::min(static_cast<int>(I.getWidth()) - 1, c + half); j++) {
+          value = erosion ? std::min(value, J[i][j]) : std::max(value, J[i][j]);
+        }
+      }
+      I[r][c] = value;
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Large kernel image morphology", "[image_morphology]")
+{
+  // Sizes not multiple of the kernel sizes, with negative values
+  vpImage<float> I(37, 53);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<float>((i * 7919) % 1013) - 500.f;
+  }
+
+  const int sizes[] = { 1, 3, 5, 7, 15, 31, 41, 75 };
+  for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+    const int size = sizes[k];
+    INFO("size " << size);
+
+    vpImage<float> I_dilatation = I, I_dilatation_ref = I;
+    vpImageMorphology::dilatation<float>(I_dilatation, size);
+    imageOperationRef(I_dilatation_ref, false, size);
+    CHECK((I_dilatation_ref == I_dilatation));
+
+    vpImage<float> I_erosion = I, I_erosion_ref = I;
+    vpImageMorphology::erosion<float>(I_erosion, size);
+    imageOperationRef(I_erosion_ref, true, size);
+    CHECK((I_erosion_ref == I_erosion));
+  }
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
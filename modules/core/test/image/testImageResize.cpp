@@ -45,6 +45,7 @@
 #define CATCH_CONFIG_RUNNER
 #include "common.hpp"
 #include <catch.hpp>
+#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
 
 static unsigned int g_input_width = 7;
@@ -129,6 +130,45 @@ TEST_CASE("Bilinear interpolation", "[image_resize]")
   }
 }
 
+TEST_CASE("Fused crop and resize", "[image_resize]")
+{
+  vpImage<vpRGBa> I(4 * g_input_height, 4 * g_input_width);
+  common_tools::fill(I);
+  vpImage<unsigned char> I_gray;
+  vpImageConvert::convert(I, I_gray);
+  const vpRect roi(-1.5, 2.3, 3 * g_input_width, 2 * g_input_height);
+
+  const vpImageTools::vpImageInterpolationType methods[] = {
+      vpImageTools::INTERPOLATION_NEAREST, vpImageTools::INTERPOLATION_LINEAR, vpImageTools::INTERPOLATION_CUBIC };
+  for (size_t m = 0; m < 3; m++) {
+    vpImage<unsigned char> I_gray_crop, I_gray_ref, I_gray_fused;
+    vpImageTools::crop(I_gray, roi, I_gray_crop);
+    vpImageTools::resize(I_gray_crop, I_gray_ref, g_output_width, g_output_height, methods[m]);
+    vpImageTools::cropResize(I_gray, roi, I_gray_fused, g_output_width, g_output_height, methods[m]);
+    CHECK((I_gray_fused == I_gray_ref));
+
+    vpImage<vpRGBa> I_crop, I_ref, I_fused;
+    vpImageTools::crop(I, roi, I_crop);
+    vpImageTools::resize(I_crop, I_ref, g_output_width, g_output_height, methods[m]);
+    vpImageTools::cropResize(I, roi, I_fused, g_output_width, g_output_height, methods[m]);
+    bool same = true;
+    for (unsigned int i = 0; i < I_ref.getSize(); i++) {
+      same = same && I_fused.bitmap[i].R == I_ref.bitmap[i].R && I_fused.bitmap[i].G == I_ref.bitmap[i].G &&
+        I_fused.bitmap[i].B == I_ref.bitmap[i].B;
+    }
+    CHECK(same);
+
+    vpImage<unsigned char> I_convert_ref, I_convert_fused;
+    vpImageConvert::convert(I_ref, I_convert_ref);
+    vpImageTools::cropResize(I, roi, I_convert_fused, g_output_width, g_output_height, methods[m]);
+    CHECK((I_convert_fused == I_convert_ref));
+  }
+
+  vpImage<unsigned char> I_out;
+  CHECK_THROWS_AS(vpImageTools::cropResize(I_gray, vpRect(-20, -20, 10, 10), I_out, 4, 4), vpException);
+  CHECK_THROWS_AS(vpImageTools::cropResize(I_gray, roi, I_out, 0, 4), vpException);
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -36,6 +36,8 @@
 #define _vpDetectorAprilTag_h_
 
 #include <map>
+#include <string>
+#include <utility>
 
 #include <visp3/core/vpConfig.h>
 
@@ -44,6 +46,7 @@
 #include <visp3/core/vpColor.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/detection/vpDetectorBase.h>
 
 /*!
@@ -210,6 +213,10 @@
  *   Pose: 0.08951250829  0.02243780207  0.306540622  1.998073197  2.061488008  -0.8699567948
  * \endcode
  *
+ * On video streams, setAprilTagTracking() enables a temporal mode where only the regions around the tags
+ * detected in the previous frame are processed, the whole image being processed again periodically or when
+ * a tag is lost. setAprilTagRois() restricts the next detection to regions of interest given by the user.
+ *
  * Other examples are also provided in tutorial-apriltag-detector.cpp and
  * tutorial-apriltag-detector-live.cpp
  */
@@ -279,6 +286,7 @@ public:
   std::vector<int> getTagsId() const;
   std::vector<std::vector<vpPoint> > getTagsPoints3D(const std::vector<int> &tagsId,
                                                      const std::map<int, double> &tagsSize) const;
+  std::vector<std::pair<std::string, double> > getTimeProfile() const;
 
   void setAprilTagDecodeSharpening(double decodeSharpening);
   void setAprilTagFamily(const vpAprilTagFamily &tagFamily);
@@ -287,6 +295,8 @@ public:
   void setAprilTagQuadDecimate(float quadDecimate);
   void setAprilTagQuadSigma(float quadSigma);
   void setAprilTagRefineEdges(bool refineEdges);
+  void setAprilTagRois(const std::vector<vpRect> &rois);
+  void setAprilTagTracking(bool enable, unsigned int fullDetectionPeriod = 10, double roiMargin = 0.5);
 
 
 
@@ -40,6 +40,8 @@
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030403) && defined(HAVE_OPENCV_DNN) && \
     ((__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)))
 
+#include <deque>
+#include <future>
 #include <map>
 #include <string>
 #include <vector>
@@ -77,6 +79,10 @@ using json = nlohmann::json; //! json namespace shortcut
  * This class can be initialized from a JSON file if ViSP has been compiled with NLOHMANN JSON (see \ref soft_tool_json to see how to do it).
  * Examples of such JSON files can be found in the tutorial folder.
  *
+ * Several images, e.g. coming from a multi-camera rig, can be processed by a single inference with the detect()
+ * overloads that take a vector of images. On video streams, submit() and poll() run the inference of a frame in a
+ * background thread while the next frame is acquired and preprocessed.
+ *
  * \sa \ref tutorial-detection-dnn
  */
 class VISP_EXPORT vpDetectorDNNOpenCV
@@ -488,6 +494,12 @@ public:
   virtual bool detect(const cv::Mat &I, std::vector<DetectedFeatures2D> &output);
   virtual bool detect(const cv::Mat &I, std::map< std::string, std::vector<DetectedFeatures2D>> &output);
   virtual bool detect(const cv::Mat &I, std::vector< std::pair<std::string, std::vector<DetectedFeatures2D>>> &output);
+  virtual bool detect(const std::vector<vpImage<vpRGBa> > &images, std::vector<std::vector<DetectedFeatures2D> > &output);
+  virtual bool detect(const std::vector<cv::Mat> &images, std::vector<std::vector<DetectedFeatures2D> > &output);
+
+  void submit(const vpImage<vpRGBa> &I);
+  void submit(const cv::Mat &I);
+  bool poll(std::vector<DetectedFeatures2D> &output, bool blocking = false);
 
   void readNet(const std::string &model, const std::string &config = "", const std::string &framework = "");
 
@@ -553,8 +565,20 @@ protected:
   std::map<std::string, std::vector<vpDetectorDNNOpenCV::DetectedFeatures2D>>
     filterDetectionMultiClassInput(const std::map< std::string, std::vector<vpDetectorDNNOpenCV::DetectedFeatures2D>> &detected_features, const double minRatioOfAreaOk);
 
+  cv::Size getBlobSize(const cv::Mat &I) const;
+
+  void runInference(const cv::Mat &blob);
+
+  std::vector<DetectedFeatures2D> detectFromBlob(const cv::Mat &I, const cv::Mat &blob);
+
+  std::vector<DetectedFeatures2D> getDetectedFeatures(const DetectionCandidates &proposals) const;
+
+  void nonMaximumSuppression(const DetectionCandidates &proposals);
+
   void postProcess(DetectionCandidates &proposals);
 
+  void waitAsync();
+
   void postProcess_YoloV3_V4(DetectionCandidates &proposals, std::vector<cv::Mat> &dnnRes, const NetConfig &netConfig);
 
   void postProcess_YoloV5_V7(DetectionCandidates &proposals, std::vector<cv::Mat> &dnnRes, const NetConfig &netConfig);
@@ -591,6 +615,10 @@ protected:
   std::vector<cv::Mat> m_dnnRes;
   //! Pointer towards the parsing method, used if \b m_parsingMethodType is equal to \b m_parsingMethodType::USER_SPECIFIED
   void (*m_parsingMethod)(DetectionCandidates &, std::vector<cv::Mat> &, const NetConfig &);
+  //! Detections of the frame being processed in the background, see submit()
+  std::shared_future<std::vector<DetectedFeatures2D> > m_asyncDetection;
+  //! Detections of the processed frames that have not been returned by poll() yet
+  std::deque<std::vector<DetectedFeatures2D> > m_asyncResults;
 };
 
 /*!
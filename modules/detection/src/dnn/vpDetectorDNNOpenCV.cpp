@@ -42,7 +42,29 @@
 #include <visp3/detection/vpDetectorDNNOpenCV.h>
 #include <visp3/core/vpIoTools.h>
 
-#include<algorithm>
+#include <algorithm>
+#include <chrono>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Index of the first maximum of the class scores of a detection proposal, as cv::minMaxLoc() on the scores row
+int getMaxScoreIndex(const float *scores, int nbScores, double &maxScore)
+{
+  int maxIdx = 0;
+  float maxVal = scores[0];
+  for (int c = 1; c < nbScores; ++c) {
+    if (scores[c] > maxVal) {
+      maxVal = scores[c];
+      maxIdx = c;
+    }
+  }
+  maxScore = maxVal;
+  return maxIdx;
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /**
  * \brief Get the list of the parsing methods / types of DNNs supported by the \b vpDetectorDNNOpenCV class.
  *
@@ -230,9 +252,14 @@ void vpDetectorDNNOpenCV::saveConfigurationInJSON(const std::string &jsonPath) c
 #endif
 
 /**
- * \brief Destroy the \b vpDetectorDNNOpenCV object
+ * \brief Destroy the \b vpDetectorDNNOpenCV object, after the end of the inference running in the background if any.
  */
-vpDetectorDNNOpenCV::~vpDetectorDNNOpenCV() { }
+vpDetectorDNNOpenCV::~vpDetectorDNNOpenCV()
+{
+  if (m_asyncDetection.valid()) {
+    m_asyncDetection.wait();
+  }
+}
 
 /**
  * \brief Object detection using OpenCV DNN module.
@@ -293,6 +320,7 @@ bool vpDetectorDNNOpenCV::detect(const vpImage<unsigned char> &I, std::vector< s
  */
 bool vpDetectorDNNOpenCV::detect(const vpImage<vpRGBa> &I, std::vector<DetectedFeatures2D> &output)
 {
+  waitAsync();
   vpImageConvert::convert(I, m_img);
 
   return detect(m_img, output);
@@ -309,6 +337,7 @@ bool vpDetectorDNNOpenCV::detect(const vpImage<vpRGBa> &I, std::vector<DetectedF
 */
 bool vpDetectorDNNOpenCV::detect(const vpImage<vpRGBa> &I, std::map< std::string, std::vector<DetectedFeatures2D>> &output)
 {
+  waitAsync();
   vpImageConvert::convert(I, m_img);
 
   return detect(m_img, output);
@@ -323,6 +352,7 @@ bool vpDetectorDNNOpenCV::detect(const vpImage<vpRGBa> &I, std::map< std::string
 */
 bool vpDetectorDNNOpenCV::detect(const vpImage<vpRGBa> &I, std::vector< std::pair<std::string, std::vector<DetectedFeatures2D>>> &output)
 {
+  waitAsync();
   vpImageConvert::convert(I, m_img);
 
   return detect(m_img, output);
@@ -337,25 +367,30 @@ bool vpDetectorDNNOpenCV::detect(const vpImage<vpRGBa> &I, std::vector< std::pai
 */
 bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::vector<DetectedFeatures2D> &output)
 {
+  waitAsync();
+
+  cv::dnn::blobFromImage(I, m_blob, m_netConfig.m_scaleFactor, getBlobSize(I), m_netConfig.m_mean, m_netConfig.m_swapRB, false);
+  output = detectFromBlob(I, m_blob);
+
+  return !output.empty();
+}
+
+/*!
+  Object detection using OpenCV DNN module.
+
+  \param I : Input image.
+  \param output : map where the name of the class is used as key and whose value is a vector of detected 2D features that belong to the class.
+  \return false if there is no detection.
+*/
+bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::map< std::string, std::vector<DetectedFeatures2D>> &output)
+{
+  waitAsync();
+
   m_img = I;
   output.clear();
 
-  cv::Size inputSize(m_netConfig.m_inputSize.width > 0 ? m_netConfig.m_inputSize.width : m_img.cols,
-    m_netConfig.m_inputSize.height > 0 ? m_netConfig.m_inputSize.height : m_img.rows);
-  cv::dnn::blobFromImage(m_img, m_blob, m_netConfig.m_scaleFactor, inputSize, m_netConfig.m_mean, m_netConfig.m_swapRB, false);
-
-  m_net.setInput(m_blob);
-  try {
-    m_net.forward(m_dnnRes, m_outNames);
-  }
-  catch (const cv::Exception &e) {
-    std::cerr << "Caught an exception trying to run inference:" << std::endl << "\t"
-      << e.what()
-      << "\nCuda and/or GPU driver might not be correctly installed. Setting preferable backend to CPU and trying again." << std::endl;
-    m_net.setPreferableBackend(cv::dnn::DNN_BACKEND_DEFAULT);
-    m_net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-    m_net.forward(m_dnnRes, m_outNames);
-  }
+  cv::dnn::blobFromImage(m_img, m_blob, m_netConfig.m_scaleFactor, getBlobSize(m_img), m_netConfig.m_mean, m_netConfig.m_swapRB, false);
+  runInference(m_blob);
 
   DetectionCandidates proposals;
   postProcess(proposals);
@@ -363,18 +398,21 @@ bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::vector<DetectedFeatures2
   for (size_t i = 0; i < m_indices.size(); ++i) {
     int idx = m_indices[i];
     cv::Rect box = proposals.m_boxes[idx];
-    std::optional<std::string> classname_opt;
+    std::string classname;
     if (nbClassNames > 0) {
-      classname_opt = m_netConfig.m_classNames[proposals.m_classIds[idx]];
+      classname = m_netConfig.m_classNames[proposals.m_classIds[idx]];
     }
-    output.emplace_back(box.x, box.x + box.width, box.y, box.y + box.height
+    else {
+      classname = std::to_string(proposals.m_classIds[idx]);
+    }
+    std::optional<std::string> classname_opt = std::optional<std::string>(classname);
+    output[classname].emplace_back(box.x, box.x + box.width, box.y, box.y + box.height
       , proposals.m_classIds[idx], proposals.m_confidences[idx]
       , classname_opt
     );
   }
 
   if (m_applySizeFilterAfterNMS) {
-    // removing false detections, based on the bbox sizes
     output = filterDetectionMultiClassInput(output, m_netConfig.m_filterSizeRatio);
   }
 
@@ -385,19 +423,218 @@ bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::vector<DetectedFeatures2
   Object detection using OpenCV DNN module.
 
   \param I : Input image.
-  \param output : map where the name of the class is used as key and whose value is a vector of detected 2D features that belong to the class.
+  \param output : vector of pairs <name_of_the_class, vector_of_detections>
   \return false if there is no detection.
 */
-bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::map< std::string, std::vector<DetectedFeatures2D>> &output)
+bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::vector< std::pair<std::string, std::vector<DetectedFeatures2D>>> &output)
 {
-  m_img = I;
+  std::map< std::string, std::vector<DetectedFeatures2D>> map_output;
+  bool returnStatus = detect(I, map_output);
+  for (auto key_val : map_output) {
+    output.push_back(key_val);
+  }
+  return returnStatus;
+}
+
+/*!
+  Object detection on several images with a single inference of the network, e.g. for the cameras of a multi-camera
+  rig. The images are resized to the input size of the network and stacked in one blob.
+
+  \warning Classical object detection network uses as input 3-channels.
+
+  \param images : Input images.
+  \param output : For each input image, the vector of its detections, whichever class they belong to.
+  \return false if there is no detection in any of the images, true otherwise.
+*/
+bool vpDetectorDNNOpenCV::detect(const std::vector<vpImage<vpRGBa> > &images, std::vector<std::vector<DetectedFeatures2D> > &output)
+{
+  std::vector<cv::Mat> imgs(images.size());
+  for (size_t i = 0; i < images.size(); ++i) {
+    vpImageConvert::convert(images[i], imgs[i]);
+  }
+
+  return detect(imgs, output);
+}
+
+/*!
+  Object detection on several images with a single inference of the network, e.g. for the cameras of a multi-camera
+  rig. The images are resized to the input size of the network, or to the size of the first image when the input size
+  is not set, and stacked in one blob.
+
+  The outputs of the network are split per image before being parsed: the outputs of the Yolo networks along their
+  first dimension, and the [batchId, classId, confidence, left, top, right, bottom] detections of the Faster-RCNN,
+  SSD-MobileNet and ResNet-10 networks according to their batch id.
+
+  \param images : Input images.
+  \param output : For each input image, the vector of its detections, whichever class they belong to.
+  \return false if there is no detection in any of the images, true otherwise.
+*/
+bool vpDetectorDNNOpenCV::detect(const std::vector<cv::Mat> &images, std::vector<std::vector<DetectedFeatures2D> > &output)
+{
+  waitAsync();
+
   output.clear();
+  if (images.empty()) {
+    return false;
+  }
+
+  cv::dnn::blobFromImages(images, m_blob, m_netConfig.m_scaleFactor, getBlobSize(images[0]), m_netConfig.m_mean, m_netConfig.m_swapRB, false);
+  runInference(m_blob);
+
+  const int batchSize = static_cast<int>(images.size());
+  const bool detectionOutput = (m_netConfig.m_parsingMethodType == FASTER_RCNN || m_netConfig.m_parsingMethodType == SSD_MOBILENET
+    || m_netConfig.m_parsingMethodType == RESNET_10);
+  const std::vector<cv::Mat> batchRes = m_dnnRes;
+
+  bool detected = false;
+  output.resize(images.size());
+  for (int b = 0; b < batchSize; ++b) {
+    // Outputs of the b-th image, sharing the data of the batch outputs when possible
+    m_dnnRes.resize(batchRes.size());
+    for (size_t o = 0; o < batchRes.size(); ++o) {
+      const cv::Mat &res = batchRes[o];
+      if (batchSize == 1) {
+        m_dnnRes[o] = res;
+      }
+      else if (detectionOutput && res.size[res.dims - 1] == 7) {
+        const cv::Mat rows = res.reshape(1, static_cast<int>(res.total() / 7));
+        cv::Mat detections;
+        for (int r = 0; r < rows.rows; ++r) {
+          if (static_cast<int>(rows.at<float>(r, 0)) == b) {
+            detections.push_back(rows.row(r));
+          }
+        }
+        m_dnnRes[o] = detections.empty() ? cv::Mat(0, 7, CV_32F) : detections;
+      }
+      else if (res.dims == 2 && res.rows % batchSize == 0) {
+        const int rows = res.rows / batchSize;
+        m_dnnRes[o] = res.rowRange(b * rows, (b + 1) * rows);
+      }
+      else if (res.dims > 2 && res.size[0] == batchSize) {
+        m_dnnRes[o] = cv::Mat(res.dims - 1, res.size.p + 1, res.type(), const_cast<uchar *>(res.ptr(b)));
+      }
+      else {
+        throw(vpException(vpException::dimensionError, "Cannot split the output %d of the network between the %d images of the batch",
+          static_cast<int>(o), batchSize));
+      }
+    }
+
+    m_img = images[b];
+    DetectionCandidates proposals;
+    postProcess(proposals);
+    output[b] = getDetectedFeatures(proposals);
+    if (m_applySizeFilterAfterNMS) {
+      output[b] = filterDetectionMultiClassInput(output[b], m_netConfig.m_filterSizeRatio);
+    }
+    detected = detected || !output[b].empty();
+  }
+  m_dnnRes = batchRes;
+
+  return detected;
+}
+
+/*!
+  Start the detection of the objects in an image in a background thread and return as soon as the image is
+  preprocessed, so that the inference of a frame overlaps with the acquisition and the preprocessing of the next one.
+  The detections are retrieved with poll(), in the order of the submitted images.
+
+  Only one inference runs at a time: if the previous image is still being processed, this function waits for its
+  detections after having preprocessed the new image. The configuration of the detector must not be modified while an
+  image is being processed.
+
+  \warning Classical object detection network uses as input 3-channels.
+
+  \param I : Input image.
+*/
+void vpDetectorDNNOpenCV::submit(const vpImage<vpRGBa> &I)
+{
+  cv::Mat img;
+  vpImageConvert::convert(I, img);
+  submit(img);
+}
+
+/*!
+  Start the detection of the objects in an image in a background thread and return as soon as the image is
+  preprocessed, so that the inference of a frame overlaps with the acquisition and the preprocessing of the next one.
+  The detections are retrieved with poll(), in the order of the submitted images.
 
-  cv::Size inputSize(m_netConfig.m_inputSize.width > 0 ? m_netConfig.m_inputSize.width : m_img.cols,
-    m_netConfig.m_inputSize.height > 0 ? m_netConfig.m_inputSize.height : m_img.rows);
-  cv::dnn::blobFromImage(m_img, m_blob, m_netConfig.m_scaleFactor, inputSize, m_netConfig.m_mean, m_netConfig.m_swapRB, false);
+  Only one inference runs at a time: if the previous image is still being processed, this function waits for its
+  detections after having preprocessed the new image. The configuration of the detector must not be modified while an
+  image is being processed.
 
-  m_net.setInput(m_blob);
+  \param I : Input image. Its data is shared with the background thread and must not be modified until the
+  detections of the image are returned by poll().
+*/
+void vpDetectorDNNOpenCV::submit(const cv::Mat &I)
+{
+  cv::Mat blob;
+  cv::dnn::blobFromImage(I, blob, m_netConfig.m_scaleFactor, getBlobSize(I), m_netConfig.m_mean, m_netConfig.m_swapRB, false);
+
+  waitAsync();
+  m_asyncDetection = std::async(std::launch::async, [this, I, blob]() { return detectFromBlob(I, blob); }).share();
+}
+
+/*!
+  Retrieve the detections of the oldest image given to submit() whose detections have not been retrieved yet.
+
+  \param output : Vector of detections of the image, whichever class they belong to.
+  \param blocking : If true, wait for the end of the inference running in the background when there is no other
+  available detections.
+  \return true if the detections of an image are returned, false if there is no submitted image or if its inference is
+  still running and \e blocking is false.
+*/
+bool vpDetectorDNNOpenCV::poll(std::vector<DetectedFeatures2D> &output, bool blocking)
+{
+  if (m_asyncDetection.valid()) {
+    bool ready = m_asyncDetection.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    if (ready || (blocking && m_asyncResults.empty())) {
+      waitAsync();
+    }
+  }
+
+  if (m_asyncResults.empty()) {
+    return false;
+  }
+
+  output = m_asyncResults.front();
+  m_asyncResults.pop_front();
+  return true;
+}
+
+/*!
+  Wait for the end of the inference running in the background, if any, and store its detections to be returned by
+  poll().
+*/
+void vpDetectorDNNOpenCV::waitAsync()
+{
+  if (m_asyncDetection.valid()) {
+    std::shared_future<std::vector<DetectedFeatures2D> > detection = m_asyncDetection;
+    m_asyncDetection = std::shared_future<std::vector<DetectedFeatures2D> >();
+    m_asyncResults.push_back(detection.get());
+  }
+}
+
+/*!
+  Return the size of the blob for an input image: the input size of the network if it is set, the size of the image
+  otherwise.
+
+  \param I : Input image.
+*/
+cv::Size vpDetectorDNNOpenCV::getBlobSize(const cv::Mat &I) const
+{
+  return cv::Size(m_netConfig.m_inputSize.width > 0 ? m_netConfig.m_inputSize.width : I.cols,
+    m_netConfig.m_inputSize.height > 0 ? m_netConfig.m_inputSize.height : I.rows);
+}
+
+/*!
+  Run the network on a blob, the raw results being stored in \b m_dnnRes .
+  If the inference fails, e.g. because CUDA is not correctly installed, it is run again with the CPU backend.
+
+  \param blob : Input blob, from one or several images.
+*/
+void vpDetectorDNNOpenCV::runInference(const cv::Mat &blob)
+{
+  m_net.setInput(blob);
   try {
     m_net.forward(m_dnnRes, m_outNames);
   }
@@ -409,49 +646,115 @@ bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::map< std::string, std::v
     m_net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
     m_net.forward(m_dnnRes, m_outNames);
   }
+}
+
+/*!
+  Run the network on the blob of an image and return the filtered detections.
+
+  \param I : Input image, whose size is used to express the detections in pixels.
+  \param blob : Blob of the image.
+  \return The detections, whichever class they belong to.
+*/
+std::vector<vpDetectorDNNOpenCV::DetectedFeatures2D> vpDetectorDNNOpenCV::detectFromBlob(const cv::Mat &I, const cv::Mat &blob)
+{
+  m_img = I;
+  runInference(blob);
 
   DetectionCandidates proposals;
   postProcess(proposals);
+  std::vector<DetectedFeatures2D> output = getDetectedFeatures(proposals);
+
+  if (m_applySizeFilterAfterNMS) {
+    // removing false detections, based on the bbox sizes
+    output = filterDetectionMultiClassInput(output, m_netConfig.m_filterSizeRatio);
+  }
+  return output;
+}
+
+/*!
+  Convert the detection candidates kept by the Non-Maximum Suppression into detected features.
+
+  \param proposals : All the detection candidates.
+  \return The kept detections.
+*/
+std::vector<vpDetectorDNNOpenCV::DetectedFeatures2D> vpDetectorDNNOpenCV::getDetectedFeatures(const DetectionCandidates &proposals) const
+{
+  std::vector<DetectedFeatures2D> output;
+  output.reserve(m_indices.size());
   size_t nbClassNames = m_netConfig.m_classNames.size();
   for (size_t i = 0; i < m_indices.size(); ++i) {
     int idx = m_indices[i];
     cv::Rect box = proposals.m_boxes[idx];
-    std::string classname;
+    std::optional<std::string> classname_opt;
     if (nbClassNames > 0) {
-      classname = m_netConfig.m_classNames[proposals.m_classIds[idx]];
-    }
-    else {
-      classname = std::to_string(proposals.m_classIds[idx]);
+      classname_opt = m_netConfig.m_classNames[proposals.m_classIds[idx]];
     }
-    std::optional<std::string> classname_opt = std::optional<std::string>(classname);
-    output[classname].emplace_back(box.x, box.x + box.width, box.y, box.y + box.height
+    output.emplace_back(box.x, box.x + box.width, box.y, box.y + box.height
       , proposals.m_classIds[idx], proposals.m_confidences[idx]
       , classname_opt
     );
   }
-
-  if (m_applySizeFilterAfterNMS) {
-    output = filterDetectionMultiClassInput(output, m_netConfig.m_filterSizeRatio);
-  }
-
-  return !output.empty();
+  return output;
 }
 
 /*!
-  Object detection using OpenCV DNN module.
+  Non-Maximum Suppression of the detection candidates, whatever their class, the indices of the kept candidates being
+  stored in \b m_indices by decreasing confidence. It gives the same result as cv::dnn::NMSBoxes() but works on
+  contiguous arrays of box coordinates and areas computed once.
 
-  \param I : Input image.
-  \param output : vector of pairs <name_of_the_class, vector_of_detections>
-  \return false if there is no detection.
+  \param proposals : All the detection candidates.
 */
-bool vpDetectorDNNOpenCV::detect(const cv::Mat &I, std::vector< std::pair<std::string, std::vector<DetectedFeatures2D>>> &output)
+void vpDetectorDNNOpenCV::nonMaximumSuppression(const DetectionCandidates &proposals)
 {
-  std::map< std::string, std::vector<DetectedFeatures2D>> map_output;
-  bool returnStatus = detect(I, map_output);
-  for (auto key_val : map_output) {
-    output.push_back(key_val);
+  m_indices.clear();
+
+  const std::vector<float> &scores = proposals.m_confidences;
+  std::vector<int> order;
+  for (size_t i = 0; i < scores.size(); ++i) {
+    if (scores[i] > m_netConfig.m_confThreshold) {
+      order.push_back(static_cast<int>(i));
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a] > scores[b]; });
+
+  // Coordinates of the kept boxes
+  std::vector<int> left, top, right, bottom, area;
+  left.reserve(order.size());
+  top.reserve(order.size());
+  right.reserve(order.size());
+  bottom.reserve(order.size());
+  area.reserve(order.size());
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    const cv::Rect &box = proposals.m_boxes[order[i]];
+    const int boxRight = box.x + box.width, boxBottom = box.y + box.height, boxArea = box.area();
+    const bool boxEmpty = box.width <= 0 || box.height <= 0;
+
+    bool keep = true;
+    for (size_t k = 0; k < left.size() && keep; ++k) {
+      // Same overlap as cv::rectOverlap()
+      float overlap = 1.f;
+      if (boxArea + area[k] > 0) {
+        double intersection = 0.;
+        const int w = std::min(boxRight, right[k]) - std::max(box.x, left[k]);
+        const int h = std::min(boxBottom, bottom[k]) - std::max(box.y, top[k]);
+        if (!boxEmpty && right[k] > left[k] && bottom[k] > top[k] && w > 0 && h > 0) {
+          intersection = static_cast<double>(w * h);
+        }
+        overlap = 1.f - static_cast<float>(1. - intersection / (boxArea + area[k] - intersection));
+      }
+      keep = overlap <= m_netConfig.m_nmsThreshold;
+    }
+
+    if (keep) {
+      m_indices.push_back(order[i]);
+      left.push_back(box.x);
+      top.push_back(box.y);
+      right.push_back(boxRight);
+      bottom.push_back(boxBottom);
+      area.push_back(boxArea);
+    }
   }
-  return returnStatus;
 }
 
 #if (VISP_HAVE_OPENCV_VERSION == 0x030403)
@@ -518,8 +821,7 @@ void vpDetectorDNNOpenCV::postProcess(DetectionCandidates &proposals)
     throw(vpException(vpException::badValue, "Type of DNN post-processing method not handled."));
   }
 
-  m_indices.clear();
-  cv::dnn::NMSBoxes(proposals.m_boxes, proposals.m_confidences, m_netConfig.m_confThreshold, m_netConfig.m_nmsThreshold, m_indices);
+  nonMaximumSuppression(proposals);
 }
 
 /*!
@@ -697,24 +999,27 @@ void vpDetectorDNNOpenCV::postProcess_YoloV3_V4(DetectionCandidates &proposals,
       dnnRes[i] = dnnRes[i].reshape(0, num_proposal);
     }
 
-    int n = 0, row_ind = 0; /// cx,cy,w,h,box_score,class_score
+    if (nout <= 5) {
+      continue;
+    }
+    if (!dnnRes[i].isContinuous()) {
+      dnnRes[i] = dnnRes[i].clone();
+    }
+
+    int n = 0; /// cx,cy,w,h,box_score,class_score
     float *pdata = (float *)dnnRes[i].data;
 
     // Iterate on the detections to keep only the meaningful ones
     for (n = 0; n < num_proposal; n++) {
       float box_score = pdata[4];
       if (box_score > netConfig.m_confThreshold) {
-        cv::Mat scores = dnnRes[i].row(row_ind).colRange(5, nout);
-        cv::Point classIdPoint;
         double max_class_score;
-        // Get the value and location of the maximum score
-        cv::minMaxLoc(scores, 0, &max_class_score, 0, &classIdPoint);
-
+        // Get the value and location of the maximum score, directly in the raw output
+        const int class_idx = getMaxScoreIndex(pdata + 5, nout - 5, max_class_score);
         max_class_score *= box_score;
 
         // The detection is kept only if the confidence is greater than the threshold
         if (max_class_score > netConfig.m_confThreshold) {
-          const int class_idx = classIdPoint.x;
           float cx = pdata[0] * m_img.cols; /// cx
           float cy = pdata[1] * m_img.rows; /// cy
           float w = pdata[2] * m_img.cols; /// w
@@ -728,7 +1033,6 @@ void vpDetectorDNNOpenCV::postProcess_YoloV3_V4(DetectionCandidates &proposals,
           proposals.m_classIds.push_back(class_idx);
         }
       }
-      row_ind++;
       pdata += nout;
     }
   }
@@ -762,7 +1066,14 @@ void vpDetectorDNNOpenCV::postProcess_YoloV5_V7(DetectionCandidates &proposals,
       dnnRes[i] = dnnRes[i].reshape(0, num_proposal);
     }
 
-    int n = 0, row_ind = 0; /// cx,cy,w,h,box_score,class_score
+    if (nout <= 5) {
+      continue;
+    }
+    if (!dnnRes[i].isContinuous()) {
+      dnnRes[i] = dnnRes[i].clone();
+    }
+
+    int n = 0; /// cx,cy,w,h,box_score,class_score
     float *pdata = (float *)dnnRes[i].data;
 
     // Iterate on the detections to keep only the meaningful ones
@@ -770,16 +1081,13 @@ void vpDetectorDNNOpenCV::postProcess_YoloV5_V7(DetectionCandidates &proposals,
       float box_score = pdata[4];
 
       if (box_score > netConfig.m_confThreshold) {
-        cv::Mat scores = dnnRes[i].row(row_ind).colRange(5, nout);
-        cv::Point classIdPoint;
         double max_class_score;
-        // Get the value and location of the maximum score
-        cv::minMaxLoc(scores, 0, &max_class_score, 0, &classIdPoint);
+        // Get the value and location of the maximum score, directly in the raw output
+        const int class_idx = getMaxScoreIndex(pdata + 5, nout - 5, max_class_score);
         max_class_score *= box_score;
 
         // The detection is kept only if the confidence is greater than the threshold
         if (max_class_score > netConfig.m_confThreshold) {
-          const int class_idx = classIdPoint.x;
           float cx = pdata[0] * ratiow; /// cx
           float cy = pdata[1] * ratioh; /// cy
           float w = pdata[2] * ratiow; /// w
@@ -793,7 +1101,6 @@ void vpDetectorDNNOpenCV::postProcess_YoloV5_V7(DetectionCandidates &proposals,
           proposals.m_classIds.push_back(class_idx);
         }
       }
-      row_ind++;
       pdata += nout;
     }
   }
@@ -827,37 +1134,45 @@ void vpDetectorDNNOpenCV::postProcess_YoloV8(DetectionCandidates &proposals, std
       nout = dnnRes[i].size[1];
       dnnRes[i] = dnnRes[i].reshape(0, nout);
     }
-    cv::transpose(dnnRes[i], dnnRes[i]); // Organise data as YoloV5 i.e. [batchsize][1:num_proposals][1:4+nb_classes]
+    const int nbClasses = nout - 4;
+    if (nbClasses <= 0) {
+      continue;
+    }
+    if (!dnnRes[i].isContinuous()) {
+      dnnRes[i] = dnnRes[i].clone();
+    }
 
-    int n = 0, row_ind = 0; /// cx,cy,w,h,box_score,class_score
-    float *pdata = (float *)dnnRes[i].data;
+    // The data is organised as [1:4+nb_classes][1:num_proposals]: instead of transposing it, the best class of all the
+    // proposals is searched class row by class row, on contiguous data
+    const float *pdata = (const float *)dnnRes[i].data;
+    std::vector<float> max_class_scores(pdata + 4 * num_proposal, pdata + 5 * num_proposal);
+    std::vector<int> class_ids(num_proposal, 0);
+    for (int c = 1; c < nbClasses; c++) {
+      const float *scores = pdata + (4 + c) * num_proposal;
+      for (int n = 0; n < num_proposal; n++) {
+        if (scores[n] > max_class_scores[n]) {
+          max_class_scores[n] = scores[n];
+          class_ids[n] = c;
+        }
+      }
+    }
 
     // Iterate on the detections to keep only the meaningful ones
-    for (n = 0; n < num_proposal; n++) {
-      cv::Mat scores = dnnRes[i].row(row_ind).colRange(4, nout);
-      cv::Point classIdPoint;
-      double max_class_score;
-      // Get the value and location of the maximum score
-      cv::minMaxLoc(scores, 0, &max_class_score, 0, &classIdPoint);
-
+    for (int n = 0; n < num_proposal; n++) {
       // The detection is kept only if the confidence is greater than the threshold
-      if (max_class_score > netConfig.m_confThreshold) {
-        const int class_idx = classIdPoint.x;
-        float cx = pdata[0] * ratiow; /// cx
-        float cy = pdata[1] * ratioh; /// cy
-        float w = pdata[2] * ratiow; /// w
-        float h = pdata[3] * ratioh; /// h
+      if (max_class_scores[n] > netConfig.m_confThreshold) {
+        float cx = pdata[n] * ratiow; /// cx
+        float cy = pdata[num_proposal + n] * ratioh; /// cy
+        float w = pdata[2 * num_proposal + n] * ratiow; /// w
+        float h = pdata[3 * num_proposal + n] * ratioh; /// h
 
         int left = int(cx - 0.5 * w);
         int top = int(cy - 0.5 * h);
 
-        proposals.m_confidences.push_back((float)max_class_score);
+        proposals.m_confidences.push_back(max_class_scores[n]);
         proposals.m_boxes.push_back(cv::Rect(left, top, (int)(w), (int)(h)));
-        proposals.m_classIds.push_back(class_idx);
+        proposals.m_classIds.push_back(class_ids[n]);
       }
-
-      row_ind++;
-      pdata += nout;
     }
   }
 }
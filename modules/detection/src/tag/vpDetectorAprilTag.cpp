@@ -40,6 +40,7 @@
 #include <apriltag.h>
 #include <apriltag_pose.h>
 #include <common/homography.h>
+#include <common/timeprofile.h>
 #include <tag16h5.h>
 #include <tag25h7.h>
 #include <tag25h9.h>
@@ -55,6 +56,8 @@
 #include <tagStandard52h13.h>
 #endif
 
+#include <algorithm>
+
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPoint.h>
@@ -66,7 +69,8 @@ class vpDetectorAprilTag::Impl
 public:
   Impl(const vpAprilTagFamily &tagFamily, const vpPoseEstimationMethod &method)
     : m_poseEstimationMethod(method), m_tagsId(), m_tagFamily(tagFamily), m_td(nullptr), m_tf(nullptr), m_detections(nullptr),
-    m_zAlignedWithCameraFrame(false)
+    m_zAlignedWithCameraFrame(false), m_tracking(false), m_fullDetectionPeriod(10), m_roiMargin(0.5),
+    m_nbFramesSinceFullDetection(0), m_userRois(), m_trackedRois(), m_trackedIds(), m_timeProfile()
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -135,7 +139,10 @@ public:
 
   Impl(const Impl &o)
     : m_poseEstimationMethod(o.m_poseEstimationMethod), m_tagsId(o.m_tagsId), m_tagFamily(o.m_tagFamily), m_td(nullptr),
-    m_tf(nullptr), m_detections(nullptr), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame)
+    m_tf(nullptr), m_detections(nullptr), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame),
+    m_tracking(o.m_tracking), m_fullDetectionPeriod(o.m_fullDetectionPeriod), m_roiMargin(o.m_roiMargin),
+    m_nbFramesSinceFullDetection(o.m_nbFramesSinceFullDetection), m_userRois(o.m_userRois),
+    m_trackedRois(o.m_trackedRois), m_trackedIds(o.m_trackedIds), m_timeProfile(o.m_timeProfile)
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -308,17 +315,12 @@ public:
 
     const bool computePose = (cMo_vec != nullptr);
 
-    image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
-      /*.height =*/(int32_t)I.getHeight(),
-      /*.stride =*/(int32_t)I.getWidth(),
-      /*.buf =*/I.bitmap };
-
     if (m_detections) {
       apriltag_detections_destroy(m_detections);
       m_detections = nullptr;
     }
 
-    m_detections = apriltag_detector_detect(m_td, &im);
+    m_detections = detectTags(I);
     int nb_detections = zarray_size(m_detections);
     bool detected = nb_detections > 0;
 
@@ -379,6 +381,194 @@ public:
     return detected;
   }
 
+  zarray_t *detectTags(const vpImage<unsigned char> &I)
+  {
+    // Regions of interest given by the user are used once, otherwise the regions around the tags of the previous
+    // frame are searched until the next full frame detection
+    std::vector<vpRect> rois;
+    bool tracked = false;
+    m_timeProfile.clear();
+    if (!m_userRois.empty()) {
+      rois.swap(m_userRois);
+    }
+    else if (m_tracking && !m_trackedRois.empty() && m_nbFramesSinceFullDetection + 1 < m_fullDetectionPeriod) {
+      rois = m_trackedRois;
+      tracked = true;
+    }
+
+    zarray_t *detections = nullptr;
+    if (!rois.empty()) {
+      detections = detectInRois(I, rois);
+
+      if (tracked && isTagLost(detections)) {
+        apriltag_detections_destroy(detections);
+        detections = nullptr;
+      }
+    }
+
+    if (detections) {
+      m_nbFramesSinceFullDetection++;
+    }
+    else {
+      image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
+        /*.height =*/(int32_t)I.getHeight(),
+        /*.stride =*/(int32_t)I.getWidth(),
+        /*.buf =*/I.bitmap };
+      detections = apriltag_detector_detect(m_td, &im);
+      addTimeProfile();
+      m_nbFramesSinceFullDetection = 0;
+    }
+
+    if (m_tracking) {
+      updateTrackedRois(I, detections);
+    }
+
+    return detections;
+  }
+
+  // Add the duration of each stage of the last call to apriltag_detector_detect(), stages of the same name being
+  // summed over the regions of interest
+  void addTimeProfile()
+  {
+    int64_t lastutime = m_td->tp->utime;
+    for (int i = 0; i < zarray_size(m_td->tp->stamps); i++) {
+      struct timeprofile_entry *stamp;
+      zarray_get_volatile(m_td->tp->stamps, i, &stamp);
+      const double duration = (stamp->utime - lastutime) / 1000.0;
+      lastutime = stamp->utime;
+
+      bool found = false;
+      for (size_t j = 0; j < m_timeProfile.size() && !found; j++) {
+        if (m_timeProfile[j].first == stamp->name) {
+          m_timeProfile[j].second += duration;
+          found = true;
+        }
+      }
+      if (!found) {
+        m_timeProfile.push_back(std::make_pair(std::string(stamp->name), duration));
+      }
+    }
+  }
+
+  zarray_t *detectInRois(const vpImage<unsigned char> &I, const std::vector<vpRect> &rois)
+  {
+    // Merge the overlapping regions so that a tag is not detected twice
+    std::vector<vpRect> merged;
+    const vpRect imageRect(0, 0, I.getWidth(), I.getHeight());
+    for (size_t i = 0; i < rois.size(); i++) {
+      vpRect roi = rois[i] & imageRect;
+      if (roi.getWidth() <= 0 || roi.getHeight() <= 0) {
+        continue;
+      }
+
+      bool overlap = true;
+      while (overlap) {
+        overlap = false;
+        for (size_t j = 0; j < merged.size(); j++) {
+          vpRect intersection = roi & merged[j];
+          if (intersection.getWidth() > 0 && intersection.getHeight() > 0) {
+            const double left = std::min<double>(roi.getLeft(), merged[j].getLeft());
+            const double top = std::min<double>(roi.getTop(), merged[j].getTop());
+            const double right =
+              std::max<double>(roi.getLeft() + roi.getWidth(), merged[j].getLeft() + merged[j].getWidth());
+            const double bottom =
+              std::max<double>(roi.getTop() + roi.getHeight(), merged[j].getTop() + merged[j].getHeight());
+            roi.setRect(left, top, right - left, bottom - top);
+            merged.erase(merged.begin() + j);
+            overlap = true;
+            break;
+          }
+        }
+      }
+      merged.push_back(roi);
+    }
+
+    zarray_t *detections = zarray_create(sizeof(apriltag_detection_t *));
+    vpImage<unsigned char> crop;
+    for (size_t i = 0; i < merged.size(); i++) {
+      const unsigned int left = static_cast<unsigned int>(std::floor(merged[i].getLeft()));
+      const unsigned int top = static_cast<unsigned int>(std::floor(merged[i].getTop()));
+      const unsigned int right = std::min<unsigned int>(
+        I.getWidth(), static_cast<unsigned int>(std::ceil(merged[i].getLeft() + merged[i].getWidth())));
+      const unsigned int bottom = std::min<unsigned int>(
+        I.getHeight(), static_cast<unsigned int>(std::ceil(merged[i].getTop() + merged[i].getHeight())));
+      if (right <= left || bottom <= top) {
+        continue;
+      }
+
+      // Contiguous copy, the detector may blur its input in place and reads it with its stride
+      crop.resize(bottom - top, right - left);
+      for (unsigned int y = 0; y < crop.getHeight(); y++) {
+        memcpy(crop[y], I[top + y] + left, crop.getWidth() * sizeof(unsigned char));
+      }
+
+      image_u8_t im = {/*.width =*/(int32_t)crop.getWidth(),
+        /*.height =*/(int32_t)crop.getHeight(),
+        /*.stride =*/(int32_t)crop.getWidth(),
+        /*.buf =*/crop.bitmap };
+      zarray_t *roiDetections = apriltag_detector_detect(m_td, &im);
+      addTimeProfile();
+
+      // Back to full image coordinates
+      for (int j = 0; j < zarray_size(roiDetections); j++) {
+        apriltag_detection_t *det;
+        zarray_get(roiDetections, j, &det);
+
+        det->c[0] += left;
+        det->c[1] += top;
+        for (int k = 0; k < 4; k++) {
+          det->p[k][0] += left;
+          det->p[k][1] += top;
+        }
+        for (int k = 0; k < 3; k++) {
+          MATD_EL(det->H, 0, k) += left * MATD_EL(det->H, 2, k);
+          MATD_EL(det->H, 1, k) += top * MATD_EL(det->H, 2, k);
+        }
+        zarray_add(detections, &det);
+      }
+      zarray_destroy(roiDetections);
+    }
+
+    return detections;
+  }
+
+  // A tag is lost when one of the previously detected ids is missing
+  bool isTagLost(const zarray_t *detections) const
+  {
+    std::vector<int> ids;
+    for (int i = 0; i < zarray_size(detections); i++) {
+      apriltag_detection_t *det;
+      zarray_get(detections, i, &det);
+      ids.push_back(det->id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    return !std::includes(ids.begin(), ids.end(), m_trackedIds.begin(), m_trackedIds.end());
+  }
+
+  void updateTrackedRois(const vpImage<unsigned char> &I, const zarray_t *detections)
+  {
+    m_trackedRois.clear();
+    m_trackedIds.clear();
+    const vpRect imageRect(0, 0, I.getWidth(), I.getHeight());
+    for (int i = 0; i < zarray_size(detections); i++) {
+      apriltag_detection_t *det;
+      zarray_get(detections, i, &det);
+
+      std::vector<vpImagePoint> corners;
+      for (int k = 0; k < 4; k++) {
+        corners.push_back(vpImagePoint(det->p[k][1], det->p[k][0]));
+      }
+      vpRect bbox(corners);
+      const double margin = m_roiMargin * std::max(bbox.getWidth(), bbox.getHeight());
+      bbox.setRect(bbox.getLeft() - margin, bbox.getTop() - margin, bbox.getWidth() + 2 * margin,
+                   bbox.getHeight() + 2 * margin);
+      m_trackedRois.push_back(bbox & imageRect);
+      m_trackedIds.push_back(det->id);
+    }
+    std::sort(m_trackedIds.begin(), m_trackedIds.end());
+  }
+
   void displayFrames(const vpImage<unsigned char> &I, const std::vector<vpHomogeneousMatrix> &cMo_vec,
                      const vpCameraParameters &cam, double size, const vpColor &color, unsigned int thickness) const
   {
@@ -801,6 +991,27 @@ public:
 
   void setZAlignedWithCameraAxis(bool zAlignedWithCameraFrame) { m_zAlignedWithCameraFrame = zAlignedWithCameraFrame; }
 
+  void getTracking(bool &enable, unsigned int &fullDetectionPeriod, double &roiMargin) const
+  {
+    enable = m_tracking;
+    fullDetectionPeriod = m_fullDetectionPeriod;
+    roiMargin = m_roiMargin;
+  }
+
+  void setTracking(bool enable, unsigned int fullDetectionPeriod, double roiMargin)
+  {
+    m_tracking = enable;
+    m_fullDetectionPeriod = fullDetectionPeriod;
+    m_roiMargin = roiMargin;
+    m_nbFramesSinceFullDetection = 0;
+    m_trackedRois.clear();
+    m_trackedIds.clear();
+  }
+
+  void setRois(const std::vector<vpRect> &rois) { m_userRois = rois; }
+
+  std::vector<std::pair<std::string, double> > getTimeProfile() const { return m_timeProfile; }
+
 protected:
   std::map<vpPoseEstimationMethod, vpPose::vpPoseMethodType> m_mapOfCorrespondingPoseMethods;
   vpPoseEstimationMethod m_poseEstimationMethod;
@@ -810,6 +1021,14 @@ protected:
   apriltag_family_t *m_tf;
   zarray_t *m_detections;
   bool m_zAlignedWithCameraFrame;
+  bool m_tracking;
+  unsigned int m_fullDetectionPeriod;
+  double m_roiMargin;
+  unsigned int m_nbFramesSinceFullDetection;
+  std::vector<vpRect> m_userRois;
+  std::vector<vpRect> m_trackedRois;
+  std::vector<int> m_trackedIds;
+  std::vector<std::pair<std::string, double> > m_timeProfile;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -1064,6 +1283,16 @@ std::vector<std::vector<vpImagePoint> > vpDetectorAprilTag::getTagsCorners() con
 */
 std::vector<int> vpDetectorAprilTag::getTagsId() const { return m_impl->getTagsId(); }
 
+/*!
+  Return the time spent in each stage of the AprilTag pipeline (decimation, blur, quad detection, decoding...) during
+  the last call to detect(), as pairs of stage name and duration in ms. When the tags are searched in regions of
+  interest, the durations of a stage are summed over the regions.
+*/
+std::vector<std::pair<std::string, double> > vpDetectorAprilTag::getTimeProfile() const
+{
+  return m_impl->getTimeProfile();
+}
+
 void vpDetectorAprilTag::setAprilTagDecodeSharpening(double decodeSharpening)
 {
   return m_impl->setAprilTagDecodeSharpening(decodeSharpening);
@@ -1083,6 +1312,10 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   bool refineEdges = true;
   m_impl->getRefineEdges(refineEdges);
   bool zAxis = m_impl->getZAlignedWithCameraAxis();
+  bool tracking = false;
+  unsigned int fullDetectionPeriod = 10;
+  double roiMargin = 0.5;
+  m_impl->getTracking(tracking, fullDetectionPeriod, roiMargin);
 
   delete m_impl;
   m_impl = new Impl(tagFamily, m_poseEstimationMethod);
@@ -1092,6 +1325,7 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   m_impl->setQuadSigma(quadSigma);
   m_impl->setRefineEdges(refineEdges);
   m_impl->setZAlignedWithCameraAxis(zAxis);
+  m_impl->setTracking(tracking, fullDetectionPeriod, roiMargin);
 }
 
 /*!
@@ -1171,6 +1405,43 @@ void vpDetectorAprilTag::setAprilTagRefineDecode(bool refineDecode)
 */
 void vpDetectorAprilTag::setAprilTagRefineEdges(bool refineEdges) { m_impl->setRefineEdges(refineEdges); }
 
+/*!
+  Restrict the next call to detect() to regions of interest, for instance the regions where the tags are
+  predicted by another tracker. The regions are only used once, the following calls to detect() process
+  the whole image again, or the tracked regions if setAprilTagTracking() is enabled.
+
+  The tags are searched in a copy of each region, overlapping regions being merged, with the same detector
+  settings as for the whole image.
+
+  \param rois : Regions of interest in the image.
+
+  \sa setAprilTagTracking()
+*/
+void vpDetectorAprilTag::setAprilTagRois(const std::vector<vpRect> &rois) { m_impl->setRois(rois); }
+
+/*!
+  Enable the temporal mode, meant for video streams where the tags move slowly between two frames.
+
+  When enabled, detect() only searches the tags in the regions around the tags detected in the previous
+  frame. The whole image is processed again every \e fullDetectionPeriod frames, to find new tags, or
+  as soon as one of the tracked tags is not found in its region.
+
+  \param enable : If true, enable the temporal mode. Enabling or disabling the mode resets the tracked regions.
+  \param fullDetectionPeriod : The whole image is processed at least once every \e fullDetectionPeriod
+  frames. A value of 1 processes every frame entirely.
+  \param roiMargin : Margin added on each side of the bounding box of a tag to get its region in the next
+  frame, as a ratio of the bounding box size.
+
+  \sa setAprilTagRois()
+*/
+void vpDetectorAprilTag::setAprilTagTracking(bool enable, unsigned int fullDetectionPeriod, double roiMargin)
+{
+  if (roiMargin < 0) {
+    throw(vpException(vpException::badValue, "The region margin (%f) must be positive", roiMargin));
+  }
+  m_impl->setTracking(enable, fullDetectionPeriod, roiMargin);
+}
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
 /*!
   \deprecated Deprecated parameter from AprilTag 2 version.
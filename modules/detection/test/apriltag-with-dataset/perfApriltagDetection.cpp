@@ -44,6 +44,19 @@
 #include <visp3/detection/vpDetectorAprilTag.h>
 #include <visp3/io/vpImageIo.h>
 
+namespace
+{
+// Time spent in each stage of the AprilTag pipeline during the last detection
+void printTimeProfile(const vpDetectorAprilTag &detector, const std::string &title)
+{
+  const std::vector<std::pair<std::string, double> > timeProfile = detector.getTimeProfile();
+  std::cout << title << std::endl;
+  for (size_t i = 0; i < timeProfile.size(); i++) {
+    std::cout << "  " << timeProfile[i].first << ": " << timeProfile[i].second << " ms" << std::endl;
+  }
+}
+}
+
 TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
 {
   const double tagSize = 0.25;
@@ -66,6 +79,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag16_05 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag16_05 1920x1080 decimate=2")
@@ -75,6 +89,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag16_05 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag16_05 1920x1080 decimate=3")
@@ -84,6 +99,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag16_05 1920x1080 decimate=3");
   }
 
   SECTION("tag25_09")
@@ -102,6 +118,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag25_09 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag25_09 1920x1080 decimate=2")
@@ -111,6 +128,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag25_09 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag25_09 1920x1080 decimate=3")
@@ -120,6 +138,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag25_09 1920x1080 decimate=3");
   }
 
   SECTION("tag36_11")
@@ -138,6 +157,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag36_11 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag36_11 1920x1080 decimate=2")
@@ -147,6 +167,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag36_11 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag36_11 1920x1080 decimate=3")
@@ -156,6 +177,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag36_11 1920x1080 decimate=3");
   }
 
   SECTION("tag21_07")
@@ -174,6 +196,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag21_07 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag21_07 1920x1080 decimate=2")
@@ -183,6 +206,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag21_07 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag21_07 1920x1080 decimate=3")
@@ -192,6 +216,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag21_07 1920x1080 decimate=3");
   }
 
 #if defined(VISP_HAVE_APRILTAG_BIG_FAMILY)
@@ -211,6 +236,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag49_12 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag49_12 1920x1080 decimate=2")
@@ -220,6 +246,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag49_12 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag49_12 1920x1080 decimate=3")
@@ -229,6 +256,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag49_12 1920x1080 decimate=3");
   }
 
   SECTION("tag48_12")
@@ -247,6 +275,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag48_12 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag48_12 1920x1080 decimate=2")
@@ -256,6 +285,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag48_12 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag48_12 1920x1080 decimate=3")
@@ -265,6 +295,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag48_12 1920x1080 decimate=3");
   }
 
   SECTION("tag41_12")
@@ -283,6 +314,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag41_12 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag41_12 1920x1080 decimate=2")
@@ -292,6 +324,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag41_12 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag41_12 1920x1080 decimate=3")
@@ -301,6 +334,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag41_12 1920x1080 decimate=3");
   }
 
   SECTION("tag52_13")
@@ -319,6 +353,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag52_13 1920x1080");
 
     apriltag_detector.setAprilTagQuadDecimate(2);
     BENCHMARK("Benchmark Apriltag detection: tag52_13 1920x1080 decimate=2")
@@ -328,6 +363,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag52_13 1920x1080 decimate=2");
 
     apriltag_detector.setAprilTagQuadDecimate(3);
     BENCHMARK("Benchmark Apriltag detection: tag52_13 1920x1080 decimate=3")
@@ -337,6 +373,7 @@ TEST_CASE("Benchmark Apriltag detection 1920x1080", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag52_13 1920x1080 decimate=3");
   }
 #endif
 }
@@ -363,6 +400,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag16_05 640x480");
   }
 
   SECTION("tag25_09")
@@ -381,6 +419,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag25_09 640x480");
   }
 
   SECTION("tag36_11")
@@ -399,6 +438,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag36_11 640x480");
   }
 
   SECTION("tag21_07")
@@ -417,6 +457,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag21_07 640x480");
   }
 
 #if defined(VISP_HAVE_APRILTAG_BIG_FAMILY)
@@ -436,6 +477,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag49_12 640x480");
   }
 
   SECTION("tag48_12")
@@ -454,6 +496,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag48_12 640x480");
   }
 
   SECTION("tag41_12")
@@ -472,6 +515,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag41_12 640x480");
   }
 
   SECTION("tag52_13")
@@ -490,6 +534,7 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]")
       CHECK(cMo_vec.size() == nbTags);
       return cMo_vec;
     };
+    printTimeProfile(apriltag_detector, "tag52_13 640x480");
   }
 #endif
 }
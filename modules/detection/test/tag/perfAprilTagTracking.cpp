@@ -0,0 +1,299 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Apriltag detection with the temporal mode.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_HAVE_APRILTAG)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 1920;
+int g_height = 1080;
+
+// Tag16h5 layout and codes of the first tags
+const int g_bitX[16] = { 1, 2, 3, 2, 4, 4, 4, 3, 4, 3, 2, 3, 1, 1, 1, 2 };
+const int g_bitY[16] = { 1, 1, 1, 2, 1, 2, 3, 2, 4, 4, 4, 3, 4, 3, 2, 3 };
+const unsigned int g_codes[5] = { 0x27c8, 0x31b6, 0x3859, 0x569c, 0x6c76 };
+
+struct Tag
+{
+  int id;
+  int i, j; // Top left position
+};
+
+// Draw the 8x8 cells of tag16h5 tags, with cellSize pixels per cell, on a gray background
+vpImage<unsigned char> drawTags(const std::vector<Tag> &tags, unsigned int cellSize)
+{
+  vpImage<unsigned char> I(static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), 128);
+  for (size_t t = 0; t < tags.size(); t++) {
+    unsigned char cells[8][8];
+    for (int r = 0; r < 8; r++) {
+      for (int c = 0; c < 8; c++) {
+        cells[r][c] = (r == 0 || r == 7 || c == 0 || c == 7) ? 255 : 0;
+      }
+    }
+    for (int b = 0; b < 16; b++) {
+      if (g_codes[tags[t].id] & (1u << (15 - b))) {
+        cells[g_bitY[b] + 1][g_bitX[b] + 1] = 255;
+      }
+    }
+
+    for (unsigned int i = 0; i < 8 * cellSize; i++) {
+      for (unsigned int j = 0; j < 8 * cellSize; j++) {
+        I[tags[t].i + i][tags[t].j + j] = cells[i / cellSize][j / cellSize];
+      }
+    }
+  }
+  return I;
+}
+
+std::vector<Tag> moveTags(const std::vector<Tag> &tags, int di, int dj)
+{
+  std::vector<Tag> moved = tags;
+  for (size_t t = 0; t < moved.size(); t++) {
+    moved[t].i += di;
+    moved[t].j += dj;
+  }
+  return moved;
+}
+
+// Tag corners sorted by tag id
+std::map<int, std::vector<vpImagePoint> > getCorners(const vpDetectorAprilTag &detector)
+{
+  std::map<int, std::vector<vpImagePoint> > corners;
+  const std::vector<int> ids = detector.getTagsId();
+  const std::vector<std::vector<vpImagePoint> > polygons = detector.getTagsCorners();
+  for (size_t k = 0; k < ids.size(); k++) {
+    corners[ids[k]] = polygons[k];
+  }
+  return corners;
+}
+
+void checkSameCorners(const vpDetectorAprilTag &detector, const vpDetectorAprilTag &detector_ref)
+{
+  std::map<int, std::vector<vpImagePoint> > corners = getCorners(detector), corners_ref = getCorners(detector_ref);
+  REQUIRE(corners.size() == corners_ref.size());
+  for (std::map<int, std::vector<vpImagePoint> >::const_iterator it = corners_ref.begin(); it != corners_ref.end();
+       ++it) {
+    REQUIRE(corners.find(it->first) != corners.end());
+    for (size_t k = 0; k < 4; k++) {
+      CHECK(vpImagePoint::distance(corners[it->first][k], it->second[k]) < 0.2);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Apriltag tracking", "[benchmark]")
+{
+  std::vector<Tag> tags;
+  const Tag tag0 = { 0, 100, 150 }, tag1 = { 1, 300, 900 }, tag2 = { 2, 700, 400 }, tag3 = { 3, 600, 1500 };
+  tags.push_back(tag0);
+  tags.push_back(tag1);
+  tags.push_back(tag2);
+  tags.push_back(tag3);
+  const unsigned int cellSize = 12;
+
+  vpDetectorAprilTag detector_ref(vpDetectorAprilTag::TAG_16h5, vpDetectorAprilTag::HOMOGRAPHY);
+  vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_16h5, vpDetectorAprilTag::HOMOGRAPHY);
+  const unsigned int fullDetectionPeriod = 5;
+  detector.setAprilTagTracking(true, fullDetectionPeriod);
+
+  const vpCameraParameters cam(1500, 1500, g_width / 2., g_height / 2.);
+  const double tagSize = 0.1;
+
+  SECTION("Same detections as the full image")
+  {
+    for (int frame = 0; frame < 8; frame++) {
+      const vpImage<unsigned char> I = drawTags(moveTags(tags, 2 * frame, 3 * frame), cellSize);
+
+      std::vector<vpHomogeneousMatrix> cMo_vec_ref, cMo_vec;
+      detector_ref.detect(I, tagSize, cam, cMo_vec_ref);
+      detector.detect(I, tagSize, cam, cMo_vec);
+      CHECK(detector.getNbObjects() == tags.size());
+      checkSameCorners(detector, detector_ref);
+
+      // The homography is expressed in the full image: the pose from the homography, that is approximate, reprojects
+      // close to the corners
+      std::map<int, double> tagsSize;
+      tagsSize[-1] = tagSize;
+      const std::vector<std::vector<vpPoint> > points3D = detector.getTagsPoints3D(detector.getTagsId(), tagsSize);
+      const std::vector<std::vector<vpImagePoint> > corners = detector.getTagsCorners();
+      REQUIRE(cMo_vec.size() == corners.size());
+      for (size_t k = 0; k < cMo_vec.size(); k++) {
+        for (size_t c = 0; c < 4; c++) {
+          vpPoint pt = points3D[k][c];
+          pt.project(cMo_vec[k]);
+          vpImagePoint ip;
+          vpMeterPixelConversion::convertPoint(cam, pt.get_x(), pt.get_y(), ip);
+          CHECK(vpImagePoint::distance(ip, corners[k][c]) < 5.0);
+        }
+      }
+    }
+  }
+
+  SECTION("Lost and new tags")
+  {
+    detector.detect(drawTags(tags, cellSize));
+    CHECK(detector.getNbObjects() == 4);
+
+    // A tag disappears, the whole image is processed again
+    std::vector<Tag> tags_lost(tags.begin(), tags.begin() + 3);
+    detector.detect(drawTags(tags_lost, cellSize));
+    CHECK(detector.getNbObjects() == 3);
+
+    // A new tag is only found with the next full image detection
+    std::vector<Tag> tags_new = tags_lost;
+    const Tag tag4 = { 4, 800, 1000 };
+    tags_new.push_back(tag4);
+    const vpImage<unsigned char> I_new = drawTags(tags_new, cellSize);
+    for (unsigned int frame = 1; frame < fullDetectionPeriod; frame++) {
+      detector.detect(I_new);
+      CHECK(detector.getNbObjects() == 3);
+    }
+    detector.detect(I_new);
+    CHECK(detector.getNbObjects() == 4);
+  }
+
+  SECTION("User regions of interest")
+  {
+    const vpImage<unsigned char> I = drawTags(tags, cellSize);
+    const double size = 8 * cellSize;
+    std::vector<vpRect> rois;
+    rois.push_back(vpRect(tag1.j - size / 2, tag1.i - size / 2, 2 * size, 2 * size));
+    rois.push_back(vpRect(tag3.j - size / 2, tag3.i - size / 2, 2 * size, 2 * size));
+    // Overlapping the previous one
+    rois.push_back(vpRect(tag3.j, tag3.i, 2 * size, 2 * size));
+
+    detector_ref.setAprilTagRois(rois);
+    detector_ref.detect(I);
+    std::vector<int> ids = detector_ref.getTagsId();
+    std::sort(ids.begin(), ids.end());
+    REQUIRE(ids.size() == 2);
+    CHECK(ids[0] == 1);
+    CHECK(ids[1] == 3);
+
+    // Only used once
+    detector_ref.detect(I);
+    CHECK(detector_ref.getNbObjects() == 4);
+  }
+
+  SECTION("Decimation, blur and time profile")
+  {
+    const vpImage<unsigned char> I = drawTags(tags, cellSize);
+    detector_ref.detect(I);
+
+    detector.setAprilTagTracking(false);
+    detector.setAprilTagQuadDecimate(2);
+    detector.setAprilTagQuadSigma(0.8f);
+    detector.detect(I);
+    CHECK(detector.getNbObjects() == tags.size());
+
+    // The decimated image gives slightly different corners
+    std::map<int, std::vector<vpImagePoint> > corners = getCorners(detector), corners_ref = getCorners(detector_ref);
+    REQUIRE(corners.size() == corners_ref.size());
+    for (std::map<int, std::vector<vpImagePoint> >::const_iterator it = corners_ref.begin(); it != corners_ref.end();
+         ++it) {
+      REQUIRE(corners.find(it->first) != corners.end());
+      for (size_t k = 0; k < 4; k++) {
+        CHECK(vpImagePoint::distance(corners[it->first][k], it->second[k]) < 1.0);
+      }
+    }
+
+    const std::vector<std::pair<std::string, double> > timeProfile = detector.getTimeProfile();
+    std::vector<std::string> stages;
+    for (size_t k = 0; k < timeProfile.size(); k++) {
+      CHECK(timeProfile[k].second >= 0);
+      stages.push_back(timeProfile[k].first);
+    }
+    CHECK(std::find(stages.begin(), stages.end(), "decimate") != stages.end());
+    CHECK(std::find(stages.begin(), stages.end(), "blur/sharp") != stages.end());
+    CHECK(std::find(stages.begin(), stages.end(), "quads") != stages.end());
+  }
+
+  if (g_runBenchmark) {
+    const vpImage<unsigned char> I = drawTags(tags, cellSize);
+    std::vector<vpHomogeneousMatrix> cMo_vec;
+
+    BENCHMARK("Apriltag detection (full image)")
+    {
+      detector_ref.detect(I, tagSize, cam, cMo_vec);
+      return cMo_vec;
+    };
+
+    detector.setAprilTagTracking(true, 1000);
+    BENCHMARK("Apriltag detection (tracking)")
+    {
+      detector.detect(I, tagSize, cam, cMo_vec);
+      return cMo_vec;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -117,6 +117,10 @@ public:
     float m_centerMinDist; /*!< Maximum distance between two circle candidates centers to consider merging them.*/
     float m_mergingRadiusDiffThresh; /*!< Maximum radius difference between two circle candidates to consider merging them.*/
 
+    // // Performance attributes
+    unsigned int m_edgeDecimationStep; /*!< Only one edge point out of this number votes, with a weight equal to this number.*/
+    unsigned int m_nbThreads; /*!< Number of threads used for the center and radius votes, 0 to use all the CPU threads.*/
+
     friend class vpCircleHoughTransform;
   public:
     /**
@@ -147,6 +151,8 @@ public:
       , m_recordVotingPoints(false)
       , m_centerMinDist(15.f)
       , m_mergingRadiusDiffThresh(1.5f * m_centerMinDist)
+      , m_edgeDecimationStep(1)
+      , m_nbThreads(1)
     {
 
     }
@@ -188,6 +194,9 @@ public:
      * are kept. Otherwise, maximum up to this number of centers are kept.
      * \param[in] recordVotingPoints If true, the edge-map points having voted for each circle will be stored.
      * \param[in] visibilityRatioThresh Visibility threshold: which minimum ratio of the circle must be visible in order to keep a circle candidate.
+     * \param[in] edgeDecimationStep Only one edge point out of \b edgeDecimationStep votes, with a weight equal to
+     * \b edgeDecimationStep. Must be strictly positive.
+     * \param[in] nbThreads Number of threads used for the center and radius votes, 0 to use all the CPU threads.
      */
     vpCircleHoughTransformParameters(
       const int &gaussianKernelSize
@@ -214,6 +223,8 @@ public:
       , const int &expectedNbCenters = -1
       , const bool &recordVotingPoints = false
       , const float &visibilityRatioThresh = 0.1f
+      , const unsigned int &edgeDecimationStep = 1
+      , const unsigned int &nbThreads = 1
     )
       : m_filteringAndGradientType(filteringAndGradientMethod)
       , m_gaussianKernelSize(gaussianKernelSize)
@@ -239,6 +250,8 @@ public:
       , m_recordVotingPoints(recordVotingPoints)
       , m_centerMinDist(centerMinDistThresh)
       , m_mergingRadiusDiffThresh(mergingRadiusDiffThresh)
+      , m_edgeDecimationStep(std::max<unsigned int>(edgeDecimationStep, 1))
+      , m_nbThreads(nbThreads)
     { }
 
     /**
@@ -448,6 +461,26 @@ public:
       return m_mergingRadiusDiffThresh;
     }
 
+    /**
+     * \brief Get the edge decimation step: only one edge point out of this number votes.
+     *
+     * \return unsigned int The decimation step.
+     */
+    inline unsigned int getEdgeDecimationStep() const
+    {
+      return m_edgeDecimationStep;
+    }
+
+    /**
+     * \brief Get the number of threads used for the center and radius votes.
+     *
+     * \return unsigned int The number of threads, 0 meaning all the CPU threads.
+     */
+    inline unsigned int getNbThreads() const
+    {
+      return m_nbThreads;
+    }
+
     /**
      * Create a string with all the Hough transform parameters.
      */
@@ -483,6 +516,8 @@ public:
       txt <<  "\tRecord voting points = " + (m_recordVotingPoints ? std::string("true") : std::string("false")) << "\n";
       txt <<  "\tCenters minimum distance = " << m_centerMinDist << "\n";
       txt <<  "\tRadius difference merging threshold = " << m_mergingRadiusDiffThresh << "\n";
+      txt <<  "\tEdge decimation step = " << m_edgeDecimationStep << "\n";
+      txt <<  "\tNumber of threads = " << m_nbThreads << "\n";
       return txt.str();
     }
 
@@ -611,6 +646,13 @@ public:
       if (params.m_mergingRadiusDiffThresh <= 0) {
         throw vpException(vpException::badValue, "Radius difference merging threshold must be positive.");
       }
+
+      params.m_edgeDecimationStep = j.value("edgeDecimationStep", params.m_edgeDecimationStep);
+      if (params.m_edgeDecimationStep == 0) {
+        throw vpException(vpException::badValue, "Edge decimation step must be strictly positive.");
+      }
+
+      params.m_nbThreads = j.value("nbThreads", params.m_nbThreads);
     }
 
     /**
@@ -646,7 +688,9 @@ public:
           {"circlePerfectnessThreshold", params.m_circlePerfectness},
           {"recordVotingPoints", params.m_recordVotingPoints},
           {"centerMinDistance", params.m_centerMinDist},
-          {"mergingRadiusDiffThresh", params.m_mergingRadiusDiffThresh} };
+          {"mergingRadiusDiffThresh", params.m_mergingRadiusDiffThresh},
+          {"edgeDecimationStep", params.m_edgeDecimationStep},
+          {"nbThreads", params.m_nbThreads} };
     }
 #endif
   };
@@ -1015,6 +1059,34 @@ public:
   {
     mp_mask = &mask;
   }
+
+  /**
+   * \brief Set the edge decimation step: only one edge point out of \b edgeDecimationStep, in raster order, votes
+   * for the centers and the radii, with a weight equal to \b edgeDecimationStep so that the thresholds keep the
+   * same meaning. When the voting points are recorded, only the decimated points are.
+   *
+   * \param[in] edgeDecimationStep The decimation step, 1 to use all the edge points.
+   */
+  inline void setEdgeDecimationStep(const unsigned int &edgeDecimationStep)
+  {
+    if (edgeDecimationStep == 0) {
+      throw vpException(vpException::badValue, "Edge decimation step must be strictly positive.");
+    }
+    m_algoParams.m_edgeDecimationStep = edgeDecimationStep;
+  }
+
+  /**
+   * \brief Set the number of threads used for the center votes, each thread voting in its own accumulator, and for
+   * the radius votes, the center candidates being shared between the threads.
+   * As the per-thread accumulators are summed in a different order, the centers may slightly differ from the ones
+   * detected by a single thread when several candidates have close votes.
+   *
+   * \param[in] nbThreads The number of threads, 0 to use all the CPU threads.
+   */
+  inline void setNbThreads(const unsigned int &nbThreads)
+  {
+    m_algoParams.m_nbThreads = nbThreads;
+  }
   //@}
 
   /** @name  Getters */
@@ -1226,6 +1298,19 @@ protected:
    */
   virtual void computeCircleCandidates();
 
+  /**
+   * \brief Vote for the radii of the circles centered on \b centerCandidate with the edge points, and keep the
+   * radius candidates having enough votes and a high enough probability.
+   * \param[in] centerCandidate The center candidate, as pair <row, col>.
+   * \param[out] circleCandidates The circle candidates of this center.
+   * \param[out] circleCandidatesProba The probabilities of the circle candidates.
+   * \param[out] circleCandidatesVotes The votes of the circle candidates.
+   * \param[out] votingPoints The edge-map points having voted for the circle candidates, if they are recorded.
+   */
+  void computeRadiusCandidates(const std::pair<float, float> &centerCandidate, std::vector<vpImageCircle> &circleCandidates,
+                               std::vector<float> &circleCandidatesProba, std::vector<unsigned int> &circleCandidatesVotes,
+                               std::vector<std::vector<std::pair<unsigned int, unsigned int> > > &votingPoints);
+
   /**
    * \brief For each circle candidate CiC_i, check if similar circles have also been detected and if so merges them.
    */
@@ -1262,6 +1347,10 @@ protected:
 
   // // Center candidates computation attributes
   std::vector<std::pair<unsigned int, unsigned int> > m_edgePointsList; /*!< Vector that contains the list of edge points, to make faster some parts of the algo. They are stored as pair <row, col>.*/
+  std::vector<float> m_edgePointsX; /*!< Column of each edge point of \b m_edgePointsList.*/
+  std::vector<float> m_edgePointsY; /*!< Row of each edge point of \b m_edgePointsList.*/
+  std::vector<float> m_edgePointsGx; /*!< Gradient along the x-axis at each edge point of \b m_edgePointsList.*/
+  std::vector<float> m_edgePointsGy; /*!< Gradient along the y-axis at each edge point of \b m_edgePointsList.*/
   std::vector<std::pair<float, float> > m_centerCandidatesList; /*!< Vector that contains the list of center candidates. They are stored as pair <row, col>.*/
   std::vector<int> m_centerVotes; /*!< Number of votes for the center candidates that are kept.*/
 
@@ -42,8 +42,12 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/imgproc/vpContours.h>
 
+#include <vector>
+
 #define USE_OLD_FILL_HOLE 0
 
 namespace vp
@@ -91,6 +95,16 @@ typedef enum
                               */
 } vpAutoThresholdMethod;
 
+/*!
+ * Statistics of a connected component, see connectedComponents().
+ */
+struct vpConnectedComponent
+{
+  unsigned int area;     //!< Number of pixels of the component.
+  vpRect bbox;           //!< Bounding box of the pixels, a single pixel having a size of 1 x 1.
+  vpImagePoint centroid; //!< Mean position of the pixels.
+};
+
 /*!
  * \ingroup group_imgproc_brightness
  *
@@ -169,9 +183,12 @@ VISP_EXPORT void adjust(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, double a
  * transfer function for each pixel independently but for a grid of adjacent
  * boxes of the given block size only and interpolates for locations in
  * between.
+ * \param nbThreads : Number of threads processing bands of rows, 0 to use all
+ * the CPU threads. The result does not depend on the number of threads.
  */
 VISP_EXPORT void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius = 150,
-                       int bins = 256, float slope = 3.0f, bool fast = true);
+                       int bins = 256, float slope = 3.0f, bool fast = true,
+                       unsigned int nbThreads = 1);
 
 /*!
  * \ingroup group_imgproc_brightness
@@ -199,9 +216,12 @@ VISP_EXPORT void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char>
  * transfer function for each pixel independently but for a grid of adjacent
  * boxes of the given block size only and interpolates for locations in
  * between.
+ * \param nbThreads : Number of threads processing bands of rows, 0 to use all
+ * the CPU threads. The result does not depend on the number of threads.
 */
 VISP_EXPORT void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius = 150, int bins = 256,
-                       float slope = 3.0f, bool fast = true);
+                       float slope = 3.0f, bool fast = true,
+                       unsigned int nbThreads = 1);
 
 /*!
  * \ingroup group_imgproc_histogram
@@ -467,6 +487,32 @@ VISP_EXPORT void unsharpMask(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires, fl
 VISP_EXPORT void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
                                      const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Perform connected components detection and compute the statistics of each component.
+ *
+ * Neighbor pixels with the same non zero value belong to the same component. Components
+ * are labeled from 1 in the order of their first pixel in raster order, as
+ * connectedComponents(const vpImage<unsigned char> &, vpImage<int> &, int &, const vpImageMorphology::vpConnexityType &)
+ * does.
+ *
+ * The labeling is done with a union-find in two passes over the image. With several
+ * threads, horizontal strips of the image are labeled in parallel and then merged.
+ *
+ * \param I : Input image (0 means background).
+ * \param labels : Label image that contain for each position the component label.
+ * \param nbComponents : Number of connected components.
+ * \param components : Statistics of each component, the statistics of the component labeled
+ * \e l being at index \e l - 1.
+ * \param connexity : Type of connexity.
+ * \param nbThreads : Number of threads, 0 to use all the CPU threads.
+ */
+VISP_EXPORT void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                                     std::vector<vpConnectedComponent> &components,
+                                     const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4,
+                                     unsigned int nbThreads = 1);
+
 /*!
  * \ingroup group_imgproc_morph
  *
@@ -486,8 +532,11 @@ VISP_EXPORT void fillHoles(vpImage<unsigned char> &I
  *
  * Perform the flood fill algorithm.
  *
+ * The region is filled span by span: each horizontal run of \a oldValue pixels is filled at once
+ * and only one seed per run of the neighbor rows is pushed on the stack.
+ *
  * \param I : Input image to flood fill.
- * \param seedPoint : Seed position in the image.
+ * \param seedPoint : Seed position in the image. Nothing is done if it is outside the image.
  * \param oldValue : Old value to replace.
  * \param newValue : New value to flood fill.
  * \param connexity : Type of connexity.
@@ -496,6 +545,23 @@ VISP_EXPORT void floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPo
                            const unsigned char newValue,
                            const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Perform the flood fill algorithm from several seed points, sharing the same stack of spans.
+ * The result is the same as calling floodFill(vpImage<unsigned char> &, const vpImagePoint &, const unsigned char,
+ * const unsigned char, const vpImageMorphology::vpConnexityType &) for each seed point.
+ *
+ * \param I : Input image to flood fill.
+ * \param seedPoints : Seed positions in the image. Seed points outside the image are ignored.
+ * \param oldValue : Old value to replace.
+ * \param newValue : New value to flood fill.
+ * \param connexity : Type of connexity.
+ */
+VISP_EXPORT void floodFill(vpImage<unsigned char> &I, const std::vector<vpImagePoint> &seedPoints,
+                           const unsigned char oldValue, const unsigned char newValue,
+                           const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+
 /*!
  * \ingroup group_imgproc_morph
  *
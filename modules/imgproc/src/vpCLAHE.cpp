@@ -76,13 +76,45 @@
   \brief Contrast Limited Adaptive Histogram Equalization (CLAHE).
 */
 
-#include <visp3/core/vpImageConvert.h>
+#include <thread>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
 {
 int fastRound(float value) { return (int)(value + 0.5f); }
 
+// Histogram bin of each gray level
+void createBinLut(int bins, int binLut[256])
+{
+  for (int v = 0; v < 256; v++) {
+    binLut[v] = fastRound(v / 255.0f * bins);
+  }
+}
+
+// Call func(begin, end) on consecutive ranges of [0, size) over nbThreads threads
+template <typename Func> void parallelRanges(int size, unsigned int nbThreads, Func func)
+{
+  if (nbThreads == 0) {
+    nbThreads = std::max<unsigned int>(1, std::thread::hardware_concurrency());
+  }
+  nbThreads = std::max<unsigned int>(1, std::min<unsigned int>(nbThreads, static_cast<unsigned int>(size)));
+
+  if (nbThreads == 1) {
+    func(0, size);
+    return;
+  }
+
+  std::vector<std::thread> threadpool;
+  for (unsigned int t = 0; t < nbThreads; t++) {
+    const int begin = static_cast<int>((static_cast<long long>(size) * t) / nbThreads);
+    const int end = static_cast<int>((static_cast<long long>(size) * (t + 1)) / nbThreads);
+    threadpool.emplace_back(func, begin, end);
+  }
+  for (size_t t = 0; t < threadpool.size(); t++) {
+    threadpool[t].join();
+  }
+}
+
 void clipHistogram(const std::vector<int> &hist, std::vector<int> &clippedHist, int limit)
 {
   clippedHist = hist;
@@ -115,8 +147,8 @@ void clipHistogram(const std::vector<int> &hist, std::vector<int> &clippedHist,
   } while (clippedEntries != clippedEntriesBefore);
 }
 
-void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCenter, const vpImage<unsigned char> &I,
-                     std::vector<int> &hist)
+void createHistogram(int blockRadius, int blockXCenter, int blockYCenter, const vpImage<unsigned char> &I,
+                     const int binLut[256], std::vector<int> &hist)
 {
   std::fill(hist.begin(), hist.end(), 0);
 
@@ -126,13 +158,14 @@ void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCent
   int yMax = std::min<int>((int)I.getHeight(), blockYCenter + blockRadius + 1);
 
   for (int y = yMin; y < yMax; ++y) {
+    const unsigned char *row = I[y];
     for (int x = xMin; x < xMax; ++x) {
-      ++hist[fastRound(I[y][x] / 255.0f * bins)];
+      ++hist[binLut[row[x]]];
     }
   }
 }
 
-std::vector<float> createTransfer(const std::vector<int> &hist, int limit, std::vector<int> &cdfs)
+void createTransfer(const std::vector<int> &hist, int limit, std::vector<int> &cdfs, float *transfer)
 {
   clipHistogram(hist, cdfs, limit);
   int hMin = (int)hist.size() - 1;
@@ -151,12 +184,9 @@ std::vector<float> createTransfer(const std::vector<int> &hist, int limit, std::
   int cdfMin = cdfs[hMin];
   int cdfMax = cdfs[hist.size() - 1];
 
-  std::vector<float> transfer(hist.size());
-  for (int i = 0; i < (int)transfer.size(); ++i) {
+  for (int i = 0; i < (int)hist.size(); ++i) {
     transfer[i] = (cdfs[i] - cdfMin) / (float)(cdfMax - cdfMin);
   }
-
-  return transfer;
 }
 
 float transferValue(int v, std::vector<int> &clippedHist)
@@ -189,149 +219,98 @@ float transferValue(int v, const std::vector<int> &hist, std::vector<int> &clipp
 
   return transferValue(v, clippedHist);
 }
-} // namespace
 
-namespace vp
+// Centers of the blocks along one dimension of the image for the fast version
+std::vector<int> blockCenters(int length, int blockRadius)
 {
-void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope, bool fast)
-{
-  if (blockRadius < 0) {
-    std::cerr << "Error: blockRadius < 0!" << std::endl;
-    return;
-  }
-
-  if (bins < 0 || bins > 256) {
-    std::cerr << "Error: (bins < 0 || bins > 256)!" << std::endl;
-    return;
-  }
-
-  if ((unsigned int)(2 * blockRadius + 1) > I1.getWidth() || (unsigned int)(2 * blockRadius + 1) > I1.getHeight()) {
-    std::cerr << "Error: (unsigned int) (2*blockRadius+1) > I1.getWidth() || "
-      "(unsigned int) (2*blockRadius+1) > I1.getHeight()!"
-      << std::endl;
-    return;
-  }
-
-  I2.resize(I1.getHeight(), I1.getWidth());
-
-  if (fast) {
-    int blockSize = 2 * blockRadius + 1;
-    int limit = (int)(slope * blockSize * blockSize / bins + 0.5);
-
-    /* div */
-    int nc = I1.getWidth() / blockSize;
-    int nr = I1.getHeight() / blockSize;
-
-    /* % */
-    int cm = I1.getWidth() - nc * blockSize;
-    std::vector<int> cs;
-
-    switch (cm) {
-    case 0:
-      cs.resize(nc);
-      for (int i = 0; i < nc; ++i) {
-        cs[i] = i * blockSize + blockRadius + 1;
-      }
-      break;
-
-    case 1:
-      cs.resize(nc + 1);
-      for (int i = 0; i < nc; ++i) {
-        cs[i] = i * blockSize + blockRadius + 1;
-      }
-      cs[nc] = I1.getWidth() - blockRadius - 1;
-      break;
-
-    default:
-      cs.resize(nc + 2);
-      cs[0] = blockRadius + 1;
-      for (int i = 0; i < nc; ++i) {
-        cs[i + 1] = i * blockSize + blockRadius + 1 + cm / 2;
-      }
-      cs[nc + 1] = I1.getWidth() - blockRadius - 1;
+  int blockSize = 2 * blockRadius + 1;
+  /* div */
+  int n = length / blockSize;
+  /* % */
+  int m = length - n * blockSize;
+  std::vector<int> centers;
+
+  switch (m) {
+  case 0:
+    centers.resize((size_t)n);
+    for (int i = 0; i < n; ++i) {
+      centers[i] = i * blockSize + blockRadius + 1;
     }
+    break;
 
-    int rm = I1.getHeight() - nr * blockSize;
-    std::vector<int> rs;
+  case 1:
+    centers.resize((size_t)(n + 1));
+    for (int i = 0; i < n; ++i) {
+      centers[i] = i * blockSize + blockRadius + 1;
+    }
+    centers[n] = length - blockRadius - 1;
+    break;
+
+  default:
+    centers.resize((size_t)(n + 2));
+    centers[0] = blockRadius + 1;
+    for (int i = 0; i < n; ++i) {
+      centers[i + 1] = i * blockSize + blockRadius + 1 + m / 2;
+    }
+    centers[n + 1] = length - blockRadius - 1;
+  }
 
-    switch (rm) {
-    case 0:
-      rs.resize((size_t)nr);
-      for (int i = 0; i < nr; ++i) {
-        rs[i] = i * blockSize + blockRadius + 1;
-      }
-      break;
+  return centers;
+}
 
-    case 1:
-      rs.resize((size_t)(nr + 1));
-      for (int i = 0; i < nr; ++i) {
-        rs[i] = i * blockSize + blockRadius + 1;
-      }
-      rs[nr] = I1.getHeight() - blockRadius - 1;
-      break;
-
-    default:
-      rs.resize((size_t)(nr + 2));
-      rs[0] = blockRadius + 1;
-      for (int i = 0; i < nr; ++i) {
-        rs[i + 1] = i * blockSize + blockRadius + 1 + rm / 2;
-      }
-      rs[nr + 1] = I1.getHeight() - blockRadius - 1;
+void claheFast(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope,
+               unsigned int nbThreads)
+{
+  int blockSize = 2 * blockRadius + 1;
+  int limit = (int)(slope * blockSize * blockSize / bins + 0.5);
+  int binLut[256];
+  createBinLut(bins, binLut);
+
+  const std::vector<int> cs = blockCenters((int)I1.getWidth(), blockRadius);
+  const std::vector<int> rs = blockCenters((int)I1.getHeight(), blockRadius);
+  const int nbCols = (int)cs.size();
+  const size_t histSize = (size_t)(bins + 1);
+
+  // Transfer function of each block, computed once
+  std::vector<float> transfers(rs.size() * cs.size() * histSize);
+  parallelRanges((int)(rs.size() * cs.size()), nbThreads, [&](int begin, int end) {
+    std::vector<int> hist(histSize), cdfs(histSize);
+    for (int k = begin; k < end; k++) {
+      createHistogram(blockRadius, cs[k % nbCols], rs[k / nbCols], I1, binLut, hist);
+      createTransfer(hist, limit, cdfs, &transfers[k * histSize]);
     }
+  });
 
-    std::vector<int> hist((size_t)(bins + 1));
-    std::vector<int> cdfs((size_t)(bins + 1));
-    std::vector<float> tl;
-    std::vector<float> tr;
-    std::vector<float> br;
-    std::vector<float> bl;
-
+  // Each pixel interpolates the transfer functions of the four nearest blocks
+  parallelRanges((int)I1.getHeight(), nbThreads, [&](int yBegin, int yEnd) {
     for (int r = 0; r <= (int)rs.size(); ++r) {
       int r0 = std::max<int>(0, r - 1);
       int r1 = std::min<int>((int)rs.size() - 1, r);
       int dr = rs[r1] - rs[r0];
 
-      createHistogram(blockRadius, bins, cs[0], rs[r0], I1, hist);
-      tr = createTransfer(hist, limit, cdfs);
-      if (r0 == r1) {
-        br = tr;
-      }
-      else {
-        createHistogram(blockRadius, bins, cs[0], rs[r1], I1, hist);
-        br = createTransfer(hist, limit, cdfs);
-      }
-
-      int yMin = (r == 0 ? 0 : rs[r0]);
-      int yMax = (r < (int)rs.size() ? rs[r1] : I1.getHeight());
+      int yMin = std::max<int>(yBegin, r == 0 ? 0 : rs[r0]);
+      int yMax = std::min<int>(yEnd, r < (int)rs.size() ? rs[r1] : (int)I1.getHeight());
 
       for (int c = 0; c <= (int)cs.size(); ++c) {
         int c0 = std::max<int>(0, c - 1);
         int c1 = std::min<int>((int)cs.size() - 1, c);
         int dc = cs[c1] - cs[c0];
 
-        tl = tr;
-        bl = br;
-
-        if (c0 != c1) {
-          createHistogram(blockRadius, bins, cs[c1], rs[r0], I1, hist);
-          tr = createTransfer(hist, limit, cdfs);
-          if (r0 == r1) {
-            br = tr;
-          }
-          else {
-            createHistogram(blockRadius, bins, cs[c1], rs[r1], I1, hist);
-            br = createTransfer(hist, limit, cdfs);
-          }
-        }
+        const float *tl = &transfers[(r0 * nbCols + c0) * histSize];
+        const float *tr = &transfers[(r0 * nbCols + c1) * histSize];
+        const float *bl = &transfers[(r1 * nbCols + c0) * histSize];
+        const float *br = &transfers[(r1 * nbCols + c1) * histSize];
 
         int xMin = (c == 0 ? 0 : cs[c0]);
-        int xMax = (c < (int)cs.size() ? cs[c1] : I1.getWidth());
+        int xMax = (c < (int)cs.size() ? cs[c1] : (int)I1.getWidth());
         for (int y = yMin; y < yMax; ++y) {
           float wy = (float)(rs[r1] - y) / dr;
+          const unsigned char *src = I1[y];
+          unsigned char *dst = I2[y];
 
           for (int x = xMin; x < xMax; ++x) {
             float wx = (float)(cs[c1] - x) / dc;
-            int v = fastRound(I1[y][x] / 255.0f * bins);
+            int v = binLut[src[x]];
             float t00 = tl[v];
             float t01 = tr[v];
             float t10 = bl[v];
@@ -348,66 +327,61 @@ void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blo
             }
 
             float t = (r0 == r1) ? t0 : wy * t0 + (1.0f - wy) * t1;
-            I2[y][x] = std::max<unsigned char>(0, std::min<unsigned char>(255, fastRound(t * 255.0f)));
+            dst[x] = static_cast<unsigned char>(fastRound(t * 255.0f));
           }
         }
       }
     }
-  }
-  else {
-    std::vector<int> hist(bins + 1), prev_hist(bins + 1);
-    std::vector<int> clippedHist(bins + 1);
-
-    bool first = true;
-    int xMin0 = 0;
-    int xMax0 = std::min<int>((int)I1.getWidth(), blockRadius);
+  });
+}
 
-    for (int y = 0; y < (int)I1.getHeight(); y++) {
+void claheAccurate(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins,
+                   float slope, unsigned int nbThreads)
+{
+  int binLut[256];
+  createBinLut(bins, binLut);
+  const int height = (int)I1.getHeight();
+  const int width = (int)I1.getWidth();
+
+  // Each thread slides its own histograms over a band of rows
+  parallelRanges(height, nbThreads, [&](int yBegin, int yEnd) {
+    std::vector<int> rowHist((size_t)(bins + 1), 0), hist((size_t)(bins + 1));
+    std::vector<int> clippedHist((size_t)(bins + 1));
+    const int xMax0 = std::min<int>(width, blockRadius);
+
+    for (int y = yBegin; y < yEnd; y++) {
       int yMin = std::max<int>(0, y - (int)blockRadius);
-      int yMax = std::min<int>((int)I1.getHeight(), y + blockRadius + 1);
+      int yMax = std::min<int>(height, y + blockRadius + 1);
       int h = yMax - yMin;
 
-#if 0
-      std::fill(hist.begin(), hist.end(), 0);
-      // Compute histogram for the current block
-      for (int yi = yMin; yi < yMax; yi++) {
-        for (int xi = xMin0; xi < xMax0; xi++) {
-          ++hist[fastRound(I1[yi][xi] / 255.0f * bins)];
-        }
-      }
-#else
-      if (first) {
-        first = false;
-        // Compute histogram for the block at (0,0)
+      if (y == yBegin) {
+        // Compute histogram for the block at (0, yBegin)
         for (int yi = yMin; yi < yMax; yi++) {
-          for (int xi = xMin0; xi < xMax0; xi++) {
-            ++hist[fastRound(I1[yi][xi] / 255.0f * bins)];
+          for (int xi = 0; xi < xMax0; xi++) {
+            ++rowHist[binLut[I1[yi][xi]]];
           }
         }
       }
       else {
-        hist = prev_hist;
-
         if (yMin > 0) {
-          int yMin1 = yMin - 1;
           // Sliding histogram, remove top
-          for (int xi = xMin0; xi < xMax0; xi++) {
-            --hist[fastRound(I1[yMin1][xi] / 255.0f * bins)];
+          const unsigned char *top = I1[yMin - 1];
+          for (int xi = 0; xi < xMax0; xi++) {
+            --rowHist[binLut[top[xi]]];
           }
         }
 
-        if (y + blockRadius < (int)I1.getHeight()) {
-          int yMax1 = yMax - 1;
+        if (y + blockRadius < height) {
           // Sliding histogram, add bottom
-          for (int xi = xMin0; xi < xMax0; xi++) {
-            ++hist[fastRound(I1[yMax1][xi] / 255.0f * bins)];
+          const unsigned char *bottom = I1[yMax - 1];
+          for (int xi = 0; xi < xMax0; xi++) {
+            ++rowHist[binLut[bottom[xi]]];
           }
         }
       }
-      prev_hist = hist;
-#endif
+      hist = rowHist;
 
-      for (int x = 0; x < (int)I1.getWidth(); x++) {
+      for (int x = 0; x < width; x++) {
         int xMin = std::max<int>(0, x - (int)blockRadius);
         int xMax = x + blockRadius + 1;
 
@@ -415,65 +389,93 @@ void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blo
           int xMin1 = xMin - 1;
           // Sliding histogram, remove left
           for (int yi = yMin; yi < yMax; yi++) {
-            --hist[fastRound(I1[yi][xMin1] / 255.0f * bins)];
+            --hist[binLut[I1[yi][xMin1]]];
           }
         }
 
-        if (xMax <= (int)I1.getWidth()) {
+        if (xMax <= width) {
           int xMax1 = xMax - 1;
           // Sliding histogram, add right
           for (int yi = yMin; yi < yMax; yi++) {
-            ++hist[fastRound(I1[yi][xMax1] / 255.0f * bins)];
+            ++hist[binLut[I1[yi][xMax1]]];
           }
         }
 
-        int v = fastRound(I1[y][x] / 255.0f * bins);
-        int w = std::min<int>((int)I1.getWidth(), xMax) - xMin;
+        int v = binLut[I1[y][x]];
+        int w = std::min<int>(width, xMax) - xMin;
         int n = h * w;
         int limit = (int)(slope * n / bins + 0.5f);
-        I2[y][x] = fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f);
+        I2[y][x] = static_cast<unsigned char>(fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f));
       }
     }
-  }
+  });
 }
+} // namespace
 
-void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius, int bins, float slope, bool fast)
+namespace vp
 {
-  // Split
-  vpImage<unsigned char> pR(I1.getHeight(), I1.getWidth());
-  vpImage<unsigned char> pG(I1.getHeight(), I1.getWidth());
-  vpImage<unsigned char> pB(I1.getHeight(), I1.getWidth());
-  vpImage<unsigned char> pa(I1.getHeight(), I1.getWidth());
+void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope,
+           bool fast, unsigned int nbThreads)
+{
+  if (blockRadius < 0) {
+    std::cerr << "Error: blockRadius < 0!" << std::endl;
+    return;
+  }
 
-  vpImageConvert::split(I1, &pR, &pG, &pB, &pa);
+  if (bins < 0 || bins > 256) {
+    std::cerr << "Error: (bins < 0 || bins > 256)!" << std::endl;
+    return;
+  }
 
-  // Apply CLAHE independently on RGB channels
-  vpImage<unsigned char> resR, resG, resB;
-  clahe(pR, resR, blockRadius, bins, slope, fast);
-  clahe(pG, resG, blockRadius, bins, slope, fast);
-  clahe(pB, resB, blockRadius, bins, slope, fast);
+  if ((unsigned int)(2 * blockRadius + 1) > I1.getWidth() || (unsigned int)(2 * blockRadius + 1) > I1.getHeight()) {
+    std::cerr << "Error: (unsigned int) (2*blockRadius+1) > I1.getWidth() || "
+      "(unsigned int) (2*blockRadius+1) > I1.getHeight()!"
+      << std::endl;
+    return;
+  }
 
   I2.resize(I1.getHeight(), I1.getWidth());
-  unsigned int size = I2.getWidth() * I2.getHeight();
-  unsigned char *ptrStart = (unsigned char *)I2.bitmap;
-  unsigned char *ptrEnd = ptrStart + size * 4;
-  unsigned char *ptrCurrent = ptrStart;
 
-  unsigned int cpt = 0;
-  while (ptrCurrent != ptrEnd) {
-    *ptrCurrent = resR.bitmap[cpt];
-    ++ptrCurrent;
+  if (fast) {
+    claheFast(I1, I2, blockRadius, bins, slope, nbThreads);
+  }
+  else {
+    claheAccurate(I1, I2, blockRadius, bins, slope, nbThreads);
+  }
+}
 
-    *ptrCurrent = resG.bitmap[cpt];
-    ++ptrCurrent;
+void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius, int bins, float slope, bool fast,
+           unsigned int nbThreads)
+{
+  // Split
+  const unsigned int size = I1.getSize();
+  vpImage<unsigned char> channels[3];
+  for (int k = 0; k < 3; k++) {
+    channels[k].resize(I1.getHeight(), I1.getWidth());
+  }
+  for (unsigned int i = 0; i < size; i++) {
+    channels[0].bitmap[i] = I1.bitmap[i].R;
+    channels[1].bitmap[i] = I1.bitmap[i].G;
+    channels[2].bitmap[i] = I1.bitmap[i].B;
+  }
 
-    *ptrCurrent = resB.bitmap[cpt];
-    ++ptrCurrent;
+  // Apply CLAHE independently on RGB channels
+  vpImage<unsigned char> res[3];
+  for (int k = 0; k < 3; k++) {
+    clahe(channels[k], res[k], blockRadius, bins, slope, fast, nbThreads);
+  }
 
-    *ptrCurrent = pa.bitmap[cpt];
-    ++ptrCurrent;
+  if (res[0].getSize() != size) {
+    return;
+  }
 
-    cpt++;
+  // Merge, I2 may be I1
+  I2.resize(I1.getHeight(), I1.getWidth());
+  for (unsigned int i = 0; i < size; i++) {
+    I2.bitmap[i].A = I1.bitmap[i].A;
+    I2.bitmap[i].R = res[0].bitmap[i];
+    I2.bitmap[i].G = res[1].bitmap[i];
+    I2.bitmap[i].B = res[2].bitmap[i];
   }
 }
 };
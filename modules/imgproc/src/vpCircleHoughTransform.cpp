@@ -33,6 +33,8 @@
 
 #include <visp3/imgproc/vpCircleHoughTransform.h>
 
+#include <thread>
+
 #if (VISP_CXX_STANDARD == VISP_CXX_STANDARD_98)
 namespace
 {
@@ -42,26 +44,6 @@ bool hasBetterProba(std::pair<size_t, float> a, std::pair<size_t, float> b)
   return (a.second > b.second);
 }
 
-void updateAccumulator(const float &x_orig, const float &y_orig,
-                       const int &x, const int &y,
-                       const int &offsetX, const int &offsetY,
-                       const int &nbCols, const int &nbRows,
-                       vpImage<float> &accum, bool &hasToStop)
-{
-  if (((x - offsetX) < 0) ||
-      ((x - offsetX) >= nbCols) ||
-      ((y - offsetY) < 0) ||
-      ((y - offsetY) >= nbRows)
-      ) {
-    hasToStop = true;
-  }
-  else {
-    float dx = (x_orig - static_cast<float>(x));
-    float dy = (y_orig - static_cast<float>(y));
-    accum[y - offsetY][x - offsetX] += std::abs(dx) + std::abs(dy);
-  }
-}
-
 bool sortingCenters(const std::pair<std::pair<float, float>, float> &position_vote_a,
                     const std::pair<std::pair<float, float>, float> &position_vote_b)
 {
@@ -91,6 +73,149 @@ scaleFilter(vpArray2D<float> &filter, const float &scale)
 };
 #endif
 
+namespace
+{
+// Area of the image plane covered by the center accumulator
+struct vpCenterAccumulatorArea
+{
+  float m_minX;
+  float m_maxX;
+  float m_minY;
+  float m_maxY;
+  int m_offsetX;
+  int m_offsetY;
+  int m_width;
+  int m_height;
+};
+
+// Vote of the edge point (x, y), whose unit gradient is (sx, sy), for the centers located along both directions of
+// the gradient between minRadius and maxRadius. Each vote is spread over the two nearest cells of the accumulator.
+void voteForCenters(float x, float y, float sx, float sy, float minRadius, float maxRadius,
+                    const vpCenterAccumulatorArea &area, float weight, vpImage<float> &accum)
+{
+  const int nbDirections = 2;
+  for (int k1 = 0; k1 < nbDirections; ++k1) {
+    bool hasToStopLoop = false;
+    int x_low_prev = std::numeric_limits<int>::max(), y_low_prev, y_high_prev;
+    int x_high_prev = (y_low_prev = (y_high_prev = x_low_prev));
+
+    float rstart = minRadius, rstop = maxRadius;
+    float min_minus_c = area.m_minX - x;
+    float min_minus_r = area.m_minY - y;
+    float max_minus_c = area.m_maxX - x;
+    float max_minus_r = area.m_maxY - y;
+    if (sx > 0) {
+      rstart = std::max<float>(min_minus_c / sx, minRadius);
+      rstop = std::min<float>(max_minus_c / sx, maxRadius);
+    }
+    else if (sx < 0) {
+      rstart = std::max<float>(max_minus_c / sx, minRadius);
+      rstop = std::min<float>(min_minus_c / sx, maxRadius);
+    }
+
+    if (sy > 0) {
+      rstart = std::max<float>(min_minus_r / sy, rstart);
+      rstop = std::min<float>(max_minus_r / sy, rstop);
+    }
+    else if (sy < 0) {
+      rstart = std::max<float>(max_minus_r / sy, rstart);
+      rstop = std::min<float>(min_minus_r / sy, rstop);
+    }
+
+    float deltar_x = 1.f / std::abs(sx);
+    float deltar_y = 1.f / std::abs(sy);
+    float deltar = std::min<float>(deltar_x, deltar_y);
+
+    float rad = rstart;
+    while ((rad <= rstop) && (!hasToStopLoop)) {
+      float x1 = x + (rad * sx);
+      float y1 = y + (rad * sy);
+      rad += deltar;
+
+      if ((x1 < area.m_minX) || (y1 < area.m_minY) || (x1 > area.m_maxX) || (y1 > area.m_maxY)) {
+        continue; // It means that the center is outside the search region.
+      }
+
+      int x_low, x_high;
+      int y_low, y_high;
+
+      if (x1 > 0.) {
+        x_low = static_cast<int>(std::floor(x1));
+        x_high = static_cast<int>(std::ceil(x1));
+      }
+      else {
+        x_low = -(static_cast<int>(std::ceil(-x1)));
+        x_high = -(static_cast<int>(std::floor(-x1)));
+      }
+
+      if (y1 > 0.) {
+        y_low = static_cast<int>(std::floor(y1));
+        y_high = static_cast<int>(std::ceil(y1));
+      }
+      else {
+        y_low = -(static_cast<int>(std::ceil(-1. * y1)));
+        y_high = -(static_cast<int>(std::floor(-1. * y1)));
+      }
+
+      if ((x_low_prev == x_low) && (x_high_prev == x_high) && (y_low_prev == y_low) && (y_high_prev == y_high)) {
+        // Avoid duplicated votes to the same center candidate
+        continue;
+      }
+      x_low_prev = x_low;
+      x_high_prev = x_high;
+      y_low_prev = y_low;
+      y_high_prev = y_high;
+
+      const int xs[2] = { x_low, x_high };
+      const int ys[2] = { y_low, y_high };
+      for (int k2 = 0; k2 < 2; ++k2) {
+        const int col = xs[k2] - area.m_offsetX;
+        const int row = ys[k2] - area.m_offsetY;
+        if ((col < 0) || (col >= area.m_width) || (row < 0) || (row >= area.m_height)) {
+          hasToStopLoop = true;
+        }
+        else {
+          float dx = (x1 - static_cast<float>(xs[k2]));
+          float dy = (y1 - static_cast<float>(ys[k2]));
+          accum[row][col] += weight * (std::abs(dx) + std::abs(dy));
+        }
+      }
+    }
+
+    sx = -sx;
+    sy = -sy;
+  }
+}
+
+// Number of threads actually used to process size items
+unsigned int getNbThreads(unsigned int nbThreads, int size)
+{
+  if (nbThreads == 0) {
+    nbThreads = std::max<unsigned int>(1, std::thread::hardware_concurrency());
+  }
+  return std::max<unsigned int>(1, std::min<unsigned int>(nbThreads, static_cast<unsigned int>(std::max<int>(size, 1))));
+}
+
+// Call func(threadId, begin, end) on consecutive ranges of [0, size) over nbThreads threads
+template <typename Func> void parallelRanges(int size, unsigned int nbThreads, Func func)
+{
+  if (nbThreads <= 1) {
+    func(0u, 0, size);
+    return;
+  }
+
+  std::vector<std::thread> threadpool;
+  for (unsigned int t = 0; t < nbThreads; t++) {
+    const int begin = static_cast<int>((static_cast<long long>(size) * t) / nbThreads);
+    const int end = static_cast<int>((static_cast<long long>(size) * (t + 1)) / nbThreads);
+    threadpool.emplace_back(func, t, begin, end);
+  }
+  for (size_t t = 0; t < threadpool.size(); t++) {
+    threadpool[t].join();
+  }
+}
+} // namespace
+
 vpCircleHoughTransform::vpCircleHoughTransform()
   : m_algoParams()
   , mp_mask(nullptr)
@@ -294,8 +419,15 @@ vpCircleHoughTransform::detect(const vpImage<unsigned char> &I)
   m_circleCandidates.clear();
   m_circleCandidatesVotes.clear();
   m_circleCandidatesProbabilities.clear();
+  m_edgePointsX.clear();
+  m_edgePointsY.clear();
+  m_edgePointsGx.clear();
+  m_edgePointsGy.clear();
+  m_circleCandidatesVotingPoints.clear();
   m_finalCircles.clear();
   m_finalCircleVotes.clear();
+  m_finalCirclesProbabilities.clear();
+  m_finalCirclesVotingPoints.clear();
 
   // Ensuring that the difference between the max and min radii is big enough to take into account
   // the pixelization of the image
@@ -578,155 +710,74 @@ vpCircleHoughTransform::computeCenterCandidates()
     throw(vpException(vpException::dimensionError, errMsg));
   }
 
-  vpImage<float> centersAccum(accumulatorHeight, accumulatorWidth + 1, 0.); /*!< Votes for the center candidates.*/
-
-  const int nbDirections = 2;
+  // Edge points having a non-null gradient, stored in contiguous arrays for the votes. Only one edge point out of
+  // m_edgeDecimationStep is kept, in raster order, and it votes for the ones that were skipped
+  const unsigned int decimationStep = std::max<unsigned int>(m_algoParams.m_edgeDecimationStep, 1);
+  unsigned int nbEdgePointsSeen = 0;
   for (unsigned int r = 0; r < nbRows; ++r) {
     for (unsigned int c = 0; c < nbCols; ++c) {
       if (m_edgeMap[r][c] == vpCircleHoughTransform::edgeMapOn) {
-        // Voting for points in both direction of the gradient
-        // Step from min_radius to max_radius in both directions of the gradient
         float mag = std::sqrt((m_dIx[r][c] * m_dIx[r][c]) + (m_dIy[r][c] * m_dIy[r][c]));
-
-        float sx = 0.f, sy = 0.f;
-        if (std::abs(mag) >= std::numeric_limits<float>::epsilon()) {
-          sx = m_dIx[r][c] / mag;
-          sy = m_dIy[r][c] / mag;
+        if (std::abs(mag) < std::numeric_limits<float>::epsilon()) {
+          continue;
         }
-        else {
+        if (((nbEdgePointsSeen++) % decimationStep) != 0) {
           continue;
         }
-
-        // Saving the edge point for further use
         m_edgePointsList.push_back(std::pair<unsigned int, unsigned int>(r, c));
+        m_edgePointsX.push_back(static_cast<float>(c));
+        m_edgePointsY.push_back(static_cast<float>(r));
+        m_edgePointsGx.push_back(m_dIx[r][c]);
+        m_edgePointsGy.push_back(m_dIy[r][c]);
+      }
+    }
+  }
 
-        float float_minRad = static_cast<float>(m_algoParams.m_minRadius);
-        float float_maxRad = static_cast<float>(m_algoParams.m_maxRadius);
-
-        for (int k1 = 0; k1 < nbDirections; ++k1) {
-          bool hasToStopLoop = false;
-          int x_low_prev = std::numeric_limits<int>::max(), y_low_prev, y_high_prev;
-          int x_high_prev = (y_low_prev = (y_high_prev = x_low_prev));
-
-          float rstart = float_minRad, rstop = float_maxRad;
-          float min_minus_c = minimumXpositionFloat - static_cast<float>(c);
-          float min_minus_r = minimumYpositionFloat - static_cast<float>(r);
-          float max_minus_c = maximumXpositionFloat - static_cast<float>(c);
-          float max_minus_r = maximumYpositionFloat - static_cast<float>(r);
-          if (sx > 0) {
-            float rmin = min_minus_c / sx;
-            rstart = std::max<float>(rmin, float_minRad);
-            float rmax = max_minus_c / sx;
-            rstop = std::min<float>(rmax, float_maxRad);
-          }
-          else if (sx < 0) {
-            float rmin = max_minus_c / sx;
-            rstart = std::max<float>(rmin, float_minRad);
-            float rmax = min_minus_c / sx;
-            rstop = std::min<float>(rmax, float_maxRad);
-          }
-
-          if (sy > 0) {
-            float rmin = min_minus_r / sy;
-            rstart = std::max<float>(rmin, rstart);
-            float rmax = max_minus_r / sy;
-            rstop = std::min<float>(rmax, rstop);
-          }
-          else if (sy < 0) {
-            float rmin = max_minus_r / sy;
-            rstart = std::max<float>(rmin, rstart);
-            float rmax = min_minus_r / sy;
-            rstop = std::min<float>(rmax, rstop);
-          }
-
-          float deltar_x = 1.f / std::abs(sx);
-          float deltar_y = 1.f / std::abs(sy);
-          float deltar = std::min<float>(deltar_x, deltar_y);
-
-          float rad = rstart;
-          while ((rad <= rstop) && (!hasToStopLoop)) {
-            float x1 = static_cast<float>(c) + (rad * sx);
-            float y1 = static_cast<float>(r) + (rad * sy);
-            rad += deltar; // Update rad that is not used below not to forget it
-
-            if ((x1 < minimumXpositionFloat) || (y1 < minimumYpositionFloat)
-                || (x1 > maximumXpositionFloat) || (y1 > maximumYpositionFloat)) {
-              continue; // It means that the center is outside the search region.
-            }
-
-            int x_low, x_high;
-            int y_low, y_high;
-
-            if (x1 > 0.) {
-              x_low = static_cast<int>(std::floor(x1));
-              x_high = static_cast<int>(std::ceil(x1));
-            }
-            else {
-              x_low = -(static_cast<int>(std::ceil(-x1)));
-              x_high = -(static_cast<int>(std::floor(-x1)));
-            }
-
-            if (y1 > 0.) {
-              y_low = static_cast<int>(std::floor(y1));
-              y_high = static_cast<int>(std::ceil(y1));
-            }
-            else {
-              y_low = -(static_cast<int>(std::ceil(-1. * y1)));
-              y_high = -(static_cast<int>(std::floor(-1. * y1)));
-            }
-
-            if ((x_low_prev == x_low) && (x_high_prev == x_high)
-                && (y_low_prev == y_low) && (y_high_prev == y_high)) {
-              // Avoid duplicated votes to the same center candidate
-              continue;
-            }
-            else {
-              x_low_prev = x_low;
-              x_high_prev = x_high;
-              y_low_prev = y_low;
-              y_high_prev = y_high;
-            }
-
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-            auto updateAccumulator =
-              [](const float &x_orig, const float &y_orig,
-                 const int &x, const int &y,
-                 const int &offsetX, const int &offsetY,
-                 const int &nbCols, const int &nbRows,
-                 vpImage<float> &accum, bool &hasToStop) {
-                   if (((x - offsetX) < 0) ||
-                       ((x - offsetX) >= nbCols) ||
-                       ((y - offsetY) < 0) ||
-                       ((y - offsetY) >= nbRows)
-                       ) {
-                     hasToStop = true;
-                   }
-                   else {
-                     float dx = (x_orig - static_cast<float>(x));
-                     float dy = (y_orig - static_cast<float>(y));
-                     accum[y - offsetY][x - offsetX] += std::abs(dx) + std::abs(dy);
-                   }
-              };
-#endif
-
-            updateAccumulator(x1, y1, x_low, y_low,
-                              offsetX, offsetY,
-                              accumulatorWidth, accumulatorHeight,
-                              centersAccum, hasToStopLoop
-            );
-
-            updateAccumulator(x1, y1, x_high, y_high,
-                              offsetX, offsetY,
-                              accumulatorWidth, accumulatorHeight,
-                              centersAccum, hasToStopLoop
-            );
+  vpCenterAccumulatorArea area;
+  area.m_minX = minimumXpositionFloat;
+  area.m_maxX = maximumXpositionFloat;
+  area.m_minY = minimumYpositionFloat;
+  area.m_maxY = maximumYpositionFloat;
+  area.m_offsetX = offsetX;
+  area.m_offsetY = offsetY;
+  area.m_width = accumulatorWidth;
+  area.m_height = accumulatorHeight;
+
+  // Voting for points in both direction of the gradient, each thread voting in its own accumulator
+  vpImage<float> centersAccum(accumulatorHeight, accumulatorWidth + 1, 0.); /*!< Votes for the center candidates.*/
+  const int nbEdgePoints = static_cast<int>(m_edgePointsX.size());
+  const unsigned int nbThreads = getNbThreads(m_algoParams.m_nbThreads, nbEdgePoints);
+  std::vector<vpImage<float> > threadAccums(nbThreads - 1);
+  const float float_minRad = static_cast<float>(m_algoParams.m_minRadius);
+  const float float_maxRad = static_cast<float>(m_algoParams.m_maxRadius);
+  const float voteWeight = static_cast<float>(decimationStep);
+  parallelRanges(nbEdgePoints, nbThreads, [&](unsigned int threadId, int begin, int end) {
+    vpImage<float> &accum = (threadId == 0) ? centersAccum : threadAccums[threadId - 1];
+    if (threadId > 0) {
+      accum.resize(centersAccum.getHeight(), centersAccum.getWidth(), 0.f);
+    }
+    for (int e = begin; e < end; ++e) {
+      const float gx = m_edgePointsGx[e], gy = m_edgePointsGy[e];
+      const float mag = std::sqrt((gx * gx) + (gy * gy));
+      voteForCenters(m_edgePointsX[e], m_edgePointsY[e], gx / mag, gy / mag, float_minRad, float_maxRad, area,
+                     voteWeight, accum);
+    }
+  });
+
+  // Reduction of the accumulators, by bands of rows
+  if (!threadAccums.empty()) {
+    parallelRanges(static_cast<int>(centersAccum.getHeight()), nbThreads, [&](unsigned int, int begin, int end) {
+      const unsigned int accumCols = centersAccum.getWidth();
+      for (size_t t = 0; t < threadAccums.size(); ++t) {
+        for (int y = begin; y < end; ++y) {
+          float *dst = centersAccum[y];
+          const float *src = threadAccums[t][y];
+          for (unsigned int x = 0; x < accumCols; ++x) {
+            dst[x] += src[x];
           }
-
-          sx = -sx;
-          sy = -sy;
         }
       }
-    }
+    });
   }
 
   // Use dilatation with large kernel in order to determine the
@@ -870,205 +921,196 @@ vpCircleHoughTransform::computeCenterCandidates()
 void
 vpCircleHoughTransform::computeCircleCandidates()
 {
-  size_t nbCenterCandidates = m_centerCandidatesList.size();
+  // The center candidates are independent, they are shared between the threads and their results are then gathered
+  // in the order of the candidates
+  const int nbCenterCandidates = static_cast<int>(m_centerCandidatesList.size());
+  std::vector<std::vector<vpImageCircle> > circleCandidates(nbCenterCandidates);
+  std::vector<std::vector<float> > circleCandidatesProba(nbCenterCandidates);
+  std::vector<std::vector<unsigned int> > circleCandidatesVotes(nbCenterCandidates);
+  std::vector<std::vector<std::vector<std::pair<unsigned int, unsigned int> > > > votingPoints(nbCenterCandidates);
+  const unsigned int nbThreads = getNbThreads(m_algoParams.m_nbThreads, nbCenterCandidates);
+  parallelRanges(nbCenterCandidates, nbThreads, [&](unsigned int, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      computeRadiusCandidates(m_centerCandidatesList[i], circleCandidates[i], circleCandidatesProba[i],
+                              circleCandidatesVotes[i], votingPoints[i]);
+    }
+  });
+
+  for (int i = 0; i < nbCenterCandidates; ++i) {
+    m_circleCandidates.insert(m_circleCandidates.end(), circleCandidates[i].begin(), circleCandidates[i].end());
+    m_circleCandidatesProbabilities.insert(m_circleCandidatesProbabilities.end(), circleCandidatesProba[i].begin(),
+                                           circleCandidatesProba[i].end());
+    m_circleCandidatesVotes.insert(m_circleCandidatesVotes.end(), circleCandidatesVotes[i].begin(),
+                                   circleCandidatesVotes[i].end());
+    if (m_algoParams.m_recordVotingPoints) {
+      m_circleCandidatesVotingPoints.insert(m_circleCandidatesVotingPoints.end(), votingPoints[i].begin(),
+                                            votingPoints[i].end());
+    }
+  }
+}
+
+void
+vpCircleHoughTransform::computeRadiusCandidates(const std::pair<float, float> &centerCandidate,
+                                                std::vector<vpImageCircle> &circleCandidates,
+                                                std::vector<float> &circleCandidatesProba,
+                                                std::vector<unsigned int> &circleCandidatesVotes,
+                                                std::vector<std::vector<std::pair<unsigned int, unsigned int> > > &votingPoints)
+{
   int nbBins = static_cast<int>(((m_algoParams.m_maxRadius - m_algoParams.m_minRadius) + 1) / m_algoParams.m_mergingRadiusDiffThresh);
   nbBins = std::max<int>(static_cast<int>(1), nbBins); // Avoid having 0 bins, which causes segfault
-  std::vector<float> radiusAccumList; // Radius accumulator for each center candidates.
-  std::vector<float> radiusActualValueList; // Vector that contains the actual distance between the edge points and the center candidates.
-  std::vector<std::vector<std::pair<unsigned int, unsigned int> > > votingPoints(nbBins); // Vectors that contain the points voting for each radius bin
-
-  float rmin2 = m_algoParams.m_minRadius * m_algoParams.m_minRadius;
-  float rmax2 = m_algoParams.m_maxRadius * m_algoParams.m_maxRadius;
-  float circlePerfectness2 = m_algoParams.m_circlePerfectness * m_algoParams.m_circlePerfectness;
-
-  for (size_t i = 0; i < nbCenterCandidates; ++i) {
-    std::pair<float, float> centerCandidate = m_centerCandidatesList[i];
-    // Initialize the radius accumulator of the candidate with 0s
-    radiusAccumList.clear();
-    radiusAccumList.resize(nbBins, 0);
-    radiusActualValueList.clear();
-    radiusActualValueList.resize(nbBins, 0.);
-
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    for (auto edgePoint : m_edgePointsList)
-#else
-    for (size_t e = 0; e < m_edgePointsList.size(); ++e)
-#endif
-    {
-      // For each center candidate CeC_i, compute the distance with each edge point EP_j d_ij = dist(CeC_i; EP_j)
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-      float rx = edgePoint.second - centerCandidate.second;
-      float ry = edgePoint.first - centerCandidate.first;
-#else
-      float rx = m_edgePointsList[e].second - centerCandidate.second;
-      float ry = m_edgePointsList[e].first - centerCandidate.first;
-#endif
-      float r2 = (rx * rx) + (ry * ry);
-      if ((r2 > rmin2) && (r2 < rmax2)) {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-        float gx = m_dIx[edgePoint.first][edgePoint.second];
-        float gy = m_dIy[edgePoint.first][edgePoint.second];
-#else
-        float gx = m_dIx[m_edgePointsList[e].first][m_edgePointsList[e].second];
-        float gy = m_dIy[m_edgePointsList[e].first][m_edgePointsList[e].second];
-#endif
-        float grad2 = (gx * gx) + (gy * gy);
-
-        float scalProd = (rx * gx) + (ry * gy);
-        float scalProd2 = scalProd * scalProd;
-        if (scalProd2 >= (circlePerfectness2 * r2 * grad2)) {
-          // Look for the Radius Candidate Bin RCB_k to which d_ij is "the closest" will have an additionnal vote
-          float r = static_cast<float>(std::sqrt(r2));
-          int r_bin = static_cast<int>(std::floor((r - m_algoParams.m_minRadius) / m_algoParams.m_mergingRadiusDiffThresh));
-          r_bin = std::min<int>(r_bin, nbBins - 1);
-          if ((r < (m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * 0.5f)))
-              || (r >(m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * (static_cast<float>(nbBins - 1) + 0.5f))))) {
-            // If the radius is at the very beginning of the allowed radii or at the very end, we do not span the vote
-            radiusAccumList[r_bin] += 1.f;
-            radiusActualValueList[r_bin] += r;
-            if (m_algoParams.m_recordVotingPoints) {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-              votingPoints[r_bin].push_back(edgePoint);
-#else
-              votingPoints[r_bin].push_back(m_edgePointsList[e]);
-#endif
+  std::vector<float> radiusAccumList(nbBins, 0.f); // Radius accumulator of the center candidate.
+  std::vector<float> radiusActualValueList(nbBins, 0.f); // Vector that contains the actual distance between the edge points and the center candidate.
+  std::vector<std::vector<unsigned int> > votingPointsIds(nbBins); // Indices in m_edgePointsList of the points voting for each radius bin
+
+  const float rmin2 = m_algoParams.m_minRadius * m_algoParams.m_minRadius;
+  const float rmax2 = m_algoParams.m_maxRadius * m_algoParams.m_maxRadius;
+  const float circlePerfectness2 = m_algoParams.m_circlePerfectness * m_algoParams.m_circlePerfectness;
+  const float voteWeight = static_cast<float>(std::max<unsigned int>(m_algoParams.m_edgeDecimationStep, 1));
+  const bool recordVotingPoints = m_algoParams.m_recordVotingPoints;
+
+  const unsigned int nbEdgePoints = static_cast<unsigned int>(m_edgePointsX.size());
+  for (unsigned int e = 0; e < nbEdgePoints; ++e) {
+    // For each center candidate CeC_i, compute the distance with each edge point EP_j d_ij = dist(CeC_i; EP_j)
+    float rx = m_edgePointsX[e] - centerCandidate.second;
+    float ry = m_edgePointsY[e] - centerCandidate.first;
+    float r2 = (rx * rx) + (ry * ry);
+    if ((r2 > rmin2) && (r2 < rmax2)) {
+      float gx = m_edgePointsGx[e];
+      float gy = m_edgePointsGy[e];
+      float grad2 = (gx * gx) + (gy * gy);
+
+      float scalProd = (rx * gx) + (ry * gy);
+      float scalProd2 = scalProd * scalProd;
+      if (scalProd2 >= (circlePerfectness2 * r2 * grad2)) {
+        // Look for the Radius Candidate Bin RCB_k to which d_ij is "the closest" will have an additionnal vote
+        float r = static_cast<float>(std::sqrt(r2));
+        int r_bin = static_cast<int>(std::floor((r - m_algoParams.m_minRadius) / m_algoParams.m_mergingRadiusDiffThresh));
+        r_bin = std::min<int>(r_bin, nbBins - 1);
+        if ((r < (m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * 0.5f)))
+            || (r >= (m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * (static_cast<float>(nbBins - 1) + 0.5f))))) {
+          // If the radius is at the very beginning of the allowed radii or at the very end, we do not span the vote
+          // (a radius equal to the middle of the last bin would otherwise span it with a bin that does not exist)
+          radiusAccumList[r_bin] += voteWeight;
+          radiusActualValueList[r_bin] += r * voteWeight;
+          if (recordVotingPoints) {
+            votingPointsIds[r_bin].push_back(e);
+          }
+        }
+        else {
+          float midRadiusPrevBin = m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * ((r_bin - 1.f) + 0.5f));
+          float midRadiusCurBin = m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * (r_bin + 0.5f));
+          float midRadiusNextBin = m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * (r_bin + 1.f + 0.5f));
+
+          if ((r >= midRadiusCurBin) && (r <= midRadiusNextBin)) {
+            // The radius is at  the end of the current bin or beginning of the next, we span the vote with the next bin
+            float voteCurBin = voteWeight * (midRadiusNextBin - r) / m_algoParams.m_mergingRadiusDiffThresh; // If the difference is big, it means that we are closer to the current bin
+            float voteNextBin = voteWeight - voteCurBin;
+            radiusAccumList[r_bin] += voteCurBin;
+            radiusActualValueList[r_bin] += r * voteCurBin;
+            radiusAccumList[r_bin + 1] += voteNextBin;
+            radiusActualValueList[r_bin + 1] += r * voteNextBin;
+            if (recordVotingPoints) {
+              votingPointsIds[r_bin].push_back(e);
+              votingPointsIds[r_bin + 1].push_back(e);
             }
           }
           else {
-            float midRadiusPrevBin = m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * ((r_bin - 1.f) + 0.5f));
-            float midRadiusCurBin = m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * (r_bin + 0.5f));
-            float midRadiusNextBin = m_algoParams.m_minRadius + (m_algoParams.m_mergingRadiusDiffThresh * (r_bin + 1.f + 0.5f));
-
-            if ((r >= midRadiusCurBin) && (r <= midRadiusNextBin)) {
-              // The radius is at  the end of the current bin or beginning of the next, we span the vote with the next bin
-              float voteCurBin = (midRadiusNextBin - r) / m_algoParams.m_mergingRadiusDiffThresh; // If the difference is big, it means that we are closer to the current bin
-              float voteNextBin = 1.f - voteCurBin;
-              radiusAccumList[r_bin] += voteCurBin;
-              radiusActualValueList[r_bin] += r * voteCurBin;
-              radiusAccumList[r_bin + 1] += voteNextBin;
-              radiusActualValueList[r_bin + 1] += r * voteNextBin;
-              if (m_algoParams.m_recordVotingPoints) {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-                votingPoints[r_bin].push_back(edgePoint);
-                votingPoints[r_bin + 1].push_back(edgePoint);
-#else
-                votingPoints[r_bin].push_back(m_edgePointsList[e]);
-                votingPoints[r_bin + 1].push_back(m_edgePointsList[e]);
-#endif
-              }
-            }
-            else {
-              // The radius is at the end of the previous bin or beginning of the current, we span the vote with the previous bin
-              float votePrevBin = (r - midRadiusPrevBin) / m_algoParams.m_mergingRadiusDiffThresh; // If the difference is big, it means that we are closer to the previous bin
-              float voteCurBin = 1.f - votePrevBin;
-              radiusAccumList[r_bin] += voteCurBin;
-              radiusActualValueList[r_bin] += r * voteCurBin;
-              radiusAccumList[r_bin - 1] += votePrevBin;
-              radiusActualValueList[r_bin - 1] += r * votePrevBin;
-              if (m_algoParams.m_recordVotingPoints) {
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-                votingPoints[r_bin].push_back(edgePoint);
-                votingPoints[r_bin - 1].push_back(edgePoint);
-#else
-                votingPoints[r_bin].push_back(m_edgePointsList[e]);
-                votingPoints[r_bin - 1].push_back(m_edgePointsList[e]);
-#endif
-              }
+            // The radius is at the end of the previous bin or beginning of the current, we span the vote with the previous bin
+            float votePrevBin = voteWeight * (r - midRadiusPrevBin) / m_algoParams.m_mergingRadiusDiffThresh; // If the difference is big, it means that we are closer to the previous bin
+            float voteCurBin = voteWeight - votePrevBin;
+            radiusAccumList[r_bin] += voteCurBin;
+            radiusActualValueList[r_bin] += r * voteCurBin;
+            radiusAccumList[r_bin - 1] += votePrevBin;
+            radiusActualValueList[r_bin - 1] += r * votePrevBin;
+            if (recordVotingPoints) {
+              votingPointsIds[r_bin].push_back(e);
+              votingPointsIds[r_bin - 1].push_back(e);
             }
           }
         }
       }
     }
+  }
 
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    // Lambda to compute the effective radius (i.e. barycenter) of each radius bin
-    auto computeEffectiveRadius = [](const float &votes, const float &weigthedSumRadius) {
-      float r_effective = -1.f;
-      if (votes > std::numeric_limits<float>::epsilon()) {
-        r_effective = weigthedSumRadius / votes;
-      }
-      return r_effective;
-      };
-#endif
+  // Lambda to compute the effective radius (i.e. barycenter) of each radius bin
+  auto computeEffectiveRadius = [](const float &votes, const float &weigthedSumRadius) {
+    float r_effective = -1.f;
+    if (votes > std::numeric_limits<float>::epsilon()) {
+      r_effective = weigthedSumRadius / votes;
+    }
+    return r_effective;
+    };
 
-    // Merging similar candidates
-    std::vector<float> v_r_effective; // Vector of radius of each candidate after the merge step
-    std::vector<float> v_votes_effective; // Vector of number of votes of each candidate after the merge step
-    std::vector<std::vector<std::pair<unsigned int, unsigned int> > > v_votingPoints_effective; // Vector of voting points after the merge step
-    std::vector<bool> v_hasMerged_effective; // Vector indicating if merge has been performed for the different candidates
-    for (int idBin = 0; idBin < nbBins; ++idBin) {
-      float r_effective = computeEffectiveRadius(radiusAccumList[idBin], radiusActualValueList[idBin]);
-      float votes_effective = radiusAccumList[idBin];
-      std::vector<std::pair<unsigned int, unsigned int> > votingPoints_effective = votingPoints[idBin];
-      bool is_r_effective_similar = (r_effective > 0.f);
-      // Looking for potential similar radii in the following bins
-      // If so, compute the barycenter radius between them
-      int idCandidate = idBin + 1;
-      bool hasMerged = false;
-      while ((idCandidate < nbBins) && is_r_effective_similar) {
-        float r_effective_candidate = computeEffectiveRadius(radiusAccumList[idCandidate], radiusActualValueList[idCandidate]);
-        if (std::abs(r_effective_candidate - r_effective) < m_algoParams.m_mergingRadiusDiffThresh) {
-          r_effective = ((r_effective * votes_effective) + (r_effective_candidate * radiusAccumList[idCandidate])) / (votes_effective + radiusAccumList[idCandidate]);
-          votes_effective += radiusAccumList[idCandidate];
-          radiusAccumList[idCandidate] = -.1f;
-          radiusActualValueList[idCandidate] = -1.f;
-          is_r_effective_similar = true;
-          if (m_algoParams.m_recordVotingPoints) {
-            // Move elements from votingPoints[idCandidate] to votingPoints_effective.
-            // votingPoints[idCandidate] is left in undefined but safe-to-destruct state.
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-            votingPoints_effective.insert(
-              votingPoints_effective.end(),
-              std::make_move_iterator(votingPoints[idCandidate].begin()),
-              std::make_move_iterator(votingPoints[idCandidate].end())
-            );
-#else
-            votingPoints_effective.insert(
-              votingPoints_effective.end(),
-              votingPoints[idCandidate].begin(),
-              votingPoints[idCandidate].end()
-            );
-#endif
-            hasMerged = true;
-          }
-        }
-        else {
-          is_r_effective_similar = false;
+  // Merging similar candidates
+  std::vector<float> v_r_effective; // Vector of radius of each candidate after the merge step
+  std::vector<float> v_votes_effective; // Vector of number of votes of each candidate after the merge step
+  std::vector<std::vector<unsigned int> > v_votingPoints_effective; // Vector of voting points after the merge step
+  std::vector<bool> v_hasMerged_effective; // Vector indicating if merge has been performed for the different candidates
+  for (int idBin = 0; idBin < nbBins; ++idBin) {
+    float r_effective = computeEffectiveRadius(radiusAccumList[idBin], radiusActualValueList[idBin]);
+    float votes_effective = radiusAccumList[idBin];
+    std::vector<unsigned int> votingPoints_effective = votingPointsIds[idBin];
+    bool is_r_effective_similar = (r_effective > 0.f);
+    // Looking for potential similar radii in the following bins
+    // If so, compute the barycenter radius between them
+    int idCandidate = idBin + 1;
+    bool hasMerged = false;
+    while ((idCandidate < nbBins) && is_r_effective_similar) {
+      float r_effective_candidate = computeEffectiveRadius(radiusAccumList[idCandidate], radiusActualValueList[idCandidate]);
+      if (std::abs(r_effective_candidate - r_effective) < m_algoParams.m_mergingRadiusDiffThresh) {
+        r_effective = ((r_effective * votes_effective) + (r_effective_candidate * radiusAccumList[idCandidate])) / (votes_effective + radiusAccumList[idCandidate]);
+        votes_effective += radiusAccumList[idCandidate];
+        radiusAccumList[idCandidate] = -.1f;
+        radiusActualValueList[idCandidate] = -1.f;
+        is_r_effective_similar = true;
+        if (recordVotingPoints) {
+          votingPoints_effective.insert(votingPoints_effective.end(), votingPointsIds[idCandidate].begin(),
+                                        votingPointsIds[idCandidate].end());
+          votingPointsIds[idCandidate].clear();
+          hasMerged = true;
         }
-        ++idCandidate;
       }
+      else {
+        is_r_effective_similar = false;
+      }
+      ++idCandidate;
+    }
 
-      if ((votes_effective > m_algoParams.m_centerMinThresh) && (votes_effective >= m_algoParams.m_circleVisibilityRatioThresh * 2.f * M_PIf * r_effective)) {
-        // Only the circles having enough votes and being visible enough are considered
-        v_r_effective.push_back(r_effective);
-        v_votes_effective.push_back(votes_effective);
-        if (m_algoParams.m_recordVotingPoints) {
-          v_votingPoints_effective.push_back(votingPoints_effective);
-          v_hasMerged_effective.push_back(hasMerged);
-        }
+    if ((votes_effective > m_algoParams.m_centerMinThresh) && (votes_effective >= m_algoParams.m_circleVisibilityRatioThresh * 2.f * M_PIf * r_effective)) {
+      // Only the circles having enough votes and being visible enough are considered
+      v_r_effective.push_back(r_effective);
+      v_votes_effective.push_back(votes_effective);
+      if (recordVotingPoints) {
+        v_votingPoints_effective.push_back(votingPoints_effective);
+        v_hasMerged_effective.push_back(hasMerged);
       }
     }
+  }
 
-    unsigned int nbCandidates = v_r_effective.size();
-    for (unsigned int idBin = 0; idBin < nbCandidates; ++idBin) {
-      // If the circle of center CeC_i  and radius RCB_k has enough votes, it is added to the list
-      // of Circle Candidates
-      float r_effective = v_r_effective[idBin];
-      vpImageCircle candidateCircle(vpImagePoint(centerCandidate.first, centerCandidate.second), r_effective);
-      float proba = computeCircleProbability(candidateCircle, v_votes_effective[idBin]);
-      if (proba > m_algoParams.m_circleProbaThresh) {
-        m_circleCandidates.push_back(candidateCircle);
-        m_circleCandidatesProbabilities.push_back(proba);
-        m_circleCandidatesVotes.push_back(v_votes_effective[idBin]);
-        if (m_algoParams.m_recordVotingPoints) {
-          if (v_hasMerged_effective[idBin]) {
-            // Remove potential duplicated points
-            std::sort(v_votingPoints_effective[idBin].begin(), v_votingPoints_effective[idBin].end());
-            v_votingPoints_effective[idBin].erase(std::unique(v_votingPoints_effective[idBin].begin(), v_votingPoints_effective[idBin].end()), v_votingPoints_effective[idBin].end());
-          }
-          // Save the points
-          m_circleCandidatesVotingPoints.push_back(v_votingPoints_effective[idBin]);
+  unsigned int nbCandidates = v_r_effective.size();
+  for (unsigned int idBin = 0; idBin < nbCandidates; ++idBin) {
+    // If the circle of center CeC_i  and radius RCB_k has enough votes, it is added to the list
+    // of Circle Candidates
+    float r_effective = v_r_effective[idBin];
+    vpImageCircle candidateCircle(vpImagePoint(centerCandidate.first, centerCandidate.second), r_effective);
+    float proba = computeCircleProbability(candidateCircle, v_votes_effective[idBin]);
+    if (proba > m_algoParams.m_circleProbaThresh) {
+      circleCandidates.push_back(candidateCircle);
+      circleCandidatesProba.push_back(proba);
+      circleCandidatesVotes.push_back(v_votes_effective[idBin]);
+      if (recordVotingPoints) {
+        std::vector<unsigned int> &ids = v_votingPoints_effective[idBin];
+        if (v_hasMerged_effective[idBin]) {
+          // Remove potential duplicated points, the edge points being stored in raster order
+          std::sort(ids.begin(), ids.end());
+          ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+        // Save the points
+        std::vector<std::pair<unsigned int, unsigned int> > points(ids.size());
+        for (size_t k = 0; k < ids.size(); ++k) {
+          points[k] = m_edgePointsList[ids[k]];
         }
+        votingPoints.push_back(points);
       }
     }
   }
@@ -36,67 +36,81 @@
   \brief Basic connected components.
 */
 
-#include <queue>
+#include <algorithm>
+#include <thread>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
 {
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity)
+// Root of the tree of a pixel, with path halving
+int findRoot(std::vector<int> &parent, int p)
 {
-  unsigned char currValue = I[i][j];
-
-  if (connexity == vpImageMorphology::CONNEXITY_4) {
-    // Top
-    if (I[i - 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i - 1, j));
-    }
+  while (parent[p] != p) {
+    parent[p] = parent[parent[p]];
+    p = parent[p];
+  }
+  return p;
+}
 
-    // Left
-    if (I[i][j - 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j - 1));
-    }
+// Merge the trees of two pixels, the smallest index becoming the root so that the root
+// of a component is always its first pixel in raster order
+void unite(std::vector<int> &parent, int p, int q)
+{
+  int rp = findRoot(parent, p);
+  int rq = findRoot(parent, q);
+  if (rp < rq) {
+    parent[rq] = rp;
+  }
+  else if (rq < rp) {
+    parent[rp] = rq;
+  }
+}
 
-    // Right
-    if (I[i][j + 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j + 1));
-    }
+// Merge the pixel (i, j) with its neighbors of the previous row having the same value
+void uniteUp(const vpImage<unsigned char> &I, std::vector<int> &parent, unsigned int i, unsigned int j,
+             const vpImageMorphology::vpConnexityType &connexity)
+{
+  const unsigned int width = I.getWidth();
+  const unsigned char value = I[i][j];
+  const int p = static_cast<int>(i * width + j);
+  const int up = p - static_cast<int>(width);
 
-    // Bottom
-    if (I[i + 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i + 1, j));
-    }
+  if (I[i - 1][j] == value) {
+    unite(parent, p, up);
   }
-  else {
-    for (int cpt1 = -1; cpt1 <= 1; cpt1++) {
-      for (int cpt2 = -1; cpt2 <= 1; cpt2++) {
-        // Everything except the current position
-        if (cpt1 != 0 || cpt2 != 0) {
-          if (I[(int)i + cpt1][(int)j + cpt2] == currValue) {
-            listOfNeighbors.push(vpImagePoint((int)i + cpt1, (int)j + cpt2));
-          }
-        }
-      }
+  if (connexity == vpImageMorphology::CONNEXITY_8) {
+    if (j > 0 && I[i - 1][j - 1] == value) {
+      unite(parent, p, up - 1);
+    }
+    if (j + 1 < width && I[i - 1][j + 1] == value) {
+      unite(parent, p, up + 1);
     }
   }
 }
 
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity)
+// First pass of the labeling on the rows [rowBegin, rowEnd), only the pixels of the strip are merged
+void labelStrip(const vpImage<unsigned char> &I, std::vector<int> &parent, unsigned int rowBegin, unsigned int rowEnd,
+                const vpImageMorphology::vpConnexityType &connexity)
 {
-  // Visit the neighbors
-  while (!listOfNeighbors.empty()) {
-    vpImagePoint imPt = listOfNeighbors.front();
-    unsigned int i = (unsigned int)imPt.get_i();
-    unsigned int j = (unsigned int)imPt.get_j();
-    listOfNeighbors.pop();
-
-    if (I_copy[i][j]) {
-      getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
-
-      // Reset current position and set label
-      I_copy[i][j] = 0;
-      labels[i][j] = current_label;
+  const unsigned int width = I.getWidth();
+
+  for (unsigned int i = rowBegin; i < rowEnd; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const int p = static_cast<int>(i * width + j);
+      const unsigned char value = I[i][j];
+
+      if (value == 0) {
+        parent[p] = -1;
+        continue;
+      }
+
+      parent[p] = p;
+      if (j > 0 && I[i][j - 1] == value) {
+        unite(parent, p, p - 1);
+      }
+      if (i > rowBegin) {
+        uniteUp(I, parent, i, j, connexity);
+      }
     }
   }
 }
@@ -104,58 +118,110 @@ void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &li
 
 namespace vp
 {
-void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents, const vpImageMorphology::vpConnexityType &connexity)
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         const vpImageMorphology::vpConnexityType &connexity)
+{
+  std::vector<vpConnectedComponent> components;
+  connectedComponents(I, labels, nbComponents, components, connexity);
+}
+
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         std::vector<vpConnectedComponent> &components,
+                         const vpImageMorphology::vpConnexityType &connexity, unsigned int nbThreads)
 {
   if (I.getSize() == 0) {
     return;
   }
 
-  labels.resize(I.getHeight(), I.getWidth());
+  const unsigned int height = I.getHeight();
+  const unsigned int width = I.getWidth();
+  labels.resize(height, width);
 
-  vpImage<unsigned char> I_copy(I.getHeight() + 2, I.getWidth() + 2);
-  // Copy and add border
-  for (unsigned int i = 0; i < I_copy.getHeight(); i++) {
-    if (i == 0 || i == I_copy.getHeight() - 1) {
-      memset(I_copy[i], 0, sizeof(unsigned char) * I_copy.getWidth());
-    }
-    else {
-      I_copy[i][0] = 0;
-      memcpy(I_copy[i] + 1, I[i - 1], sizeof(unsigned char) * I.getWidth());
-      I_copy[i][I_copy.getWidth() - 1] = 0;
-    }
+  if (nbThreads == 0) {
+    nbThreads = std::max<unsigned int>(1, std::thread::hardware_concurrency());
   }
+  nbThreads = std::min<unsigned int>(nbThreads, height);
 
-  vpImage<int> labels_copy(I.getHeight() + 2, I.getWidth() + 2, 0);
-
-  int current_label = 1;
-  std::queue<vpImagePoint> listOfNeighbors;
-
-  for (unsigned int cpt1 = 0; cpt1 < I.getHeight(); cpt1++) {
-    unsigned int i = cpt1 + 1;
-
-    for (unsigned int cpt2 = 0; cpt2 < I.getWidth(); cpt2++) {
-      unsigned int j = cpt2 + 1;
+  // First pass: union-find on horizontal strips, in parallel
+  std::vector<int> parent(I.getSize());
+  std::vector<unsigned int> stripBegins(nbThreads + 1);
+  for (unsigned int t = 0; t <= nbThreads; t++) {
+    stripBegins[t] = (height * t) / nbThreads;
+  }
 
-      if (I_copy[i][j] && labels_copy[i][j] == 0) {
-        // Get all the neighbors relative to the current position
-        getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
+  if (nbThreads == 1) {
+    labelStrip(I, parent, 0, height, connexity);
+  }
+  else {
+    std::vector<std::thread> threadpool;
+    for (unsigned int t = 0; t < nbThreads; t++) {
+      threadpool.emplace_back(labelStrip, std::cref(I), std::ref(parent), stripBegins[t], stripBegins[t + 1],
+                              std::cref(connexity));
+    }
+    for (size_t t = 0; t < threadpool.size(); t++) {
+      threadpool[t].join();
+    }
 
-        // Reset current position and set label
-        I_copy[i][j] = 0;
-        labels_copy[i][j] = current_label;
+    // Merge the first row of each strip with the last row of the previous one
+    for (unsigned int t = 1; t < nbThreads; t++) {
+      const unsigned int i = stripBegins[t];
+      for (unsigned int j = 0; j < width; j++) {
+        if (I[i][j]) {
+          uniteUp(I, parent, i, j, connexity);
+        }
+      }
+    }
+  }
 
-        visitNeighbors(I_copy, listOfNeighbors, labels_copy, current_label, connexity);
+  // Second pass: a root is the first pixel of its component in raster order, so the parent of a pixel
+  // has always been flattened to its root before the pixel is visited
+  struct Accumulator
+  {
+    unsigned int area;
+    double sum_i, sum_j;
+    unsigned int min_i, max_i, min_j, max_j;
+  };
+  std::vector<Accumulator> accumulators;
+
+  int *const labelsPtr = labels.bitmap;
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const int p = static_cast<int>(i * width + j);
+      const int q = parent[p];
+
+      if (q < 0) {
+        labelsPtr[p] = 0;
+        continue;
+      }
 
-        // Increment label
-        current_label++;
+      if (q == p) {
+        Accumulator acc = { 0, 0.0, 0.0, i, i, j, j };
+        accumulators.push_back(acc);
+        labelsPtr[p] = static_cast<int>(accumulators.size());
+      }
+      else {
+        parent[p] = parent[q];
+        labelsPtr[p] = labelsPtr[parent[p]];
       }
+
+      Accumulator &acc = accumulators[labelsPtr[p] - 1];
+      acc.area++;
+      acc.sum_i += i;
+      acc.sum_j += j;
+      acc.min_i = std::min<unsigned int>(acc.min_i, i);
+      acc.max_i = std::max<unsigned int>(acc.max_i, i);
+      acc.min_j = std::min<unsigned int>(acc.min_j, j);
+      acc.max_j = std::max<unsigned int>(acc.max_j, j);
     }
   }
 
-  for (unsigned int i = 0; i < labels.getHeight(); i++) {
-    memcpy(labels[i], labels_copy[i + 1] + 1, sizeof(int) * labels.getWidth());
+  nbComponents = static_cast<int>(accumulators.size());
+  components.resize(accumulators.size());
+  for (size_t k = 0; k < accumulators.size(); k++) {
+    const Accumulator &acc = accumulators[k];
+    components[k].area = acc.area;
+    components[k].bbox = vpRect(acc.min_j, acc.min_i, acc.max_j - acc.min_j + 1, acc.max_i - acc.min_i + 1);
+    components[k].centroid = vpImagePoint(acc.sum_i / acc.area, acc.sum_j / acc.area);
   }
-
-  nbComponents = current_label - 1;
 }
 };
@@ -63,99 +63,118 @@
   \brief Flood fill algorithm.
 */
 
-#include <queue>
+#include <algorithm>
 #include <visp3/imgproc/vpImgproc.h>
 
-namespace vp
+namespace
 {
-void floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPoint, const unsigned char oldValue,
-               const unsigned char newValue, const vpImageMorphology::vpConnexityType &connexity)
+// Seed of a span, in integer coordinates
+struct vpSpanSeed
 {
-  // Code from Lode Vandevenne tutorial.
-  // Naive modification for 8-connexity implementation
-  if (oldValue == newValue || I.getSize() == 0) {
-    return;
-  }
-
-  std::queue<vpImagePoint> seed_queue;
-
-  // Add initial seed point
-  seed_queue.push(seedPoint);
-
-  while (!seed_queue.empty()) {
-    vpImagePoint current_seed = seed_queue.front();
-    seed_queue.pop();
-
-    unsigned int x = (unsigned int)current_seed.get_j();
-    unsigned int y = (unsigned int)current_seed.get_i();
-    int x1 = (int)x;
+  int i, j;
+};
 
-    // Find most left pixel
-    while (x1 >= 0 && I[y][x1] == oldValue) {
-      x1--;
+// Push one seed per run of oldValue pixels of row i between the columns j_begin and j_end (included)
+void pushRuns(const vpImage<unsigned char> &I, std::vector<vpSpanSeed> &stack, int i, int j_begin, int j_end,
+              const unsigned char oldValue)
+{
+  const unsigned char *row = I[static_cast<unsigned int>(i)];
+  bool inRun = false;
+  for (int j = j_begin; j <= j_end; j++) {
+    if (row[j] == oldValue) {
+      if (!inRun) {
+        vpSpanSeed seed = { i, j };
+        stack.push_back(seed);
+        inRun = true;
+      }
+    }
+    else {
+      inRun = false;
     }
-    x1++;
+  }
+}
 
-    bool spanAbove = false, spanBelow = false;
+void floodFillSpans(vpImage<unsigned char> &I, std::vector<vpSpanSeed> &stack, const unsigned char oldValue,
+                    const unsigned char newValue, const vpImageMorphology::vpConnexityType &connexity)
+{
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  // With 8-connexity, the diagonal neighbors of the span ends are also connected
+  const int border = connexity == vpImageMorphology::CONNEXITY_4 ? 0 : 1;
+
+  while (!stack.empty()) {
+    const vpSpanSeed seed = stack.back();
+    stack.pop_back();
+
+    unsigned char *row = I[static_cast<unsigned int>(seed.i)];
+    if (row[seed.j] != oldValue) {
+      // Already filled from another seed
+      continue;
+    }
 
-    while (x1 < (int)I.getWidth() && I[y][x1] == oldValue) {
-      I[y][x1] = newValue;
+    // Extend the span on both sides and fill it
+    int j_left = seed.j, j_right = seed.j;
+    while (j_left > 0 && row[j_left - 1] == oldValue) {
+      j_left--;
+    }
+    while (j_right < width - 1 && row[j_right + 1] == oldValue) {
+      j_right++;
+    }
+    std::fill(row + j_left, row + j_right + 1, newValue);
 
-      if (!spanAbove && y > 0) {
-        if (I[y - 1][x1] == oldValue) {
-          // North
-          spanAbove = true;
-          seed_queue.push(vpImagePoint(y - 1, x1));
-        }
+    const int j_begin = std::max(0, j_left - border);
+    const int j_end = std::min(width - 1, j_right + border);
+    if (seed.i > 0) {
+      pushRuns(I, stack, seed.i - 1, j_begin, j_end, oldValue);
+    }
+    if (seed.i < height - 1) {
+      pushRuns(I, stack, seed.i + 1, j_begin, j_end, oldValue);
+    }
+  }
+}
 
-        if (connexity != vpImageMorphology::CONNEXITY_4) {
-          if (x1 > 0 && I[y - 1][x1 - 1] == oldValue) {
-            // North west
-            spanAbove = true;
-            seed_queue.push(vpImagePoint(y - 1, x1 - 1));
-          }
-          if (x1 < (int)I.getWidth() - 1 && I[y - 1][x1 + 1] == oldValue) {
-            // North east
-            spanAbove = true;
-            seed_queue.push(vpImagePoint(y - 1, x1 + 1));
-          }
-        }
-      }
-      else if (spanAbove && y > 0 && I[y - 1][x1] != oldValue) {
-        spanAbove = false;
-      }
+bool pushSeed(const vpImage<unsigned char> &I, std::vector<vpSpanSeed> &stack, const vpImagePoint &seedPoint)
+{
+  if (seedPoint.get_i() < 0 || seedPoint.get_j() < 0) {
+    return false;
+  }
+  vpSpanSeed seed = { static_cast<int>(seedPoint.get_i()), static_cast<int>(seedPoint.get_j()) };
+  if (seed.i >= static_cast<int>(I.getHeight()) || seed.j >= static_cast<int>(I.getWidth())) {
+    return false;
+  }
+  stack.push_back(seed);
+  return true;
+}
+} // namespace
 
-      if (!spanBelow && y < I.getHeight() - 1) {
-        if (I[y + 1][x1] == oldValue) {
-          // South
-          seed_queue.push(vpImagePoint(y + 1, x1));
-          spanBelow = true;
-        }
+namespace vp
+{
+void floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPoint, const unsigned char oldValue,
+               const unsigned char newValue, const vpImageMorphology::vpConnexityType &connexity)
+{
+  // Span filling derived from Lode Vandevenne tutorial
+  if (oldValue == newValue || I.getSize() == 0) {
+    return;
+  }
 
-        if (connexity != vpImageMorphology::CONNEXITY_4) {
-          if (x1 > 0 && I[y + 1][x1 - 1] == oldValue) {
-            // South west
-            seed_queue.push(vpImagePoint(y + 1, x1 - 1));
-            spanBelow = true;
-          }
-          if (x1 < (int)I.getWidth() - 1 && I[y + 1][x1 + 1] == oldValue) {
-            // South east
-            seed_queue.push(vpImagePoint(y + 1, x1 + 1));
-            spanBelow = true;
-          }
-        }
-      }
-      else if (spanBelow && y < I.getHeight() - 1 && I[y + 1][x1] != oldValue) {
-        spanBelow = false;
-      }
+  std::vector<vpSpanSeed> stack;
+  if (pushSeed(I, stack, seedPoint)) {
+    floodFillSpans(I, stack, oldValue, newValue, connexity);
+  }
+}
 
-      // TODO: improve 8-connexity
-      if (connexity != vpImageMorphology::CONNEXITY_4) {
-        spanBelow = false;
-        spanAbove = false;
-      }
+void floodFill(vpImage<unsigned char> &I, const std::vector<vpImagePoint> &seedPoints, const unsigned char oldValue,
+               const unsigned char newValue, const vpImageMorphology::vpConnexityType &connexity)
+{
+  if (oldValue == newValue || I.getSize() == 0) {
+    return;
+  }
 
-      x1++;
+  std::vector<vpSpanSeed> stack;
+  for (size_t k = 0; k < seedPoints.size(); k++) {
+    // The stack is emptied by each fill, its memory being kept for the next seed
+    if (pushSeed(I, stack, seedPoints[k])) {
+      floodFillSpans(I, stack, oldValue, newValue, connexity);
     }
   }
 }
@@ -36,6 +36,8 @@
   \brief Additional image morphology functions.
 */
 
+#include <queue>
+
 #include <visp3/core/vpImageTools.h>
 #include <visp3/imgproc/vpImgproc.h>
 
@@ -55,8 +57,8 @@ void fillHoles(vpImage<unsigned char> &I
 
 #if USE_OLD_FILL_HOLE
   // Code similar to Matlab imfill(BW,'holes')
-  // Replaced by flood fill as imfill use imreconstruct
-  // and our reconstruct implementation is naive and inefficient
+  // Replaced by flood fill as imfill use imreconstruct,
+  // that is slower than a flood fill from the border for binary images
   // Difference between new and old implementation:
   //  - new implementation allows to set the fill value
   //  - only background==0 is required, before it was 0 (background) / 1
@@ -93,26 +95,25 @@ void fillHoles(vpImage<unsigned char> &I
     }
   }
 #else
-  // Create flood fill mask
-  vpImage<unsigned char> flood_fill_mask(I.getHeight() + 2, I.getWidth() + 2, 0);
-  // Copy I to mask + add border padding
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    memcpy(flood_fill_mask[i + 1] + 1, I[i], sizeof(unsigned char) * I.getWidth());
+  // Flood fill the background from all the border pixels, the pixels that are not reached are the holes
+  std::vector<vpImagePoint> seedPoints;
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  for (unsigned int j = 0; j < width; j++) {
+    seedPoints.push_back(vpImagePoint(0, j));
+    seedPoints.push_back(vpImagePoint(height - 1, j));
+  }
+  for (unsigned int i = 1; i + 1 < height; i++) {
+    seedPoints.push_back(vpImagePoint(i, 0));
+    seedPoints.push_back(vpImagePoint(i, width - 1));
   }
 
-  // Perform flood fill
-  vp::floodFill(flood_fill_mask, vpImagePoint(0, 0), 0, 255);
+  vpImage<unsigned char> mask = I;
+  vp::floodFill(mask, seedPoints, 0, 255);
 
-  // Get current mask
-  vpImage<unsigned char> mask(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < mask.getHeight(); i++) {
-    memcpy(mask[i], flood_fill_mask[i + 1] + 1, sizeof(unsigned char) * mask.getWidth());
+  // Only the background reached from the border stays at 0, holes and foreground are set to 255
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = (I.bitmap[i] == 0 && mask.bitmap[i] != 0) ? 0 : 255;
   }
-
-  // Get image with holes filled
-  vpImage<unsigned char> I_white(I.getHeight(), I.getWidth(), 255), I_holes;
-  vpImageTools::imageSubtract(I_white, mask, I_holes);
-  vpImageTools::imageAdd(I, I_holes, I, true);
 #endif
 }
 
@@ -131,25 +132,86 @@ void reconstruct(const vpImage<unsigned char> &marker, const vpImage<unsigned ch
     return;
   }
 
-  vpImage<unsigned char> h_k = marker;
-  h_kp1 = h_k;
-
-  do {
-    // Dilatation
-    vpImageMorphology::dilatation<unsigned char>(h_kp1, connexity);
+  // Hybrid algorithm from L. Vincent, "Morphological grayscale reconstruction in image analysis:
+  // applications and efficient algorithms", IEEE Trans. on Image Processing, 1993:
+  // a raster and an anti-raster scan propagate the values over most of the image, then a FIFO
+  // of pixels propagates the remaining values, each pixel being processed a bounded number of times.
+  //
+  // As with the iterated geodesic dilations of the definition, start from the first geodesic
+  // dilation of the marker, the result being the same when the marker is below the mask
+  h_kp1 = marker;
+  vpImageMorphology::dilatation<unsigned char>(h_kp1, connexity);
+
+  const int height = static_cast<int>(mask.getHeight());
+  const int width = static_cast<int>(mask.getWidth());
+  unsigned char *J = h_kp1.bitmap;
+  const unsigned char *I = mask.bitmap;
+  for (unsigned int i = 0; i < mask.getSize(); i++) {
+    J[i] = std::min<unsigned char>(J[i], I[i]);
+  }
 
-    // Keep min
-    for (unsigned int i = 0; i < h_kp1.getHeight(); i++) {
-      for (unsigned int j = 0; j < h_kp1.getWidth(); j++) {
-        h_kp1[i][j] = std::min<unsigned char>(h_kp1[i][j], mask[i][j]);
+  // Neighbors before the current pixel in raster order, the following ones are the opposite offsets
+  const int nbHalfNeighbors = connexity == vpImageMorphology::CONNEXITY_4 ? 2 : 4;
+  const int offset_i[4] = { 0, -1, -1, -1 };
+  const int offset_j[4] = { -1, 0, -1, 1 };
+
+  // Raster scan
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      unsigned char value = J[i * width + j];
+      for (int k = 0; k < nbHalfNeighbors; k++) {
+        int i_ = i + offset_i[k], j_ = j + offset_j[k];
+        if (i_ >= 0 && j_ >= 0 && j_ < width) {
+          value = std::max<unsigned char>(value, J[i_ * width + j_]);
+        }
       }
+      J[i * width + j] = std::min<unsigned char>(value, I[i * width + j]);
     }
+  }
 
-    if (h_kp1 == h_k) {
-      break;
+  // Anti-raster scan, pixels that could still propagate their value are queued
+  std::queue<int> fifo;
+  for (int i = height - 1; i >= 0; i--) {
+    for (int j = width - 1; j >= 0; j--) {
+      const int p = i * width + j;
+      unsigned char value = J[p];
+      for (int k = 0; k < nbHalfNeighbors; k++) {
+        int i_ = i - offset_i[k], j_ = j - offset_j[k];
+        if (i_ < height && j_ >= 0 && j_ < width) {
+          value = std::max<unsigned char>(value, J[i_ * width + j_]);
+        }
+      }
+      J[p] = std::min<unsigned char>(value, I[p]);
+
+      for (int k = 0; k < nbHalfNeighbors; k++) {
+        int i_ = i - offset_i[k], j_ = j - offset_j[k];
+        if (i_ < height && j_ >= 0 && j_ < width) {
+          const int q = i_ * width + j_;
+          if (J[q] < J[p] && J[q] < I[q]) {
+            fifo.push(p);
+            break;
+          }
+        }
+      }
     }
+  }
 
-    h_k = h_kp1;
-  } while (true);
+  // Propagation
+  while (!fifo.empty()) {
+    const int p = fifo.front();
+    fifo.pop();
+    const int i = p / width, j = p % width;
+    for (int k = 0; k < 2 * nbHalfNeighbors; k++) {
+      int i_ = k < nbHalfNeighbors ? i + offset_i[k] : i - offset_i[k - nbHalfNeighbors];
+      int j_ = k < nbHalfNeighbors ? j + offset_j[k] : j - offset_j[k - nbHalfNeighbors];
+      if (i_ >= 0 && i_ < height && j_ >= 0 && j_ < width) {
+        const int q = i_ * width + j_;
+        if (J[q] < J[p] && I[q] != J[q]) {
+          J[q] = std::min<unsigned char>(J[p], I[q]);
+          fifo.push(q);
+        }
+      }
+    }
+  }
 }
 };
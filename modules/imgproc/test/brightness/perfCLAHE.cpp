@@ -0,0 +1,256 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Benchmark CLAHE.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 640;
+int g_height = 480;
+
+int fastRound(float value) { return (int)(value + 0.5f); }
+
+// Accurate CLAHE with the histogram of each window computed from scratch
+void claheRef(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope)
+{
+  const int height = static_cast<int>(I1.getHeight()), width = static_cast<int>(I1.getWidth());
+  I2.resize(I1.getHeight(), I1.getWidth());
+  std::vector<int> hist(static_cast<size_t>(bins + 1));
+
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const int yMin = std::max(0, y - blockRadius), yMax = std::min(height, y + blockRadius + 1);
+      const int xMin = std::max(0, x - blockRadius), xMax = std::min(width, x + blockRadius + 1);
+      std::fill(hist.begin(), hist.end(), 0);
+      for (int yi = yMin; yi < yMax; yi++) {
+        for (int xi = xMin; xi < xMax; xi++) {
+          ++hist[fastRound(I1[yi][xi] / 255.0f * bins)];
+        }
+      }
+
+      // Clip the histogram and redistribute the clipped entries
+      const int histlength = bins + 1;
+      const int limit = (int)(slope * (yMax - yMin) * (xMax - xMin) / bins + 0.5f);
+      int clippedEntries = 0, clippedEntriesBefore = 0;
+      do {
+        clippedEntriesBefore = clippedEntries;
+        clippedEntries = 0;
+        for (int i = 0; i < histlength; i++) {
+          if (hist[i] > limit) {
+            clippedEntries += hist[i] - limit;
+            hist[i] = limit;
+          }
+        }
+        for (int i = 0; i < histlength; i++) {
+          hist[i] += clippedEntries / histlength;
+        }
+        const int m = clippedEntries % histlength;
+        if (m != 0) {
+          const int s = (histlength - 1) / m;
+          for (int i = s / 2; i < histlength; i += s) {
+            ++hist[i];
+          }
+        }
+      } while (clippedEntries != clippedEntriesBefore);
+
+      int hMin = 0;
+      while (hMin < histlength - 1 && hist[hMin] == 0) {
+        hMin++;
+      }
+      const int v = fastRound(I1[y][x] / 255.0f * bins);
+      int cdf = 0, cdfMax = 0;
+      for (int i = hMin; i < histlength; i++) {
+        cdfMax += hist[i];
+        if (i <= v) {
+          cdf += hist[i];
+        }
+      }
+      I2[y][x] = static_cast<unsigned char>(fastRound((cdf - hist[hMin]) / (float)(cdfMax - hist[hMin]) * 255.0f));
+    }
+  }
+}
+
+// Dark image with a gradient, a few bright patches and noise
+vpImage<unsigned char> generateImage(unsigned int height, unsigned int width, vpUniRand &rand)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = static_cast<unsigned char>(20 + (40 * j) / width + rand.uniform(0, 20));
+    }
+  }
+  for (unsigned int n = 0; n < 10; n++) {
+    const unsigned int top = static_cast<unsigned int>(rand.uniform(0, static_cast<int>(height)));
+    const unsigned int left = static_cast<unsigned int>(rand.uniform(0, static_cast<int>(width)));
+    const unsigned char value = static_cast<unsigned char>(rand.uniform(80, 256));
+    for (unsigned int i = top; i < std::min(height, top + height / 8); i++) {
+      for (unsigned int j = left; j < std::min(width, left + width / 8); j++) {
+        I[i][j] = value;
+      }
+    }
+  }
+  return I;
+}
+} // namespace
+
+TEST_CASE("CLAHE accurate", "[benchmark]")
+{
+  vpUniRand rand(42);
+  const vpImage<unsigned char> I = generateImage(90, 121, rand);
+
+  const int bins[2] = { 256, 40 };
+  for (int b = 0; b < 2; b++) {
+    vpImage<unsigned char> I_ref, I_clahe;
+    claheRef(I, I_ref, 12, bins[b], 3.0f);
+
+    vp::clahe(I, I_clahe, 12, bins[b], 3.0f, false);
+    CHECK(I_clahe == I_ref);
+
+    vp::clahe(I, I_clahe, 12, bins[b], 3.0f, false, 4);
+    CHECK(I_clahe == I_ref);
+  }
+}
+
+TEST_CASE("CLAHE", "[benchmark]")
+{
+  vpUniRand rand(42);
+  const vpImage<unsigned char> I =
+    generateImage(static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), rand);
+  const int blockRadius = std::min(g_width, g_height) / 10;
+
+  SECTION("Same result with several threads")
+  {
+    vpImage<unsigned char> I_clahe, I_clahe_threads;
+    vp::clahe(I, I_clahe, blockRadius, 256, 3.0f, true);
+    vp::clahe(I, I_clahe_threads, blockRadius, 256, 3.0f, true, 3);
+    CHECK(I_clahe == I_clahe_threads);
+    vp::clahe(I, I_clahe_threads, blockRadius, 256, 3.0f, true, 0);
+    CHECK(I_clahe == I_clahe_threads);
+  }
+
+  SECTION("Color image")
+  {
+    vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I_color.bitmap[i] = vpRGBa(I.bitmap[i], static_cast<unsigned char>(255 - I.bitmap[i]),
+                                 static_cast<unsigned char>(I.bitmap[(i * 7) % I.getSize()]), 128);
+    }
+
+    vpImage<unsigned char> R(I.getHeight(), I.getWidth()), G(I.getHeight(), I.getWidth()),
+      B(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      R.bitmap[i] = I_color.bitmap[i].R;
+      G.bitmap[i] = I_color.bitmap[i].G;
+      B.bitmap[i] = I_color.bitmap[i].B;
+    }
+    vpImage<unsigned char> R_clahe, G_clahe, B_clahe;
+    vp::clahe(R, R_clahe, blockRadius);
+    vp::clahe(G, G_clahe, blockRadius);
+    vp::clahe(B, B_clahe, blockRadius);
+
+    vpImage<vpRGBa> I_color_clahe;
+    vp::clahe(I_color, I_color_clahe, blockRadius, 256, 3.0f, true, 2);
+    bool same = true;
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      same = same && I_color_clahe.bitmap[i] == vpRGBa(R_clahe.bitmap[i], G_clahe.bitmap[i], B_clahe.bitmap[i], 128);
+    }
+    CHECK(same);
+
+    // In place
+    vp::clahe(I_color, I_color, blockRadius);
+    CHECK(I_color == I_color_clahe);
+  }
+
+  if (g_runBenchmark) {
+    vpImage<unsigned char> I_clahe;
+    BENCHMARK("CLAHE (ViSP)")
+    {
+      vp::clahe(I, I_clahe, blockRadius);
+      return I_clahe;
+    };
+
+    BENCHMARK("CLAHE (ViSP, all threads)")
+    {
+      vp::clahe(I, I_clahe, blockRadius, 256, 3.0f, true, 0);
+      return I_clahe;
+    };
+
+    BENCHMARK("CLAHE accurate (ViSP, all threads)")
+    {
+      vp::clahe(I, I_clahe, blockRadius, 256, 3.0f, false, 0);
+      return I_clahe;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
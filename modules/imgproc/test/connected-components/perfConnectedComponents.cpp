@@ -0,0 +1,251 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Benchmark connected components labeling.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <queue>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 640;
+int g_height = 480;
+
+// Breadth-first labeling, components are numbered in raster order of their first pixel
+int connectedComponentsRef(const vpImage<unsigned char> &I, vpImage<int> &labels,
+                           const vpImageMorphology::vpConnexityType &connexity)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  labels.resize(I.getHeight(), I.getWidth(), 0);
+
+  int current_label = 0;
+  std::queue<std::pair<int, int> > queue;
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      if (I[i][j] == 0 || labels[i][j] != 0) {
+        continue;
+      }
+
+      current_label++;
+      labels[i][j] = current_label;
+      queue.push(std::make_pair(i, j));
+      while (!queue.empty()) {
+        const int u = queue.front().first, v = queue.front().second;
+        queue.pop();
+        for (int di = -1; di <= 1; di++) {
+          for (int dj = -1; dj <= 1; dj++) {
+            if ((di == 0 && dj == 0) || (connexity == vpImageMorphology::CONNEXITY_4 && di != 0 && dj != 0)) {
+              continue;
+            }
+            const int n_i = u + di, n_j = v + dj;
+            if (n_i >= 0 && n_i < height && n_j >= 0 && n_j < width && I[n_i][n_j] == I[u][v] &&
+                labels[n_i][n_j] == 0) {
+              labels[n_i][n_j] = current_label;
+              queue.push(std::make_pair(n_i, n_j));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return current_label;
+}
+
+// Random rectangles of a few values on a noisy background, to get both large and tiny components
+vpImage<unsigned char> generateImage(unsigned int height, unsigned int width, vpUniRand &rand)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = rand.uniform(0, 4) == 0 ? static_cast<unsigned char>(rand.uniform(1, 4)) : 0;
+  }
+  for (unsigned int n = 0; n < 100; n++) {
+    const unsigned char value = static_cast<unsigned char>(rand.uniform(0, 4));
+    const unsigned int top = static_cast<unsigned int>(rand.uniform(0, static_cast<int>(height)));
+    const unsigned int left = static_cast<unsigned int>(rand.uniform(0, static_cast<int>(width)));
+    const unsigned int bottom = std::min(height, top + static_cast<unsigned int>(rand.uniform(1, 80)));
+    const unsigned int right = std::min(width, left + static_cast<unsigned int>(rand.uniform(1, 80)));
+    for (unsigned int i = top; i < bottom; i++) {
+      for (unsigned int j = left; j < right; j++) {
+        I[i][j] = value;
+      }
+    }
+  }
+  return I;
+}
+
+void checkComponents(const vpImage<int> &labels, int nbComponents,
+                     const std::vector<vp::vpConnectedComponent> &components)
+{
+  std::vector<unsigned int> area(static_cast<size_t>(nbComponents), 0);
+  std::vector<double> sum_i(area.size(), 0.0), sum_j(area.size(), 0.0);
+  std::vector<unsigned int> min_i(area.size(), labels.getHeight()), max_i(area.size(), 0);
+  std::vector<unsigned int> min_j(area.size(), labels.getWidth()), max_j(area.size(), 0);
+  for (unsigned int i = 0; i < labels.getHeight(); i++) {
+    for (unsigned int j = 0; j < labels.getWidth(); j++) {
+      const int label = labels[i][j];
+      if (label == 0) {
+        continue;
+      }
+      const size_t k = static_cast<size_t>(label - 1);
+      min_i[k] = std::min(min_i[k], i);
+      max_i[k] = std::max(max_i[k], i);
+      min_j[k] = std::min(min_j[k], j);
+      max_j[k] = std::max(max_j[k], j);
+      area[k]++;
+      sum_i[k] += i;
+      sum_j[k] += j;
+    }
+  }
+
+  REQUIRE(components.size() == area.size());
+  for (size_t k = 0; k < area.size(); k++) {
+    CHECK(components[k].area == area[k]);
+    CHECK(components[k].bbox == vpRect(min_j[k], min_i[k], max_j[k] - min_j[k] + 1, max_i[k] - min_i[k] + 1));
+    CHECK(components[k].centroid.get_i() == Approx(sum_i[k] / area[k]));
+    CHECK(components[k].centroid.get_j() == Approx(sum_j[k] / area[k]));
+  }
+}
+} // namespace
+
+TEST_CASE("Connected components", "[benchmark]")
+{
+  vpUniRand rand(42);
+  const vpImage<unsigned char> I =
+    generateImage(static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), rand);
+
+  const vpImageMorphology::vpConnexityType connexities[2] = { vpImageMorphology::CONNEXITY_4,
+                                                              vpImageMorphology::CONNEXITY_8 };
+  for (int c = 0; c < 2; c++) {
+    const vpImageMorphology::vpConnexityType connexity = connexities[c];
+    const std::string connexityName = connexity == vpImageMorphology::CONNEXITY_4 ? "4-connexity" : "8-connexity";
+
+    SECTION(connexityName)
+    {
+      vpImage<int> labels_ref;
+      int nbComponents_ref = connectedComponentsRef(I, labels_ref, connexity);
+
+      vpImage<int> labels;
+      int nbComponents = 0;
+      vp::connectedComponents(I, labels, nbComponents, connexity);
+      CHECK(nbComponents == nbComponents_ref);
+      CHECK(labels == labels_ref);
+
+      const unsigned int nbThreads[3] = { 1, 3, 0 };
+      for (int t = 0; t < 3; t++) {
+        std::vector<vp::vpConnectedComponent> components;
+        vp::connectedComponents(I, labels, nbComponents, components, connexity, nbThreads[t]);
+        CHECK(nbComponents == nbComponents_ref);
+        CHECK(labels == labels_ref);
+        checkComponents(labels, nbComponents, components);
+      }
+
+      // Single row and single column images
+      vpImage<unsigned char> I_row(1, I.getWidth()), I_col(I.getHeight(), 1);
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        I_row[0][j] = I[0][j];
+      }
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        I_col[i][0] = I[i][0];
+      }
+      connectedComponentsRef(I_row, labels_ref, connexity);
+      vp::connectedComponents(I_row, labels, nbComponents, connexity);
+      CHECK(labels == labels_ref);
+      std::vector<vp::vpConnectedComponent> components;
+      nbComponents_ref = connectedComponentsRef(I_col, labels_ref, connexity);
+      vp::connectedComponents(I_col, labels, nbComponents, components, connexity, 4);
+      CHECK(nbComponents == nbComponents_ref);
+      CHECK(labels == labels_ref);
+
+      if (g_runBenchmark) {
+        BENCHMARK("Connected components (breadth-first) " + connexityName)
+        {
+          connectedComponentsRef(I, labels_ref, connexity);
+          return labels_ref;
+        };
+
+        BENCHMARK("Connected components (ViSP) " + connexityName)
+        {
+          vp::connectedComponents(I, labels, nbComponents, connexity);
+          return labels;
+        };
+
+        BENCHMARK("Connected components with statistics (ViSP, all threads) " + connexityName)
+        {
+          vp::connectedComponents(I, labels, nbComponents, components, connexity, 0);
+          return labels;
+        };
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
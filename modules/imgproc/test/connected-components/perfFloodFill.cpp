@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Benchmark flood fill.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <queue>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 640;
+int g_height = 480;
+
+// Pixel by pixel breadth-first flood fill
+void floodFillRef(vpImage<unsigned char> &I, const std::vector<vpImagePoint> &seedPoints, unsigned char oldValue,
+                  unsigned char newValue, const vpImageMorphology::vpConnexityType &connexity)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  std::queue<std::pair<int, int> > queue;
+  for (size_t k = 0; k < seedPoints.size(); k++) {
+    const int i = static_cast<int>(seedPoints[k].get_i()), j = static_cast<int>(seedPoints[k].get_j());
+    if (i >= 0 && i < height && j >= 0 && j < width && I[i][j] == oldValue) {
+      I[i][j] = newValue;
+      queue.push(std::make_pair(i, j));
+    }
+
+    while (!queue.empty()) {
+      const int u = queue.front().first, v = queue.front().second;
+      queue.pop();
+      for (int di = -1; di <= 1; di++) {
+        for (int dj = -1; dj <= 1; dj++) {
+          if ((di == 0 && dj == 0) || (connexity == vpImageMorphology::CONNEXITY_4 && di != 0 && dj != 0)) {
+            continue;
+          }
+          const int n_i = u + di, n_j = v + dj;
+          if (n_i >= 0 && n_i < height && n_j >= 0 && n_j < width && I[n_i][n_j] == oldValue) {
+            I[n_i][n_j] = newValue;
+            queue.push(std::make_pair(n_i, n_j));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Binary image of random thin rings, with holes, on a sparse noisy background
+vpImage<unsigned char> generateImage(unsigned int height, unsigned int width, vpUniRand &rand)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = rand.uniform(0, 3) == 0 ? 255 : 0;
+  }
+  for (unsigned int n = 0; n < 40; n++) {
+    const int ci = rand.uniform(0, static_cast<int>(height)), cj = rand.uniform(0, static_cast<int>(width));
+    const int radius = rand.uniform(5, 80);
+    for (int i = std::max(0, ci - radius); i < std::min(static_cast<int>(height), ci + radius); i++) {
+      for (int j = std::max(0, cj - radius); j < std::min(static_cast<int>(width), cj + radius); j++) {
+        const int d2 = (i - ci) * (i - ci) + (j - cj) * (j - cj);
+        if (d2 < radius * radius) {
+          I[i][j] = d2 > (radius - 2) * (radius - 2) ? 255 : 0;
+        }
+      }
+    }
+  }
+  return I;
+}
+} // namespace
+
+TEST_CASE("Flood fill", "[benchmark]")
+{
+  vpUniRand rand(42);
+  const vpImage<unsigned char> I =
+    generateImage(static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), rand);
+
+  std::vector<vpImagePoint> seedPoints;
+  for (unsigned int n = 0; n < 20; n++) {
+    seedPoints.push_back(vpImagePoint(rand.uniform(0, g_height), rand.uniform(0, g_width)));
+  }
+  // Outside of the image
+  seedPoints.push_back(vpImagePoint(-1, 0));
+  seedPoints.push_back(vpImagePoint(0, g_width));
+
+  const vpImageMorphology::vpConnexityType connexities[2] = { vpImageMorphology::CONNEXITY_4,
+                                                              vpImageMorphology::CONNEXITY_8 };
+  for (int c = 0; c < 2; c++) {
+    const vpImageMorphology::vpConnexityType connexity = connexities[c];
+    const std::string connexityName = connexity == vpImageMorphology::CONNEXITY_4 ? "4-connexity" : "8-connexity";
+
+    SECTION(connexityName)
+    {
+      vpImage<unsigned char> I_fill, I_ref;
+      for (size_t k = 0; k < seedPoints.size(); k++) {
+        I_fill = I;
+        I_ref = I;
+        vp::floodFill(I_fill, seedPoints[k], 0, 128, connexity);
+        floodFillRef(I_ref, std::vector<vpImagePoint>(1, seedPoints[k]), 0, 128, connexity);
+        CHECK(I_fill == I_ref);
+      }
+
+      I_fill = I;
+      I_ref = I;
+      vp::floodFill(I_fill, seedPoints, 255, 128, connexity);
+      floodFillRef(I_ref, seedPoints, 255, 128, connexity);
+      CHECK(I_fill == I_ref);
+
+      if (g_runBenchmark) {
+        const std::vector<vpImagePoint> seedPoint(1, vpImagePoint(0, 0));
+        vpImage<unsigned char> I_background(I.getHeight(), I.getWidth(), 0);
+
+        BENCHMARK("Flood fill (breadth-first) " + connexityName)
+        {
+          I_ref = I_background;
+          floodFillRef(I_ref, seedPoint, 0, 255, connexity);
+          return I_ref;
+        };
+
+        BENCHMARK("Flood fill (ViSP) " + connexityName)
+        {
+          I_fill = I_background;
+          vp::floodFill(I_fill, seedPoint[0], 0, 255, connexity);
+          return I_fill;
+        };
+      }
+    }
+  }
+}
+
+TEST_CASE("Fill holes", "[benchmark]")
+{
+  vpUniRand rand(42);
+  const vpImage<unsigned char> I =
+    generateImage(static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), rand);
+
+  // Reference: flood fill of the background from a padded border
+  vpImage<unsigned char> I_padded(I.getHeight() + 2, I.getWidth() + 2, 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I_padded[i + 1][j + 1] = I[i][j];
+    }
+  }
+  floodFillRef(I_padded, std::vector<vpImagePoint>(1, vpImagePoint(0, 0)), 0, 128,
+               vpImageMorphology::CONNEXITY_4);
+  vpImage<unsigned char> I_ref(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I_ref[i][j] = I_padded[i + 1][j + 1] == 128 ? 0 : 255;
+    }
+  }
+
+  vpImage<unsigned char> I_fill = I;
+  vp::fillHoles(I_fill);
+  CHECK(I_fill == I_ref);
+
+  if (g_runBenchmark) {
+    BENCHMARK("Fill holes (ViSP)")
+    {
+      I_fill = I;
+      vp::fillHoles(I_fill);
+      return I_fill;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark circle Hough transform.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_17)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpCircleHoughTransform.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 640;
+int g_height = 480;
+
+// Bright discs on a dark noisy background, whose (row, col, radius) are given in fractions of the image height
+void generateDiscs(vpImage<unsigned char> &I, unsigned int height, unsigned int width,
+                   std::vector<vpImageCircle> &circles)
+{
+  const double discs[3][3] = { { 0.3, 0.35, 0.12 }, { 0.55, 0.9, 0.15 }, { 0.7, 0.35, 0.1 } };
+  circles.clear();
+  I.resize(height, width, 50);
+  for (unsigned int k = 0; k < 3; k++) {
+    const double ci = discs[k][0] * height, cj = discs[k][1] * height, radius = discs[k][2] * height;
+    circles.push_back(vpImageCircle(vpImagePoint(ci, cj), static_cast<float>(radius)));
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        if (vpMath::sqr(i - ci) + vpMath::sqr(j - cj) < vpMath::sqr(radius)) {
+          I[i][j] = 200;
+        }
+      }
+    }
+  }
+
+  vpUniRand rng(7);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(I.bitmap[i] + rng.uniform(0, 10));
+  }
+}
+
+vpCircleHoughTransform::vpCircleHoughTransformParameters getParameters(unsigned int height, unsigned int width)
+{
+  return vpCircleHoughTransform::vpCircleHoughTransformParameters(
+    5, 1.f, 3, 10.f, 20.f, 0, std::pair<int, int>(0, width), std::pair<int, int>(0, height),
+    static_cast<unsigned int>(0.08 * height), static_cast<unsigned int>(0.2 * height), 5, 5,
+    0.1f * height, 0.7f, 0.9f, 0.05f * height, 0.05f * height, vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING,
+    vpImageFilter::CANNY_VISP_BACKEND, 0.6f, 0.8f, -1, true);
+}
+
+// Index of the detection matching the circle, -1 if none
+int findCircle(const std::vector<vpImageCircle> &detections, const vpImageCircle &circle, double tolerance)
+{
+  for (size_t k = 0; k < detections.size(); k++) {
+    if ((vpImagePoint::distance(detections[k].getCenter(), circle.getCenter()) < tolerance) &&
+        (std::fabs(detections[k].getRadius() - circle.getRadius()) < tolerance)) {
+      return static_cast<int>(k);
+    }
+  }
+  return -1;
+}
+} // namespace
+
+TEST_CASE("Circle Hough transform", "[circle_hough]")
+{
+  vpImage<unsigned char> I;
+  std::vector<vpImageCircle> circles;
+  generateDiscs(I, 480, 640, circles);
+
+  vpCircleHoughTransform detector(getParameters(I.getHeight(), I.getWidth()));
+  std::vector<vpImageCircle> detections = detector.detect(I);
+  for (size_t k = 0; k < circles.size(); k++) {
+    CHECK(findCircle(detections, circles[k], 3.) >= 0);
+  }
+
+  SECTION("Voting points")
+  {
+    std::optional<vpImage<bool> > mask;
+    std::optional<std::vector<std::vector<std::pair<unsigned int, unsigned int> > > > votingPoints;
+    detector.computeVotingMask(I, detections, mask, votingPoints);
+    REQUIRE(votingPoints);
+    REQUIRE(votingPoints->size() == detections.size());
+    for (size_t k = 0; k < detections.size(); k++) {
+      CHECK(!(*votingPoints)[k].empty());
+      for (size_t p = 0; p < (*votingPoints)[k].size(); p++) {
+        const vpImagePoint pt((*votingPoints)[k][p].first, (*votingPoints)[k][p].second);
+        CHECK(std::fabs(vpImagePoint::distance(pt, detections[k].getCenter()) - detections[k].getRadius()) < 4.);
+      }
+    }
+  }
+
+  SECTION("Multi-threading")
+  {
+    detector.setNbThreads(4);
+    std::vector<vpImageCircle> detections_mt = detector.detect(I);
+    // The per-thread accumulators are summed in a different order, which may move the centers having close votes
+    REQUIRE(detections_mt.size() == detections.size());
+    for (size_t k = 0; k < circles.size(); k++) {
+      CHECK(findCircle(detections_mt, circles[k], 3.) >= 0);
+    }
+  }
+
+  SECTION("Edge decimation")
+  {
+    detector.setEdgeDecimationStep(2);
+    std::vector<vpImageCircle> detections_decim = detector.detect(I);
+    for (size_t k = 0; k < circles.size(); k++) {
+      CHECK(findCircle(detections_decim, circles[k], 3.) >= 0);
+    }
+    CHECK_THROWS(detector.setEdgeDecimationStep(0));
+  }
+}
+
+TEST_CASE("Circle Hough transform benchmark", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    vpImage<unsigned char> I;
+    std::vector<vpImageCircle> circles;
+    generateDiscs(I, static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), circles);
+
+    vpCircleHoughTransform::vpCircleHoughTransformParameters params = getParameters(I.getHeight(), I.getWidth());
+    vpCircleHoughTransform detector(params);
+    BENCHMARK("Circle Hough transform")
+    {
+      return detector.detect(I);
+    };
+
+    detector.setNbThreads(0);
+    BENCHMARK("Circle Hough transform (all threads)")
+    {
+      return detector.detect(I);
+    };
+
+    detector.setEdgeDecimationStep(2);
+    BENCHMARK("Circle Hough transform (all threads, edge decimation 2)")
+    {
+      return detector.detect(I);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
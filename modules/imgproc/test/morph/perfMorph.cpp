@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Benchmark morphological reconstruction.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_width = 640;
+int g_height = 480;
+
+// Reconstruction by iterated geodesic dilations, as in the definition
+void reconstructRef(const vpImage<unsigned char> &marker, const vpImage<unsigned char> &mask,
+                    vpImage<unsigned char> &h_kp1, const vpImageMorphology::vpConnexityType &connexity)
+{
+  vpImage<unsigned char> h_k = marker;
+  h_kp1 = h_k;
+
+  do {
+    vpImageMorphology::dilatation<unsigned char>(h_kp1, connexity);
+
+    for (unsigned int i = 0; i < h_kp1.getHeight(); i++) {
+      for (unsigned int j = 0; j < h_kp1.getWidth(); j++) {
+        h_kp1[i][j] = std::min<unsigned char>(h_kp1[i][j], mask[i][j]);
+      }
+    }
+
+    if (h_kp1 == h_k) {
+      break;
+    }
+
+    h_k = h_kp1;
+  } while (true);
+}
+
+// Smooth gray level image made of random bright discs on a noisy background
+vpImage<unsigned char> generateImage(unsigned int height, unsigned int width, vpUniRand &rand)
+{
+  vpImage<unsigned char> I(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rand.uniform(0, 40));
+  }
+  for (unsigned int n = 0; n < 60; n++) {
+    int ci = rand.uniform(0, static_cast<int>(height)), cj = rand.uniform(0, static_cast<int>(width));
+    int radius = rand.uniform(5, 60);
+    int top = rand.uniform(80, 256);
+    for (int i = std::max(0, ci - radius); i < std::min(static_cast<int>(height), ci + radius); i++) {
+      for (int j = std::max(0, cj - radius); j < std::min(static_cast<int>(width), cj + radius); j++) {
+        int d2 = (i - ci) * (i - ci) + (j - cj) * (j - cj);
+        if (d2 < radius * radius) {
+          int value = top - (top - 40) * d2 / (radius * radius);
+          I[i][j] = static_cast<unsigned char>(std::max<int>(I[i][j], value));
+        }
+      }
+    }
+  }
+  return I;
+}
+} // namespace
+
+TEST_CASE("Morphological reconstruction", "[benchmark]")
+{
+  vpUniRand rand(42);
+  const vpImage<unsigned char> mask =
+    generateImage(static_cast<unsigned int>(g_height), static_cast<unsigned int>(g_width), rand);
+
+  // h-dome marker, below the mask
+  vpImage<unsigned char> marker_dome(mask.getHeight(), mask.getWidth());
+  for (unsigned int i = 0; i < mask.getSize(); i++) {
+    marker_dome.bitmap[i] = static_cast<unsigned char>(std::max(0, mask.bitmap[i] - 30));
+  }
+
+  // Sparse marker, partly above the mask
+  vpImage<unsigned char> marker_sparse(mask.getHeight(), mask.getWidth(), 0);
+  for (unsigned int n = 0; n < 200; n++) {
+    unsigned int index = static_cast<unsigned int>(rand.uniform(0, static_cast<int>(mask.getSize())));
+    marker_sparse.bitmap[index] = static_cast<unsigned char>(rand.uniform(0, 256));
+  }
+
+  const vpImageMorphology::vpConnexityType connexities[2] = { vpImageMorphology::CONNEXITY_4,
+                                                              vpImageMorphology::CONNEXITY_8 };
+  for (int c = 0; c < 2; c++) {
+    const vpImageMorphology::vpConnexityType connexity = connexities[c];
+    const std::string connexityName = connexity == vpImageMorphology::CONNEXITY_4 ? "4-connexity" : "8-connexity";
+
+    SECTION(connexityName)
+    {
+      vpImage<unsigned char> I, I_ref;
+      vp::reconstruct(marker_dome, mask, I, connexity);
+      reconstructRef(marker_dome, mask, I_ref, connexity);
+      CHECK(I == I_ref);
+
+      vp::reconstruct(marker_sparse, mask, I, connexity);
+      reconstructRef(marker_sparse, mask, I_ref, connexity);
+      CHECK(I == I_ref);
+
+      if (g_runBenchmark) {
+        BENCHMARK("Reconstruction (iterated dilations) " + connexityName)
+        {
+          reconstructRef(marker_sparse, mask, I_ref, connexity);
+          return I_ref;
+        };
+
+        BENCHMARK("Reconstruction (ViSP) " + connexityName)
+        {
+          vp::reconstruct(marker_sparse, mask, I, connexity);
+          return I;
+        };
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_width, "width")["--width"]("Image width")
+             | Opt(g_height, "height")["--height"]("Image height");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
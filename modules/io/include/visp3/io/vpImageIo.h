@@ -134,6 +134,16 @@ public:
   static void write(const vpImage<unsigned char> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
   static void write(const vpImage<vpRGBa> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
 
+  static void readBatch(std::vector<vpImage<unsigned char> > &ivec, const std::vector<std::string> &filenames,
+                        int backend = IO_DEFAULT_BACKEND, unsigned int nThreads = 0);
+  static void readBatch(std::vector<vpImage<vpRGBa> > &ivec, const std::vector<std::string> &filenames,
+                        int backend = IO_DEFAULT_BACKEND, unsigned int nThreads = 0);
+
+  static void writeBatch(const std::vector<vpImage<unsigned char> > &ivec, const std::vector<std::string> &filenames,
+                         int backend = IO_DEFAULT_BACKEND, unsigned int nThreads = 0);
+  static void writeBatch(const std::vector<vpImage<vpRGBa> > &ivec, const std::vector<std::string> &filenames,
+                         int backend = IO_DEFAULT_BACKEND, unsigned int nThreads = 0);
+
   static void readPFM(vpImage<float> &I, const std::string &filename);
   static void readPFM_HDR(vpImage<float> &I, const std::string &filename);
   static void readPFM_HDR(vpImage<vpRGBf> &I, const std::string &filename);
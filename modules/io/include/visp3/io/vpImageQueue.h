@@ -36,11 +36,13 @@
 
 #include <visp3/core/vpConfig.h>
 
+#include <algorithm>
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpIoTools.h>
@@ -55,6 +57,10 @@
 
   This call is to use with vpImageStorageWorker.
 
+  The queue is a ring of image slots. The pixel buffers are reused: push() copies the image in a buffer taken
+  from a small pool of recycled buffers (see setPoolSize()) instead of allocating a new image, and pop() swaps
+  the queued buffer with the one of the output image. When the queue is full, the oldest image is dropped and
+  its buffer is reused; getNbDroppedImages() and getQueueSize() allow to monitor if the storage falls behind.
 */
 template <class Type> class vpImageQueue
 {
@@ -70,10 +76,14 @@ public:
    * \param[in] record_mode : 0 to record a sequence of images, 1 to record single images.
    */
   vpImageQueue(const std::string &seqname, int record_mode)
-    : m_cancelled(false), m_cond(), m_queue_image(), m_queue_data(), m_maxQueueSize(1024 * 8), m_mutex(),
-    m_seqname(seqname), m_recording_mode(record_mode), m_start_recording(false), m_directory_to_create(false),
-    m_recording_trigger(false)
+    : m_cancelled(false), m_cond(), m_ring(), m_ring_data(), m_head(0), m_size(0), m_pool(), m_poolSize(4),
+    m_nbDropped(0), m_maxQueueSize(1024 * 8), m_mutex(), m_seqname(seqname), m_recording_mode(record_mode),
+    m_start_recording(false), m_directory_to_create(false), m_recording_trigger(false)
   {
+    m_ring.resize(m_maxQueueSize);
+    m_ring_data.resize(m_maxQueueSize);
+    m_pool.reserve(m_poolSize);
+
     m_directory = vpIoTools::getParent(seqname);
     if (!m_directory.empty()) {
       if (!vpIoTools::checkDirectory(m_directory)) {
@@ -95,6 +105,24 @@ public:
     m_cond.notify_all();
   }
 
+  /*!
+   * Return the number of images that were dropped because the queue was full.
+   */
+  unsigned long getNbDroppedImages()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nbDropped;
+  }
+
+  /*!
+   * Return the number of images currently waiting in the queue.
+   */
+  size_t getQueueSize()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+  }
+
   /*!
    * Return record mode; 0 when recording a sequence of images, 1 when recording recording single imagess.
    */
@@ -113,15 +141,15 @@ public:
   /*!
    * Pop the image to save from the queue (FIFO).
    *
-   * \param[out] I : Image to record.
-   * \param[out] data : Data to record.
+   * \param[out] I : Image to record. Its previous pixel buffer is given back to the queue to be reused.
+   * \param[out] data : Data to record, empty if no data was pushed with the image.
    *
    */
   void pop(vpImage<Type> &I, std::string &data)
   {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    while (m_queue_image.empty()) {
+    while (m_size == 0) {
       if (m_cancelled) {
         throw vpCancelled_t();
       }
@@ -133,13 +161,23 @@ public:
       }
     }
 
-    I = m_queue_image.front();
+    vpImage<Type> &slot = m_ring[m_head];
+    swapBuffers(I, slot);
+    data.swap(m_ring_data[m_head]);
+    m_ring_data[m_head].clear();
 
-    m_queue_image.pop();
+    m_head = (m_head + 1) % m_ring.size();
+    m_size--;
 
-    if (!m_queue_data.empty()) {
-      data = m_queue_data.front();
-      m_queue_data.pop();
+    // Keep the previous buffer of the output image for a next push
+    if (slot.getSize() > 0) {
+      if (m_pool.size() < m_poolSize) {
+        m_pool.push_back(vpImage<Type>());
+        swapBuffers(m_pool.back(), slot);
+      }
+      else {
+        slot.destroy();
+      }
     }
   }
 
@@ -153,22 +191,27 @@ public:
   {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    m_queue_image.push(I);
-
-    if (data != nullptr) {
-      m_queue_data.push(*data);
+    vpImage<Type> &slot = m_ring[acquireSlot(data)];
+    slot.resize(I.getHeight(), I.getWidth());
+    if (I.getSize() > 0) {
+      memcpy(slot.bitmap, I.bitmap, I.getSize() * sizeof(Type));
     }
 
-    // Pop extra data in the queue
-    while (m_queue_image.size() > m_maxQueueSize) {
-      m_queue_image.pop();
-    }
+    m_cond.notify_one();
+  }
 
-    if (data != nullptr) {
-      while (m_queue_data.size() > m_maxQueueSize) {
-        m_queue_data.pop();
-      }
-    }
+  /*!
+   * Push data to save in the queue (FIFO) without copying the image.
+   *
+   * \param[in] I : Image to record. On return, it contains a recycled buffer (possibly empty) that can be used to
+   * acquire the next image.
+   * \param[in] data : Data to record.
+   */
+  void push(vpImage<Type> &&I, std::string *data)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    swapBuffers(m_ring[acquireSlot(data)], I);
 
     m_cond.notify_one();
   }
@@ -260,16 +303,110 @@ public:
   }
 
   /*!
-   * Set queue size.
+   * Set queue size. If more images are waiting in the queue, the oldest ones are dropped.
    * \param[in] max_queue_size : Queue size.
    */
-  void setMaxQueueSize(const size_t max_queue_size) { m_maxQueueSize = max_queue_size; }
+  void setMaxQueueSize(const size_t max_queue_size)
+  {
+    if (max_queue_size == 0) {
+      throw(vpException(vpException::badValue, "The image queue size should be at least 1"));
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const size_t nb_kept = std::min<size_t>(m_size, max_queue_size);
+    std::vector<vpImage<Type> > ring(max_queue_size);
+    std::vector<std::string> ring_data(max_queue_size);
+    for (size_t k = 0; k < nb_kept; k++) {
+      const size_t idx = (m_head + m_size - nb_kept + k) % m_ring.size();
+      swapBuffers(ring[k], m_ring[idx]);
+      ring_data[k].swap(m_ring_data[idx]);
+    }
+    m_nbDropped += m_size - nb_kept;
+
+    m_ring.swap(ring);
+    m_ring_data.swap(ring_data);
+    m_head = 0;
+    m_size = nb_kept;
+    m_maxQueueSize = max_queue_size;
+  }
+
+  /*!
+   * Set the number of free image buffers that are kept to be reused by push(). By default 4 buffers are kept.
+   *
+   * \param[in] pool_size : Number of free buffers to keep.
+   * \param[in] height, width : When not null, the pool is filled with buffers of this size, to avoid any
+   * allocation when the recording starts.
+   */
+  void setPoolSize(size_t pool_size, unsigned int height = 0, unsigned int width = 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<vpImage<Type> > pool;
+    pool.reserve(pool_size);
+    for (size_t k = 0; k < std::min<size_t>(pool_size, m_pool.size()); k++) {
+      pool.push_back(vpImage<Type>());
+      swapBuffers(pool.back(), m_pool[k]);
+    }
+    if (height > 0 && width > 0) {
+      while (pool.size() < pool_size) {
+        pool.push_back(vpImage<Type>());
+        pool.back().resize(height, width);
+      }
+    }
+    m_pool.swap(pool);
+    m_poolSize = pool_size;
+  }
 
 private:
+  /*!
+   * Reserve the slot of the ring where the next image is pushed, dropping the oldest image if the queue is full.
+   * Must be called with the mutex locked.
+   */
+  size_t acquireSlot(const std::string *data)
+  {
+    size_t idx;
+    if (m_size == m_ring.size()) {
+      // The oldest image is dropped and its buffer reused
+      idx = m_head;
+      m_head = (m_head + 1) % m_ring.size();
+      m_nbDropped++;
+    }
+    else {
+      idx = (m_head + m_size) % m_ring.size();
+      m_size++;
+      if (m_ring[idx].getSize() == 0 && !m_pool.empty()) {
+        swapBuffers(m_ring[idx], m_pool.back());
+        m_pool.pop_back();
+      }
+    }
+
+    if (data != nullptr) {
+      m_ring_data[idx] = *data;
+    }
+    else {
+      m_ring_data[idx].clear();
+    }
+    return idx;
+  }
+
+  /*!
+   * Exchange the pixel buffers of two images, each image staying attached to its own display.
+   */
+  static void swapBuffers(vpImage<Type> &I1, vpImage<Type> &I2)
+  {
+    swap(I1, I2);
+    std::swap(I1.display, I2.display);
+  }
+
   bool m_cancelled;
   std::condition_variable m_cond;
-  std::queue<vpImage<Type> > m_queue_image;
-  std::queue<std::string> m_queue_data;
+  std::vector<vpImage<Type> > m_ring;
+  std::vector<std::string> m_ring_data;
+  size_t m_head;
+  size_t m_size;
+  std::vector<vpImage<Type> > m_pool;
+  size_t m_poolSize;
+  unsigned long m_nbDropped;
   size_t m_maxQueueSize;
   std::mutex m_mutex;
   std::string m_seqname;
@@ -36,6 +36,11 @@
 
 #include <visp3/core/vpConfig.h>
 
+#include <map>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include <visp3/io/vpImageIo.h>
 #include <visp3/io/vpImageQueue.h>
 
@@ -46,6 +51,8 @@
 
   Save data contained in an vpImageQueue.
 
+  Images can be encoded by several threads (see setNbThreads()). The images keep the index of their position in
+  the queue in their file name and the lines of the data file are written in the same order.
 */
 template <class Type> class vpImageStorageWorker
 {
@@ -55,16 +62,55 @@ public:
    * \param[in] queue : A reference to a queue.
    */
   vpImageStorageWorker(vpImageQueue<Type> &queue)
-    : m_queue(queue), m_dataname(""), m_cpt(1), m_ofs_data(), m_data_file_created(false)
+    : m_queue(queue), m_dataname(""), m_cpt(1), m_ofs_data(), m_data_file_created(false), m_nThreads(1),
+    m_mutex_pop(), m_mutex_data(), m_data_next(1), m_data_pending()
   {
     m_seqname = queue.getSeqName();
     m_record_mode = queue.getRecordingMode();
   }
 
   /*!
-   * Thread main loop that save the images and additional data.
+   * Thread main loop that save the images and additional data. When more than one thread is set with
+   * setNbThreads(), the additional encoding threads are started and joined by this function.
    */
   void run()
+  {
+    std::vector<std::thread> encoders;
+    for (unsigned int i = 1; i < m_nThreads; i++) {
+      encoders.push_back(std::thread(&vpImageStorageWorker<Type>::save, this));
+    }
+    save();
+    for (size_t i = 0; i < encoders.size(); i++) {
+      encoders[i].join();
+    }
+
+    if (std::is_same<Type, vpRGBa>::value) {
+      std::cout << "Receive cancel during color image saving." << std::endl;
+    }
+    else {
+      std::cout << "Receive cancel during gray image saving." << std::endl;
+    }
+    if (m_data_file_created) {
+      std::cout << "Close data file: " << m_dataname << std::endl;
+      m_ofs_data.close();
+    }
+  }
+
+  /*!
+   * Set the number of threads used to encode the images.
+   * \param[in] nThreads : Number of threads. When 0, the number of concurrent threads supported by the
+   * hardware is used. Default is 1.
+   */
+  void setNbThreads(unsigned int nThreads)
+  {
+    m_nThreads = (nThreads == 0) ? std::max<unsigned int>(1, std::thread::hardware_concurrency()) : nThreads;
+  }
+
+private:
+  /*!
+   * Encoding loop, run by each encoding thread until the queue is cancelled and empty.
+   */
+  void save()
   {
     try {
       vpImage<Type> I;
@@ -72,56 +118,64 @@ public:
       char filename[FILENAME_MAX];
 
       for (;;) {
-        m_queue.pop(I, data);
+        unsigned int cpt;
+        {
+          // The index of an image is its position in the queue
+          std::lock_guard<std::mutex> lock(m_mutex_pop);
+          m_queue.pop(I, data);
+          cpt = m_cpt++;
+        }
 
         // Save image
-        snprintf(filename, FILENAME_MAX, m_seqname.c_str(), m_cpt);
+        snprintf(filename, FILENAME_MAX, m_seqname.c_str(), cpt);
 
         if (m_record_mode > 0) { // Single image
           std::cout << "Save image: " << filename << std::endl;
         }
-        else if (m_cpt == 1) {
+        else if (cpt == 1) {
           std::cout << "Started sequence saving: " << m_seqname << std::endl;
         }
         vpImageIo::write(I, filename);
 
-        if (!data.empty()) {
-          if (!m_data_file_created) {
-            std::string parent = vpIoTools::getParent(m_seqname);
-            if (!parent.empty()) {
-              m_dataname = vpIoTools::getParent(m_seqname) + "/";
-            }
-            m_dataname += vpIoTools::getNameWE(m_seqname);
-            m_dataname += ".txt";
-
-            std::cout << "Create data file: " << m_dataname << std::endl;
-            m_ofs_data.open(m_dataname);
-
-            m_data_file_created = true;
-          }
-          m_ofs_data << vpIoTools::getName(filename) << " " << data << std::endl;
-        }
-
-        m_cpt++;
+        saveData(cpt, data.empty() ? std::string() : vpIoTools::getName(filename) + " " + data);
       }
     }
-    catch (const vpImageQueue<vpRGBa>::vpCancelled_t &) {
-      std::cout << "Receive cancel during color image saving." << std::endl;
-      if (m_data_file_created) {
-        std::cout << "Close data file: " << m_dataname << std::endl;
-        m_ofs_data.close();
-      }
+    catch (const typename vpImageQueue<Type>::vpCancelled_t &) {
     }
-    catch (const vpImageQueue<unsigned char>::vpCancelled_t &) {
-      std::cout << "Receive cancel during gray image saving." << std::endl;
-      if (m_data_file_created) {
-        std::cout << "Close data file: " << m_dataname << std::endl;
-        m_ofs_data.close();
+  }
+
+  /*!
+   * Write the data lines in the order of the image indexes. The line of image \e cpt is kept until the lines of
+   * all the previous images are written. An empty line means that no data is attached to the image.
+   */
+  void saveData(unsigned int cpt, const std::string &line)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex_data);
+
+    m_data_pending[cpt] = line;
+    std::map<unsigned int, std::string>::iterator it;
+    while ((it = m_data_pending.find(m_data_next)) != m_data_pending.end()) {
+      if (!it->second.empty()) {
+        if (!m_data_file_created) {
+          std::string parent = vpIoTools::getParent(m_seqname);
+          if (!parent.empty()) {
+            m_dataname = vpIoTools::getParent(m_seqname) + "/";
+          }
+          m_dataname += vpIoTools::getNameWE(m_seqname);
+          m_dataname += ".txt";
+
+          std::cout << "Create data file: " << m_dataname << std::endl;
+          m_ofs_data.open(m_dataname);
+
+          m_data_file_created = true;
+        }
+        m_ofs_data << it->second << std::endl;
       }
+      m_data_pending.erase(it);
+      m_data_next++;
     }
   }
 
-private:
   vpImageQueue<Type> &m_queue;
   std::string m_seqname;
   std::string m_dataname;
@@ -129,6 +183,11 @@ private:
   unsigned int m_cpt;
   std::ofstream m_ofs_data;
   bool m_data_file_created;
+  unsigned int m_nThreads;
+  std::mutex m_mutex_pop;
+  std::mutex m_mutex_data;
+  unsigned int m_data_next;
+  std::map<unsigned int, std::string> m_data_pending;
 };
 
 #endif
@@ -0,0 +1,192 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Single file lossless image sequence container.
+ */
+
+/*!
+ * \file vpRawSequence.h
+ * \brief Single file lossless image sequence container.
+ */
+
+#ifndef vpRawSequence_h
+#define vpRawSequence_h
+
+#include <visp3/core/vpConfig.h>
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+ * \class vpRawSequence
+ *
+ * \ingroup group_io_video
+ *
+ * \brief Append-only container storing a sequence of images and their timestamps in a single file.
+ *
+ * Each record holds one grey level (`vpImage<unsigned char>`), color (`vpImage<vpRGBa>`) or depth
+ * (`vpImage<uint16_t>`) image, the stream it belongs to and a timestamp. Several streams, e.g. the color and the
+ * depth images of one or more RGB-D cameras, can thus be interleaved in the same file.
+ *
+ * The images are compressed with a fast lossless codec: each row is first delta encoded per channel, the bytes are
+ * then split by significance into planes and the result is compressed with an LZ77 byte oriented scheme close to
+ * LZ4. When compression does not pay off, the record is stored uncompressed. Encoding and decoding are much
+ * faster than PNG, which makes it possible to record full rate streams.
+ *
+ * An index of all the records is appended at the end of the file by close(). Opening the file in read mode loads
+ * this index, so that any record can be read in constant time with read(). If the index is missing, e.g. because
+ * the recording was interrupted, it is rebuilt by scanning the records. Opening an existing file in append mode
+ * allows to add new records to it.
+ *
+ * The files use the `.vpseq` extension and the images of stream 0 can also be read with vpVideoReader.
+ *
+ * \code
+ * #include <visp3/io/vpRawSequence.h>
+ *
+ * int main()
+ * {
+ *   vpImage<vpRGBa> color(480, 640);
+ *   vpImage<uint16_t> depth(480, 640);
+ *
+ *   vpRawSequence writer;
+ *   writer.open("rgbd.vpseq", vpRawSequence::MODE_WRITE);
+ *   for (unsigned int i = 0; i < 10; i++) {
+ *     double t = vpTime::measureTimeSecond();
+ *     // Acquire color and depth
+ *     writer.write(color, t, 0);
+ *     writer.write(depth, t, 1);
+ *   }
+ *   writer.close();
+ *
+ *   vpRawSequence reader;
+ *   reader.open("rgbd.vpseq", vpRawSequence::MODE_READ);
+ *   std::vector<size_t> depth_records = reader.getStreamRecords(1);
+ *   double t;
+ *   reader.read(depth, depth_records.back(), &t);
+ * }
+ * \endcode
+ *
+ * \sa vpVideoReader
+ */
+class VISP_EXPORT vpRawSequence
+{
+public:
+  //! Type of the pixels stored in a record.
+  typedef enum
+  {
+    PIXEL_UCHAR = 0,  //!< Grey level image, `vpImage<unsigned char>`.
+    PIXEL_RGBA = 1,   //!< Color image, `vpImage<vpRGBa>`.
+    PIXEL_UINT16 = 2  //!< Depth image, `vpImage<uint16_t>`.
+  } vpPixelType;
+
+  //! File opening mode.
+  typedef enum
+  {
+    MODE_READ,   //!< Open an existing file to read its records.
+    MODE_WRITE,  //!< Create a new file, or truncate an existing one.
+    MODE_APPEND  //!< Open an existing file, or create it, to add new records.
+  } vpOpenMode;
+
+  //! Description of a record as stored in the index.
+  typedef struct vpRecordInfo
+  {
+    uint64_t offset;       //!< Position of the record in the file.
+    unsigned int stream;   //!< Stream identifier.
+    vpPixelType type;      //!< Pixel type.
+    unsigned int width;    //!< Image width.
+    unsigned int height;   //!< Image height.
+    double timestamp;      //!< Timestamp given when the record was written.
+  } vpRecordInfo;
+
+  vpRawSequence();
+  virtual ~vpRawSequence();
+
+  void close();
+
+  /*!
+   * Return the number of records in the file.
+   */
+  inline size_t getNbRecords() const { return m_index.size(); }
+  const vpRecordInfo &getRecordInfo(size_t index) const;
+  std::vector<size_t> getStreamRecords(unsigned int stream) const;
+
+  /*!
+   * Return true if the file is open.
+   */
+  inline bool isOpen() const { return m_mode != MODE_CLOSED; }
+
+  void open(const std::string &filename, const vpOpenMode &mode);
+
+  void read(vpImage<unsigned char> &I, size_t index, double *timestamp = nullptr);
+  void read(vpImage<vpRGBa> &I, size_t index, double *timestamp = nullptr);
+  void read(vpImage<uint16_t> &I, size_t index, double *timestamp = nullptr);
+
+  /*!
+   * Enable or disable the LZ compression stage for the records written afterwards. When disabled, the delta
+   * encoded images are stored as is, which is the fastest option but uses more disk space. Enabled by default.
+   */
+  inline void setCompression(bool compress) { m_compress = compress; }
+
+  size_t write(const vpImage<unsigned char> &I, double timestamp, unsigned int stream = 0);
+  size_t write(const vpImage<vpRGBa> &I, double timestamp, unsigned int stream = 0);
+  size_t write(const vpImage<uint16_t> &I, double timestamp, unsigned int stream = 0);
+
+private:
+  // Opening state, extends vpOpenMode
+  static const int MODE_CLOSED = -1;
+
+  void buildIndex(uint64_t fileSize);
+  bool loadIndex(uint64_t fileSize);
+  void readPayload(const vpRecordInfo &info, unsigned int nbChannels, unsigned int channelSize, unsigned char *data);
+  size_t writeRecord(const unsigned char *data, unsigned int width, unsigned int height, unsigned int nbChannels,
+                     unsigned int channelSize, vpPixelType type, double timestamp, unsigned int stream);
+  void writeIndex();
+
+  std::fstream m_file;
+  std::string m_filename;
+  int m_mode;
+  bool m_compress;
+  bool m_modified;
+  //! Position where the next record is written
+  uint64_t m_end;
+  std::vector<vpRecordInfo> m_index;
+  // Scratch buffers reused from one record to the other
+  std::vector<unsigned char> m_raw;
+  std::vector<unsigned char> m_packed;
+  std::vector<unsigned char> m_converted;
+  std::vector<uint32_t> m_hashTable;
+};
+
+#endif
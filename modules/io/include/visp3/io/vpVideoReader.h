@@ -40,8 +40,10 @@
 #define _vpVideoReader_h_
 
 #include <string>
+#include <vector>
 
 #include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpRawSequence.h>
 
 #if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_VIDEOIO) && defined(HAVE_OPENCV_HIGHGUI)
 #include <opencv2/videoio/videoio.hpp>
@@ -74,6 +76,10 @@
  *   FLV, MKV video formats. Installation instructions are provided here
  *   https://visp.inria.fr/3rd_opencv.
  *
+ * Single file image sequences recorded with vpRawSequence (`.vpseq` extension)
+ * are read without any 3rd party. The frames are the grey level or color records
+ * of stream 0, indexed from 0, and getFrame() gives a direct access to any of them.
+ *
  * The following example available in tutorial-video-reader.cpp shows how this
  * class is really easy to use. It enables to read a video file named
  * video.mpeg.
@@ -166,6 +172,12 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
 private:
   //! To read sequences of images
   vpDiskGrabber *m_imSequence;
+  //! To read single file image sequences
+  vpRawSequence *m_rawSequence;
+  //! Records of stream 0 that are the frames of the single file image sequence
+  std::vector<size_t> m_rawSequenceRecords;
+  //! Index of the next record read from the single file image sequence
+  long m_rawSequenceNext;
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
   //! To read video files with OpenCV
   cv::VideoCapture m_capture;
@@ -196,6 +208,8 @@ private:
     FORMAT_WMV,
     FORMAT_FLV,
     FORMAT_MKV,
+    // ViSP single file image sequence
+    FORMAT_RAW_SEQUENCE,
     FORMAT_UNKNOWN
   } vpVideoFormatType;
 
@@ -373,6 +387,7 @@ private:
   bool isVideoExtensionSupported() const;
   bool checkImageNameFormat(const std::string &format) const;
   void getProperties();
+  template <class Type> bool getRawSequenceFrame(vpImage<Type> &I, long frame_index);
 };
 
 #endif
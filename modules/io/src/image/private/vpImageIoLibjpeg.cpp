@@ -219,29 +219,22 @@ void readJPEGLibjpeg(vpImage<unsigned char> &I, const std::string &filename)
 
   jpeg_start_decompress(&cinfo);
 
-  unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
-  JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
-
   if (cinfo.out_color_space == JCS_RGB) {
-    vpImage<vpRGBa> Ic(height, width);
-    unsigned char *output = (unsigned char *)Ic.bitmap;
+    // Each decoded RGB scanline is converted at once
+    unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
     while (cinfo.output_scanline < cinfo.output_height) {
+      unsigned int row = cinfo.output_scanline;
       jpeg_read_scanlines(&cinfo, buffer, 1);
-      for (unsigned int i = 0; i < width; i++) {
-        *(output++) = buffer[0][i * 3];
-        *(output++) = buffer[0][i * 3 + 1];
-        *(output++) = buffer[0][i * 3 + 2];
-        *(output++) = vpRGBa::alpha_default;
-      }
+      vpImageConvert::RGBToGrey(buffer[0], I[row], width);
     }
-    vpImageConvert::convert(Ic, I);
   }
 
   else if (cinfo.out_color_space == JCS_GRAYSCALE) {
+    // Decode directly in the image memory
     while (cinfo.output_scanline < cinfo.output_height) {
-      unsigned int row = cinfo.output_scanline;
-      jpeg_read_scanlines(&cinfo, buffer, 1);
-      memcpy(I[row], buffer[0], rowbytes);
+      JSAMPROW row = I[cinfo.output_scanline];
+      jpeg_read_scanlines(&cinfo, &row, 1);
     }
   }
 
@@ -298,34 +291,44 @@ void readJPEGLibjpeg(vpImage<vpRGBa> &I, const std::string &filename)
   if ((width != I.getWidth()) || (height != I.getHeight()))
     I.resize(height, width);
 
+#if defined(JCS_EXTENSIONS)
+  // libjpeg-turbo is able to output RGBA pixels with an opaque alpha channel, the layout of vpRGBa
+  if (cinfo.out_color_space == JCS_RGB) {
+    cinfo.out_color_space = JCS_EXT_RGBA;
+  }
+#endif
+
   jpeg_start_decompress(&cinfo);
 
   unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
-  JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
+
+#if defined(JCS_EXTENSIONS)
+  if (cinfo.out_color_space == JCS_EXT_RGBA) {
+    // Decode directly in the image memory
+    while (cinfo.output_scanline < cinfo.output_height) {
+      JSAMPROW row = reinterpret_cast<JSAMPROW>(I[cinfo.output_scanline]);
+      jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+  }
+#endif
 
   if (cinfo.out_color_space == JCS_RGB) {
-    unsigned char *output = (unsigned char *)I.bitmap;
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
     while (cinfo.output_scanline < cinfo.output_height) {
+      unsigned int row = cinfo.output_scanline;
       jpeg_read_scanlines(&cinfo, buffer, 1);
-      for (unsigned int i = 0; i < width; i++) {
-        *(output++) = buffer[0][i * 3];
-        *(output++) = buffer[0][i * 3 + 1];
-        *(output++) = buffer[0][i * 3 + 2];
-        *(output++) = vpRGBa::alpha_default;
-      }
+      vpImageConvert::RGBToRGBa(buffer[0], reinterpret_cast<unsigned char *>(I[row]), width);
     }
   }
 
   else if (cinfo.out_color_space == JCS_GRAYSCALE) {
-    vpImage<unsigned char> Ig(height, width);
-
+    // Each decoded scanline is converted at once
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowbytes, 1);
     while (cinfo.output_scanline < cinfo.output_height) {
       unsigned int row = cinfo.output_scanline;
       jpeg_read_scanlines(&cinfo, buffer, 1);
-      memcpy(Ig[row], buffer[0], rowbytes);
+      vpImageConvert::GreyToRGBa(buffer[0], reinterpret_cast<unsigned char *>(I[row]), width);
     }
-
-    vpImageConvert::convert(Ig, I);
   }
 
   jpeg_finish_decompress(&cinfo);
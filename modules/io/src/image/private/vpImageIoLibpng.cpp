@@ -356,6 +356,8 @@ void readPNGLibpng(vpImage<unsigned char> &I, const std::string &filename)
   else if (bit_depth < 8)
     png_set_packing(png_ptr);
 
+  const bool interlaced = (png_set_interlace_handling(png_ptr) > 1);
+
   /* update info structure to apply transformations */
   png_read_update_info(png_ptr, info_ptr);
 
@@ -366,57 +368,56 @@ void readPNGLibpng(vpImage<unsigned char> &I, const std::string &filename)
 
   png_bytep *rowPtrs = new png_bytep[height];
 
-  unsigned int stride = png_get_rowbytes(png_ptr, info_ptr);
-  unsigned char *data = new unsigned char[stride * height];
-
-  for (unsigned int i = 0; i < height; i++)
-    rowPtrs[i] = (png_bytep)data + (i * stride);
-
-  png_read_image(png_ptr, rowPtrs);
+  if (channels == 1) {
+    // Decode directly in the image memory
+    for (unsigned int i = 0; i < height; i++)
+      rowPtrs[i] = (png_bytep)I[i];
 
-  vpImage<vpRGBa> Ic(height, width);
-  unsigned char *output;
-
-  switch (channels) {
-  case 1:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i];
-    }
-    break;
-
-  case 2:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 2];
-    }
-    break;
-
-  case 3:
-    output = (unsigned char *)Ic.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 3];
-      *(output++) = data[i * 3 + 1];
-      *(output++) = data[i * 3 + 2];
-      *(output++) = vpRGBa::alpha_default;
+    png_read_image(png_ptr, rowPtrs);
+  }
+  else if (!interlaced && (channels == 3 || channels == 4)) {
+    // Decode and convert row by row
+    unsigned char *data = new unsigned char[png_get_rowbytes(png_ptr, info_ptr)];
+    for (unsigned int i = 0; i < height; i++) {
+      png_read_row(png_ptr, (png_bytep)data, nullptr);
+      if (channels == 3) {
+        vpImageConvert::RGBToGrey(data, I[i], width);
+      }
+      else {
+        vpImageConvert::RGBaToGrey(data, I[i], width);
+      }
     }
-    vpImageConvert::convert(Ic, I);
-    break;
-
-  case 4:
-    output = (unsigned char *)Ic.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 4];
-      *(output++) = data[i * 4 + 1];
-      *(output++) = data[i * 4 + 2];
-      *(output++) = data[i * 4 + 3];
+    delete[] data;
+  }
+  else {
+    unsigned int stride = png_get_rowbytes(png_ptr, info_ptr);
+    unsigned char *data = new unsigned char[stride * height];
+
+    for (unsigned int i = 0; i < height; i++)
+      rowPtrs[i] = (png_bytep)data + (i * stride);
+
+    png_read_image(png_ptr, rowPtrs);
+
+    unsigned char *output = (unsigned char *)I.bitmap;
+    switch (channels) {
+    case 2:
+      for (unsigned int i = 0; i < width * height; i++) {
+        *(output++) = data[i * 2];
+      }
+      break;
+
+    case 3:
+      vpImageConvert::RGBToGrey(data, I.bitmap, width * height);
+      break;
+
+    case 4:
+      vpImageConvert::RGBaToGrey(data, I.bitmap, width * height);
+      break;
     }
-    vpImageConvert::convert(Ic, I);
-    break;
+    delete[] data;
   }
 
   delete[](png_bytep) rowPtrs;
-  delete[] data;
   png_read_end(png_ptr, nullptr);
   png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
   fclose(file);
@@ -533,67 +534,54 @@ void readPNGLibpng(vpImage<vpRGBa> &I, const std::string &filename)
   else if (bit_depth < 8)
     png_set_packing(png_ptr);
 
+  /* interlaced images are expanded to RGBa by libpng, the layout of vpRGBa, since they cannot be read row by row */
+  const bool interlaced = (png_set_interlace_handling(png_ptr) > 1);
+  if (interlaced) {
+    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+      png_set_gray_to_rgb(png_ptr);
+    if (color_type != PNG_COLOR_TYPE_RGB_ALPHA)
+      png_set_filler(png_ptr, vpRGBa::alpha_default, PNG_FILLER_AFTER);
+  }
+
   /* update info structure to apply transformations */
   png_read_update_info(png_ptr, info_ptr);
 
   channels = png_get_channels(png_ptr, info_ptr);
 
+  if ((channels != 4) && (interlaced || (channels != 1 && channels != 3))) {
+    png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+    fclose(file);
+    throw(vpImageException(vpImageException::ioError, "Unsupported PNG pixel format in file \"%s\"",
+                           filename.c_str()));
+  }
+
   if ((width != I.getWidth()) || (height != I.getHeight()))
     I.resize(height, width);
 
-  png_bytep *rowPtrs = new png_bytep[height];
-
-  unsigned int stride = png_get_rowbytes(png_ptr, info_ptr);
-  unsigned char *data = new unsigned char[stride * height];
-
-  for (unsigned int i = 0; i < height; i++)
-    rowPtrs[i] = (png_bytep)data + (i * stride);
-
-  png_read_image(png_ptr, rowPtrs);
+  if (channels == 4) {
+    // Decode directly in the image memory
+    png_bytep *rowPtrs = new png_bytep[height];
+    for (unsigned int i = 0; i < height; i++)
+      rowPtrs[i] = (png_bytep)I[i];
 
-  vpImage<unsigned char> Ig(height, width);
-  unsigned char *output;
-
-  switch (channels) {
-  case 1:
-    output = (unsigned char *)Ig.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i];
-    }
-    vpImageConvert::convert(Ig, I);
-    break;
-
-  case 2:
-    output = (unsigned char *)Ig.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 2];
-    }
-    vpImageConvert::convert(Ig, I);
-    break;
-
-  case 3:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 3];
-      *(output++) = data[i * 3 + 1];
-      *(output++) = data[i * 3 + 2];
-      *(output++) = vpRGBa::alpha_default;
-    }
-    break;
-
-  case 4:
-    output = (unsigned char *)I.bitmap;
-    for (unsigned int i = 0; i < width * height; i++) {
-      *(output++) = data[i * 4];
-      *(output++) = data[i * 4 + 1];
-      *(output++) = data[i * 4 + 2];
-      *(output++) = data[i * 4 + 3];
+    png_read_image(png_ptr, rowPtrs);
+    delete[](png_bytep) rowPtrs;
+  }
+  else {
+    // Decode and convert row by row
+    unsigned char *data = new unsigned char[png_get_rowbytes(png_ptr, info_ptr)];
+    for (unsigned int i = 0; i < height; i++) {
+      png_read_row(png_ptr, (png_bytep)data, nullptr);
+      if (channels == 1) {
+        vpImageConvert::GreyToRGBa(data, reinterpret_cast<unsigned char *>(I[i]), width);
+      }
+      else {
+        vpImageConvert::RGBToRGBa(data, reinterpret_cast<unsigned char *>(I[i]), width);
+      }
     }
-    break;
+    delete[] data;
   }
 
-  delete[](png_bytep) rowPtrs;
-  delete[] data;
   png_read_end(png_ptr, nullptr);
   png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
   fclose(file);
@@ -41,6 +41,10 @@
 
 #include "private/vpImageIoBackend.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 vpImageIo::vpImageFormatType vpImageIo::getFormat(const std::string &filename)
 {
   std::string ext = vpImageIo::getExtension(filename);
@@ -382,6 +386,155 @@ void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename, int
   }
 }
 
+namespace
+{
+template <class Type>
+void readBatchTpl(std::vector<vpImage<Type> > &ivec, const std::vector<std::string> &filenames, int backend,
+                  unsigned int nThreads)
+{
+  ivec.resize(filenames.size());
+
+  std::string error;
+  const int nbImages = static_cast<int>(filenames.size());
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < nbImages; i++) {
+    try {
+      vpImageIo::read(ivec[i], filenames[i], backend);
+    }
+    catch (const vpException &e) {
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      if (error.empty()) {
+        error = e.getStringMessage();
+      }
+    }
+  }
+
+  if (!error.empty()) {
+    throw(vpImageException(vpImageException::ioError, error));
+  }
+}
+
+template <class Type>
+void writeBatchTpl(const std::vector<vpImage<Type> > &ivec, const std::vector<std::string> &filenames, int backend,
+                   unsigned int nThreads)
+{
+  if (ivec.size() != filenames.size()) {
+    throw(vpImageException(vpImageException::ioError, "Cannot write %d images in %d files",
+                           static_cast<int>(ivec.size()), static_cast<int>(filenames.size())));
+  }
+
+  std::string error;
+  const int nbImages = static_cast<int>(filenames.size());
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < nbImages; i++) {
+    try {
+      vpImageIo::write(ivec[i], filenames[i], backend);
+    }
+    catch (const vpException &e) {
+#if defined(_OPENMP)
+#pragma omp critical
+#endif
+      if (error.empty()) {
+        error = e.getStringMessage();
+      }
+    }
+  }
+
+  if (!error.empty()) {
+    throw(vpImageException(vpImageException::ioError, error));
+  }
+}
+} // namespace
+
+/*!
+  Read a list of grayscale images, the files being decoded in parallel.
+
+  The images already present in \e ivec are reused: as with read(), the memory of an image is only
+  reallocated when its size differs from the one of the file.
+
+  \param[out] ivec : Images read, resized to the number of files.
+  \param[in] filenames : Names of the files to read.
+  \param[in] backend : Library backend type (see vpImageIo::vpImageIoBackendType) for image reading.
+  \param[in] nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \exception vpImageException::ioError : If a file cannot be read. All the other files are read before
+  the exception is thrown with the message of the first error.
+*/
+void vpImageIo::readBatch(std::vector<vpImage<unsigned char> > &ivec, const std::vector<std::string> &filenames,
+                          int backend, unsigned int nThreads)
+{
+  readBatchTpl(ivec, filenames, backend, nThreads);
+}
+
+/*!
+  Read a list of color images, the files being decoded in parallel.
+
+  \param[out] ivec : Images read, resized to the number of files.
+  \param[in] filenames : Names of the files to read.
+  \param[in] backend : Library backend type (see vpImageIo::vpImageIoBackendType) for image reading.
+  \param[in] nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \sa readBatch(std::vector<vpImage<unsigned char> > &, const std::vector<std::string> &, int, unsigned int)
+*/
+void vpImageIo::readBatch(std::vector<vpImage<vpRGBa> > &ivec, const std::vector<std::string> &filenames,
+                          int backend, unsigned int nThreads)
+{
+  readBatchTpl(ivec, filenames, backend, nThreads);
+}
+
+/*!
+  Write a list of grayscale images, the files being encoded in parallel.
+
+  \param[in] ivec : Images to write.
+  \param[in] filenames : Names of the files, one per image.
+  \param[in] backend : Library backend type (see vpImageIo::vpImageIoBackendType) for image writing.
+  \param[in] nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \exception vpImageException::ioError : If the number of images and files differ or if a file cannot be
+  written. All the other files are written before the exception is thrown with the message of the first error.
+*/
+void vpImageIo::writeBatch(const std::vector<vpImage<unsigned char> > &ivec, const std::vector<std::string> &filenames,
+                           int backend, unsigned int nThreads)
+{
+  writeBatchTpl(ivec, filenames, backend, nThreads);
+}
+
+/*!
+  Write a list of color images, the files being encoded in parallel.
+
+  \param[in] ivec : Images to write.
+  \param[in] filenames : Names of the files, one per image.
+  \param[in] backend : Library backend type (see vpImageIo::vpImageIoBackendType) for image writing.
+  \param[in] nThreads : Number of threads to use if OpenMP is available
+  (zero will let OpenMP uses the optimal number of threads).
+
+  \sa writeBatch(const std::vector<vpImage<unsigned char> > &, const std::vector<std::string> &, int, unsigned int)
+*/
+void vpImageIo::writeBatch(const std::vector<vpImage<vpRGBa> > &ivec, const std::vector<std::string> &filenames,
+                           int backend, unsigned int nThreads)
+{
+  writeBatchTpl(ivec, filenames, backend, nThreads);
+}
+
 /*!
   Load a jpeg image. If it is a color image it is converted in gray.
   \param[out] I : Gray level image.
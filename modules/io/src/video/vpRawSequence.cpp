@@ -0,0 +1,814 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Single file lossless image sequence container.
+ */
+
+#include <visp3/io/vpRawSequence.h>
+
+#include <cstring>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageConvert.h>
+
+/*
+  File layout, all the values are little endian:
+  - file header: "VPRAWSEQ" magic, uint32 version, uint32 reserved
+  - records: record header followed by the payload
+    uint32 magic, uint32 stream, uint8 pixel type, uint8 codec, uint16 reserved, uint32 width, uint32 height,
+    float64 timestamp, uint64 payload size
+  - index written by close(): uint32 magic, uint32 reserved, uint64 number of records, then for each record
+    uint64 offset, uint32 stream, uint8 pixel type, 3 reserved bytes, uint32 width, uint32 height, float64 timestamp
+  - trailer: uint64 index offset, "VPSEQIDX" magic
+*/
+namespace
+{
+const char FILE_MAGIC[8] = { 'V', 'P', 'R', 'A', 'W', 'S', 'E', 'Q' };
+const char TRAILER_MAGIC[8] = { 'V', 'P', 'S', 'E', 'Q', 'I', 'D', 'X' };
+const uint32_t FILE_VERSION = 1;
+const uint32_t RECORD_MAGIC = 0x43455256; // "VREC"
+const uint32_t INDEX_MAGIC = 0x58444956;  // "VIDX"
+const size_t FILE_HEADER_SIZE = 16;
+const size_t RECORD_HEADER_SIZE = 36;
+const size_t INDEX_HEADER_SIZE = 16;
+const size_t INDEX_ENTRY_SIZE = 32;
+const size_t TRAILER_SIZE = 16;
+
+// Payload encodings
+const unsigned char CODEC_DELTA = 0;
+const unsigned char CODEC_DELTA_LZ = 1;
+
+// LZ parameters, the compressed stream follows the LZ4 block format
+const unsigned int LZ_HASH_LOG = 16;
+const size_t LZ_MIN_MATCH = 4;
+const size_t LZ_LAST_LITERALS = 5;
+const size_t LZ_MATCH_LIMIT = 12;
+const size_t LZ_MAX_OFFSET = 65535;
+
+void putU16(unsigned char *p, uint16_t v)
+{
+  p[0] = static_cast<unsigned char>(v);
+  p[1] = static_cast<unsigned char>(v >> 8);
+}
+
+void putU32(unsigned char *p, uint32_t v)
+{
+  for (unsigned int i = 0; i < 4; i++) {
+    p[i] = static_cast<unsigned char>(v >> (8 * i));
+  }
+}
+
+void putU64(unsigned char *p, uint64_t v)
+{
+  for (unsigned int i = 0; i < 8; i++) {
+    p[i] = static_cast<unsigned char>(v >> (8 * i));
+  }
+}
+
+void putF64(unsigned char *p, double v)
+{
+  uint64_t u;
+  memcpy(&u, &v, sizeof(u));
+  putU64(p, u);
+}
+
+uint32_t getU32(const unsigned char *p)
+{
+  uint32_t v = 0;
+  for (unsigned int i = 0; i < 4; i++) {
+    v |= static_cast<uint32_t>(p[i]) << (8 * i);
+  }
+  return v;
+}
+
+uint64_t getU64(const unsigned char *p)
+{
+  uint64_t v = 0;
+  for (unsigned int i = 0; i < 8; i++) {
+    v |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  return v;
+}
+
+double getF64(const unsigned char *p)
+{
+  uint64_t u = getU64(p);
+  double v;
+  memcpy(&v, &u, sizeof(v));
+  return v;
+}
+
+/*
+  Replace each sample by its difference with the same channel of the left pixel (the pixel above for the first
+  column) and scatter the bytes of the differences into planes: plane (c * sizeof(T) + b) holds the byte b of
+  channel c. Smooth images give long runs of small values that the LZ stage compresses well.
+*/
+template <typename T, unsigned int C>
+void deltaEncode(const T *src, unsigned int width, unsigned int height, unsigned char *dst)
+{
+  const size_t npix = static_cast<size_t>(width) * height;
+  for (unsigned int r = 0; r < height; r++) {
+    const T *row = src + static_cast<size_t>(r) * width * C;
+    size_t k = static_cast<size_t>(r) * width;
+    T pred[C];
+    for (unsigned int c = 0; c < C; c++) {
+      pred[c] = (r > 0) ? *(row - static_cast<size_t>(width) * C + c) : static_cast<T>(0);
+    }
+    for (unsigned int i = 0; i < width; i++, k++) {
+      for (unsigned int c = 0; c < C; c++) {
+        const T v = row[i * C + c];
+        const T d = static_cast<T>(v - pred[c]);
+        pred[c] = v;
+        for (unsigned int b = 0; b < sizeof(T); b++) {
+          dst[(c * sizeof(T) + b) * npix + k] = static_cast<unsigned char>(d >> (8 * b));
+        }
+      }
+    }
+  }
+}
+
+template <typename T, unsigned int C>
+void deltaDecode(const unsigned char *src, unsigned int width, unsigned int height, T *dst)
+{
+  const size_t npix = static_cast<size_t>(width) * height;
+  for (unsigned int r = 0; r < height; r++) {
+    T *row = dst + static_cast<size_t>(r) * width * C;
+    size_t k = static_cast<size_t>(r) * width;
+    T pred[C];
+    for (unsigned int c = 0; c < C; c++) {
+      pred[c] = (r > 0) ? *(row - static_cast<size_t>(width) * C + c) : static_cast<T>(0);
+    }
+    for (unsigned int i = 0; i < width; i++, k++) {
+      for (unsigned int c = 0; c < C; c++) {
+        T d = 0;
+        for (unsigned int b = 0; b < sizeof(T); b++) {
+          d = static_cast<T>(d | (static_cast<T>(src[(c * sizeof(T) + b) * npix + k]) << (8 * b)));
+        }
+        pred[c] = static_cast<T>(pred[c] + d);
+        row[i * C + c] = pred[c];
+      }
+    }
+  }
+}
+
+void deltaEncode(const unsigned char *src, unsigned int width, unsigned int height, unsigned int nbChannels,
+                 unsigned int channelSize, unsigned char *dst)
+{
+  if (channelSize == 2) {
+    deltaEncode<uint16_t, 1>(reinterpret_cast<const uint16_t *>(src), width, height, dst);
+  }
+  else if (nbChannels == 4) {
+    deltaEncode<unsigned char, 4>(src, width, height, dst);
+  }
+  else {
+    deltaEncode<unsigned char, 1>(src, width, height, dst);
+  }
+}
+
+void deltaDecode(const unsigned char *src, unsigned int width, unsigned int height, unsigned int nbChannels,
+                 unsigned int channelSize, unsigned char *dst)
+{
+  if (channelSize == 2) {
+    deltaDecode<uint16_t, 1>(src, width, height, reinterpret_cast<uint16_t *>(dst));
+  }
+  else if (nbChannels == 4) {
+    deltaDecode<unsigned char, 4>(src, width, height, dst);
+  }
+  else {
+    deltaDecode<unsigned char, 1>(src, width, height, dst);
+  }
+}
+
+inline uint32_t read32(const unsigned char *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t lzHash(uint32_t v) { return (v * 2654435761U) >> (32 - LZ_HASH_LOG); }
+
+size_t lzCompressBound(size_t size) { return size + size / 255 + 16; }
+
+unsigned char *lzWriteLength(unsigned char *op, size_t len)
+{
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = static_cast<unsigned char>(len);
+  return op;
+}
+
+unsigned char *lzWriteSequence(unsigned char *op, const unsigned char *literals, size_t nbLiterals, size_t offset,
+                               size_t matchLength)
+{
+  unsigned char *token = op++;
+  *token = static_cast<unsigned char>((nbLiterals >= 15 ? 15 : nbLiterals) << 4);
+  if (nbLiterals >= 15) {
+    op = lzWriteLength(op, nbLiterals - 15);
+  }
+  memcpy(op, literals, nbLiterals);
+  op += nbLiterals;
+  if (matchLength > 0) {
+    putU16(op, static_cast<uint16_t>(offset));
+    op += 2;
+    const size_t ml = matchLength - LZ_MIN_MATCH;
+    *token = static_cast<unsigned char>(*token | (ml >= 15 ? 15 : ml));
+    if (ml >= 15) {
+      op = lzWriteLength(op, ml - 15);
+    }
+  }
+  return op;
+}
+
+/*
+  Greedy single pass LZ77 compression producing an LZ4 block. `dst` must hold lzCompressBound(size) bytes.
+  Return the compressed size.
+*/
+size_t lzCompress(const unsigned char *src, size_t size, unsigned char *dst, std::vector<uint32_t> &table)
+{
+  table.assign(static_cast<size_t>(1) << LZ_HASH_LOG, 0);
+  unsigned char *op = dst;
+  size_t anchor = 0;
+  if (size > LZ_MATCH_LIMIT) {
+    const size_t limit = size - LZ_MATCH_LIMIT;
+    const size_t matchEnd = size - LZ_LAST_LITERALS;
+    size_t ip = 0;
+    while (ip < limit) {
+      const uint32_t seq = read32(src + ip);
+      const uint32_t h = lzHash(seq);
+      const size_t ref = table[h];
+      table[h] = static_cast<uint32_t>(ip);
+      if (ref < ip && ip - ref <= LZ_MAX_OFFSET && read32(src + ref) == seq) {
+        size_t len = LZ_MIN_MATCH;
+        while (ip + len < matchEnd && src[ref + len] == src[ip + len]) {
+          len++;
+        }
+        op = lzWriteSequence(op, src + anchor, ip - anchor, ip - ref, len);
+        ip += len;
+        anchor = ip;
+      }
+      else {
+        // Step faster over data that does not compress
+        ip += 1 + ((ip - anchor) >> 6);
+      }
+    }
+  }
+  op = lzWriteSequence(op, src + anchor, size - anchor, 0, 0);
+  return static_cast<size_t>(op - dst);
+}
+
+/*
+  Decompress an LZ4 block that must expand to exactly `size` bytes. Return false on corrupted data.
+*/
+bool lzDecompress(const unsigned char *src, size_t srcSize, unsigned char *dst, size_t size)
+{
+  size_t ip = 0, op = 0;
+  while (ip < srcSize) {
+    const unsigned char token = src[ip++];
+    size_t nbLiterals = token >> 4;
+    if (nbLiterals == 15) {
+      unsigned char b;
+      do {
+        if (ip >= srcSize) {
+          return false;
+        }
+        b = src[ip++];
+        nbLiterals += b;
+      } while (b == 255);
+    }
+    if (nbLiterals > srcSize - ip || nbLiterals > size - op) {
+      return false;
+    }
+    memcpy(dst + op, src + ip, nbLiterals);
+    ip += nbLiterals;
+    op += nbLiterals;
+    if (ip == srcSize) {
+      break; // Last literals
+    }
+
+    if (srcSize - ip < 2) {
+      return false;
+    }
+    const size_t offset = static_cast<size_t>(src[ip]) | (static_cast<size_t>(src[ip + 1]) << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return false;
+    }
+    size_t len = token & 15;
+    if (len == 15) {
+      unsigned char b;
+      do {
+        if (ip >= srcSize) {
+          return false;
+        }
+        b = src[ip++];
+        len += b;
+      } while (b == 255);
+    }
+    len += LZ_MIN_MATCH;
+    if (len > size - op) {
+      return false;
+    }
+    unsigned char *out = dst + op;
+    const unsigned char *ref = out - offset;
+    if (offset >= len) {
+      memcpy(out, ref, len);
+    }
+    else {
+      // Overlapping copy, used for runs
+      for (size_t i = 0; i < len; i++) {
+        out[i] = ref[i];
+      }
+    }
+    op += len;
+  }
+  return op == size;
+}
+} // namespace
+
+/*!
+ * Default constructor.
+ */
+vpRawSequence::vpRawSequence()
+  : m_file(), m_filename(), m_mode(MODE_CLOSED), m_compress(true), m_modified(false), m_end(0), m_index(), m_raw(),
+  m_packed(), m_converted(), m_hashTable()
+{ }
+
+/*!
+ * Destructor that closes the file.
+ */
+vpRawSequence::~vpRawSequence()
+{
+  try {
+    close();
+  }
+  catch (...) {
+  }
+}
+
+/*!
+ * Close the file. When records were written, the index is appended at the end of the file.
+ */
+void vpRawSequence::close()
+{
+  if (m_mode == MODE_CLOSED) {
+    return;
+  }
+  if (m_modified) {
+    writeIndex();
+  }
+  m_file.close();
+  m_mode = MODE_CLOSED;
+  m_modified = false;
+  m_index.clear();
+}
+
+/*!
+ * Return the description of a record.
+ *
+ * \param index : Index of the record, in [0, getNbRecords()-1].
+ */
+const vpRawSequence::vpRecordInfo &vpRawSequence::getRecordInfo(size_t index) const
+{
+  if (index >= m_index.size()) {
+    throw(vpException(vpException::dimensionError, "Record %d is out of range [0, %d]", static_cast<int>(index),
+                      static_cast<int>(m_index.size()) - 1));
+  }
+  return m_index[index];
+}
+
+/*!
+ * Return the indexes of the records of a stream, in the order they were written.
+ *
+ * \param stream : Stream identifier.
+ */
+std::vector<size_t> vpRawSequence::getStreamRecords(unsigned int stream) const
+{
+  std::vector<size_t> records;
+  for (size_t i = 0; i < m_index.size(); i++) {
+    if (m_index[i].stream == stream) {
+      records.push_back(i);
+    }
+  }
+  return records;
+}
+
+/*!
+ * Open a file.
+ *
+ * \param filename : File name, usually with the `.vpseq` extension.
+ * \param mode : Opening mode. With MODE_READ, the file is read only. With MODE_WRITE, a new file is created. With
+ * MODE_APPEND, the records are added after the ones of the existing file.
+ */
+void vpRawSequence::open(const std::string &filename, const vpOpenMode &mode)
+{
+  close();
+
+  bool create = (mode == MODE_WRITE);
+  if (mode == MODE_APPEND) {
+    std::ifstream test(filename.c_str(), std::ios::binary);
+    create = !test.good();
+  }
+
+  if (create) {
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    unsigned char header[FILE_HEADER_SIZE];
+    memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    putU32(header + 8, FILE_VERSION);
+    putU32(header + 12, 0);
+    file.write(reinterpret_cast<const char *>(header), FILE_HEADER_SIZE);
+    if (!file.good()) {
+      throw(vpException(vpException::ioError, "Cannot create the file %s", filename.c_str()));
+    }
+  }
+
+  std::ios::openmode openmode = std::ios::binary | std::ios::in;
+  if (mode != MODE_READ) {
+    openmode |= std::ios::out;
+  }
+  m_file.open(filename.c_str(), openmode);
+  if (!m_file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot open the file %s", filename.c_str()));
+  }
+
+  m_file.seekg(0, std::ios::end);
+  const uint64_t fileSize = static_cast<uint64_t>(m_file.tellg());
+  unsigned char header[FILE_HEADER_SIZE];
+  m_file.seekg(0, std::ios::beg);
+  m_file.read(reinterpret_cast<char *>(header), FILE_HEADER_SIZE);
+  if (!m_file.good() || memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+    m_file.close();
+    throw(vpException(vpException::ioError, "The file %s is not an image sequence", filename.c_str()));
+  }
+  if (getU32(header + 8) > FILE_VERSION) {
+    m_file.close();
+    throw(vpException(vpException::ioError, "The file %s was written with a newer version", filename.c_str()));
+  }
+
+  m_filename = filename;
+  m_mode = mode;
+  if (!loadIndex(fileSize)) {
+    buildIndex(fileSize);
+  }
+
+  if (mode != MODE_READ) {
+    // New records overwrite the index: invalidate the trailer until close() writes the new one, so that an
+    // interrupted recording is recovered by scanning the records.
+    if (m_end + TRAILER_SIZE <= fileSize) {
+      const unsigned char zeros[TRAILER_SIZE] = { 0 };
+      m_file.seekp(static_cast<std::streamoff>(fileSize - TRAILER_SIZE));
+      m_file.write(reinterpret_cast<const char *>(zeros), TRAILER_SIZE);
+      m_file.flush();
+    }
+    m_modified = true;
+  }
+}
+
+/*!
+ * Read a grey level image. A color record is converted to grey level.
+ *
+ * \param I : Read image.
+ * \param index : Index of the record, in [0, getNbRecords()-1].
+ * \param timestamp : If not null, filled with the timestamp of the record.
+ */
+void vpRawSequence::read(vpImage<unsigned char> &I, size_t index, double *timestamp)
+{
+  const vpRecordInfo &info = getRecordInfo(index);
+  if (info.type == PIXEL_UCHAR) {
+    I.resize(info.height, info.width);
+    readPayload(info, 1, 1, I.bitmap);
+  }
+  else if (info.type == PIXEL_RGBA) {
+    const unsigned int size = info.width * info.height;
+    m_converted.resize(static_cast<size_t>(size) * 4);
+    readPayload(info, 4, 1, m_converted.data());
+    I.resize(info.height, info.width);
+    vpImageConvert::RGBaToGrey(m_converted.data(), I.bitmap, size);
+  }
+  else {
+    throw(vpException(vpException::badValue, "Record %d holds a depth image", static_cast<int>(index)));
+  }
+  if (timestamp != nullptr) {
+    *timestamp = info.timestamp;
+  }
+}
+
+/*!
+ * Read a color image. A grey level record is converted to color.
+ *
+ * \param I : Read image.
+ * \param index : Index of the record, in [0, getNbRecords()-1].
+ * \param timestamp : If not null, filled with the timestamp of the record.
+ */
+void vpRawSequence::read(vpImage<vpRGBa> &I, size_t index, double *timestamp)
+{
+  const vpRecordInfo &info = getRecordInfo(index);
+  if (info.type == PIXEL_RGBA) {
+    I.resize(info.height, info.width);
+    readPayload(info, 4, 1, reinterpret_cast<unsigned char *>(I.bitmap));
+  }
+  else if (info.type == PIXEL_UCHAR) {
+    const unsigned int size = info.width * info.height;
+    m_converted.resize(size);
+    readPayload(info, 1, 1, m_converted.data());
+    I.resize(info.height, info.width);
+    vpImageConvert::GreyToRGBa(m_converted.data(), reinterpret_cast<unsigned char *>(I.bitmap), size);
+  }
+  else {
+    throw(vpException(vpException::badValue, "Record %d holds a depth image", static_cast<int>(index)));
+  }
+  if (timestamp != nullptr) {
+    *timestamp = info.timestamp;
+  }
+}
+
+/*!
+ * Read a depth image.
+ *
+ * \param I : Read image.
+ * \param index : Index of the record, in [0, getNbRecords()-1].
+ * \param timestamp : If not null, filled with the timestamp of the record.
+ */
+void vpRawSequence::read(vpImage<uint16_t> &I, size_t index, double *timestamp)
+{
+  const vpRecordInfo &info = getRecordInfo(index);
+  if (info.type != PIXEL_UINT16) {
+    throw(vpException(vpException::badValue, "Record %d does not hold a depth image", static_cast<int>(index)));
+  }
+  I.resize(info.height, info.width);
+  readPayload(info, 1, 2, reinterpret_cast<unsigned char *>(I.bitmap));
+  if (timestamp != nullptr) {
+    *timestamp = info.timestamp;
+  }
+}
+
+/*!
+ * Append a grey level image.
+ *
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image, e.g. given by vpTime::measureTimeSecond().
+ * \param stream : Identifier of the stream the image belongs to.
+ * \return The index of the record.
+ */
+size_t vpRawSequence::write(const vpImage<unsigned char> &I, double timestamp, unsigned int stream)
+{
+  return writeRecord(I.bitmap, I.getWidth(), I.getHeight(), 1, 1, PIXEL_UCHAR, timestamp, stream);
+}
+
+/*!
+ * Append a color image.
+ *
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image, e.g. given by vpTime::measureTimeSecond().
+ * \param stream : Identifier of the stream the image belongs to.
+ * \return The index of the record.
+ */
+size_t vpRawSequence::write(const vpImage<vpRGBa> &I, double timestamp, unsigned int stream)
+{
+  return writeRecord(reinterpret_cast<const unsigned char *>(I.bitmap), I.getWidth(), I.getHeight(), 4, 1,
+                     PIXEL_RGBA, timestamp, stream);
+}
+
+/*!
+ * Append a depth image.
+ *
+ * \param I : Image to write.
+ * \param timestamp : Timestamp of the image, e.g. given by vpTime::measureTimeSecond().
+ * \param stream : Identifier of the stream the image belongs to.
+ * \return The index of the record.
+ */
+size_t vpRawSequence::write(const vpImage<uint16_t> &I, double timestamp, unsigned int stream)
+{
+  return writeRecord(reinterpret_cast<const unsigned char *>(I.bitmap), I.getWidth(), I.getHeight(), 1, 2,
+                     PIXEL_UINT16, timestamp, stream);
+}
+
+// Rebuild the index by reading the record headers one after the other. Stop at the first truncated or invalid
+// record, which is overwritten by the next appended record.
+void vpRawSequence::buildIndex(uint64_t fileSize)
+{
+  m_index.clear();
+  uint64_t offset = FILE_HEADER_SIZE;
+  unsigned char header[RECORD_HEADER_SIZE];
+  while (offset + RECORD_HEADER_SIZE <= fileSize) {
+    m_file.seekg(static_cast<std::streamoff>(offset));
+    m_file.read(reinterpret_cast<char *>(header), RECORD_HEADER_SIZE);
+    if (!m_file.good() || getU32(header) != RECORD_MAGIC || header[8] > PIXEL_UINT16) {
+      break;
+    }
+    const uint64_t payloadSize = getU64(header + 28);
+    if (payloadSize > fileSize - offset - RECORD_HEADER_SIZE) {
+      break;
+    }
+    vpRecordInfo info;
+    info.offset = offset;
+    info.stream = getU32(header + 4);
+    info.type = static_cast<vpPixelType>(header[8]);
+    info.width = getU32(header + 12);
+    info.height = getU32(header + 16);
+    info.timestamp = getF64(header + 20);
+    m_index.push_back(info);
+    offset += RECORD_HEADER_SIZE + payloadSize;
+  }
+  m_file.clear();
+  m_end = offset;
+}
+
+// Load the index written by close(). Return false if the file has no valid index.
+bool vpRawSequence::loadIndex(uint64_t fileSize)
+{
+  m_index.clear();
+  if (fileSize < FILE_HEADER_SIZE + INDEX_HEADER_SIZE + TRAILER_SIZE) {
+    return false;
+  }
+  unsigned char trailer[TRAILER_SIZE];
+  m_file.seekg(static_cast<std::streamoff>(fileSize - TRAILER_SIZE));
+  m_file.read(reinterpret_cast<char *>(trailer), TRAILER_SIZE);
+  if (!m_file.good() || memcmp(trailer + 8, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+    m_file.clear();
+    return false;
+  }
+  const uint64_t indexOffset = getU64(trailer);
+  if (indexOffset < FILE_HEADER_SIZE || indexOffset > fileSize - TRAILER_SIZE - INDEX_HEADER_SIZE) {
+    return false;
+  }
+  unsigned char header[INDEX_HEADER_SIZE];
+  m_file.seekg(static_cast<std::streamoff>(indexOffset));
+  m_file.read(reinterpret_cast<char *>(header), INDEX_HEADER_SIZE);
+  const uint64_t count = getU64(header + 8);
+  if (!m_file.good() || getU32(header) != INDEX_MAGIC ||
+      count != (fileSize - TRAILER_SIZE - INDEX_HEADER_SIZE - indexOffset) / INDEX_ENTRY_SIZE) {
+    m_file.clear();
+    return false;
+  }
+
+  std::vector<unsigned char> entries(static_cast<size_t>(count) * INDEX_ENTRY_SIZE);
+  m_file.read(reinterpret_cast<char *>(entries.data()), static_cast<std::streamsize>(entries.size()));
+  if (!m_file.good()) {
+    m_file.clear();
+    return false;
+  }
+  m_index.resize(static_cast<size_t>(count));
+  for (size_t i = 0; i < m_index.size(); i++) {
+    const unsigned char *e = entries.data() + i * INDEX_ENTRY_SIZE;
+    if (e[12] > PIXEL_UINT16) {
+      m_index.clear();
+      return false;
+    }
+    m_index[i].offset = getU64(e);
+    m_index[i].stream = getU32(e + 8);
+    m_index[i].type = static_cast<vpPixelType>(e[12]);
+    m_index[i].width = getU32(e + 16);
+    m_index[i].height = getU32(e + 20);
+    m_index[i].timestamp = getF64(e + 24);
+  }
+  m_end = indexOffset;
+  return true;
+}
+
+// Read the payload of a record and decode it in data, that holds width*height*nbChannels*channelSize bytes.
+void vpRawSequence::readPayload(const vpRecordInfo &info, unsigned int nbChannels, unsigned int channelSize,
+                                unsigned char *data)
+{
+  unsigned char header[RECORD_HEADER_SIZE];
+  m_file.seekg(static_cast<std::streamoff>(info.offset));
+  m_file.read(reinterpret_cast<char *>(header), RECORD_HEADER_SIZE);
+  if (!m_file.good() || getU32(header) != RECORD_MAGIC || header[8] != info.type ||
+      getU32(header + 12) != info.width || getU32(header + 16) != info.height) {
+    m_file.clear();
+    throw(vpException(vpException::ioError, "Corrupted record header in %s", m_filename.c_str()));
+  }
+  const unsigned char codec = header[9];
+  const uint64_t payloadSize = getU64(header + 28);
+  const size_t rawSize = static_cast<size_t>(info.width) * info.height * nbChannels * channelSize;
+
+  m_raw.resize(rawSize);
+  bool valid = false;
+  if (codec == CODEC_DELTA && payloadSize == rawSize) {
+    m_file.read(reinterpret_cast<char *>(m_raw.data()), static_cast<std::streamsize>(rawSize));
+    valid = m_file.good();
+  }
+  else if (codec == CODEC_DELTA_LZ && payloadSize < rawSize) {
+    m_packed.resize(static_cast<size_t>(payloadSize));
+    m_file.read(reinterpret_cast<char *>(m_packed.data()), static_cast<std::streamsize>(payloadSize));
+    valid = m_file.good() && lzDecompress(m_packed.data(), m_packed.size(), m_raw.data(), rawSize);
+  }
+  if (!valid) {
+    m_file.clear();
+    throw(vpException(vpException::ioError, "Corrupted record data in %s", m_filename.c_str()));
+  }
+  deltaDecode(m_raw.data(), info.width, info.height, nbChannels, channelSize, data);
+}
+
+// Encode and append a record at the end of the file.
+size_t vpRawSequence::writeRecord(const unsigned char *data, unsigned int width, unsigned int height,
+                                  unsigned int nbChannels, unsigned int channelSize, vpPixelType type,
+                                  double timestamp, unsigned int stream)
+{
+  if (m_mode != MODE_WRITE && m_mode != MODE_APPEND) {
+    throw(vpException(vpException::notInitialized, "The image sequence is not open for writing"));
+  }
+  const size_t rawSize = static_cast<size_t>(width) * height * nbChannels * channelSize;
+  m_raw.resize(rawSize);
+  deltaEncode(data, width, height, nbChannels, channelSize, m_raw.data());
+
+  unsigned char codec = CODEC_DELTA;
+  const unsigned char *payload = m_raw.data();
+  size_t payloadSize = rawSize;
+  if (m_compress) {
+    m_packed.resize(lzCompressBound(rawSize));
+    const size_t packedSize = lzCompress(m_raw.data(), rawSize, m_packed.data(), m_hashTable);
+    if (packedSize < rawSize) {
+      codec = CODEC_DELTA_LZ;
+      payload = m_packed.data();
+      payloadSize = packedSize;
+    }
+  }
+
+  unsigned char header[RECORD_HEADER_SIZE];
+  putU32(header, RECORD_MAGIC);
+  putU32(header + 4, stream);
+  header[8] = static_cast<unsigned char>(type);
+  header[9] = codec;
+  putU16(header + 10, 0);
+  putU32(header + 12, width);
+  putU32(header + 16, height);
+  putF64(header + 20, timestamp);
+  putU64(header + 28, payloadSize);
+
+  m_file.seekp(static_cast<std::streamoff>(m_end));
+  m_file.write(reinterpret_cast<const char *>(header), RECORD_HEADER_SIZE);
+  m_file.write(reinterpret_cast<const char *>(payload), static_cast<std::streamsize>(payloadSize));
+  if (!m_file.good()) {
+    m_file.clear();
+    throw(vpException(vpException::ioError, "Cannot write in %s", m_filename.c_str()));
+  }
+
+  vpRecordInfo info;
+  info.offset = m_end;
+  info.stream = stream;
+  info.type = type;
+  info.width = width;
+  info.height = height;
+  info.timestamp = timestamp;
+  m_index.push_back(info);
+  m_end += RECORD_HEADER_SIZE + payloadSize;
+  return m_index.size() - 1;
+}
+
+// Write the index and the trailer after the last record.
+void vpRawSequence::writeIndex()
+{
+  std::vector<unsigned char> buffer(INDEX_HEADER_SIZE + m_index.size() * INDEX_ENTRY_SIZE + TRAILER_SIZE, 0);
+  unsigned char *p = buffer.data();
+  putU32(p, INDEX_MAGIC);
+  putU64(p + 8, m_index.size());
+  p += INDEX_HEADER_SIZE;
+  for (size_t i = 0; i < m_index.size(); i++, p += INDEX_ENTRY_SIZE) {
+    putU64(p, m_index[i].offset);
+    putU32(p + 8, m_index[i].stream);
+    p[12] = static_cast<unsigned char>(m_index[i].type);
+    putU32(p + 16, m_index[i].width);
+    putU32(p + 20, m_index[i].height);
+    putF64(p + 24, m_index[i].timestamp);
+  }
+  putU64(p, m_end);
+  memcpy(p + 8, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+
+  m_file.seekp(static_cast<std::streamoff>(m_end));
+  m_file.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  m_file.flush();
+  if (!m_file.good()) {
+    m_file.clear();
+    throw(vpException(vpException::ioError, "Cannot write the index of %s", m_filename.c_str()));
+  }
+}
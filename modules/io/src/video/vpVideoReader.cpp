@@ -49,7 +49,8 @@
   Basic constructor.
 */
 vpVideoReader::vpVideoReader()
-  : vpFrameGrabber(), m_imSequence(nullptr),
+  : vpFrameGrabber(), m_imSequence(nullptr), m_rawSequence(nullptr), m_rawSequenceRecords(),
+  m_rawSequenceNext(0),
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
   m_capture(), m_frame(), m_lastframe_unknown(false),
 #endif
@@ -66,6 +67,9 @@ vpVideoReader::~vpVideoReader()
   if (m_imSequence != nullptr) {
     delete m_imSequence;
   }
+  if (m_rawSequence != nullptr) {
+    delete m_rawSequence;
+  }
 }
 
 /*!
@@ -131,6 +135,21 @@ void vpVideoReader::getProperties()
     }
     m_frameRate = -1.;
   }
+  else if (m_formatType == FORMAT_RAW_SEQUENCE) {
+    m_rawSequence = new vpRawSequence;
+    m_rawSequence->open(m_videoName, vpRawSequence::MODE_READ);
+    m_rawSequenceRecords = m_rawSequence->getStreamRecords(0);
+    m_frameRate = -1.;
+    if (!m_rawSequenceRecords.empty()) {
+      const vpRawSequence::vpRecordInfo &first = m_rawSequence->getRecordInfo(m_rawSequenceRecords.front());
+      const vpRawSequence::vpRecordInfo &last = m_rawSequence->getRecordInfo(m_rawSequenceRecords.back());
+      width = first.width;
+      height = first.height;
+      if (last.timestamp > first.timestamp) {
+        m_frameRate = (m_rawSequenceRecords.size() - 1) / (last.timestamp - first.timestamp);
+      }
+    }
+  }
   else if (isVideoExtensionSupported()) {
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
     m_capture.open(m_videoName.c_str());
@@ -166,6 +185,27 @@ void vpVideoReader::getProperties()
   findLastFrameIndex();
 }
 
+/*!
+  Read the frame \e frame_index of a single file image sequence.
+*/
+template <class Type> bool vpVideoReader::getRawSequenceFrame(vpImage<Type> &I, long frame_index)
+{
+  if (frame_index < 0 || frame_index >= static_cast<long>(m_rawSequenceRecords.size())) {
+    vpERROR_TRACE("Couldn't find the %ld th frame", frame_index);
+    return false;
+  }
+  try {
+    m_rawSequence->read(I, m_rawSequenceRecords[static_cast<size_t>(frame_index)]);
+  }
+  catch (...) {
+    vpERROR_TRACE("Couldn't read the %ld th frame", frame_index);
+    return false;
+  }
+  width = I.getWidth();
+  height = I.getHeight();
+  return true;
+}
+
 /*!
   Sets all the parameters needed to read the video or the image sequence.
 
@@ -268,6 +308,15 @@ void vpVideoReader::acquire(vpImage<vpRGBa> &I)
       m_imSequence->setImageNumber(m_frameCount);
     }
   }
+  else if (m_rawSequence != nullptr) {
+    m_frameCount = m_rawSequenceNext;
+    if (!getRawSequenceFrame(I, m_frameCount)) {
+      std::cout << "Warning: Unable to decode image " << m_frameCount << std::endl;
+    }
+    if ((m_frameCount + m_frameStep <= m_lastFrame) && (m_frameCount + m_frameStep >= m_firstFrame)) {
+      m_rawSequenceNext = m_frameCount + m_frameStep;
+    }
+  }
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
   else {
     m_capture >> m_frame;
@@ -363,6 +412,15 @@ void vpVideoReader::acquire(vpImage<unsigned char> &I)
       m_imSequence->setImageNumber(m_frameCount);
     }
   }
+  else if (m_rawSequence != nullptr) {
+    m_frameCount = m_rawSequenceNext;
+    if (!getRawSequenceFrame(I, m_frameCount)) {
+      std::cout << "Warning: Unable to decode image " << m_frameCount << std::endl;
+    }
+    if ((m_frameCount + m_frameStep <= m_lastFrame) && (m_frameCount + m_frameStep >= m_firstFrame)) {
+      m_rawSequenceNext = m_frameCount + m_frameStep;
+    }
+  }
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
   else {
     m_capture >> m_frame;
@@ -453,6 +511,13 @@ bool vpVideoReader::getFrame(vpImage<vpRGBa> &I, long frame_index)
       return false;
     }
   }
+  else if (m_rawSequence != nullptr) {
+    if (!getRawSequenceFrame(I, frame_index)) {
+      return false;
+    }
+    m_frameCount = frame_index;
+    m_rawSequenceNext = frame_index; // to not increment the next frame read by acquire()
+  }
   else {
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -530,6 +595,13 @@ bool vpVideoReader::getFrame(vpImage<unsigned char> &I, long frame_index)
       return false;
     }
   }
+  else if (m_rawSequence != nullptr) {
+    if (!getRawSequenceFrame(I, frame_index)) {
+      return false;
+    }
+    m_frameCount = frame_index;
+    m_rawSequenceNext = frame_index; // to not increment the next frame read by acquire()
+  }
   else {
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
@@ -679,6 +751,10 @@ vpVideoReader::vpVideoFormatType vpVideoReader::getFormat(const std::string &fil
     return FORMAT_MTS;
   else if (ext.compare(".mts") == 0)
     return FORMAT_MTS;
+  else if (ext.compare(".VPSEQ") == 0)
+    return FORMAT_RAW_SEQUENCE;
+  else if (ext.compare(".vpseq") == 0)
+    return FORMAT_RAW_SEQUENCE;
   else
     return FORMAT_UNKNOWN;
 }
@@ -721,6 +797,11 @@ void vpVideoReader::findLastFrameIndex()
       }
     }
   }
+  else if (m_rawSequence != nullptr) {
+    if (!m_lastFrameIndexIsSet) {
+      m_lastFrame = static_cast<long>(m_rawSequenceRecords.size()) - 1;
+    }
+  }
 
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
@@ -775,6 +856,11 @@ void vpVideoReader::findFirstFrameIndex()
       m_imSequence->setImageNumber(m_firstFrame);
     }
   }
+  else if (m_rawSequence != nullptr) {
+    if (!m_firstFrameIndexIsSet) {
+      m_firstFrame = 0;
+    }
+  }
 #if defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_VIDEOIO)
 
   else if (!m_firstFrameIndexIsSet) {
@@ -885,8 +971,8 @@ bool vpVideoReader::checkImageNameFormat(const std::string &format) const
  * Indicate if the video is an encoded single video file.
  *
  * \return true if the video format corresponds to an encoded single video file like one of the following
- * avi, mpeg, mp4, mts, mov, ogv, wmv, flv, mkv. Return false, if the video is a sequence of successive
- * images (png, jpeg, ppm, pgm...).
+ * avi, mpeg, mp4, mts, mov, ogv, wmv, flv, mkv, or to a single file image sequence (vpseq). Return false, if the
+ * video is a sequence of successive images (png, jpeg, ppm, pgm...).
  */
 bool vpVideoReader::isVideoFormat() const
 {
@@ -901,6 +987,7 @@ bool vpVideoReader::isVideoFormat() const
   case FORMAT_WMV:
   case FORMAT_FLV:
   case FORMAT_MKV:
+  case FORMAT_RAW_SEQUENCE:
     return true;
   default:
     return false;
@@ -86,7 +86,7 @@ static std::vector<std::string> backendNamesPng
 #endif
       "simd", "stb"
 };
-static int nThreads = 0;
+static unsigned int nThreads = 0;
 
 TEST_CASE("Benchmark grayscale JPEG image loading", "[benchmark]")
 {
@@ -268,6 +268,110 @@ TEST_CASE("Benchmark RGBA PNG image saving", "[benchmark]")
   REQUIRE(vpIoTools::remove(directory_filename_tmp));
 }
 
+TEST_CASE("Benchmark batch image loading", "[benchmark]")
+{
+  const std::string extensions[] = { ".jpg", ".png" };
+  for (size_t e = 0; e < 2; e++) {
+    std::vector<std::string> filenames;
+    for (size_t k = 0; k < 4; k++) {
+      for (size_t i = 0; i < paths.size(); i++) {
+        filenames.push_back(paths[i] + extensions[e]);
+      }
+    }
+
+    SECTION("RGBA " + extensions[e] + " files")
+    {
+      std::vector<vpImage<vpRGBa> > ivec_seq(filenames.size()), ivec_batch;
+      vpImageIo::readBatch(ivec_batch, filenames, vpImageIo::IO_DEFAULT_BACKEND, nThreads);
+      bool same = true;
+      for (size_t i = 0; i < filenames.size(); i++) {
+        vpImageIo::read(ivec_seq[i], filenames[i]);
+        same = same && (ivec_seq[i] == ivec_batch[i]);
+      }
+      CHECK(same);
+
+      // Decoding into images of the same size does not reallocate them
+      const vpRGBa *bitmap = ivec_batch.front().bitmap;
+      vpImageIo::readBatch(ivec_batch, filenames, vpImageIo::IO_DEFAULT_BACKEND, nThreads);
+      CHECK(ivec_batch.front().bitmap == bitmap);
+
+      BENCHMARK("Sequential read (" + std::to_string(filenames.size()) + " files)")
+      {
+        for (size_t i = 0; i < filenames.size(); i++) {
+          vpImageIo::read(ivec_seq[i], filenames[i]);
+        }
+        return ivec_seq;
+      };
+
+      BENCHMARK("readBatch (" + std::to_string(filenames.size()) + " files)")
+      {
+        vpImageIo::readBatch(ivec_batch, filenames, vpImageIo::IO_DEFAULT_BACKEND, nThreads);
+        return ivec_batch;
+      };
+    }
+
+    SECTION("Grayscale " + extensions[e] + " files")
+    {
+      std::vector<vpImage<unsigned char> > ivec_seq(filenames.size()), ivec_batch;
+
+      BENCHMARK("Sequential read (" + std::to_string(filenames.size()) + " files)")
+      {
+        for (size_t i = 0; i < filenames.size(); i++) {
+          vpImageIo::read(ivec_seq[i], filenames[i]);
+        }
+        return ivec_seq;
+      };
+
+      BENCHMARK("readBatch (" + std::to_string(filenames.size()) + " files)")
+      {
+        vpImageIo::readBatch(ivec_batch, filenames, vpImageIo::IO_DEFAULT_BACKEND, nThreads);
+        return ivec_batch;
+      };
+    }
+  }
+}
+
+TEST_CASE("Benchmark batch image saving", "[benchmark]")
+{
+  std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath());
+  std::string directory_filename_tmp =
+    tmp_dir + "/vpIoTools_perfImageLoadSave_" + vpTime::getDateTime("%Y-%m-%d_%H.%M.%S");
+  vpIoTools::makeDirectory(directory_filename_tmp);
+  REQUIRE(vpIoTools::checkDirectory(directory_filename_tmp));
+
+  std::vector<vpImage<vpRGBa> > ivec(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    vpImageIo::read(ivec[i], paths[i] + ".png");
+  }
+
+  const std::string extensions[] = { ".jpg", ".png" };
+  for (size_t e = 0; e < 2; e++) {
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < paths.size(); i++) {
+      filenames.push_back(directory_filename_tmp + "/ViSP_tmp_perf_write_" + std::to_string(i) + extensions[e]);
+    }
+
+    SECTION("RGBA " + extensions[e] + " files")
+    {
+      BENCHMARK("Sequential write (" + std::to_string(filenames.size()) + " files)")
+      {
+        for (size_t i = 0; i < filenames.size(); i++) {
+          vpImageIo::write(ivec[i], filenames[i]);
+        }
+        return ivec;
+      };
+
+      BENCHMARK("writeBatch (" + std::to_string(filenames.size()) + " files)")
+      {
+        vpImageIo::writeBatch(ivec, filenames, vpImageIo::IO_DEFAULT_BACKEND, nThreads);
+        return ivec;
+      };
+    }
+  }
+
+  REQUIRE(vpIoTools::remove(directory_filename_tmp));
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
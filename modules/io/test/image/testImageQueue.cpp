@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test image queue and storage worker.
+ *
+*****************************************************************************/
+
+/*!
+  \example testImageQueue.cpp
+
+  \brief Test vpImageQueue and vpImageStorageWorker.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <fstream>
+#include <thread>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpImageQueue.h>
+#include <visp3/io/vpImageStorageWorker.h>
+
+static std::string g_tmp_dir;
+
+TEST_CASE("Push and pop images", "[image_queue]")
+{
+  vpImageQueue<unsigned char> queue("", 0);
+
+  SECTION("FIFO order and data")
+  {
+    for (unsigned int k = 0; k < 5; k++) {
+      vpImage<unsigned char> I(4, 6, static_cast<unsigned char>(k));
+      std::string data = std::to_string(k);
+      queue.push(I, (k % 2) ? &data : nullptr);
+    }
+    CHECK(queue.getQueueSize() == 5);
+
+    vpImage<unsigned char> I;
+    std::string data;
+    for (unsigned int k = 0; k < 5; k++) {
+      queue.pop(I, data);
+      CHECK(I.getHeight() == 4);
+      CHECK(I.getWidth() == 6);
+      CHECK(I[3][5] == k);
+      CHECK(data == ((k % 2) ? std::to_string(k) : std::string()));
+    }
+    CHECK(queue.getQueueSize() == 0);
+    CHECK(queue.getNbDroppedImages() == 0);
+  }
+
+  SECTION("Oldest images are dropped")
+  {
+    queue.setMaxQueueSize(3);
+    for (unsigned int k = 0; k < 5; k++) {
+      vpImage<unsigned char> I(2, 2, static_cast<unsigned char>(k));
+      queue.push(I, nullptr);
+    }
+    CHECK(queue.getQueueSize() == 3);
+    CHECK(queue.getNbDroppedImages() == 2);
+
+    queue.setMaxQueueSize(2);
+    CHECK(queue.getQueueSize() == 2);
+    CHECK(queue.getNbDroppedImages() == 3);
+
+    vpImage<unsigned char> I;
+    std::string data;
+    queue.pop(I, data);
+    CHECK(I[0][0] == 3);
+    queue.pop(I, data);
+    CHECK(I[0][0] == 4);
+
+    CHECK_THROWS_AS(queue.setMaxQueueSize(0), vpException);
+  }
+
+  SECTION("Buffers are recycled")
+  {
+    queue.setPoolSize(2, 8, 8);
+
+    vpImage<unsigned char> I(8, 8, 7);
+    unsigned char *bitmap = I.bitmap;
+    queue.push(std::move(I), nullptr);
+    // The pushed buffer is swapped with one of the pool
+    CHECK(I.getSize() == 64);
+    CHECK(I.bitmap != bitmap);
+
+    vpImage<unsigned char> I_out;
+    std::string data;
+    queue.pop(I_out, data);
+    CHECK(I_out.bitmap == bitmap);
+    CHECK(I_out[7][7] == 7);
+  }
+
+  SECTION("Pop throws when cancelled and empty")
+  {
+    vpImage<unsigned char> I(2, 2, 1);
+    queue.push(I, nullptr);
+    queue.cancel();
+
+    std::string data;
+    CHECK_NOTHROW(queue.pop(I, data));
+    CHECK_THROWS_AS(queue.pop(I, data), vpImageQueue<unsigned char>::vpCancelled_t);
+  }
+}
+
+TEST_CASE("Save images with several threads", "[image_storage]")
+{
+  const unsigned int nb_images = 20;
+  const std::string seqname = g_tmp_dir + "/queue/I%04d.pgm";
+  vpImageQueue<unsigned char> queue(seqname, 0);
+  vpImageStorageWorker<unsigned char> storage_worker(queue);
+  storage_worker.setNbThreads(4);
+  std::thread storage_thread(&vpImageStorageWorker<unsigned char>::run, &storage_worker);
+
+  vpImage<unsigned char> I(16, 16);
+  for (unsigned int k = 0; k < nb_images; k++) {
+    I = static_cast<unsigned char>(10 * k);
+    std::string data = std::to_string(k);
+    queue.record(I, &data, true, true);
+  }
+  queue.cancel();
+  storage_thread.join();
+
+  char filename[FILENAME_MAX];
+  for (unsigned int k = 0; k < nb_images; k++) {
+    snprintf(filename, FILENAME_MAX, seqname.c_str(), k + 1);
+    vpImage<unsigned char> I_read;
+    vpImageIo::read(I_read, filename);
+    CHECK(I_read[8][8] == 10 * k);
+  }
+
+  std::ifstream ifs(g_tmp_dir + "/queue/I%04d.txt");
+  REQUIRE(ifs.is_open());
+  for (unsigned int k = 0; k < nb_images; k++) {
+    std::string name;
+    unsigned int value;
+    ifs >> name >> value;
+    snprintf(filename, FILENAME_MAX, "I%04d.pgm", k + 1);
+    CHECK(name == filename);
+    CHECK(value == k);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  const std::string tmp_path = vpIoTools::getTempPath();
+  if (!vpIoTools::checkDirectory(tmp_path)) {
+    vpIoTools::makeDirectory(tmp_path);
+  }
+  g_tmp_dir = vpIoTools::makeTempDirectory(tmp_path + "/testImageQueue_XXXXXX");
+
+  int numFailed = session.run();
+
+  vpIoTools::remove(g_tmp_dir);
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
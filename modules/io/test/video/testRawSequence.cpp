@@ -0,0 +1,280 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test single file image sequence container.
+ *
+*****************************************************************************/
+
+/*!
+  \example testRawSequence.cpp
+
+  \brief Test vpRawSequence and its use through vpVideoReader.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <fstream>
+#include <random>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpRawSequence.h>
+#include <visp3/io/vpVideoReader.h>
+
+static std::string g_tmp_dir;
+
+namespace
+{
+const unsigned int nb_frames = 6;
+
+// Smooth images with some noise, close to what a camera gives
+void createFrame(unsigned int k, vpImage<vpRGBa> &color, vpImage<uint16_t> &depth, vpImage<unsigned char> &grey)
+{
+  std::mt19937 gen(k);
+  std::uniform_int_distribution<int> noise(0, 3);
+  const unsigned int h = 48 + k, w = 64 + 2 * k;
+  color.resize(h, w);
+  depth.resize(h, w);
+  grey.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      color[i][j] = vpRGBa(static_cast<unsigned char>(i + j + k), static_cast<unsigned char>(2 * i + noise(gen)),
+                           static_cast<unsigned char>(255 - j), 255);
+      depth[i][j] = (j < w / 4) ? 0 : static_cast<uint16_t>(1000 + 37 * i + 13 * j + 500 * k + noise(gen));
+      grey[i][j] = static_cast<unsigned char>(k % 2 ? noise(gen) * 60 : i * j);
+    }
+  }
+}
+
+void writeFrames(vpRawSequence &seq, unsigned int first, unsigned int last)
+{
+  vpImage<vpRGBa> color;
+  vpImage<uint16_t> depth;
+  vpImage<unsigned char> grey;
+  for (unsigned int k = first; k < last; k++) {
+    createFrame(k, color, depth, grey);
+    seq.write(color, k * 0.1, 0);
+    seq.write(depth, k * 0.1 + 0.01, 1);
+    seq.write(grey, k * 0.1 + 0.02, 2);
+  }
+}
+
+void checkFrames(vpRawSequence &seq, unsigned int nb)
+{
+  REQUIRE(seq.getNbRecords() == 3 * nb);
+  std::vector<size_t> color_records = seq.getStreamRecords(0);
+  std::vector<size_t> depth_records = seq.getStreamRecords(1);
+  std::vector<size_t> grey_records = seq.getStreamRecords(2);
+  REQUIRE(color_records.size() == nb);
+  REQUIRE(depth_records.size() == nb);
+  REQUIRE(grey_records.size() == nb);
+
+  vpImage<vpRGBa> color, color_read;
+  vpImage<uint16_t> depth, depth_read;
+  vpImage<unsigned char> grey, grey_read;
+  // Random access, from the last frame to the first one
+  for (unsigned int n = nb; n > 0; n--) {
+    const unsigned int k = n - 1;
+    createFrame(k, color, depth, grey);
+    double t = 0;
+    seq.read(color_read, color_records[k], &t);
+    CHECK(color_read == color);
+    CHECK(t == Approx(k * 0.1));
+    seq.read(depth_read, depth_records[k], &t);
+    CHECK(depth_read == depth);
+    CHECK(t == Approx(k * 0.1 + 0.01));
+    seq.read(grey_read, grey_records[k], &t);
+    CHECK(grey_read == grey);
+    CHECK(t == Approx(k * 0.1 + 0.02));
+    CHECK(seq.getRecordInfo(depth_records[k]).type == vpRawSequence::PIXEL_UINT16);
+    CHECK(seq.getRecordInfo(depth_records[k]).width == depth.getWidth());
+  }
+}
+} // namespace
+
+TEST_CASE("Write and read a sequence", "[raw_sequence]")
+{
+  const std::string filename = g_tmp_dir + "/rgbd.vpseq";
+
+  SECTION("Compressed")
+  {
+    vpRawSequence writer;
+    writer.open(filename, vpRawSequence::MODE_WRITE);
+    writeFrames(writer, 0, nb_frames);
+    writer.close();
+
+    vpRawSequence reader;
+    reader.open(filename, vpRawSequence::MODE_READ);
+    checkFrames(reader, nb_frames);
+    CHECK_THROWS_AS(reader.write(vpImage<unsigned char>(2, 2), 0.), vpException);
+  }
+
+  SECTION("Uncompressed")
+  {
+    vpRawSequence writer;
+    writer.setCompression(false);
+    writer.open(filename, vpRawSequence::MODE_WRITE);
+    writeFrames(writer, 0, nb_frames);
+    writer.close();
+
+    vpRawSequence reader;
+    reader.open(filename, vpRawSequence::MODE_READ);
+    checkFrames(reader, nb_frames);
+  }
+
+  SECTION("Pixel type conversion")
+  {
+    vpRawSequence writer;
+    writer.open(filename, vpRawSequence::MODE_WRITE);
+    writeFrames(writer, 0, 1);
+    writer.close();
+
+    vpRawSequence reader;
+    reader.open(filename, vpRawSequence::MODE_READ);
+    vpImage<vpRGBa> color;
+    vpImage<uint16_t> depth;
+    vpImage<unsigned char> grey, grey_read;
+    createFrame(0, color, depth, grey);
+    reader.read(grey_read, 0);
+    vpImage<unsigned char> grey_converted;
+    vpImageConvert::convert(color, grey_converted);
+    CHECK(grey_read == grey_converted);
+    CHECK_THROWS_AS(reader.read(grey_read, 1), vpException);
+    CHECK_THROWS_AS(reader.read(depth, 0), vpException);
+    CHECK_THROWS_AS(reader.read(depth, 3), vpException);
+  }
+}
+
+TEST_CASE("Append to a sequence and recover a missing index", "[raw_sequence]")
+{
+  const std::string filename = g_tmp_dir + "/append.vpseq";
+  {
+    vpRawSequence writer;
+    writer.open(filename, vpRawSequence::MODE_APPEND);
+    writeFrames(writer, 0, 2);
+  }
+  {
+    vpRawSequence writer;
+    writer.open(filename, vpRawSequence::MODE_APPEND);
+    CHECK(writer.getNbRecords() == 6);
+    writeFrames(writer, 2, nb_frames);
+  }
+  {
+    vpRawSequence reader;
+    reader.open(filename, vpRawSequence::MODE_READ);
+    checkFrames(reader, nb_frames);
+  }
+
+  // Remove the index, as if the recording was interrupted
+  std::vector<char> content;
+  {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  const size_t index_size = 16 + 3 * nb_frames * 32 + 16;
+  REQUIRE(content.size() > index_size);
+  {
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size() - index_size));
+  }
+  {
+    vpRawSequence reader;
+    reader.open(filename, vpRawSequence::MODE_READ);
+    checkFrames(reader, nb_frames);
+  }
+}
+
+TEST_CASE("Read a sequence with vpVideoReader", "[raw_sequence]")
+{
+  const std::string filename = g_tmp_dir + "/video.vpseq";
+  {
+    vpRawSequence writer;
+    writer.open(filename, vpRawSequence::MODE_WRITE);
+    writeFrames(writer, 0, nb_frames);
+  }
+
+  vpImage<vpRGBa> color, color_read;
+  vpImage<uint16_t> depth;
+  vpImage<unsigned char> grey;
+
+  vpVideoReader reader;
+  reader.setFileName(filename);
+  CHECK(reader.isVideoFormat());
+  reader.open(color_read);
+  CHECK(reader.getFirstFrameIndex() == 0);
+  CHECK(reader.getLastFrameIndex() == static_cast<long>(nb_frames) - 1);
+  CHECK(reader.getFramerate() == Approx(10.));
+
+  long cpt = 0;
+  while (!reader.end()) {
+    reader.acquire(color_read);
+    CHECK(reader.getFrameIndex() == cpt);
+    createFrame(static_cast<unsigned int>(cpt), color, depth, grey);
+    CHECK(color_read == color);
+    cpt++;
+  }
+  CHECK(cpt == static_cast<long>(nb_frames));
+
+  CHECK(reader.getFrame(color_read, 3));
+  createFrame(3, color, depth, grey);
+  CHECK(color_read == color);
+  CHECK_FALSE(reader.getFrame(color_read, static_cast<long>(nb_frames)));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  const std::string tmp_path = vpIoTools::getTempPath();
+  if (!vpIoTools::checkDirectory(tmp_path)) {
+    vpIoTools::makeDirectory(tmp_path);
+  }
+  g_tmp_dir = vpIoTools::makeTempDirectory(tmp_path + "/testRawSequence_XXXXXX");
+
+  int numFailed = session.run();
+
+  vpIoTools::remove(g_tmp_dir);
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
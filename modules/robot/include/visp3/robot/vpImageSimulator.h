@@ -180,13 +180,6 @@ private:
   double *vbase_u_optim;
   double *vbase_v_optim;
 
-  // allocation memoire du point 3D d'intersection entre le vecteur
-  // (centre_cam - point_plan_image) et le plan
-  double *Xinter_optim;
-
-  // triangles de projection du plan
-  std::vector<vpTriangle> listTriangle;
-
   // image de texture
   vpColorPlan colorI;
   vpImage<unsigned char> Ig;
@@ -282,15 +275,11 @@ private:
   // sinon invisible.
   bool isVisible() { return visible; }
 
-  // function that project a point x,y on the plane, return true if the
-  // projection is on the limited plane
-  // and in this case return the corresponding image pixel Ipixelplan
-  bool getPixel(const vpImagePoint &iP, unsigned char &Ipixelplan);
-  bool getPixel(const vpImagePoint &iP, vpRGBa &Ipixelplan);
-  bool getPixel(vpImage<unsigned char> &Isrc, const vpImagePoint &iP, unsigned char &Ipixelplan);
-  bool getPixel(vpImage<vpRGBa> &Isrc, const vpImagePoint &iP, vpRGBa &Ipixelplan);
-  bool getPixelDepth(const vpImagePoint &iP, double &Zpixelplan);
-  bool getPixelVisibility(const vpImagePoint &iP, double &Zpixelplan);
+  // scanline rasterization of the projected plane: call shader(i, j, Z, u, v)
+  // for each pixel (i, j) of the image viewing the plane at depth Z and at
+  // texture coordinates u, v in ]0, 1[
+  template <typename Shader>
+  void rasterize(unsigned int width, unsigned int height, const vpCameraParameters &cam, const Shader &shader);
 
   // operation 3D de base :
   void project(const vpColVector &_vin, const vpHomogeneousMatrix &_cMt, vpColVector &_vout);
@@ -45,6 +45,99 @@
 #include <visp3/io/vpImageIo.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Linear form a x + b y + c of the normalized coordinates (x, y) of a pixel
+struct vpLinearForm
+{
+  double a;
+  double b;
+  double c;
+};
+
+// Conversion of a texture value into a pixel of the simulated image
+inline void convertPixel(unsigned char src, unsigned char &dst) { dst = src; }
+inline void convertPixel(const vpRGBa &src, unsigned char &dst)
+{
+  dst = static_cast<unsigned char>(0.2126 * src.R + 0.7152 * src.G + 0.0722 * src.B);
+}
+inline void convertPixel(unsigned char src, vpRGBa &dst) { dst = vpRGBa(src, src, src); }
+inline void convertPixel(const vpRGBa &src, vpRGBa &dst) { dst = src; }
+
+// Bilinear interpolation of the texture at (i, j), with 0 <= i < height - 1 and 0 <= j < width - 1
+inline unsigned char getBilinearValue(const vpImage<unsigned char> &T, double i, double j) { return T.getValue(i, j); }
+inline vpRGBa getBilinearValue(const vpImage<vpRGBa> &T, double i, double j)
+{
+  // Fixed-point arithmetic, as in vpImage<unsigned char>::getValue()
+  const int64_t precision = 1 << 16;
+  const int64_t y = static_cast<int64_t>(i * precision);
+  const int64_t x = static_cast<int64_t>(j * precision);
+  const int64_t rratio = y & 0xFFFF;
+  const int64_t cratio = x & 0xFFFF;
+  const unsigned int i0 = static_cast<unsigned int>(y >> 16);
+  const unsigned int j0 = static_cast<unsigned int>(x >> 16);
+  const unsigned int i1 = std::min<unsigned int>(i0 + 1, T.getHeight() - 1);
+  const unsigned int j1 = std::min<unsigned int>(j0 + 1, T.getWidth() - 1);
+
+  const int64_t w00 = (precision - rratio) * (precision - cratio);
+  const int64_t w01 = (precision - rratio) * cratio;
+  const int64_t w10 = rratio * (precision - cratio);
+  const int64_t w11 = rratio * cratio;
+  const vpRGBa &p00 = T[i0][j0];
+  const vpRGBa &p01 = T[i0][j1];
+  const vpRGBa &p10 = T[i1][j0];
+  const vpRGBa &p11 = T[i1][j1];
+  const int64_t half = static_cast<int64_t>(1) << 31;
+  return vpRGBa(static_cast<unsigned char>((p00.R * w00 + p01.R * w01 + p10.R * w10 + p11.R * w11 + half) >> 32),
+                static_cast<unsigned char>((p00.G * w00 + p01.G * w01 + p10.G * w10 + p11.G * w11 + half) >> 32),
+                static_cast<unsigned char>((p00.B * w00 + p01.B * w01 + p10.B * w10 + p11.B * w11 + half) >> 32));
+}
+
+/*
+  Copy the texture value seen by a pixel of the simulated image. When a z-buffer is given, the pixel is only updated
+  if the plane is in front of the one drawn so far, negative depths meaning that no plane was drawn yet.
+*/
+template <typename TextureType, typename ImageType> class vpTextureShader
+{
+public:
+  vpTextureShader(const vpImage<TextureType> &texture, bool bilinear, vpImage<ImageType> &I,
+                  double *zBuffer = nullptr)
+    : m_texture(texture), m_bilinear(bilinear), m_I(I), m_zBuffer(zBuffer), m_height(texture.getHeight() - 1.),
+      m_width(texture.getWidth() - 1.)
+  { }
+
+  inline void operator()(unsigned int i, unsigned int j, double Z, double u, double v) const
+  {
+    if (m_zBuffer != nullptr) {
+      double &z = m_zBuffer[i * m_I.getWidth() + j];
+      if (!(Z < z || z < 0)) {
+        return;
+      }
+      z = Z;
+    }
+
+    double i2 = v * m_height;
+    double j2 = u * m_width;
+    if (m_bilinear)
+      convertPixel(getBilinearValue(m_texture, i2, j2), m_I[i][j]);
+    else
+      convertPixel(m_texture[static_cast<unsigned int>(i2)][static_cast<unsigned int>(j2)], m_I[i][j]);
+  }
+
+private:
+  const vpImage<TextureType> &m_texture;
+  bool m_bilinear;
+  vpImage<ImageType> &m_I;
+  double *m_zBuffer;
+  double m_height;
+  double m_width;
+};
+} // namespace
+
 /*!
   Basic constructor.
 
@@ -58,7 +151,7 @@
 vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
   : cMt(), pt(), ptClipped(), interp(SIMPLE), normal_obj(), normal_Cam(), normal_Cam_optim(), distance(1.),
     visible_result(1.), visible(false), X0_2_optim(nullptr), frobeniusNorm_u(0.), fronbniusNorm_v(0.), vbase_u(),
-    vbase_v(), vbase_u_optim(nullptr), vbase_v_optim(nullptr), Xinter_optim(nullptr), listTriangle(), colorI(col), Ig(), Ic(),
+    vbase_v(), vbase_u_optim(nullptr), vbase_v_optim(nullptr), colorI(col), Ig(), Ic(),
     rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
 {
   for (int i = 0; i < 4; i++)
@@ -71,8 +164,6 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
   visible = false;
   normal_Cam.resize(3);
 
-  // Xinter.resize(3);
-
   vbase_u.resize(3);
   vbase_v.resize(3);
 
@@ -84,7 +175,6 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
   X0_2_optim = new double[3];
   vbase_u_optim = new double[3];
   vbase_v_optim = new double[3];
-  Xinter_optim = new double[3];
 
   pt.resize(4);
 }
@@ -95,7 +185,7 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
 vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
   : cMt(), pt(), ptClipped(), interp(SIMPLE), normal_obj(), normal_Cam(), normal_Cam_optim(), distance(1.),
     visible_result(1.), visible(false), X0_2_optim(nullptr), frobeniusNorm_u(0.), fronbniusNorm_v(0.), vbase_u(),
-    vbase_v(), vbase_u_optim(nullptr), vbase_v_optim(nullptr), Xinter_optim(nullptr), listTriangle(), colorI(GRAY_SCALED), Ig(),
+    vbase_v(), vbase_u_optim(nullptr), vbase_v_optim(nullptr), colorI(GRAY_SCALED), Ig(),
     Ic(), rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(),
     needClipping(false)
 {
@@ -127,7 +217,6 @@ vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
   X0_2_optim = new double[3];
   vbase_u_optim = new double[3];
   vbase_v_optim = new double[3];
-  Xinter_optim = new double[3];
 
   colorI = text.colorI;
   interp = text.interp;
@@ -147,7 +236,6 @@ vpImageSimulator::~vpImageSimulator()
   delete[] X0_2_optim;
   delete[] vbase_u_optim;
   delete[] vbase_v_optim;
-  delete[] Xinter_optim;
 }
 
 vpImageSimulator &vpImageSimulator::operator=(const vpImageSimulator &sim)
@@ -177,6 +265,143 @@ vpImageSimulator &vpImageSimulator::operator=(const vpImageSimulator &sim)
   return *this;
 }
 
+/*
+  Scanline rasterization of the projected plane.
+
+  A pixel of normalized coordinates (x, y) views the plane at depth Z = d / (n . (x, y, 1)), so that 1/Z is linear in
+  x and y, and so are u/Z and v/Z where (u, v) are the texture coordinates of the intersection. Being inside the
+  projected polygon, in front of the camera and inside the texture are thus all expressed by linear constraints
+  a x + b y + c > 0. Along an image row these constraints give the span of the pixels to fill, and the perspective
+  correct texture coordinates are obtained from 1/Z, u/Z and v/Z updated linearly along the span. When the camera
+  has distortion parameters, the normalized coordinates of each pixel of the bounding box are computed instead.
+
+  The rows are processed in parallel, the shader is therefore only allowed to modify pixel (i, j).
+*/
+template <typename Shader>
+void vpImageSimulator::rasterize(unsigned int width, unsigned int height, const vpCameraParameters &cam,
+                                 const Shader &shader)
+{
+  const std::vector<vpPoint> &points = needClipping ? ptClipped : pt;
+  getRoi(width, height, cam, points, rect);
+
+  const size_t nbPoints = points.size();
+  if (nbPoints < 3) {
+    return;
+  }
+  double area = 0;
+  for (size_t k = 0; k < nbPoints; k++) {
+    const vpPoint &p0 = points[k];
+    const vpPoint &p1 = points[(k + 1) % nbPoints];
+    area += p0.get_x() * p1.get_y() - p1.get_x() * p0.get_y();
+  }
+  if (std::fabs(area) <= std::numeric_limits<double>::epsilon()) {
+    return;
+  }
+  const double orientation = (area > 0) ? 1. : -1.;
+
+  // 1/Z, u/Z and v/Z
+  const double normU = frobeniusNorm_u * frobeniusNorm_u;
+  const double normV = fronbniusNorm_v * fronbniusNorm_v;
+  double originU = 0, originV = 0;
+  for (unsigned int i = 0; i < 3; i++) {
+    originU += X0_2_optim[i] * vbase_u_optim[i];
+    originV += X0_2_optim[i] * vbase_v_optim[i];
+  }
+  vpLinearForm invZ = { normal_Cam_optim[0] / distance, normal_Cam_optim[1] / distance,
+                        normal_Cam_optim[2] / distance };
+  vpLinearForm uZ = { (vbase_u_optim[0] - originU * invZ.a) / normU, (vbase_u_optim[1] - originU * invZ.b) / normU,
+                      (vbase_u_optim[2] - originU * invZ.c) / normU };
+  vpLinearForm vZ = { (vbase_v_optim[0] - originV * invZ.a) / normV, (vbase_v_optim[1] - originV * invZ.b) / normV,
+                      (vbase_v_optim[2] - originV * invZ.c) / normV };
+
+  std::vector<vpLinearForm> constraints;
+  constraints.reserve(5 + nbPoints);
+  constraints.push_back(invZ);
+  constraints.push_back(uZ);
+  constraints.push_back(vZ);
+  vpLinearForm uMax = { invZ.a - uZ.a, invZ.b - uZ.b, invZ.c - uZ.c };
+  vpLinearForm vMax = { invZ.a - vZ.a, invZ.b - vZ.b, invZ.c - vZ.c };
+  constraints.push_back(uMax);
+  constraints.push_back(vMax);
+  for (size_t k = 0; k < nbPoints; k++) {
+    const vpPoint &p0 = points[k];
+    const vpPoint &p1 = points[(k + 1) % nbPoints];
+    vpLinearForm edge = { orientation * (p0.get_y() - p1.get_y()), orientation * (p1.get_x() - p0.get_x()),
+                          orientation * (p0.get_x() * p1.get_y() - p1.get_x() * p0.get_y()) };
+    constraints.push_back(edge);
+  }
+  const int nbConstraints = static_cast<int>(constraints.size());
+
+  const int top = static_cast<int>(std::floor(rect.getTop()));
+  const int bottom = static_cast<int>(std::ceil(rect.getBottom()));
+  const int left = static_cast<int>(std::floor(rect.getLeft()));
+  const int right = static_cast<int>(std::ceil(rect.getRight()));
+  const bool linear = (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion);
+  const double px = cam.get_px(), py = cam.get_py(), u0 = cam.get_u0(), v0 = cam.get_v0();
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 8) if ((bottom - top) * (right - left) > 16384)
+#endif
+  for (int i = top; i <= bottom; i++) {
+    if (linear) {
+      // The constraints are linear along the row: A + B j > 0
+      const double y = (i - v0) / py;
+      double jmin = left, jmax = right;
+      for (int k = 0; k < nbConstraints && jmin <= jmax; k++) {
+        const vpLinearForm &f = constraints[k];
+        const double B = f.a / px;
+        const double A = f.b * y + f.c - B * u0;
+        if (B > 0)
+          jmin = std::max(jmin, -A / B);
+        else if (B < 0)
+          jmax = std::min(jmax, -A / B);
+        else if (A < 0)
+          jmax = jmin - 1;
+      }
+      if (jmin > jmax) {
+        continue;
+      }
+
+      const double dInvZ = invZ.a / px, dUZ = uZ.a / px, dVZ = vZ.a / px;
+      const double invZ0 = invZ.b * y + invZ.c - dInvZ * u0;
+      const double uZ0 = uZ.b * y + uZ.c - dUZ * u0;
+      const double vZ0 = vZ.b * y + vZ.c - dVZ * u0;
+      const int j1 = static_cast<int>(std::floor(jmax));
+      for (int j = static_cast<int>(std::ceil(jmin)); j <= j1; j++) {
+        const double q = invZ0 + dInvZ * j;
+        if (q > 0) {
+          const double Z = 1. / q;
+          const double u = (uZ0 + dUZ * j) * Z;
+          const double v = (vZ0 + dVZ * j) * Z;
+          if (u > 0 && v > 0 && u < 1. && v < 1.) {
+            shader(static_cast<unsigned int>(i), static_cast<unsigned int>(j), Z, u, v);
+          }
+        }
+      }
+    }
+    else {
+      for (int j = left; j <= right; j++) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, static_cast<double>(j), static_cast<double>(i), x, y);
+        bool inside = true;
+        for (int k = 3; k < nbConstraints && inside; k++) {
+          const vpLinearForm &f = constraints[k];
+          inside = (f.a * x + f.b * y + f.c >= 0);
+        }
+        const double q = invZ.a * x + invZ.b * y + invZ.c;
+        if (inside && q > 0) {
+          const double Z = 1. / q;
+          const double u = (uZ.a * x + uZ.b * y + uZ.c) * Z;
+          const double v = (vZ.a * x + vZ.b * y + vZ.c) * Z;
+          if (u > 0 && v > 0 && u < 1. && v < 1.) {
+            shader(static_cast<unsigned int>(i), static_cast<unsigned int>(j), Z, u, v);
+          }
+        }
+      }
+    }
+  }
+}
+
 /*!
   Get the view of the virtual camera. Be careful, the image I is modified. The
   projected image is not added as an overlay! \param I : The image used to
@@ -199,41 +424,12 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 0;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            unsigned char pixelgrey =
-                (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-            *(bitmap + i * width + j) = pixelgrey;
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<unsigned char, unsigned char>(Ig, interp == BILINEAR_INTERPOLATION, I));
+    else if (colorI == COLORED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<vpRGBa, unsigned char>(Ic, interp == BILINEAR_INTERPOLATION, I));
   }
 }
 
@@ -257,32 +453,8 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, vpImage<unsigned char
     }
   }
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        unsigned char Ipixelplan = 0;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-        }
-      }
-    }
+    rasterize(I.getWidth(), I.getHeight(), cam,
+              vpTextureShader<unsigned char, unsigned char>(Isrc, interp == BILINEAR_INTERPOLATION, I));
   }
 }
 
@@ -316,47 +488,12 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
     }
   }
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              unsigned char pixelgrey =
-                  (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-              *(bitmap + i * width + j) = pixelgrey;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<unsigned char, unsigned char>(Ig, interp == BILINEAR_INTERPOLATION, I, zBuffer.data));
+    else if (colorI == COLORED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<vpRGBa, unsigned char>(Ic, interp == BILINEAR_INTERPOLATION, I, zBuffer.data));
   }
 }
 
@@ -378,43 +515,12 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            vpRGBa pixelcolor;
-            pixelcolor.R = Ipixelplan;
-            pixelcolor.G = Ipixelplan;
-            pixelcolor.B = Ipixelplan;
-            *(bitmap + i * width + j) = pixelcolor;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<unsigned char, vpRGBa>(Ig, interp == BILINEAR_INTERPOLATION, I));
+    else if (colorI == COLORED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<vpRGBa, vpRGBa>(Ic, interp == BILINEAR_INTERPOLATION, I));
   }
 }
 
@@ -438,32 +544,8 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, vpImage<vpRGBa> &Isrc, const
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        vpRGBa Ipixelplan;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-        }
-      }
-    }
+    rasterize(I.getWidth(), I.getHeight(), cam,
+              vpTextureShader<vpRGBa, vpRGBa>(Isrc, interp == BILINEAR_INTERPOLATION, I));
   }
 }
 
@@ -496,49 +578,12 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
     }
   }
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              vpRGBa pixelcolor;
-              pixelcolor.R = Ipixelplan;
-              pixelcolor.G = Ipixelplan;
-              pixelcolor.B = Ipixelplan;
-              *(bitmap + i * width + j) = pixelcolor;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<unsigned char, vpRGBa>(Ig, interp == BILINEAR_INTERPOLATION, I, zBuffer.data));
+    else if (colorI == COLORED)
+      rasterize(I.getWidth(), I.getHeight(), cam,
+                vpTextureShader<vpRGBa, vpRGBa>(Ic, interp == BILINEAR_INTERPOLATION, I, zBuffer.data));
   }
 }
 
@@ -649,93 +694,26 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
 void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list,
                                 const vpCameraParameters &cam)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
+  if (list.empty())
     return;
 
-  vpImageSimulator **simList = new vpImageSimulator *[nbsimList];
-
-  double topFinal = height + 1;
-  ;
-  double bottomFinal = -1;
-  double leftFinal = width + 1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
-    vpImageSimulator *sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
-  nbsimList = nbsimList - unvisible;
+  // Depth of the nearest plane drawn so far, negative where no plane was drawn yet
+  vpMatrix zBuffer(I.getHeight(), I.getWidth(), -1.);
 
-  if (nbsimList < 1) {
-    delete[] simList;
-    return;
-  }
+  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it) {
+    vpImageSimulator &sim = *it;
+    if (!sim.visible)
+      continue;
 
-  for (unsigned int i = 0; i < nbsimList; i++) {
-    if (!simList[i]->needClipping)
-      simList[i]->getRoi(width, height, cam, simList[i]->pt, simList[i]->rect);
-    else
-      simList[i]->getRoi(width, height, cam, simList[i]->ptClipped, simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop())
-      topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom())
-      bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft())
-      leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight())
-      rightFinal = simList[i]->rect.getRight();
-  }
+    bool bilinear = (sim.interp == BILINEAR_INTERPOLATION);
 
-  double zmin = -1;
-  int indice = -1;
-  unsigned char *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
-      zmin = -1;
-      double x = 0, y = 0;
-      ip.set_ij(i, j);
-      vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-      ip.set_ij(y, x);
-      for (int k = 0; k < (int)nbsimList; k++) {
-        double z = 0;
-        if (simList[k]->getPixelDepth(ip, z)) {
-          if (z < zmin || zmin < 0) {
-            zmin = z;
-            indice = k;
-          }
-        }
-      }
-      if (indice >= 0) {
-        if (simList[indice]->colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip, Ipixelplan);
-          *(bitmap + i * width + j) = Ipixelplan;
-        } else if (simList[indice]->colorI == COLORED) {
-          vpRGBa Ipixelplan(255, 255, 255);
-          simList[indice]->getPixel(ip, Ipixelplan);
-          unsigned char pixelgrey =
-              (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-          *(bitmap + i * width + j) = pixelgrey;
-        }
-      }
-    }
+    if (sim.colorI == GRAY_SCALED)
+      sim.rasterize(I.getWidth(), I.getHeight(), cam,
+                    vpTextureShader<unsigned char, unsigned char>(sim.Ig, bilinear, I, zBuffer.data));
+    else if (sim.colorI == COLORED)
+      sim.rasterize(I.getWidth(), I.getHeight(), cam,
+                    vpTextureShader<vpRGBa, unsigned char>(sim.Ic, bilinear, I, zBuffer.data));
   }
-
-  delete[] simList;
 }
 
 /*!
@@ -846,98 +824,26 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimu
 */
 void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
+  if (list.empty())
     return;
 
-  vpImageSimulator **simList = new vpImageSimulator *[nbsimList];
-
-  double topFinal = height + 1;
-  ;
-  double bottomFinal = -1;
-  double leftFinal = width + 1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
-    vpImageSimulator *sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
+  // Depth of the nearest plane drawn so far, negative where no plane was drawn yet
+  vpMatrix zBuffer(I.getHeight(), I.getWidth(), -1.);
 
-  nbsimList = nbsimList - unvisible;
+  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it) {
+    vpImageSimulator &sim = *it;
+    if (!sim.visible)
+      continue;
 
-  if (nbsimList < 1) {
-    delete[] simList;
-    return;
-  }
-
-  for (unsigned int i = 0; i < nbsimList; i++) {
-    if (!simList[i]->needClipping)
-      simList[i]->getRoi(width, height, cam, simList[i]->pt, simList[i]->rect);
-    else
-      simList[i]->getRoi(width, height, cam, simList[i]->ptClipped, simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop())
-      topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom())
-      bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft())
-      leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight())
-      rightFinal = simList[i]->rect.getRight();
-  }
+    bool bilinear = (sim.interp == BILINEAR_INTERPOLATION);
 
-  double zmin = -1;
-  int indice = -1;
-  vpRGBa *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
-      zmin = -1;
-      double x = 0, y = 0;
-      ip.set_ij(i, j);
-      vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-      ip.set_ij(y, x);
-      for (int k = 0; k < (int)nbsimList; k++) {
-        double z = 0;
-        if (simList[k]->getPixelDepth(ip, z)) {
-          if (z < zmin || zmin < 0) {
-            zmin = z;
-            indice = k;
-          }
-        }
-      }
-      if (indice >= 0) {
-        if (simList[indice]->colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip, Ipixelplan);
-          vpRGBa pixelcolor;
-          pixelcolor.R = Ipixelplan;
-          pixelcolor.G = Ipixelplan;
-          pixelcolor.B = Ipixelplan;
-          *(bitmap + i * width + j) = pixelcolor;
-        } else if (simList[indice]->colorI == COLORED) {
-          vpRGBa Ipixelplan(255, 255, 255);
-          simList[indice]->getPixel(ip, Ipixelplan);
-          // unsigned char pixelgrey = 0.2126 * Ipixelplan.R + 0.7152 *
-          // Ipixelplan.G + 0.0722 * Ipixelplan.B;
-          *(bitmap + i * width + j) = Ipixelplan;
-        }
-      }
-    }
+    if (sim.colorI == GRAY_SCALED)
+      sim.rasterize(I.getWidth(), I.getHeight(), cam,
+                    vpTextureShader<unsigned char, vpRGBa>(sim.Ig, bilinear, I, zBuffer.data));
+    else if (sim.colorI == COLORED)
+      sim.rasterize(I.getWidth(), I.getHeight(), cam,
+                    vpTextureShader<vpRGBa, vpRGBa>(sim.Ic, bilinear, I, zBuffer.data));
   }
-
-  delete[] simList;
 }
 
 /*!
@@ -1006,26 +912,8 @@ void vpImageSimulator::setCameraPosition(const vpHomogeneousMatrix &cMt_)
       vbase_v_optim[i] = vbase_v[i];
     }
 
-    std::vector<vpPoint> *ptPtr = &pt;
     if (needClipping) {
       vpPolygon3D::getClippedPolygon(pt, ptClipped, cMt, vpPolygon3D::NEAR_CLIPPING);
-      ptPtr = &ptClipped;
-    }
-
-    listTriangle.clear();
-    for (unsigned int i = 1; i < (*ptPtr).size() - 1; i++) {
-      vpImagePoint ip1, ip2, ip3;
-      ip1.set_j((*ptPtr)[0].get_x());
-      ip1.set_i((*ptPtr)[0].get_y());
-
-      ip2.set_j((*ptPtr)[i].get_x());
-      ip2.set_i((*ptPtr)[i].get_y());
-
-      ip3.set_j((*ptPtr)[i + 1].get_x());
-      ip3.set_i((*ptPtr)[i + 1].get_y());
-
-      vpTriangle tri(ip1, ip2, ip3);
-      listTriangle.push_back(tri);
     }
   }
 }
@@ -1211,255 +1099,6 @@ void vpImageSimulator::init(const char *file_image, const std::vector<vpPoint> &
 }
 #endif
 
-bool vpImageSimulator::getPixel(const vpImagePoint &iP, unsigned char &Ipixelplan)
-{
-  //  std::cout << "In get Pixel" << std::endl;
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP)){
-  ////      std::cout << "The pixel is inside the projected area" <<
-  /// std::endl;
-  //    return false;}
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //  centre = X0_2_optim[i] (premier point definissant le plan)
-  //  base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Ig.getHeight() - 1);
-    j2 = u * (Ig.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Ig.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Ig[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(vpImage<unsigned char> &Isrc, const vpImagePoint &iP, unsigned char &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //  centre = X0_2_optim[i] (premier point definissant le plan)
-  //  base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Isrc.getHeight() - 1);
-    j2 = u * (Isrc.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Isrc.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Isrc[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(const vpImagePoint &iP, vpRGBa &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //  centre = X0_2_optim[i] (premier point definissant le plan)
-  //  base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Ic.getHeight() - 1);
-    j2 = u * (Ic.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Ic.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Ic[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(vpImage<vpRGBa> &Isrc, const vpImagePoint &iP, vpRGBa &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //  centre = X0_2_optim[i] (premier point definissant le plan)
-  //  base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Isrc.getHeight() - 1);
-    j2 = u * (Isrc.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Isrc.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Isrc[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixelDepth(const vpImagePoint &iP, double &Zpixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  Zpixelplan = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  return true;
-}
-
-bool vpImageSimulator::getPixelVisibility(const vpImagePoint &iP, double &Visipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  Visipixelplan = visible_result;
-  return true;
-}
-
 void vpImageSimulator::project(const vpColVector &_vin, const vpHomogeneousMatrix &_cMt, vpColVector &_vout)
 {
   vpColVector XH(4);
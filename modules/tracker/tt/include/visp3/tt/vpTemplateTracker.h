@@ -142,6 +142,17 @@ protected:
   vpImage<double> dIy;
   vpTemplateTrackerZone zoneRef_; // Reference zone
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  // Template points as arrays, one entry per pyramid level
+  std::vector<vpTemplateTrackerPointArrays> ptArrays;
+  // Warped template point coordinates
+  std::vector<double> ptWarpedU;
+  std::vector<double> ptWarpedV;
+  // Horizontally filtered image and area of BI that is blurred for the current image
+  vpImage<double> BIx;
+  int blurRowMin, blurRowMax, blurColMin, blurColMax;
+#endif
+
 public:
   //! Default constructor.
   vpTemplateTracker()
@@ -154,7 +165,8 @@ public:
       useBrent(false), nbIterBrent(0), taillef(0), fgG(nullptr), fgdG(nullptr), ratioPixelIn(0), mod_i(0), mod_j(0),
       nbParam(), lambdaDep(0), iterationMax(0), iterationGlobale(0), diverge(false), nbIteration(0),
       useCompositionnal(false), useInverse(false), Warp(nullptr), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(),
-      zoneRef_()
+      zoneRef_(), ptArrays(), ptWarpedU(), ptWarpedV(), BIx(), blurRowMin(0), blurRowMax(-1), blurColMin(0),
+      blurColMax(-1)
   {
   }
   explicit vpTemplateTracker(vpTemplateTrackerWarp *_warp);
@@ -283,18 +295,29 @@ public:
 #endif
 
 protected:
+  void blurWarpedPoints(const vpImage<unsigned char> &I, unsigned int nbPoints);
   void computeEvalRMS(const vpColVector &p);
   void computeOptimalBrentGain(const vpImage<unsigned char> &I, vpColVector &tp, double tMI, vpColVector &direction,
                                double &alpha);
   virtual double getCost(const vpImage<unsigned char> &I, const vpColVector &tp) = 0;
-  void getGaussianBluredImage(const vpImage<unsigned char> &I) { vpImageFilter::filter(I, BI, fgG, taillef); }
+  void getGaussianBluredImage(const vpImage<unsigned char> &I)
+  {
+    vpImageFilter::filter(I, BI, fgG, taillef);
+    blurRowMin = 0;
+    blurRowMax = static_cast<int>(I.getHeight()) - 1;
+    blurColMin = 0;
+    blurColMax = static_cast<int>(I.getWidth()) - 1;
+  }
+  const vpTemplateTrackerPointArrays &getTemplatePointArrays(bool useHiG, const bool *select);
   virtual void initHessienDesired(const vpImage<unsigned char> &I) = 0;
   virtual void initHessienDesiredPyr(const vpImage<unsigned char> &I);
+  void initBlurredImage(const vpImage<unsigned char> &I);
   void initPosEvalRMS(const vpColVector &p);
   virtual void initPyramidal(unsigned int nbLvl, unsigned int l0);
   void initTracking(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
   virtual void initTrackingPyr(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
   virtual void trackPyr(const vpImage<unsigned char> &I);
+  void warpTemplatePoints(const vpTemplateTrackerPointArrays &pts, const vpColVector &tp);
 };
 #endif
@@ -45,6 +45,7 @@
 #define vpTemplateTrackerHeader_hh
 
 #include <stdio.h>
+#include <vector>
 
 /*!
   \struct vpTemplateTrackerZPoint
@@ -87,6 +88,19 @@ struct vpTemplateTrackerPointCompo {
 };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  Template points of one pyramid level stored as contiguous arrays, used by the evaluation kernels of the trackers.
+*/
+struct vpTemplateTrackerPointArrays {
+  const vpTemplateTrackerPoint *source; // Points from which the arrays were built
+  unsigned int nbParam;                 // Number of values per point in coef
+  std::vector<double> u, v;             // Template point coordinates
+  std::vector<double> val;              // Template intensities
+  std::vector<unsigned char> select;    // Points used to compute the displacement
+  std::vector<double> coef;             // nbParam values per point: HiG or dW
+  vpTemplateTrackerPointArrays() : source(nullptr), nbParam(0), u(), v(), val(), select(), coef() {}
+};
+
 struct vpTemplateTrackerPointSuppMIInv {
   double et;
   int ct;
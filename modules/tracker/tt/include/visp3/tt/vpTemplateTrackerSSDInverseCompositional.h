@@ -61,6 +61,8 @@ protected:
   bool useTemplateSelect; // use only the strong gradient pixels to compute the Jabocian
 
 protected:
+  double getCost(const vpImage<unsigned char> &I, const vpColVector &tp);
+  using vpTemplateTrackerSSD::getCost;
   void initHessienDesired(const vpImage<unsigned char> &I);
   void initCompInverse(const vpImage<unsigned char> &I);
   void trackNoPyr(const vpImage<unsigned char> &I);
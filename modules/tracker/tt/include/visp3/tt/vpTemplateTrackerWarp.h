@@ -230,8 +230,11 @@ public:
     \param p : Parameters of the warp.
     \param u : Resulting u coordinates.
     \param v : resulting v coordinates.
+
+    The default implementation calls computeDenom() and warpX() for each point. The warping models
+    override it with a loop where the model is inlined.
   */
-  void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
+  virtual void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
 
   /*!
     Warp a triangle and store the result in a new zone.
@@ -90,6 +90,7 @@ public:
 
   void pRondp(const vpColVector &p1, const vpColVector &p2, vpColVector &p12) const;
 
+  void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
   void warpX(const vpColVector &X1, vpColVector &X2, const vpColVector &p);
   void warpX(const int &v1, const int &u1, double &v2, double &u2, const vpColVector &p);
   void warpXInv(const vpColVector &X1, vpColVector &X2, const vpColVector &p);
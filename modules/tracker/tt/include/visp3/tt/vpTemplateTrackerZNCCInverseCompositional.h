@@ -61,6 +61,8 @@ protected:
   vpColVector moydIrefdp;
 
 protected:
+  double getCost(const vpImage<unsigned char> &I, const vpColVector &tp);
+  using vpTemplateTrackerZNCC::getCost;
   void initCompInverse(const vpImage<unsigned char> &I);
   void initHessienDesired(const vpImage<unsigned char> &I);
   void trackNoPyr(const vpImage<unsigned char> &I);
@@ -39,6 +39,68 @@
 #include <visp3/core/vpImageTools.h>
 #include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+  Accumulate the SSD error and the displacement over the warped template points. The number of parameters N is known
+  at compile time for the usual warps, so that the inner loop over the parameters is unrolled; N = 0 stands for a
+  number of parameters only known at run time.
+ */
+template <typename ImageType, unsigned int N>
+void accumulateSSD(const vpImage<ImageType> &I, const vpTemplateTrackerPointArrays &pts, const double *u,
+                   const double *v, double height_1, double width_1, vpColVector &dp, double &erreur,
+                   unsigned int &Nbpoint)
+{
+  const unsigned int nbParam = (N == 0) ? pts.nbParam : N;
+  const size_t nbPoints = pts.val.size();
+  const double *coef = pts.coef.data();
+  double *pdp = dp.data;
+  for (size_t point = 0; point < nbPoints; point++, coef += nbParam) {
+    if (pts.select[point]) {
+      const double i2 = v[point];
+      const double j2 = u[point];
+      if ((i2 >= 0) && (j2 >= 0) && (i2 < height_1) && (j2 < width_1)) {
+        const double IW = I.getValue(i2, j2);
+        Nbpoint++;
+        const double er = (pts.val[point] - IW);
+        for (unsigned int it = 0; it < nbParam; it++)
+          pdp[it] += er * coef[it];
+
+        erreur += er * er;
+      }
+    }
+  }
+}
+
+template <typename ImageType>
+void accumulateSSD(const vpImage<ImageType> &I, const vpTemplateTrackerPointArrays &pts, const double *u,
+                   const double *v, double height_1, double width_1, vpColVector &dp, double &erreur,
+                   unsigned int &Nbpoint)
+{
+  switch (pts.nbParam) {
+  case 2:
+    accumulateSSD<ImageType, 2>(I, pts, u, v, height_1, width_1, dp, erreur, Nbpoint);
+    break;
+  case 3:
+    accumulateSSD<ImageType, 3>(I, pts, u, v, height_1, width_1, dp, erreur, Nbpoint);
+    break;
+  case 4:
+    accumulateSSD<ImageType, 4>(I, pts, u, v, height_1, width_1, dp, erreur, Nbpoint);
+    break;
+  case 6:
+    accumulateSSD<ImageType, 6>(I, pts, u, v, height_1, width_1, dp, erreur, Nbpoint);
+    break;
+  case 8:
+    accumulateSSD<ImageType, 8>(I, pts, u, v, height_1, width_1, dp, erreur, Nbpoint);
+    break;
+  default:
+    accumulateSSD<ImageType, 0>(I, pts, u, v, height_1, width_1, dp, erreur, Nbpoint);
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 vpTemplateTrackerSSDInverseCompositional::vpTemplateTrackerSSDInverseCompositional(vpTemplateTrackerWarp *warp)
   : vpTemplateTrackerSSD(warp), compoInitialised(false), HInv(), HCompInverse(), useTemplateSelect(false)
 {
@@ -50,6 +112,13 @@ vpTemplateTrackerSSDInverseCompositional::vpTemplateTrackerSSDInverseComposition
 void vpTemplateTrackerSSDInverseCompositional::initCompInverse(const vpImage<unsigned char> & /*I*/)
 {
   H = 0;
+  // The per point parameters are recomputed, forget their copy
+  for (size_t k = 0; k < ptArrays.size(); k++) {
+    if (ptArrays[k].source == ptTemplate) {
+      ptArrays.erase(ptArrays.begin() + static_cast<std::ptrdiff_t>(k));
+      break;
+    }
+  }
 
   for (unsigned int point = 0; point < templateSize; point++) {
     if ((!useTemplateSelect) || (ptTemplateSelect[point])) {
@@ -90,22 +159,51 @@ void vpTemplateTrackerSSDInverseCompositional::initHessienDesired(const vpImage<
   initCompInverse(I);
 }
 
+double vpTemplateTrackerSSDInverseCompositional::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
+{
+  const vpTemplateTrackerPointArrays &pts =
+      getTemplatePointArrays(true, useTemplateSelect ? ptTemplateSelect : nullptr);
+  warpTemplatePoints(pts, tp);
+  if (blur) {
+    blurWarpedPoints(I, templateSize);
+  }
+
+  const double height_1 = I.getHeight() - 1;
+  const double width_1 = I.getWidth() - 1;
+  double erreur = 0;
+  int Nbpoint = 0;
+  for (unsigned int point = 0; point < templateSize; point++) {
+    const double i2 = ptWarpedV[point];
+    const double j2 = ptWarpedU[point];
+    if ((i2 >= 0) && (j2 >= 0) && (i2 < height_1) && (j2 < width_1)) {
+      const double Tij = pts.val[point];
+      const double IW = blur ? BI.getValue(i2, j2) : I.getValue(i2, j2);
+      erreur += (Tij - IW) * (Tij - IW);
+      Nbpoint++;
+    }
+  }
+  ratioPixelIn = static_cast<double>(Nbpoint) / static_cast<double>(templateSize);
+
+  if (Nbpoint == 0)
+    return 10e10;
+  return erreur / Nbpoint;
+}
+
 void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    initBlurredImage(I);
+
+  const vpTemplateTrackerPointArrays &pts =
+      getTemplatePointArrays(true, useTemplateSelect ? ptTemplateSelect : nullptr);
+  const double height_1 = I.getHeight() - 1;
+  const double width_1 = I.getWidth() - 1;
 
   vpColVector dpinv(nbParam);
-  double IW;
-  double Tij;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   double alpha = 2.;
   initPosEvalRMS(p);
 
-  vpTemplateTrackerPoint *pt;
-
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
@@ -114,33 +212,13 @@ void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned
     unsigned int Nbpoint = 0;
     double erreur = 0;
     dp = 0;
-    Warp->computeCoeff(p);
-    for (unsigned int point = 0; point < templateSize; point++) {
-      if ((!useTemplateSelect) || (ptTemplateSelect[point])) {
-        pt = &ptTemplate[point];
-        i = pt->y;
-        j = pt->x;
-        X1[0] = j;
-        X1[1] = i;
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-        j2 = X2[0];
-        i2 = X2[1];
-
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-          Tij = pt->val;
-          if (!blur)
-            IW = I.getValue(i2, j2);
-          else
-            IW = BI.getValue(i2, j2);
-          Nbpoint++;
-          double er = (Tij - IW);
-          for (unsigned int it = 0; it < nbParam; it++)
-            dp[it] += er * pt->HiG[it];
-
-          erreur += er * er;
-        }
-      }
+    warpTemplatePoints(pts, p);
+    if (blur) {
+      blurWarpedPoints(I, templateSize);
+      accumulateSSD(BI, pts, ptWarpedU.data(), ptWarpedV.data(), height_1, width_1, dp, erreur, Nbpoint);
+    }
+    else {
+      accumulateSSD(I, pts, ptWarpedU.data(), ptWarpedV.data(), height_1, width_1, dp, erreur, Nbpoint);
     }
     if (Nbpoint == 0) {
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
@@ -37,6 +37,8 @@
  *
 *****************************************************************************/
 
+#include <algorithm>
+
 #include <visp3/tt/vpTemplateTracker.h>
 #include <visp3/tt/vpTemplateTrackerBSpline.h>
 
@@ -49,7 +51,8 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
     HLMdesireInversePyr(), G(), gain(1.), thresholdGradient(40), costFunctionVerification(false), blur(true),
     useBrent(false), nbIterBrent(3), taillef(7), fgG(nullptr), fgdG(nullptr), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0),
     lambdaDep(0.001), iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(true),
-    useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
+    useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_(), ptArrays(),
+    ptWarpedU(), ptWarpedV(), BIx(), blurRowMin(0), blurRowMax(-1), blurColMin(0), blurColMax(-1)
 {
   nbParam = Warp->getNbParam();
   p.resize(nbParam);
@@ -156,6 +159,7 @@ void vpTemplateTracker::resetTracker()
 {
   // reset the tracker parameters
   p = 0;
+  ptArrays.clear();
 
   if (pyrInitialised) {
     if (ptTemplatePyr) {
@@ -823,3 +827,143 @@ void vpTemplateTracker::initPosEvalRMS(const vpColVector &param)
     }
   }
 }
+
+/*!
+  Return the points of the current template stored as contiguous arrays. The arrays are built the first time they
+  are requested for a pyramid level and kept until ptArrays is cleared.
+
+  \param[in] useHiG : If true, the per point parameter vector is HiG, otherwise dW.
+  \param[in] select : If not nullptr, flags of the points used to compute the displacement.
+ */
+const vpTemplateTrackerPointArrays &vpTemplateTracker::getTemplatePointArrays(bool useHiG, const bool *select)
+{
+  for (size_t k = 0; k < ptArrays.size(); k++) {
+    if (ptArrays[k].source == ptTemplate && ptArrays[k].u.size() == templateSize) {
+      return ptArrays[k];
+    }
+  }
+
+  ptArrays.push_back(vpTemplateTrackerPointArrays());
+  vpTemplateTrackerPointArrays &pts = ptArrays.back();
+  pts.source = ptTemplate;
+  pts.nbParam = nbParam;
+  pts.u.resize(templateSize);
+  pts.v.resize(templateSize);
+  pts.val.resize(templateSize);
+  pts.select.resize(templateSize);
+  pts.coef.assign(static_cast<size_t>(templateSize) * nbParam, 0.);
+  for (unsigned int point = 0; point < templateSize; point++) {
+    const vpTemplateTrackerPoint &pt = ptTemplate[point];
+    pts.u[point] = pt.x;
+    pts.v[point] = pt.y;
+    pts.val[point] = pt.val;
+    pts.select[point] = (select == nullptr || select[point]) ? 1 : 0;
+    const double *coef = useHiG ? pt.HiG : pt.dW;
+    if (coef != nullptr) {
+      std::copy(coef, coef + nbParam, pts.coef.begin() + static_cast<size_t>(point) * nbParam);
+    }
+  }
+  return pts;
+}
+
+/*!
+  Warp all the template points with the given parameters. The coordinates are stored in ptWarpedU and ptWarpedV.
+ */
+void vpTemplateTracker::warpTemplatePoints(const vpTemplateTrackerPointArrays &pts, const vpColVector &tp)
+{
+  const size_t nbPoints = pts.u.size();
+  ptWarpedU.resize(nbPoints);
+  ptWarpedV.resize(nbPoints);
+  Warp->warp(pts.u.data(), pts.v.data(), static_cast<int>(nbPoints), tp, ptWarpedU.data(), ptWarpedV.data());
+}
+
+/*!
+  Prepare the blurred image BI for a new image. The image is then blurred only where the warped template is,
+  see blurWarpedPoints().
+ */
+void vpTemplateTracker::initBlurredImage(const vpImage<unsigned char> &I)
+{
+  BI.resize(I.getHeight(), I.getWidth());
+  BIx.resize(I.getHeight(), I.getWidth());
+  blurRowMin = 0;
+  blurRowMax = -1;
+  blurColMin = 0;
+  blurColMax = -1;
+}
+
+/*!
+  Ensure that BI contains the Gaussian blurred image under the first warped template points stored in ptWarpedU and
+  ptWarpedV, including the neighbors used by the bilinear interpolation. The values are the same as the ones of
+  vpImageFilter::filter() applied on the whole image.
+ */
+void vpTemplateTracker::blurWarpedPoints(const vpImage<unsigned char> &I, unsigned int nbPoints)
+{
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  const double i_max = I.getHeight() - 1;
+  const double j_max = I.getWidth() - 1;
+  double i_min = i_max, j_min = j_max, i_sup = 0., j_sup = 0.;
+  bool found = false;
+  for (unsigned int point = 0; point < nbPoints; point++) {
+    const double i2 = ptWarpedV[point];
+    const double j2 = ptWarpedU[point];
+    if ((i2 >= 0) && (j2 >= 0) && (i2 < i_max) && (j2 < j_max)) {
+      i_min = std::min(i_min, i2);
+      i_sup = std::max(i_sup, i2);
+      j_min = std::min(j_min, j2);
+      j_sup = std::max(j_sup, j2);
+      found = true;
+    }
+  }
+  if (!found) {
+    return;
+  }
+  int r0 = static_cast<int>(i_min);
+  int r1 = std::min(height - 1, static_cast<int>(i_sup) + 1);
+  int c0 = static_cast<int>(j_min);
+  int c1 = std::min(width - 1, static_cast<int>(j_sup) + 1);
+  if (blurRowMin <= r0 && r1 <= blurRowMax && blurColMin <= c0 && c1 <= blurColMax) {
+    return;
+  }
+  if (blurRowMin <= blurRowMax) {
+    r0 = std::min(r0, blurRowMin);
+    r1 = std::max(r1, blurRowMax);
+    c0 = std::min(c0, blurColMin);
+    c1 = std::max(c1, blurColMax);
+  }
+
+  // Same border handling as vpImageFilter::filterX() and filterY()
+  const int half = static_cast<int>(taillef - 1) / 2;
+  const int rx0 = std::max(0, r0 - half);
+  const int rx1 = std::min(height - 1, r1 + half);
+  for (int i = rx0; i <= rx1; i++) {
+    for (int j = c0; j <= c1; j++) {
+      if (j >= width - half) {
+        BIx[i][j] = vpImageFilter::filterXRightBorder<unsigned char, double>(I, i, j, fgG, taillef);
+      }
+      else if (j < half) {
+        BIx[i][j] = vpImageFilter::filterXLeftBorder<unsigned char, double>(I, i, j, fgG, taillef);
+      }
+      else {
+        BIx[i][j] = vpImageFilter::filterX<unsigned char, double>(I, i, j, fgG, taillef);
+      }
+    }
+  }
+  for (int i = r0; i <= r1; i++) {
+    for (int j = c0; j <= c1; j++) {
+      if (i >= height - half) {
+        BI[i][j] = vpImageFilter::filterYBottomBorder<double, double>(BIx, i, j, fgG, taillef);
+      }
+      else if (i < half) {
+        BI[i][j] = vpImageFilter::filterYTopBorder<double, double>(BIx, i, j, fgG, taillef);
+      }
+      else {
+        BI[i][j] = vpImageFilter::filterY<double, double>(BIx, i, j, fgG, taillef);
+      }
+    }
+  }
+  blurRowMin = r0;
+  blurRowMax = r1;
+  blurColMin = c0;
+  blurColMax = c1;
+}
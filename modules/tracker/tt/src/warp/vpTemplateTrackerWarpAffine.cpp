@@ -121,6 +121,28 @@ void vpTemplateTrackerWarpAffine::getdWdp0(const int &v, const int &u, double *d
   dIdW[11] = 1.;
 }
 
+/*!
+ * Warp a list of points \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
+ * \f[X_2 = {^2}M_1(p) * X_1\f]
+ * \param ut0 : Coordinates of the points to warp along the image columns axis.
+ * \param vt0 : Coordinates of the points to warp along the image rows axis.
+ * \param nb_pt : Number of points.
+ * \param p : 6-dim vector that contains the parameters of the transformation.
+ * \param u : Coordinates of the warped points along the image columns axis.
+ * \param v : Coordinates of the warped points along the image rows axis.
+ */
+void vpTemplateTrackerWarpAffine::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                       double *u, double *v)
+{
+  const double a00 = 1.0 + p[0], a01 = p[2], a02 = p[4];
+  const double a10 = p[1], a11 = 1.0 + p[3], a12 = p[5];
+
+  for (int i = 0; i < nb_pt; i++) {
+    u[i] = a00 * ut0[i] + a01 * vt0[i] + a02;
+    v[i] = a10 * ut0[i] + a11 * vt0[i] + a12;
+  }
+}
+
 /*!
  * Warp point \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
  * \f[X_2 = {^2}M_1(p) * X_1\f]
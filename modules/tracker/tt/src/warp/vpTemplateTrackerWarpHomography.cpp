@@ -157,6 +157,34 @@ void vpTemplateTrackerWarpHomography::computeDenom(vpColVector &X, const vpColVe
   }
 }
 
+/*!
+ * Warp a list of points \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
+ * \f[X_2 = {^2}M_1(p) * X_1\f]
+ * \param ut0 : Coordinates of the points to warp along the image columns axis.
+ * \param vt0 : Coordinates of the points to warp along the image rows axis.
+ * \param nb_pt : Number of points.
+ * \param p : 8-dim vector that contains the parameters of the transformation.
+ * \param u : Coordinates of the warped points along the image columns axis.
+ * \param v : Coordinates of the warped points along the image rows axis.
+ */
+void vpTemplateTrackerWarpHomography::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                           double *u, double *v)
+{
+  const double h00 = 1. + p[0], h01 = p[3], h02 = p[6];
+  const double h10 = p[1], h11 = 1. + p[4], h12 = p[7];
+
+  for (int i = 0; i < nb_pt; i++) {
+    double value = (p[2] * ut0[i] + p[5] * vt0[i] + 1.);
+    if (std::fabs(value) <= std::numeric_limits<double>::epsilon()) {
+      throw(vpTrackingException(vpTrackingException::fatalError,
+                                "Division by zero in vpTemplateTrackerWarpHomography::warp()"));
+    }
+    double d = 1. / value;
+    u[i] = (h00 * ut0[i] + h01 * vt0[i] + h02) * d;
+    v[i] = (h10 * ut0[i] + h11 * vt0[i] + h12) * d;
+  }
+}
+
 /*!
  * Warp point \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
  * \f[X_2 = {^2}M_1(p) * X_1\f]
@@ -285,6 +285,28 @@ void vpTemplateTrackerWarpHomographySL3::computeCoeff(const vpColVector &p)
   G = pA.expm();
 }
 
+/*!
+ * Warp a list of points \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
+ * \f[X_2 = {^2}M_1(p) * X_1\f]
+ * \param ut0 : Coordinates of the points to warp along the image columns axis.
+ * \param vt0 : Coordinates of the points to warp along the image rows axis.
+ * \param nb_pt : Number of points.
+ * \param p : 8-dim vector that contains the parameters of the transformation.
+ * \param u : Coordinates of the warped points along the image columns axis.
+ * \param v : Coordinates of the warped points along the image rows axis.
+ */
+void vpTemplateTrackerWarpHomographySL3::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                              double *u, double *v)
+{
+  computeCoeff(p);
+
+  for (int i = 0; i < nb_pt; i++) {
+    double d = ut0[i] * G[2][0] + vt0[i] * G[2][1] + G[2][2];
+    u[i] = (ut0[i] * G[0][0] + vt0[i] * G[0][1] + G[0][2]) / d;
+    v[i] = (ut0[i] * G[1][0] + vt0[i] * G[1][1] + G[1][2]) / d;
+  }
+}
+
 /*!
  * Warp point \f$X_1=(u_1,v_1)\f$ using the transformation model.
  * \f[X_2 = {^2}M_1(p) * X_1\f]
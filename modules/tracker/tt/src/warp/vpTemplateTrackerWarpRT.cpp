@@ -106,6 +106,28 @@ void vpTemplateTrackerWarpRT::getdWdp0(const int &v, const int &u, double *dIdW)
   dIdW[5] = 1.;
 }
 
+/*!
+ * Warp a list of points \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
+ * \f[X_2 = {^2}M_1(p) * X_1\f]
+ * \param ut0 : Coordinates of the points to warp along the image columns axis.
+ * \param vt0 : Coordinates of the points to warp along the image rows axis.
+ * \param nb_pt : Number of points.
+ * \param p : 3-dim vector that contains the parameters of the transformation.
+ * \param u : Coordinates of the warped points along the image columns axis.
+ * \param v : Coordinates of the warped points along the image rows axis.
+ */
+void vpTemplateTrackerWarpRT::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                   double *u, double *v)
+{
+  double c = cos(p[0]);
+  double s = sin(p[0]);
+
+  for (int i = 0; i < nb_pt; i++) {
+    u[i] = (c * ut0[i]) - (s * vt0[i]) + p[1];
+    v[i] = (s * ut0[i]) + (c * vt0[i]) + p[2];
+  }
+}
+
 /*!
  * Warp point \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
  * \f[X_2 = {^2}M_1(p) * X_1\f]
@@ -111,6 +111,29 @@ void vpTemplateTrackerWarpSRT::getdWdp0(const int &v, const int &u, double *dIdW
   dIdW[7] = 1.;
 }
 
+/*!
+ * Warp a list of points \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
+ * \f[X_2 = {^2}M_1(p) * X_1\f]
+ * \param ut0 : Coordinates of the points to warp along the image columns axis.
+ * \param vt0 : Coordinates of the points to warp along the image rows axis.
+ * \param nb_pt : Number of points.
+ * \param p : 4-dim vector that contains the parameters of the transformation.
+ * \param u : Coordinates of the warped points along the image columns axis.
+ * \param v : Coordinates of the warped points along the image rows axis.
+ */
+void vpTemplateTrackerWarpSRT::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                    double *u, double *v)
+{
+  double c = cos(p[1]);
+  double s = sin(p[1]);
+  double scale = 1.0 + p[0];
+
+  for (int i = 0; i < nb_pt; i++) {
+    u[i] = scale * (c * ut0[i] - s * vt0[i]) + p[2];
+    v[i] = scale * (s * ut0[i] + c * vt0[i]) + p[3];
+  }
+}
+
 /*!
  * Warp point \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
  * \f[X_2 = {^2}M_1(p) * X_1\f]
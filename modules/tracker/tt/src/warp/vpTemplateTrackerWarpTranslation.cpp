@@ -97,6 +97,25 @@ void vpTemplateTrackerWarpTranslation::getdWdp0(const int &, const int &, double
   dIdW[3] = 1.;
 }
 
+/*!
+ * Warp a list of points \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
+ * \f[X_2 = {^2}M_1(p) * X_1\f]
+ * \param ut0 : Coordinates of the points to warp along the image columns axis.
+ * \param vt0 : Coordinates of the points to warp along the image rows axis.
+ * \param nb_pt : Number of points.
+ * \param p : 2-dim vector that contains the parameters of the transformation.
+ * \param u : Coordinates of the warped points along the image columns axis.
+ * \param v : Coordinates of the warped points along the image rows axis.
+ */
+void vpTemplateTrackerWarpTranslation::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                            double *u, double *v)
+{
+  for (int i = 0; i < nb_pt; i++) {
+    u[i] = ut0[i] + p[0];
+    v[i] = vt0[i] + p[1];
+  }
+}
+
 /*!
  * Warp point \f$X_1=(u_1,v_1)\f$ using the transformation model with parameters \f$p\f$.
  * \f[X_2 = {^2}M_1(p) * X_1\f]
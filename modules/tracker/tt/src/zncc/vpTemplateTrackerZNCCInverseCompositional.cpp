@@ -52,6 +52,14 @@ void vpTemplateTrackerZNCCInverseCompositional::initCompInverse(const vpImage<un
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
+  // The per point parameters are recomputed, forget their copy
+  for (size_t k = 0; k < ptArrays.size(); k++) {
+    if (ptArrays[k].source == ptTemplate) {
+      ptArrays.erase(ptArrays.begin() + static_cast<std::ptrdiff_t>(k));
+      break;
+    }
+  }
+
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
     int j = ptTemplate[point].x;
@@ -230,17 +238,31 @@ void vpTemplateTrackerZNCCInverseCompositional::initHessienDesired(const vpImage
   HLMdesireInverse = HLMdesire.inverseByLU();
 }
 
+double vpTemplateTrackerZNCCInverseCompositional::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
+{
+  if (blur && (tp.size() == nbParam)) {
+    warpTemplatePoints(getTemplatePointArrays(false, nullptr), tp);
+    blurWarpedPoints(I, templateSize);
+  }
+  return vpTemplateTrackerZNCC::getCost(I, tp);
+}
+
 void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    initBlurredImage(I);
+
+  const vpTemplateTrackerPointArrays &pts = getTemplatePointArrays(false, nullptr);
+  const double height_1 = I.getHeight() - 1;
+  const double width_1 = I.getWidth() - 1;
+  // Intensities of the warped points that are in the image, computed once per iteration
+  std::vector<unsigned int> inside(templateSize);
+  std::vector<double> Ics(templateSize);
 
   vpColVector dpinv(nbParam);
-  double Ic;
-  double Iref;
+  vpColVector sIcdIref(nbParam);
+  vpColVector sIrefdIref(nbParam);
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   initPosEvalRMS(p);
 
   double evolRMS_init = 0;
@@ -250,30 +272,22 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
   do {
     unsigned int Nbpoint = 0;
     G = 0;
-    Warp->computeCoeff(p);
+    warpTemplatePoints(pts, p);
+    if (blur)
+      blurWarpedPoints(I, templateSize);
+    const vpImage<double> *pBI = blur ? &BI : nullptr;
     double moyIref = 0;
     double moyIc = 0;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Iref = ptTemplate[point].val;
-
-        if (!blur)
-          Ic = I.getValue(i2, j2);
-        else
-          Ic = BI.getValue(i2, j2);
+      const double i2 = ptWarpedV[point];
+      const double j2 = ptWarpedU[point];
+      if ((i2 >= 0) && (j2 >= 0) && (i2 < height_1) && (j2 < width_1)) {
+        const double Ic = (pBI == nullptr) ? I.getValue(i2, j2) : pBI->getValue(i2, j2);
+        inside[Nbpoint] = point;
+        Ics[Nbpoint] = Ic;
 
         Nbpoint++;
-        moyIref += Iref;
+        moyIref += pts.val[point];
         moyIc += Ic;
       }
     }
@@ -282,40 +296,24 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
       moyIc = moyIc / Nbpoint;
       double sIcIref = 0;
       double covarIref = 0, covarIc = 0;
-      vpColVector sIcdIref(nbParam);
       sIcdIref = 0;
-      vpColVector sIrefdIref(nbParam);
       sIrefdIref = 0;
 
-      for (unsigned int point = 0; point < templateSize; point++) {
-        i = ptTemplate[point].y;
-        j = ptTemplate[point].x;
-        X1[0] = j;
-        X1[1] = i;
-
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-
-        j2 = X2[0];
-        i2 = X2[1];
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-          Iref = ptTemplate[point].val;
-
-          if (!blur)
-            Ic = I.getValue(i2, j2);
-          else
-            Ic = BI.getValue(i2, j2);
-
-          double prod = (Ic - moyIc);
-          for (unsigned int it = 0; it < nbParam; it++)
-            sIcdIref[it] += prod * (ptTemplate[point].dW[it] - moydIrefdp[it]);
-          for (unsigned int it = 0; it < nbParam; it++)
-            sIrefdIref[it] += (Iref - moyIref) * (ptTemplate[point].dW[it] - moydIrefdp[it]);
-
-          covarIref += (Iref - moyIref) * (Iref - moyIref);
-          covarIc += (Ic - moyIc) * (Ic - moyIc);
-          sIcIref += (Iref - moyIref) * (Ic - moyIc);
-        }
+      for (unsigned int k = 0; k < Nbpoint; k++) {
+        const unsigned int point = inside[k];
+        const double Iref = pts.val[point];
+        const double Ic = Ics[k];
+        const double *dWp = &pts.coef[static_cast<size_t>(point) * nbParam];
+
+        double prod = (Ic - moyIc);
+        for (unsigned int it = 0; it < nbParam; it++)
+          sIcdIref[it] += prod * (dWp[it] - moydIrefdp[it]);
+        for (unsigned int it = 0; it < nbParam; it++)
+          sIrefdIref[it] += (Iref - moyIref) * (dWp[it] - moydIrefdp[it]);
+
+        covarIref += (Iref - moyIref) * (Iref - moyIref);
+        covarIc += (Ic - moyIc) * (Ic - moyIc);
+        sIcIref += (Iref - moyIref) * (Ic - moyIc);
       }
       covarIref = sqrt(covarIref);
       covarIc = sqrt(covarIc);
@@ -108,12 +108,31 @@ protected:
   std::vector<std::vector<double> > m_d2v;
   std::vector<std::vector<double> > m_dA;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  // Contribution of a template point to the joint histogram, see addSample()
+  struct vpHistogramSample
+  {
+    int cr;
+    int ct;
+    double er;
+    double et;
+    int order;
+    size_t val;
+  };
+  // Internal vars for computeProbaSamples()
+  std::vector<vpHistogramSample> m_samples;
+  std::vector<double> m_samplesVal;
+  std::vector<double> m_bins;
+#endif
+
 protected:
+  void addSample(int cr, double er, int ct, double et, const double *val, int order);
   void computeGradient();
   void computeHessien(vpMatrix &H);
   void computeHessienNormalized(vpMatrix &H);
   void computeMI(double &MI);
   void computeProba(int &nbpoint);
+  void computeProbaSamples(int &nbpoint);
 
   double getCost(const vpImage<unsigned char> &I, const vpColVector &tp) override;
   double getCost(const vpImage<unsigned char> &I) { return getCost(I, p); }
@@ -148,7 +167,7 @@ public:
     Prt(nullptr), dPrt(nullptr), Pt(nullptr), Pr(nullptr), d2Prt(nullptr), PrtTout(nullptr), dprtemp(nullptr), PrtD(nullptr), dPrtD(nullptr),
     influBspline(0), bspline(0), Nc(0), Ncb(0), d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
     NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false), m_du(), m_dv(), m_A(),
-    m_dB(), m_d2u(), m_d2v(), m_dA()
+    m_dB(), m_d2u(), m_d2v(), m_dA(), m_samples(), m_samplesVal(), m_bins()
   { }
   explicit vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp);
   virtual ~vpTemplateTrackerMI() override;
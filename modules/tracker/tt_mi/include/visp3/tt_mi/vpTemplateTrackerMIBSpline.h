@@ -105,6 +105,11 @@ public:
   static void PutTotPVBspline3Prt(double *Prt, int &cr, double &er, int &ct, double &et, int &Ncb);
   static void PutTotPVBspline4Prt(double *Prt, int &cr, double &er, int &ct, double &et, int &Ncb);
 
+  // Joint histogram stored bin by bin, see vpTemplateTrackerMI::computeProbaSamples()
+  static int computeBsplineWeights(double e, int degree, double *B, double *dB, double *d2B);
+  static void PutTotPVBsplineBins(double *Bins, int cr, double er, int ct, double et, int Ncb, const double *val,
+                                  unsigned int NbParam, int degree, int order, unsigned int stride);
+
   static double Bspline3(double diff);
   static double Bspline4i(double diff, int &interv);
 
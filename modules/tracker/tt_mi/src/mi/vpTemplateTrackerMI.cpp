@@ -36,10 +36,16 @@
  * Aurelien Yol
  *
 *****************************************************************************/
+#include <algorithm>
+
 #include <visp3/core/vpException.h>
 #include <visp3/tt_mi/vpTemplateTrackerMI.h>
 #include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 void vpTemplateTrackerMI::setBspline(const vpBsplineType &newbs)
 {
   bspline = (int)newbs;
@@ -150,21 +156,14 @@ double vpTemplateTrackerMI::getCost(const vpImage<unsigned char> &I, const vpCol
   double IW;
 
   unsigned int Ncb_ = (unsigned int)Ncb;
-  unsigned int Nc_ = (unsigned int)Nc;
-  unsigned int influBspline_ = (unsigned int)influBspline;
 
-  memset(Prt, 0, Ncb_ * Ncb_ * sizeof(double));
-  memset(PrtD, 0, Nc_ * Nc_ * influBspline_ * sizeof(double));
+  m_samples.clear();
+  m_samplesVal.clear();
 
-  Warp->computeCoeff(tp);
+  warpTemplatePoints(getTemplatePointArrays(false, nullptr), tp);
   for (unsigned int point = 0; point < templateSize; point++) {
-    X1[0] = ptTemplate[point].x;
-    X1[1] = ptTemplate[point].y;
-
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-    double j2 = X2[0];
-    double i2 = X2[1];
+    double j2 = ptWarpedU[point];
+    double i2 = ptWarpedV[point];
 
     if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
       Nbpoint++;
@@ -183,34 +182,17 @@ double vpTemplateTrackerMI::getCost(const vpImage<unsigned char> &I, const vpCol
       double er = IW_Nc - cr;
       double et = Tij_Nc - ct;
 
-      // Calcul de l'histogramme joint par interpolation bilineaire
-      // (Bspline ordre 1)
-      vpTemplateTrackerMIBSpline::PutPVBsplineD(PrtD, cr, er, ct, et, Nc, 1., bspline);
+      // Joint histogram computed by B-spline interpolation
+      addSample(cr, er, ct, et, nullptr, 0);
     }
   }
 
   ratioPixelIn = (double)Nbpoint / (double)templateSize;
 
-  double *pt = PrtD;
-  for (int r = 0; r < Nc; r++)
-    for (int t = 0; t < Nc; t++) {
-      for (int i = 0; i < influBspline; i++) {
-        int r2, t2;
-        r2 = r + i / bspline;
-        t2 = t + i % bspline;
-        Prt[r2 * Ncb + t2] += *pt;
-
-        pt++;
-      }
-    }
-
   if (Nbpoint == 0)
     return 0;
-  for (unsigned int r = 0; r < Ncb_; r++) {
-    for (unsigned int t = 0; t < Ncb_; t++) {
-      Prt[r * Ncb_ + t] /= Nbpoint;
-    }
-  }
+  computeProbaSamples(Nbpoint);
+
   // Compute Pr, Pt
   memset(Pr, 0, Ncb_ * sizeof(double));
   memset(Pt, 0, Ncb_ * sizeof(double));
@@ -378,6 +360,108 @@ void vpTemplateTrackerMI::computeProba(int &nbpoint)
   }
 }
 
+/*!
+  Add a template point to the samples of the joint histogram processed by computeProbaSamples().
+
+  \param cr, er : Integer and fractional parts of the sample along the first axis of the histogram.
+  \param ct, et : Integer and fractional parts of the sample along the second axis of the histogram.
+  \param val : Derivatives of the second axis value with respect to the warp parameters.
+  \param order : 0 to only update the probabilities, 1 to also update their derivatives, 2 to also update their
+  second derivatives.
+ */
+void vpTemplateTrackerMI::addSample(int cr, double er, int ct, double et, const double *val, int order)
+{
+  vpHistogramSample sample;
+  sample.cr = cr;
+  sample.ct = ct;
+  sample.er = er;
+  sample.et = et;
+  sample.order = order;
+  sample.val = m_samplesVal.size();
+  if (order > 0) {
+    m_samplesVal.insert(m_samplesVal.end(), val, val + nbParam);
+  }
+  m_samples.push_back(sample);
+}
+
+/*!
+  Compute the joint probabilities Prt, their derivatives dPrt and second derivatives d2Prt from the samples added with
+  addSample(), and normalize them by the number of points. This gives the same result as filling PrtTout and calling
+  computeProba().
+
+  The samples are split between the threads, each of them filling its own histogram where the probability and its
+  derivatives are contiguous for each bin; the partial histograms are then summed up. Only the probabilities are
+  updated when no sample needs the derivatives.
+ */
+void vpTemplateTrackerMI::computeProbaSamples(int &nbpoint)
+{
+  if (nbpoint == 0) {
+    throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
+  }
+
+  const int nbSamples = static_cast<int>(m_samples.size());
+  int order = 0;
+  for (int s = 0; s < nbSamples; s++) {
+    order = std::max(order, m_samples[s].order);
+  }
+  const unsigned int Ncb2_ = static_cast<unsigned int>(Ncb * Ncb);
+  const unsigned int nbParam2 = nbParam * (nbParam + 1) / 2;
+  const unsigned int stride = (order == 0) ? 1 : 1 + nbParam + nbParam2;
+  const size_t binsSize = static_cast<size_t>(Ncb2_) * stride;
+
+  int nbThreads = 1;
+#ifdef VISP_HAVE_OPENMP
+  // Avoid to pay for the threads and the reduction when there is little to compute
+  if (static_cast<size_t>(nbSamples) * stride > 4 * binsSize) {
+    nbThreads = std::min(omp_get_max_threads(), std::max(1, nbSamples / 256));
+  }
+#endif
+  m_bins.assign(binsSize * static_cast<size_t>(nbThreads), 0.);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+    int thread = 0;
+#ifdef VISP_HAVE_OPENMP
+    thread = omp_get_thread_num();
+#endif
+    double *bins = &m_bins[static_cast<size_t>(thread) * binsSize];
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int s = 0; s < nbSamples; s++) {
+      const vpHistogramSample &sample = m_samples[s];
+      const double *val = (sample.order > 0) ? &m_samplesVal[sample.val] : nullptr;
+      vpTemplateTrackerMIBSpline::PutTotPVBsplineBins(bins, sample.cr, sample.er, sample.ct, sample.et, Ncb, val,
+                                                      nbParam, bspline, sample.order, stride);
+    }
+  }
+
+  for (int thread = 1; thread < nbThreads; thread++) {
+    const double *bins = &m_bins[static_cast<size_t>(thread) * binsSize];
+    for (size_t i = 0; i < binsSize; i++) {
+      m_bins[i] += bins[i];
+    }
+  }
+
+  const double *bin = &m_bins[0];
+  for (unsigned int i = 0; i < Ncb2_; i++, bin += stride) {
+    Prt[i] = bin[0] / nbpoint;
+    if (stride > 1) {
+      double *pdPrt = &dPrt[i * nbParam];
+      double *pd2Prt = &d2Prt[i * nbParam * nbParam];
+      const double *d2 = bin + 1 + nbParam;
+      for (unsigned int ip = 0; ip < nbParam; ip++) {
+        pdPrt[ip] = bin[1 + ip] / nbpoint;
+        for (unsigned int ip2 = ip; ip2 < nbParam; ip2++) {
+          pd2Prt[ip * nbParam + ip2] = pd2Prt[ip2 * nbParam + ip] = *d2++ / nbpoint;
+        }
+      }
+    }
+  }
+}
+
 void vpTemplateTrackerMI::computeMI(double &MI)
 {
   unsigned int Ncb_ = (unsigned int)Ncb;
@@ -582,6 +666,9 @@ void vpTemplateTrackerMI::zeroProbabilities()
   memset(dPrt, 0, Ncb2_nbParam_);
   memset(d2Prt, 0, Ncb2_nbParam2_);
   memset(PrtTout, 0, Nc_ * Nc_ * influBspline_ * (1 + nbParam + nbParam * nbParam) * sizeof(double));
+
+  m_samples.clear();
+  m_samplesVal.clear();
 }
 
 double vpTemplateTrackerMI::getMI(const vpImage<unsigned char> &I, int &nc, const int &bspline_, vpColVector &tp)
@@ -39,10 +39,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 vpTemplateTrackerMIESM::vpTemplateTrackerMIESM(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), CompoInitialised(false), HDirect(), HInverse(),
     HdesireDirect(), HdesireInverse(), GDirect(), GInverse()
@@ -103,13 +99,12 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
       cr = static_cast<int>((IW * (Nc - 1)) / 255.);
       er = (IW * (Nc - 1)) / 255. - cr;
 
-      vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,
-                                                       bspline, ApproxHessian, false);
+      addSample(cr, er, ct, et, ptTemplate[point].dW, (ApproxHessian == HESSIAN_NONSECOND) ? 1 : 2);
     }
   }
 
   double MI;
-  computeProba(Nbpoint);
+  computeProbaSamples(Nbpoint);
   computeMI(MI);
   computeHessien(HdesireInverse);
 
@@ -159,12 +154,11 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
       for (unsigned int it = 0; it < nbParam; it++)
         tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-      vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, tptemp.data, nbParam, bspline,
-                                                       ApproxHessian, false);
+      addSample(cr, er, ct, et, tptemp.data, (ApproxHessian == HESSIAN_NONSECOND) ? 1 : 2);
     }
   }
 
-  computeProba(Nbpoint);
+  computeProbaSamples(Nbpoint);
   computeMI(MI);
   computeHessien(HdesireDirect);
 
@@ -283,9 +277,8 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
         cr = static_cast<int>((IW * (Nc - 1)) / 255.);
         er = (IW * (Nc - 1)) / 255. - cr;
 
-        vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,
-                                                         bspline, ApproxHessian,
-                                                         hessianComputation == USE_HESSIEN_DESIRE);
+        addSample(cr, er, ct, et, ptTemplate[point].dW,
+                  (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == USE_HESSIEN_DESIRE) ? 1 : 2);
       }
     }
 
@@ -294,7 +287,7 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
       MI = 0;
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
     } else {
-      computeProba(Nbpoint);
+      computeProbaSamples(Nbpoint);
       computeMI(MI);
       if (hessianComputation != vpTemplateTrackerMI::USE_HESSIEN_DESIRE) {
         computeHessien(HInverse);
@@ -310,14 +303,8 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
 
       zeroProbabilities();
 
+      // The joint histogram is computed in parallel by computeProbaSamples()
       Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-      int nthreads = omp_get_num_procs();
-      // std::cout << "file: " __FILE__ << " line: " << __LINE__ << "
-      // function: " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-      omp_set_num_threads(nthreads);
-#pragma omp parallel for private(i, j, i2, j2) default(shared)
-#endif
       for (point = 0; point < static_cast<int>(templateSize); point++) {
         i = ptTemplate[point].y;
         j = ptTemplate[point].x;
@@ -348,12 +335,12 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
           for (unsigned int it = 0; it < nbParam; it++)
             tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-          vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, tptemp.data, nbParam, bspline,
-                                                           ApproxHessian, hessianComputation == USE_HESSIEN_DESIRE);
+          addSample(cr, er, ct, et, tptemp.data,
+                    (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == USE_HESSIEN_DESIRE) ? 1 : 2);
         }
       }
 
-      computeProba(Nbpoint);
+      computeProbaSamples(Nbpoint);
       computeMI(MI);
       if (hessianComputation != vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
         computeHessien(HDirect);
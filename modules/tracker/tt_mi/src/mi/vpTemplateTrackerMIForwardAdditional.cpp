@@ -39,10 +39,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 vpTemplateTrackerMIForwardAdditional::vpTemplateTrackerMIForwardAdditional(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), p_prec(), G_prec(), KQuasiNewton()
 {
@@ -100,22 +96,19 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
       er = (static_cast<double>(Tij) * (Nc - 1)) / 255. - cr;
       Warp->dWarp(X1, X2, p, dW);
 
-      double *tptemp = new double[nbParam];
       for (unsigned int it = 0; it < nbParam; it++)
-        tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
+        temp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
       if (ApproxHessian == HESSIAN_NONSECOND)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
+        addSample(cr, er, ct, et, temp, 1);
       else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-        vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      delete[] tptemp;
+        addSample(cr, er, ct, et, temp, 2);
     }
   }
 
   if (Nbpoint > 0) {
     double MI;
-    computeProba(Nbpoint);
+    computeProbaSamples(Nbpoint);
     computeMI(MI);
     computeHessien(Hdesire);
 
@@ -161,14 +154,8 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
 
     zeroProbabilities();
 
+    // The joint histogram is computed in parallel by computeProbaSamples()
     Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-    int nthreads = omp_get_num_procs();
-    // std::cout << "file: " __FILE__ << " line: " << __LINE__ << " function:
-    // " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-    omp_set_num_threads(nthreads);
-#pragma omp parallel for default(shared)
-#endif
     for (int point = 0; point < (int)templateSize; point++) {
       int i = ptTemplate[point].y;
       int j = ptTemplate[point].x;
@@ -200,15 +187,12 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
 
         Warp->dWarp(X1, X2, p, dW);
 
-        double *tptemp = new double[nbParam];
         for (unsigned int it = 0; it < nbParam; it++)
-          tptemp[it] = (dW[0][it] * dx + dW[1][it] * dy);
+          temp[it] = (dW[0][it] * dx + dW[1][it] * dy);
         if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
+          addSample(cr, er, ct, et, temp, 1);
         else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+          addSample(cr, er, ct, et, temp, 2);
       }
     }
 
@@ -217,7 +201,7 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
       MI = 0;
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
     } else {
-      computeProba(Nbpoint);
+      computeProbaSamples(Nbpoint);
       computeMI(MI);
       computeHessien(H);
       computeGradient();
@@ -120,17 +120,14 @@ void vpTemplateTrackerMIForwardCompositional::initHessienDesired(const vpImage<u
 
       Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
 
-      double *tptemp = new double[nbParam];
       for (unsigned int it = 0; it < nbParam; it++)
-        tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
+        temp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-      vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      delete[] tptemp;
+      addSample(cr, er, ct, et, temp, 2);
     }
   }
   double MI;
-  computeProba(Nbpoint);
+  computeProbaSamples(Nbpoint);
   computeMI(MI);
   computeHessien(Hdesire);
 
@@ -212,16 +209,13 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
 
         Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
 
-        double *tptemp = new double[nbParam];
         for (unsigned int it = 0; it < nbParam; it++)
-          tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
+          temp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
         if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
+          addSample(cr, er, ct, et, temp, 1);
         else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+          addSample(cr, er, ct, et, temp, 2);
       }
     }
     if (Nbpoint == 0) {
@@ -229,7 +223,7 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
       MI = 0;
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
     } else {
-      computeProba(Nbpoint);
+      computeProbaSamples(Nbpoint);
       computeMI(MI);
       if (hessianComputation != vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
         computeHessien(H);
@@ -164,22 +164,17 @@ void vpTemplateTrackerMIInverseCompositional::initHessienDesired(const vpImage<u
       er = (IW * (Nc - 1)) / 255. - cr;
 
       if (ApproxHessian == HESSIAN_NONSECOND && (ptTemplateSelect[point] || !useTemplateSelect)) {
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,
-                                                            bspline);
+        addSample(cr, er, ct, et, ptTemplate[point].dW, 1);
       } else if ((ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW) &&
                  (ptTemplateSelect[point] || !useTemplateSelect)) {
-        if (bspline == 3) {
-          vpTemplateTrackerMIBSpline::PutTotPVBspline3(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam);
-        } else {
-          vpTemplateTrackerMIBSpline::PutTotPVBspline4(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam);
-        }
+        addSample(cr, er, ct, et, ptTemplate[point].dW, 2);
       } else if (ptTemplateSelect[point] || !useTemplateSelect)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(PrtTout, cr, er, ct, et, Nc, nbParam, bspline);
+        addSample(cr, er, ct, et, nullptr, 0);
     }
   }
 
   double MI;
-  computeProba(Nbpoint);
+  computeProbaSamples(Nbpoint);
   computeMI(MI);
   computeHessien(Hdesire);
 
@@ -226,6 +221,8 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
   vpColVector dpinv_test_LMA(nbParam);
   vpColVector p_test_LMA(nbParam);
 
+  const vpTemplateTrackerPointArrays &pts = getTemplatePointArrays(false, nullptr);
+
   do {
     int Nbpoint = 0;
     MIprec = MI;
@@ -233,17 +230,11 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
 
     zeroProbabilities();
 
-    Warp->computeCoeff(p);
+    warpTemplatePoints(pts, p);
 
     for (int point = 0; point < static_cast<int>(templateSize); point++) {
-      X1[0] = static_cast<double>(ptTemplate[point].x);
-      X1[1] = static_cast<double>(ptTemplate[point].y);
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      double j2 = X2[0];
-      double i2 = X2[1];
+      double j2 = ptWarpedU[point];
+      double i2 = ptWarpedV[point];
 
       if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
 
@@ -262,18 +253,11 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
 
         if ((ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE) &&
             (ptTemplateSelect[point] || !useTemplateSelect)) {
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(Prt, dPrt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                              nbParam, bspline);
+          addSample(cr, er, ct, et, ptTemplate[point].dW, 1);
         } else if (ptTemplateSelect[point] || !useTemplateSelect) {
-          if (bspline == 3) {
-            vpTemplateTrackerMIBSpline::PutTotPVBspline3(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                         nbParam);
-          } else {
-            vpTemplateTrackerMIBSpline::PutTotPVBspline4(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                         nbParam);
-          }
+          addSample(cr, er, ct, et, ptTemplate[point].dW, 2);
         } else {
-          vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(Prt, cr, er, ct, et, Ncb, nbParam, bspline);
+          addSample(cr, er, ct, et, nullptr, 0);
         }
       }
     }
@@ -284,20 +268,7 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
 
     } else {
-      unsigned int indd, indd2;
-      indd = indd2 = 0;
-      unsigned int Ncb_ = static_cast<unsigned int>(Ncb);
-      for (unsigned int i = 0; i < Ncb_ * Ncb_; i++) {
-        Prt[i] /= Nbpoint;
-        for (unsigned int j = 0; j < nbParam; j++) {
-          dPrt[indd] /= Nbpoint;
-          indd++;
-          for (unsigned int k = 0; k < nbParam; k++) {
-            d2Prt[indd2] /= Nbpoint;
-            indd2++;
-          }
-        }
-      }
+      computeProbaSamples(Nbpoint);
 
       computeMI(MI);
 
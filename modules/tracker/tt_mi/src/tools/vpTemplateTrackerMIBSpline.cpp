@@ -36,10 +36,157 @@
  * Aurelien Yol
  *
 *****************************************************************************/
+#include <vector>
+
 #include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+namespace
+{
+/*
+  Add the contribution of a sample to the bins of the joint histogram. Each bin stores the probability, its NbParam
+  derivatives and the upper triangle of its NbParam x NbParam second derivatives. N is the number of parameters when
+  it is known at compile time, 0 otherwise.
+ */
+template <unsigned int N>
+void putBins(double *Bins, int r0, int t0, int Ncb, int degree, const double *Br, const double *Bt, const double *dBt,
+             const double *d2Bt, const double *val, unsigned int NbParam, int order, unsigned int stride)
+{
+  const unsigned int n = (N == 0) ? NbParam : N;
+  const unsigned int n2 = n * (n + 1) / 2;
+
+  // Products of the parameters used by the second derivatives, computed once for all the bins
+  double vvStatic[N == 0 ? 1 : N * (N + 1) / 2];
+  std::vector<double> vvDynamic;
+  double *vv = vvStatic;
+  if (order > 1) {
+    if (N == 0) {
+      vvDynamic.resize(n2);
+      vv = vvDynamic.data();
+    }
+    unsigned int k = 0;
+    for (unsigned int ip = 0; ip < n; ip++) {
+      for (unsigned int ip2 = ip; ip2 < n; ip2++) {
+        vv[k++] = val[ip] * val[ip2];
+      }
+    }
+  }
+
+  for (int ir = 0; ir < degree; ir++) {
+    double *bin = Bins + static_cast<size_t>((r0 + ir) * Ncb + t0) * stride;
+    for (int it = 0; it < degree; it++, bin += stride) {
+      bin[0] += Br[ir] * Bt[it];
+      if (order > 0) {
+        const double v1 = Br[ir] * dBt[it];
+        double *d = bin + 1;
+        for (unsigned int ip = 0; ip < n; ip++) {
+          d[ip] -= v1 * val[ip];
+        }
+        if (order > 1) {
+          const double v2 = Br[ir] * d2Bt[it];
+          double *d2 = bin + 1 + n;
+          for (unsigned int k = 0; k < n2; k++) {
+            d2[k] += v2 * vv[k];
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+/*
+  Compute in one go the B-spline weights, and their first and second derivatives if dB and d2B are not nullptr, of the
+  histogram bins around a sample with fractional part e. The values are the ones of Bspline3(), dBspline3() and
+  d2Bspline3() or vpTemplateTrackerBSpline::Bspline4(), dBspline4() and d2Bspline4() at the bins, written as
+  polynomials of e. Return the shift to apply to the first bin index.
+ */
+int vpTemplateTrackerMIBSpline::computeBsplineWeights(double e, int degree, double *B, double *dB, double *d2B)
+{
+  if (degree == 4) {
+    const double f = 1. - e;
+    const double e2 = e * e;
+    const double f2 = f * f;
+    B[0] = f2 * f / 6.;
+    B[1] = e2 * (e / 2. - 1.) + 4. / 6.;
+    B[2] = f2 * (f / 2. - 1.) + 4. / 6.;
+    B[3] = e2 * e / 6.;
+    if (dB != nullptr) {
+      dB[0] = -0.5 * f2;
+      dB[1] = 1.5 * e2 - 2. * e;
+      dB[2] = -1.5 * f2 + 2. * f;
+      dB[3] = 0.5 * e2;
+    }
+    if (d2B != nullptr) {
+      d2B[0] = f;
+      d2B[1] = 3. * e - 2.;
+      d2B[2] = 1. - 3. * e;
+      d2B[3] = e;
+    }
+    return 0;
+  }
+
+  int shift = 0;
+  if (e > 0.5) {
+    shift = 1;
+    e = e - 1.;
+  }
+  const double a = 0.5 - e;
+  const double b = 0.5 + e;
+  B[0] = 0.5 * a * a;
+  B[1] = 0.75 - e * e;
+  B[2] = 0.5 * b * b;
+  if (dB != nullptr) {
+    dB[0] = -a;
+    dB[1] = -2. * e;
+    dB[2] = b;
+  }
+  if (d2B != nullptr) {
+    d2B[0] = 1.;
+    d2B[1] = -2.;
+    d2B[2] = 1.;
+  }
+  return shift;
+}
+
+/*
+  Add a sample to the joint histogram Bins of size Ncb x Ncb where each bin stores stride values: the probability,
+  then if order > 0 its NbParam derivatives and if order > 1 the upper triangle of its second derivatives. This is the
+  same contribution as the one of PutTotPVBspline() (order 2), PutTotPVBsplineNoSecond() (order 1) or
+  PutTotPVBsplinePrtTout() (order 0) to PrtTout, once summed up by vpTemplateTrackerMI::computeProba().
+ */
+void vpTemplateTrackerMIBSpline::PutTotPVBsplineBins(double *Bins, int cr, double er, int ct, double et, int Ncb,
+                                                     const double *val, unsigned int NbParam, int degree, int order,
+                                                     unsigned int stride)
+{
+  double Br[4], Bt[4], dBt[4], d2Bt[4];
+  const int sr = computeBsplineWeights(er, degree, Br, nullptr, nullptr);
+  const int st = computeBsplineWeights(et, degree, Bt, order > 0 ? dBt : nullptr, order > 1 ? d2Bt : nullptr);
+  const int r0 = cr + sr;
+  const int t0 = ct + st;
+
+  switch (order > 0 ? NbParam : 0) {
+  case 2:
+    putBins<2>(Bins, r0, t0, Ncb, degree, Br, Bt, dBt, d2Bt, val, NbParam, order, stride);
+    break;
+  case 3:
+    putBins<3>(Bins, r0, t0, Ncb, degree, Br, Bt, dBt, d2Bt, val, NbParam, order, stride);
+    break;
+  case 4:
+    putBins<4>(Bins, r0, t0, Ncb, degree, Br, Bt, dBt, d2Bt, val, NbParam, order, stride);
+    break;
+  case 6:
+    putBins<6>(Bins, r0, t0, Ncb, degree, Br, Bt, dBt, d2Bt, val, NbParam, order, stride);
+    break;
+  case 8:
+    putBins<8>(Bins, r0, t0, Ncb, degree, Br, Bt, dBt, d2Bt, val, NbParam, order, stride);
+    break;
+  default:
+    putBins<0>(Bins, r0, t0, Ncb, degree, Br, Bt, dBt, d2Bt, val, NbParam, order, stride);
+  }
+}
+
 void vpTemplateTrackerMIBSpline::PutPVBsplineD(double *Prt, int cr, double er, int ct, double et, int Nc, double val,
                                                const int &degre)
 {
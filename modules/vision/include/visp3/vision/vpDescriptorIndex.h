@@ -0,0 +1,232 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Approximate nearest neighbor index for keypoint descriptors.
+ */
+
+#ifndef _vpDescriptorIndex_h_
+#define _vpDescriptorIndex_h_
+
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+ * \class vpDescriptorIndex
+ * \ingroup group_vision_keypoints
+ *
+ * \brief Approximate nearest neighbor index for keypoint descriptors, that does not
+ * rely on OpenCV FLANN.
+ *
+ * Two kinds of index are available:
+ * - vpDescriptorIndex::HAMMING_CLUSTERING_TREE, for binary descriptors (ORB, BRISK, BRIEF...)
+ *   compared with the Hamming distance. Each tree recursively clusters the descriptors around
+ *   randomly chosen centers (hierarchical clustering tree).
+ * - vpDescriptorIndex::L2_KD_FOREST, for floating point descriptors (SIFT, SURF...) compared with
+ *   the Euclidean distance. Each tree is a randomized kd-tree that splits the data along one of the
+ *   dimensions with the highest variance.
+ *
+ * Descriptors are inserted incrementally: a leaf is split as soon as it contains more than
+ * setLeafMaxSize() descriptors, so that reference descriptors can be added at any time without
+ * rebuilding the index. Queries explore the trees in a best-bin-first order and stop after
+ * setMaxChecks() descriptor comparisons, which trades accuracy for speed.
+ *
+ * Searches are read-only and can be run concurrently from multiple threads.
+ *
+ * \code
+ * vpDescriptorIndex index(vpDescriptorIndex::HAMMING_CLUSTERING_TREE, 32); // ORB: 32 bytes
+ * index.add(trainDescriptors.data(), nbTrainDescriptors);
+ * std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+ * index.knnSearch(queryDescriptor, 2, neighbors);
+ * \endcode
+ *
+ * vpKeyPoint uses this index when the matcher is set to "IndexBased".
+ */
+class VISP_EXPORT vpDescriptorIndex
+{
+public:
+  typedef enum
+  {
+    HAMMING_CLUSTERING_TREE, /*!< Hierarchical clustering trees for binary descriptors (Hamming distance). */
+    L2_KD_FOREST             /*!< Randomized kd-trees for float descriptors (Euclidean distance). */
+  } vpDescriptorIndexType;
+
+  /*!
+   * Neighbor returned by a query.
+   */
+  struct vpNeighbor
+  {
+    unsigned int index; //!< Index of the train descriptor, in insertion order.
+    float distance;     //!< Hamming or Euclidean distance to the query descriptor.
+  };
+
+  /*!
+   * Create an empty index.
+   *
+   * \param type : Kind of index, that defines the descriptor type and the distance.
+   * \param descriptorSize : Size of a descriptor, in bytes for HAMMING_CLUSTERING_TREE and
+   * in number of float values for L2_KD_FOREST.
+   */
+  vpDescriptorIndex(const vpDescriptorIndexType &type, unsigned int descriptorSize);
+
+  /*!
+   * Insert binary descriptors in a HAMMING_CLUSTERING_TREE index.
+   *
+   * \param descriptors : Contiguous rows of descriptors.
+   * \param nbDescriptors : Number of rows.
+   */
+  void add(const unsigned char *descriptors, unsigned int nbDescriptors);
+
+  /*!
+   * Insert float descriptors in a L2_KD_FOREST index.
+   *
+   * \param descriptors : Contiguous rows of descriptors.
+   * \param nbDescriptors : Number of rows.
+   */
+  void add(const float *descriptors, unsigned int nbDescriptors);
+
+  /*!
+   * Remove all the descriptors.
+   */
+  void clear();
+
+  /*!
+   * Descriptors of the index stored as contiguous rows in insertion order, either unsigned char
+   * or float values depending on getType().
+   */
+  inline const void *getDescriptors() const
+  {
+    return m_type == HAMMING_CLUSTERING_TREE ? static_cast<const void *>(m_binaryData.data())
+                                             : static_cast<const void *>(m_floatData.data());
+  }
+  inline unsigned int getBranching() const { return m_branching; }
+  inline unsigned int getDescriptorSize() const { return m_descriptorSize; }
+  inline unsigned int getLeafMaxSize() const { return m_leafMaxSize; }
+  inline unsigned int getMaxChecks() const { return m_maxChecks; }
+  inline unsigned int getNbTrees() const { return m_nbTrees; }
+  inline vpDescriptorIndexType getType() const { return m_type; }
+
+  /*!
+   * Find the approximate k nearest neighbors of a binary descriptor.
+   *
+   * \param query : Query descriptor of getDescriptorSize() bytes.
+   * \param k : Number of neighbors.
+   * \param neighbors : Neighbors sorted by increasing distance, at most k.
+   */
+  void knnSearch(const unsigned char *query, unsigned int k, std::vector<vpNeighbor> &neighbors) const;
+
+  /*!
+   * Find the approximate k nearest neighbors of a float descriptor.
+   *
+   * \param query : Query descriptor of getDescriptorSize() values.
+   * \param k : Number of neighbors.
+   * \param neighbors : Neighbors sorted by increasing distance, at most k.
+   */
+  void knnSearch(const float *query, unsigned int k, std::vector<vpNeighbor> &neighbors) const;
+
+  /*!
+   * Restore the trees written by saveTrees(), so that the index does not have to be built again.
+   * The index must be empty and of the same type and descriptor size as the saved one.
+   *
+   * \param descriptors : Descriptors of the saved index, as contiguous rows in insertion order.
+   * They are copied in the index.
+   * \param nbDescriptors : Number of descriptors.
+   * \param buffer : Data written by saveTrees().
+   * \param bufferSize : Size of \e buffer in bytes.
+   */
+  void loadTrees(const void *descriptors, unsigned int nbDescriptors, const char *buffer, size_t bufferSize);
+
+  /*!
+   * Write the parameters and the trees of the index in native byte order, without the descriptors.
+   *
+   * \param os : Output binary stream.
+   */
+  void saveTrees(std::ostream &os) const;
+
+  /*!
+   * Set the number of children of a node for HAMMING_CLUSTERING_TREE. Must be set before adding descriptors.
+   */
+  void setBranching(unsigned int branching);
+
+  /*!
+   * Set the maximum number of descriptors in a leaf before it is split. Must be set before adding descriptors.
+   */
+  void setLeafMaxSize(unsigned int leafMaxSize);
+
+  /*!
+   * Set the maximum number of descriptors compared to the query during a search.
+   * Higher values give better recall at the expense of speed.
+   */
+  inline void setMaxChecks(unsigned int maxChecks) { m_maxChecks = maxChecks; }
+
+  /*!
+   * Set the number of trees of the index. Must be set before adding descriptors.
+   */
+  void setNbTrees(unsigned int nbTrees);
+
+  /*!
+   * Number of descriptors in the index.
+   */
+  inline unsigned int size() const { return m_nbDescriptors; }
+
+private:
+  struct vpNode
+  {
+    std::vector<unsigned int> children; //!< Indexes of the children nodes, empty for a leaf.
+    std::vector<unsigned int> points;   //!< Descriptors in a leaf.
+    unsigned int center;                //!< Clustering tree: descriptor used as center of the node.
+    unsigned int splitDim;              //!< Kd-tree: split dimension.
+    float splitValue;                   //!< Kd-tree: split value.
+    bool splittable;                    //!< False if the leaf descriptors cannot be separated.
+  };
+
+  template <typename Type> void addImpl(const Type *descriptors, unsigned int nbDescriptors);
+  template <typename Type> const Type *getRow(unsigned int index) const;
+  template <typename Type> void insert(std::vector<vpNode> &tree, unsigned int index);
+  template <typename Type>
+  void knnSearchImpl(const Type *query, unsigned int k, std::vector<vpNeighbor> &neighbors) const;
+  template <typename Type> void split(std::vector<vpNode> &tree, unsigned int node);
+
+  vpDescriptorIndexType m_type;
+  unsigned int m_descriptorSize;
+  unsigned int m_nbTrees;
+  unsigned int m_branching;
+  unsigned int m_leafMaxSize;
+  unsigned int m_maxChecks;
+  unsigned int m_nbDescriptors;
+  std::vector<unsigned char> m_binaryData;
+  std::vector<float> m_floatData;
+  std::vector<std::vector<vpNode> > m_trees;
+  std::mt19937 m_rng;
+};
+
+#endif
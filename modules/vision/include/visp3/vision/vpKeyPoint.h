@@ -38,6 +38,7 @@
 #include <fstream>   // std::ofstream
 #include <limits>
 #include <map>      // std::map
+#include <memory>   // std::shared_ptr
 #include <numeric>  // std::accumulate
 #include <stdlib.h> // srand, rand
 #include <time.h>   // time
@@ -50,6 +51,7 @@
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpBasicKeyPoint.h>
+#include <visp3/vision/vpDescriptorIndex.h>
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_IO
 #include <visp3/io/vpImageIo.h>
@@ -377,6 +379,19 @@ public:
    */
   unsigned int buildReference(const vpImage<unsigned char> &I, const vpRect &rectangle);
 
+  /*!
+   * Build the reference keypoints list from multiple training images.
+   * The keypoint class_id is set to the index of the training image in the list.
+   *
+   * When the parallel pipeline is enabled with setParallelPipeline(), keypoint detection
+   * and descriptor extraction are run concurrently on the training images.
+   *
+   * \param listOfImages : List of input reference images.
+   * \return The number of detected keypoints in all the images.
+   * \sa setParallelPipeline(), setParallelPipelineNbThreads()
+   */
+  unsigned int buildReference(const std::vector<vpImage<unsigned char> > &listOfImages);
+
   /*!
    * Build the reference keypoints list and compute the 3D position
    * corresponding of the keypoints locations.
@@ -1315,6 +1330,28 @@ public:
    */
   void loadLearningData(const std::string &filename, bool binaryMode = false, bool append = false);
 
+  /*!
+   * Load a learning database saved with saveLearningDatabase().
+   *
+   * The file is memory mapped and the train descriptors refer directly to the mapped
+   * pages, without being copied or parsed. Multiple processes loading the same database
+   * thus share the same page-cached data. The file stays mapped as long as the train
+   * descriptors, or a matrix returned by getTrainDescriptors(), are in use.
+   * With OpenCV 2.4 the descriptors are copied.
+   *
+   * When the database was saved with the "IndexBased" matcher and the current matcher is
+   * "IndexBased" with the same number of trees, leaf size and branching factor (see
+   * setIndexBasedMatcherParameters()), the search trees are restored from the file instead of
+   * being rebuilt. The index still keeps its own copy of the descriptors. In any other case,
+   * including \e append, the stored trees are ignored and the matcher is trained as usual.
+   *
+   * \param filename : Path of the learning database.
+   * \param append : If true, concatenate the learning data (the train descriptors are then
+   * copied), otherwise reset the variables.
+   * \sa saveLearningDatabase(), loadLearningData()
+   */
+  void loadLearningDatabase(const std::string &filename, bool append = false);
+
   /*!
    * Match keypoints based on distance between their descriptors.
    *
@@ -1531,6 +1568,20 @@ public:
    */
   void saveLearningData(const std::string &filename, bool binaryMode = false, bool saveTrainingImages = true);
 
+  /*!
+   * Save the learning data in a versioned binary database that can be memory mapped
+   * by loadLearningDatabase().
+   *
+   * Keypoints, 3D points and descriptors are stored in separate sections aligned on 64 bytes,
+   * the descriptors as a contiguous matrix. With the "IndexBased" matcher, the search trees
+   * built on the train descriptors are stored as well.
+   *
+   * \param filename : Path of the learning database.
+   * \param saveTrainingImages : If true, save also the training images on disk.
+   * \sa loadLearningDatabase(), saveLearningData()
+   */
+  void saveLearningDatabase(const std::string &filename, bool saveTrainingImages = true);
+
   /*!
    * Set if the covariance matrix has to be computed in the Virtual Visual
    * Servoing approach.
@@ -1690,6 +1741,7 @@ public:
    *   - BruteForce-Hamming
    *   - BruteForce-Hamming(2)
    *   - FlannBased
+   *   - IndexBased (approximate search with vpDescriptorIndex, available since OpenCV 3.0)
    *
    * L1 and L2 norms are preferable choices for SIFT and SURF descriptors,
    * NORM_HAMMING should be used with ORB, BRISK and BRIEF, NORM_HAMMING2
@@ -1703,6 +1755,21 @@ public:
     initMatcher(m_matcherName);
   }
 
+  /*!
+   * Set the parameters of the IndexBased matcher (see setMatcher() and vpDescriptorIndex).
+   *
+   * \param maxChecks : Maximum number of train descriptors compared to a query descriptor.
+   * Higher values give better matches at the expense of speed. This is also the maximum number
+   * of neighbors returned by a radius search.
+   * \param nbTrees : Number of trees of the index.
+   * \param leafMaxSize : Maximum number of descriptors in a leaf of a tree.
+   * \param branching : Number of children of a node for binary descriptors.
+   *
+   * Changing \e nbTrees, \e leafMaxSize or \e branching rebuilds the index at the next matching.
+   */
+  void setIndexBasedMatcherParameters(unsigned int maxChecks, unsigned int nbTrees = 4, unsigned int leafMaxSize = 64,
+                                      unsigned int branching = 16);
+
   /*!
    * Set maximum number of keypoints to extract.
    * \warning This functionality is only available for ORB and SIFT extractors.
@@ -1786,6 +1853,36 @@ public:
     }
   }
 
+  /*!
+   * Use or not the multithreaded keypoint pipeline. When enabled:
+   * - the affine views computed by detectExtractAffine() are processed concurrently,
+   * - the training images passed to buildReference(const std::vector<vpImage<unsigned char> > &)
+   *   are processed concurrently,
+   * - the query descriptors (or the train descriptors when setUseMatchTrainToQuery() is used)
+   *   are split in chunks matched in parallel against the other set.
+   *
+   * The results are the same as with the sequential pipeline.
+   *
+   * The work is dispatched to the OpenCV thread pool (see cv::setNumThreads()), whose threads
+   * are reused from one call to the other. The OpenCV parallel loops of the detectors and
+   * extractors then run sequentially inside each worker. Matching is split in chunks of at
+   * least a few hundred descriptors, so that small sets of descriptors are matched without
+   * any thread overhead.
+   *
+   * \sa setParallelPipelineNbThreads()
+   */
+  inline void setParallelPipeline(bool parallel) { m_parallelPipeline = parallel; }
+
+  /*!
+   * Set the number of threads to use if the multithreaded keypoint pipeline is enabled.
+   *
+   * \param nthreads : Number of threads, if 0 the number of threads of the OpenCV thread pool
+   * (cv::getNumThreads()) is used. The number of concurrent workers is also bounded by the size of
+   * the OpenCV thread pool.
+   * \sa setParallelPipeline
+   */
+  inline void setParallelPipelineNbThreads(unsigned int nthreads) { m_parallelPipelineNbThreads = nthreads; }
+
   /*!
    * Set the percentage value for defining the cardinality of the consensus
    * group.
@@ -2027,6 +2124,10 @@ private:
   //! List of 3D points (in the object frame) filtered after the matching to
   //! compute the pose.
   std::vector<cv::Point3f> m_objectFilteredPoints;
+  //! If true, use the multithreaded detection, extraction and matching pipeline
+  bool m_parallelPipeline;
+  //! Number of threads for the parallel pipeline (if 0, try to determine the number of CPU threads)
+  unsigned int m_parallelPipelineNbThreads;
   //! Elapsed time to compute the pose.
   double m_poseTime;
   /*! Matrix of descriptors (each row contains the descriptors values for each
@@ -2095,6 +2196,14 @@ private:
   vpImage<unsigned char> m_I;
   //! Max number of features to extract, -1 to use default values
   int m_maxFeatures;
+  //! IndexBased matcher: maximum number of descriptor comparisons per query
+  unsigned int m_indexMaxChecks;
+  //! IndexBased matcher: number of trees
+  unsigned int m_indexNbTrees;
+  //! IndexBased matcher: maximum number of descriptors in a leaf
+  unsigned int m_indexLeafMaxSize;
+  //! IndexBased matcher: branching factor of the clustering trees
+  unsigned int m_indexBranching;
 
   /*!
    * Apply an affine and skew transformation to an image.
@@ -2106,6 +2215,22 @@ private:
    */
   void affineSkew(double tilt, double phi, cv::Mat &img, cv::Mat &mask, cv::Mat &Ai);
 
+  /*!
+   * Save the training images in a directory.
+   *
+   * \param parent : Directory where the images are saved.
+   * \param mapOfImgPath : Map of image id with the saved image filename.
+   */
+  void writeTrainingImages(const std::string &parent, std::map<int, std::string> &mapOfImgPath) const;
+
+  /*!
+   * Get the number of threads to use for the parallel pipeline.
+   *
+   * \return 1 if the parallel pipeline is disabled, the user number of threads otherwise
+   * or the number of CPU threads if it is not set.
+   */
+  unsigned int getParallelPipelineNbThreads() const;
+
   /*!
    * Compute the pose estimation error, the mean square error (in pixel) between
    * the location of the detected keypoints and the location of the projection
@@ -2250,6 +2375,47 @@ private:
     static void retainBest(std::vector<cv::KeyPoint> &keypoints, int npoints);
   };
 
+  /*
+   * Descriptor matcher based on vpDescriptorIndex, that does not need OpenCV FLANN.
+   * Hierarchical clustering trees are used for binary descriptors and randomized
+   * kd-trees for float descriptors. Train descriptors appended after the last training
+   * are inserted in the index without rebuilding it.
+   * radiusMatch() returns at most maxChecks neighbors per query descriptor.
+   */
+  class DescriptorIndexMatcher : public cv::DescriptorMatcher
+  {
+  public:
+    DescriptorIndexMatcher(unsigned int maxChecks = 512, unsigned int nbTrees = 4, unsigned int leafMaxSize = 64,
+                           unsigned int branching = 16);
+
+    virtual void add(cv::InputArrayOfArrays descriptors);
+    virtual void clear();
+    virtual cv::Ptr<cv::DescriptorMatcher> clone(bool emptyTrainData = false) const;
+    //! Train if needed and return the index, null when there is no train descriptor
+    std::shared_ptr<vpDescriptorIndex> getIndex();
+    virtual bool isMaskSupported() const;
+    bool setIndex(const std::shared_ptr<vpDescriptorIndex> &index);
+    void setParameters(unsigned int maxChecks, unsigned int nbTrees, unsigned int leafMaxSize, unsigned int branching);
+    virtual void train();
+
+  protected:
+    virtual void knnMatchImpl(cv::InputArray queryDescriptors, std::vector<std::vector<cv::DMatch> > &matches, int k,
+                              cv::InputArrayOfArrays masks = cv::noArray(), bool compactResult = false);
+    virtual void radiusMatchImpl(cv::InputArray queryDescriptors, std::vector<std::vector<cv::DMatch> > &matches,
+                                 float maxDistance, cv::InputArrayOfArrays masks = cv::noArray(),
+                                 bool compactResult = false);
+
+    std::shared_ptr<vpDescriptorIndex> m_index;
+    //! Index of the first descriptor of each train image
+    std::vector<unsigned int> m_startIndexes;
+    //! True if train descriptors were added or cleared since the last training
+    bool m_modified;
+    unsigned int m_maxChecks;
+    unsigned int m_nbTrees;
+    unsigned int m_leafMaxSize;
+    unsigned int m_branching;
+  };
+
 #endif
 };
 
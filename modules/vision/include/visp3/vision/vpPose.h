@@ -184,6 +184,26 @@ public:
    */
   bool computePose(vpPoseMethodType method, vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &) = nullptr);
 
+  /*!
+   * Compute the poses of many independent sets of points, for example the corners of
+   * each detected tag, with the same method and parameters as this instance.
+   *
+   * Each set of points is solved as computePose() would do on a vpPose holding only these
+   * points, and gives the same result. The sets are dispatched over \e nbThreads threads,
+   * each of them reusing a single copy of this instance for all the sets it processes.
+   * The points of this instance are not used.
+   *
+   * \param method : Pose estimation method, see computePose().
+   * \param points : Sets of points, each of them with at least 4 points.
+   * \param cMo : Estimated poses, one per set of points. If it already has one element per
+   * set, its elements are used as initial poses by the methods that need one.
+   * \param nbThreads : Number of threads, 0 to use all the CPU threads.
+   * eturn For each set of points, true if its pose was successfully computed. A set with less
+   * than 4 points or for which computePose() throws an exception is reported as a failure.
+   */
+  std::vector<bool> computePoses(vpPoseMethodType method, const std::vector<std::vector<vpPoint> > &points,
+                                 std::vector<vpHomogeneousMatrix> &cMo, unsigned int nbThreads = 0) const;
+
   /*!
    * @brief Method that first computes the pose \b cMo using the linear approaches of Dementhon and Lagrange
    * and then uses the non-linear Virtual Visual Servoing approach to affine the pose which
@@ -0,0 +1,627 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Approximate nearest neighbor index for keypoint descriptors.
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <stdint.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/vision/vpDescriptorIndex.h>
+
+namespace
+{
+inline unsigned int popcount64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned int>(__builtin_popcountll(v));
+#else
+  return static_cast<unsigned int>(std::bitset<64>(v).count());
+#endif
+}
+
+// Hamming distance between binary descriptors
+inline float descriptorDistance(const unsigned char *a, const unsigned char *b, unsigned int size)
+{
+  unsigned int dist = 0;
+  unsigned int i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t va, vb;
+    std::memcpy(&va, a + i, sizeof(va));
+    std::memcpy(&vb, b + i, sizeof(vb));
+    dist += popcount64(va ^ vb);
+  }
+  for (; i < size; i++) {
+    dist += popcount64(static_cast<uint64_t>(a[i] ^ b[i]));
+  }
+  return static_cast<float>(dist);
+}
+
+// Squared Euclidean distance between float descriptors
+inline float descriptorDistance(const float *a, const float *b, unsigned int size)
+{
+  float dist0 = 0.f, dist1 = 0.f, dist2 = 0.f, dist3 = 0.f;
+  unsigned int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float d0 = a[i] - b[i], d1 = a[i + 1] - b[i + 1], d2 = a[i + 2] - b[i + 2], d3 = a[i + 3] - b[i + 3];
+    dist0 += d0 * d0;
+    dist1 += d1 * d1;
+    dist2 += d2 * d2;
+    dist3 += d3 * d3;
+  }
+  for (; i < size; i++) {
+    float d = a[i] - b[i];
+    dist0 += d * d;
+  }
+  return (dist0 + dist1) + (dist2 + dist3);
+}
+
+// Branch of a tree not yet explored during a search
+struct Branch
+{
+  float priority;
+  unsigned int tree;
+  unsigned int node;
+
+  bool operator>(const Branch &other) const { return priority > other.priority; }
+};
+
+// Insert a candidate in the list of the k best neighbors sorted by increasing distance
+inline void addNeighbor(unsigned int index, float distance, unsigned int k,
+                        std::vector<vpDescriptorIndex::vpNeighbor> &neighbors)
+{
+  if (neighbors.size() == k && distance >= neighbors.back().distance) {
+    return;
+  }
+  // The same descriptor can be reached from several trees
+  for (size_t i = 0; i < neighbors.size(); i++) {
+    if (neighbors[i].index == index) {
+      return;
+    }
+  }
+
+  vpDescriptorIndex::vpNeighbor neighbor;
+  neighbor.index = index;
+  neighbor.distance = distance;
+  std::vector<vpDescriptorIndex::vpNeighbor>::iterator it = neighbors.begin();
+  while (it != neighbors.end() && it->distance <= distance) {
+    ++it;
+  }
+  neighbors.insert(it, neighbor);
+  if (neighbors.size() > k) {
+    neighbors.pop_back();
+  }
+}
+
+const char descriptorIndexMagic[4] = { 'V', 'P', 'D', 'I' };
+const uint32_t descriptorIndexVersion = 1;
+
+template <typename Type> void writeValue(std::ostream &os, const Type &value)
+{
+  os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Bounds checked reading of the buffer written by vpDescriptorIndex::saveTrees()
+class TreesReader
+{
+public:
+  TreesReader(const char *buffer, size_t size) : m_buffer(buffer), m_size(size), m_offset(0) { }
+
+  template <typename Type> Type read()
+  {
+    if (m_size - m_offset < sizeof(Type)) {
+      throw vpException(vpException::ioError, "Truncated descriptor index data");
+    }
+    Type value;
+    std::memcpy(&value, m_buffer + m_offset, sizeof(value));
+    m_offset += sizeof(value);
+    return value;
+  }
+
+  // Read count indexes lower than maxIndex
+  void readIndexes(std::vector<unsigned int> &indexes, uint32_t count, uint32_t maxIndex)
+  {
+    if ((m_size - m_offset) / sizeof(uint32_t) < count) {
+      throw vpException(vpException::ioError, "Truncated descriptor index data");
+    }
+    indexes.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+      indexes[i] = read<uint32_t>();
+      if (indexes[i] >= maxIndex) {
+        throw vpException(vpException::ioError, "Corrupted descriptor index data");
+      }
+    }
+  }
+
+private:
+  const char *m_buffer;
+  size_t m_size;
+  size_t m_offset;
+};
+} // namespace
+
+vpDescriptorIndex::vpDescriptorIndex(const vpDescriptorIndexType &type, unsigned int descriptorSize)
+  : m_type(type), m_descriptorSize(descriptorSize), m_nbTrees(4), m_branching(16), m_leafMaxSize(64),
+  m_maxChecks(512), m_nbDescriptors(0), m_binaryData(), m_floatData(), m_trees(), m_rng(0)
+{
+  if (descriptorSize == 0) {
+    throw vpException(vpException::badValue, "The descriptor size must be greater than zero");
+  }
+}
+
+template <> const unsigned char *vpDescriptorIndex::getRow<unsigned char>(unsigned int index) const
+{
+  return &m_binaryData[static_cast<size_t>(index) * m_descriptorSize];
+}
+
+template <> const float *vpDescriptorIndex::getRow<float>(unsigned int index) const
+{
+  return &m_floatData[static_cast<size_t>(index) * m_descriptorSize];
+}
+
+void vpDescriptorIndex::add(const unsigned char *descriptors, unsigned int nbDescriptors)
+{
+  if (m_type != HAMMING_CLUSTERING_TREE) {
+    throw vpException(vpException::badValue, "Binary descriptors need a HAMMING_CLUSTERING_TREE index");
+  }
+  m_binaryData.insert(m_binaryData.end(), descriptors,
+                      descriptors + static_cast<size_t>(nbDescriptors) * m_descriptorSize);
+  addImpl(descriptors, nbDescriptors);
+}
+
+void vpDescriptorIndex::add(const float *descriptors, unsigned int nbDescriptors)
+{
+  if (m_type != L2_KD_FOREST) {
+    throw vpException(vpException::badValue, "Float descriptors need a L2_KD_FOREST index");
+  }
+  m_floatData.insert(m_floatData.end(), descriptors,
+                     descriptors + static_cast<size_t>(nbDescriptors) * m_descriptorSize);
+  addImpl(descriptors, nbDescriptors);
+}
+
+template <typename Type> void vpDescriptorIndex::addImpl(const Type *, unsigned int nbDescriptors)
+{
+  if (m_trees.empty()) {
+    vpNode root;
+    root.center = 0;
+    root.splitDim = 0;
+    root.splitValue = 0.f;
+    root.splittable = true;
+    m_trees.assign(m_nbTrees, std::vector<vpNode>(1, root));
+  }
+
+  unsigned int first = m_nbDescriptors;
+  m_nbDescriptors += nbDescriptors;
+  for (size_t t = 0; t < m_trees.size(); t++) {
+    for (unsigned int i = first; i < m_nbDescriptors; i++) {
+      insert<Type>(m_trees[t], i);
+    }
+  }
+}
+
+void vpDescriptorIndex::clear()
+{
+  m_nbDescriptors = 0;
+  m_binaryData.clear();
+  m_floatData.clear();
+  m_trees.clear();
+  m_rng.seed(0);
+}
+
+template <typename Type> void vpDescriptorIndex::insert(std::vector<vpNode> &tree, unsigned int index)
+{
+  const Type *descriptor = getRow<Type>(index);
+  unsigned int node = 0;
+  while (!tree[node].children.empty()) {
+    const vpNode &current = tree[node];
+    if (m_type == HAMMING_CLUSTERING_TREE) {
+      // Go down to the child with the closest center
+      unsigned int best = current.children[0];
+      float bestDistance = descriptorDistance(descriptor, getRow<Type>(tree[best].center), m_descriptorSize);
+      for (size_t i = 1; i < current.children.size(); i++) {
+        unsigned int child = current.children[i];
+        float distance = descriptorDistance(descriptor, getRow<Type>(tree[child].center), m_descriptorSize);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best = child;
+        }
+      }
+      node = best;
+    }
+    else {
+      node = static_cast<float>(descriptor[current.splitDim]) <= current.splitValue ? current.children[0]
+                                                                                      : current.children[1];
+    }
+  }
+
+  tree[node].points.push_back(index);
+  if (tree[node].splittable && tree[node].points.size() > m_leafMaxSize) {
+    split<Type>(tree, node);
+  }
+}
+
+template <typename Type> void vpDescriptorIndex::split(std::vector<vpNode> &tree, unsigned int node)
+{
+  std::vector<unsigned int> points = tree[node].points;
+  std::vector<std::vector<unsigned int> > groups;
+  std::vector<unsigned int> centers;
+  unsigned int splitDim = 0;
+  float splitValue = 0.f;
+
+  if (m_type == HAMMING_CLUSTERING_TREE) {
+    // Choose random centers among the leaf descriptors
+    std::vector<unsigned int> candidates = points;
+    size_t nbCenters = std::min(static_cast<size_t>(m_branching), candidates.size());
+    for (size_t i = 0; i < nbCenters; i++) {
+      size_t j = i + static_cast<size_t>(m_rng() % (candidates.size() - i));
+      std::swap(candidates[i], candidates[j]);
+    }
+    centers.assign(candidates.begin(), candidates.begin() + nbCenters);
+
+    // Assign each descriptor to the closest center
+    groups.resize(centers.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      const Type *descriptor = getRow<Type>(points[i]);
+      size_t best = 0;
+      float bestDistance = descriptorDistance(descriptor, getRow<Type>(centers[0]), m_descriptorSize);
+      for (size_t c = 1; c < centers.size(); c++) {
+        float distance = descriptorDistance(descriptor, getRow<Type>(centers[c]), m_descriptorSize);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best = c;
+        }
+      }
+      groups[best].push_back(points[i]);
+    }
+  }
+  else {
+    // Mean and variance of each dimension
+    std::vector<double> mean(m_descriptorSize, 0.0), var(m_descriptorSize, 0.0);
+    for (size_t i = 0; i < points.size(); i++) {
+      const Type *descriptor = getRow<Type>(points[i]);
+      for (unsigned int d = 0; d < m_descriptorSize; d++) {
+        mean[d] += descriptor[d];
+      }
+    }
+    for (unsigned int d = 0; d < m_descriptorSize; d++) {
+      mean[d] /= points.size();
+    }
+    for (size_t i = 0; i < points.size(); i++) {
+      const Type *descriptor = getRow<Type>(points[i]);
+      for (unsigned int d = 0; d < m_descriptorSize; d++) {
+        double diff = descriptor[d] - mean[d];
+        var[d] += diff * diff;
+      }
+    }
+
+    // Randomly pick one of the dimensions with the highest variance, which decorrelates the trees
+    const size_t nbCandidateDims = 5;
+    std::vector<unsigned int> dims(m_descriptorSize);
+    for (unsigned int d = 0; d < m_descriptorSize; d++) {
+      dims[d] = d;
+    }
+    size_t nbDims = std::min(nbCandidateDims, dims.size());
+    std::partial_sort(dims.begin(), dims.begin() + nbDims, dims.end(),
+                      [&var](unsigned int d1, unsigned int d2) { return var[d1] > var[d2]; });
+    while (nbDims > 1 && var[dims[nbDims - 1]] <= 0.0) {
+      nbDims--;
+    }
+    splitDim = dims[m_rng() % nbDims];
+    splitValue = static_cast<float>(mean[splitDim]);
+
+    groups.resize(2);
+    if (var[splitDim] > 0.0) {
+      for (size_t i = 0; i < points.size(); i++) {
+        groups[static_cast<float>(getRow<Type>(points[i])[splitDim]) <= splitValue ? 0 : 1].push_back(points[i]);
+      }
+    }
+  }
+
+  size_t nbGroups = 0;
+  for (size_t g = 0; g < groups.size(); g++) {
+    if (!groups[g].empty()) {
+      nbGroups++;
+    }
+  }
+  if (nbGroups < 2) {
+    // All the descriptors are identical, keep a single leaf
+    tree[node].splittable = false;
+    return;
+  }
+
+  std::vector<unsigned int> children;
+  for (size_t g = 0; g < groups.size(); g++) {
+    // Kd-tree nodes always have two children, clustering nodes only non empty clusters
+    if (groups[g].empty() && m_type == HAMMING_CLUSTERING_TREE) {
+      continue;
+    }
+    vpNode child;
+    child.center = centers.empty() ? 0 : centers[g];
+    child.splitDim = 0;
+    child.splitValue = 0.f;
+    child.splittable = true;
+    child.points = groups[g];
+    children.push_back(static_cast<unsigned int>(tree.size()));
+    tree.push_back(child);
+  }
+
+  tree[node].children = children;
+  tree[node].splitDim = splitDim;
+  tree[node].splitValue = splitValue;
+  std::vector<unsigned int>().swap(tree[node].points);
+
+  for (size_t i = 0; i < children.size(); i++) {
+    if (tree[children[i]].points.size() > m_leafMaxSize) {
+      split<Type>(tree, children[i]);
+    }
+  }
+}
+
+void vpDescriptorIndex::knnSearch(const unsigned char *query, unsigned int k, std::vector<vpNeighbor> &neighbors) const
+{
+  if (m_type != HAMMING_CLUSTERING_TREE) {
+    throw vpException(vpException::badValue, "Binary descriptors need a HAMMING_CLUSTERING_TREE index");
+  }
+  knnSearchImpl(query, k, neighbors);
+}
+
+void vpDescriptorIndex::knnSearch(const float *query, unsigned int k, std::vector<vpNeighbor> &neighbors) const
+{
+  if (m_type != L2_KD_FOREST) {
+    throw vpException(vpException::badValue, "Float descriptors need a L2_KD_FOREST index");
+  }
+  knnSearchImpl(query, k, neighbors);
+
+  // Internal distances are squared Euclidean distances
+  for (size_t i = 0; i < neighbors.size(); i++) {
+    neighbors[i].distance = std::sqrt(neighbors[i].distance);
+  }
+}
+
+template <typename Type>
+void vpDescriptorIndex::knnSearchImpl(const Type *query, unsigned int k, std::vector<vpNeighbor> &neighbors) const
+{
+  neighbors.clear();
+  if (k == 0 || m_nbDescriptors == 0) {
+    return;
+  }
+
+  std::priority_queue<Branch, std::vector<Branch>, std::greater<Branch> > branches;
+  unsigned int nbChecks = 0;
+
+  // Best-bin-first descent from a node to a leaf, the other branches are kept for later
+  auto explore = [&](unsigned int t, unsigned int node) {
+    const std::vector<vpNode> &tree = m_trees[t];
+    while (!tree[node].children.empty()) {
+      const vpNode &current = tree[node];
+      if (m_type == HAMMING_CLUSTERING_TREE) {
+        unsigned int best = 0;
+        float bestDistance = 0.f;
+        for (size_t i = 0; i < current.children.size(); i++) {
+          unsigned int child = current.children[i];
+          float distance = descriptorDistance(query, getRow<Type>(tree[child].center), m_descriptorSize);
+          if (i == 0 || distance < bestDistance) {
+            if (i != 0) {
+              Branch branch = { bestDistance, t, best };
+              branches.push(branch);
+            }
+            bestDistance = distance;
+            best = child;
+          }
+          else {
+            Branch branch = { distance, t, child };
+            branches.push(branch);
+          }
+        }
+        node = best;
+      }
+      else {
+        float diff = static_cast<float>(query[current.splitDim]) - current.splitValue;
+        Branch branch = { diff * diff, t, diff <= 0.f ? current.children[1] : current.children[0] };
+        branches.push(branch);
+        node = diff <= 0.f ? current.children[0] : current.children[1];
+      }
+    }
+
+    const std::vector<unsigned int> &points = tree[node].points;
+    for (size_t i = 0; i < points.size(); i++) {
+      if (nbChecks >= m_maxChecks && neighbors.size() == k) {
+        return;
+      }
+      nbChecks++;
+      addNeighbor(points[i], descriptorDistance(query, getRow<Type>(points[i]), m_descriptorSize), k, neighbors);
+    }
+  };
+
+  for (unsigned int t = 0; t < m_trees.size(); t++) {
+    explore(t, 0);
+  }
+
+  while (!branches.empty() && (nbChecks < m_maxChecks || neighbors.size() < k)) {
+    Branch branch = branches.top();
+    branches.pop();
+    // For kd-trees the priority is a lower bound of the distance to the descriptors of the branch
+    if (m_type == L2_KD_FOREST && neighbors.size() == k && branch.priority >= neighbors.back().distance) {
+      continue;
+    }
+    explore(branch.tree, branch.node);
+  }
+}
+
+void vpDescriptorIndex::loadTrees(const void *descriptors, unsigned int nbDescriptors, const char *buffer,
+                                  size_t bufferSize)
+{
+  if (m_nbDescriptors > 0) {
+    throw vpException(vpException::fatalError, "The trees must be loaded in an empty index");
+  }
+
+  TreesReader reader(buffer, bufferSize);
+  char magic[sizeof(descriptorIndexMagic)];
+  for (size_t i = 0; i < sizeof(magic); i++) {
+    magic[i] = reader.read<char>();
+  }
+  if (std::memcmp(magic, descriptorIndexMagic, sizeof(magic)) != 0 ||
+      reader.read<uint32_t>() != descriptorIndexVersion) {
+    throw vpException(vpException::ioError, "Unsupported descriptor index data");
+  }
+  uint32_t type = reader.read<uint32_t>();
+  uint32_t descriptorSize = reader.read<uint32_t>();
+  uint32_t nbTrees = reader.read<uint32_t>();
+  uint32_t branching = reader.read<uint32_t>();
+  uint32_t leafMaxSize = reader.read<uint32_t>();
+  uint32_t maxChecks = reader.read<uint32_t>();
+  uint32_t savedNbDescriptors = reader.read<uint32_t>();
+  if (type != static_cast<uint32_t>(m_type) || descriptorSize != m_descriptorSize ||
+      savedNbDescriptors != nbDescriptors || nbTrees == 0 || branching < 2 || leafMaxSize == 0) {
+    throw vpException(vpException::badValue, "The saved descriptor index does not match the descriptors");
+  }
+
+  std::vector<std::vector<vpNode> > trees(nbTrees);
+  for (uint32_t t = 0; t < nbTrees; t++) {
+    uint32_t nbNodes = reader.read<uint32_t>();
+    if (nbNodes == 0 || nbNodes > bufferSize) {
+      throw vpException(vpException::ioError, "Corrupted descriptor index data");
+    }
+    trees[t].resize(nbNodes);
+    for (uint32_t n = 0; n < nbNodes; n++) {
+      vpNode &node = trees[t][n];
+      node.center = reader.read<uint32_t>();
+      node.splitDim = reader.read<uint32_t>();
+      node.splitValue = reader.read<float>();
+      node.splittable = reader.read<uint32_t>() != 0;
+      uint32_t nbChildren = reader.read<uint32_t>();
+      uint32_t nbPoints = reader.read<uint32_t>();
+      // Children are always stored after their parent, which prevents cycles
+      reader.readIndexes(node.children, nbChildren, nbNodes);
+      reader.readIndexes(node.points, nbPoints, nbDescriptors);
+      for (size_t i = 0; i < node.children.size(); i++) {
+        if (node.children[i] <= n) {
+          throw vpException(vpException::ioError, "Corrupted descriptor index data");
+        }
+      }
+      if ((n > 0 && node.center >= std::max(nbDescriptors, 1u)) || node.splitDim >= m_descriptorSize) {
+        throw vpException(vpException::ioError, "Corrupted descriptor index data");
+      }
+    }
+  }
+
+  size_t nbValues = static_cast<size_t>(nbDescriptors) * m_descriptorSize;
+  if (m_type == HAMMING_CLUSTERING_TREE) {
+    const unsigned char *data = static_cast<const unsigned char *>(descriptors);
+    m_binaryData.assign(data, data + nbValues);
+  }
+  else {
+    const float *data = static_cast<const float *>(descriptors);
+    m_floatData.assign(data, data + nbValues);
+  }
+  m_nbTrees = nbTrees;
+  m_branching = branching;
+  m_leafMaxSize = leafMaxSize;
+  m_maxChecks = maxChecks;
+  m_nbDescriptors = nbDescriptors;
+  m_trees.swap(trees);
+}
+
+void vpDescriptorIndex::saveTrees(std::ostream &os) const
+{
+  os.write(descriptorIndexMagic, sizeof(descriptorIndexMagic));
+  writeValue(os, descriptorIndexVersion);
+  writeValue(os, static_cast<uint32_t>(m_type));
+  writeValue(os, static_cast<uint32_t>(m_descriptorSize));
+  writeValue(os, static_cast<uint32_t>(m_nbTrees));
+  writeValue(os, static_cast<uint32_t>(m_branching));
+  writeValue(os, static_cast<uint32_t>(m_leafMaxSize));
+  writeValue(os, static_cast<uint32_t>(m_maxChecks));
+  writeValue(os, static_cast<uint32_t>(m_nbDescriptors));
+  for (unsigned int t = 0; t < m_nbTrees; t++) {
+    // An empty index has no tree yet, save a single empty leaf
+    std::vector<vpNode> root(1);
+    root[0].center = 0;
+    root[0].splitDim = 0;
+    root[0].splitValue = 0.f;
+    root[0].splittable = true;
+    const std::vector<vpNode> &tree = t < m_trees.size() ? m_trees[t] : root;
+
+    writeValue(os, static_cast<uint32_t>(tree.size()));
+    for (size_t n = 0; n < tree.size(); n++) {
+      const vpNode &node = tree[n];
+      writeValue(os, static_cast<uint32_t>(node.center));
+      writeValue(os, static_cast<uint32_t>(node.splitDim));
+      writeValue(os, node.splitValue);
+      writeValue(os, static_cast<uint32_t>(node.splittable ? 1 : 0));
+      writeValue(os, static_cast<uint32_t>(node.children.size()));
+      writeValue(os, static_cast<uint32_t>(node.points.size()));
+      for (size_t i = 0; i < node.children.size(); i++) {
+        writeValue(os, static_cast<uint32_t>(node.children[i]));
+      }
+      for (size_t i = 0; i < node.points.size(); i++) {
+        writeValue(os, static_cast<uint32_t>(node.points[i]));
+      }
+    }
+  }
+}
+
+void vpDescriptorIndex::setBranching(unsigned int branching)
+{
+  if (m_nbDescriptors > 0) {
+    throw vpException(vpException::fatalError, "The branching factor must be set before adding descriptors");
+  }
+  if (branching < 2) {
+    throw vpException(vpException::badValue, "The branching factor must be at least 2");
+  }
+  m_branching = branching;
+}
+
+void vpDescriptorIndex::setLeafMaxSize(unsigned int leafMaxSize)
+{
+  if (m_nbDescriptors > 0) {
+    throw vpException(vpException::fatalError, "The leaf size must be set before adding descriptors");
+  }
+  if (leafMaxSize == 0) {
+    throw vpException(vpException::badValue, "The leaf size must be greater than zero");
+  }
+  m_leafMaxSize = leafMaxSize;
+}
+
+void vpDescriptorIndex::setNbTrees(unsigned int nbTrees)
+{
+  if (m_nbDescriptors > 0) {
+    throw vpException(vpException::fatalError, "The number of trees must be set before adding descriptors");
+  }
+  if (nbTrees == 0) {
+    throw vpException(vpException::badValue, "The number of trees must be greater than zero");
+  }
+  m_nbTrees = nbTrees;
+}
@@ -31,14 +31,31 @@
  * Key point functionalities.
  */
 
+#include <atomic>
+#include <cstring>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <type_traits>
 
+#include <visp3/core/vpEndian.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/vision/vpKeyPoint.h>
 
 #if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_FEATURES2D)
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #if defined(VISP_HAVE_PUGIXML)
 #include <pugixml.hpp>
 #endif
@@ -60,6 +77,290 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
   return vpImagePoint(pair.first.pt.y, pair.first.pt.x);
 }
 
+// Learning database (see vpKeyPoint::saveLearningDatabase()) stored in little endian.
+// All the sections are aligned on learningDatabaseAlignment bytes so that they can be
+// used in place once the file is memory mapped:
+// - header: LearningDatabaseHeader
+// - training images: for each image, image_id (int32), path length (int32) and path characters
+// - keypoint class_id to training image_id map: nbImageIds pairs of int32
+// - keypoints: nbKeyPoints LearningDatabaseKeyPoint
+// - 3D points: nbKeyPoints cv::Point3f if have3DInfo != 0
+// - descriptors: nbKeyPoints contiguous rows of descriptorCols elements of type descriptorType
+// - matcher index: vpDescriptorIndex::saveTrees() data of indexSize bytes when the IndexBased
+//   matcher is used, empty otherwise
+const char learningDatabaseMagic[8] = { 'V', 'P', 'K', 'P', 'D', 'B', '\0', '\0' };
+const uint32_t learningDatabaseVersion = 1;
+const uint64_t learningDatabaseAlignment = 64;
+
+struct LearningDatabaseHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  int32_t nbKeyPoints;
+  int32_t descriptorCols;
+  int32_t descriptorType;
+  int32_t have3DInfo;
+  int32_t nbImages;
+  int32_t nbImageIds;
+  uint64_t imagesOffset;
+  uint64_t imageIdsOffset;
+  uint64_t keyPointsOffset;
+  uint64_t pointsOffset;
+  uint64_t descriptorsOffset;
+  uint64_t indexOffset;
+  uint64_t indexSize;
+  uint64_t fileSize;
+  uint64_t reserved[3];
+};
+
+struct LearningDatabaseKeyPoint
+{
+  float u, v, size, angle, response;
+  int32_t octave, class_id;
+};
+
+static_assert(sizeof(LearningDatabaseHeader) == 128, "Unexpected learning database header size");
+static_assert(sizeof(LearningDatabaseKeyPoint) == 28, "Unexpected learning database keypoint size");
+static_assert(sizeof(cv::Point3f) == 3 * sizeof(float), "Unexpected cv::Point3f size");
+
+inline uint64_t alignLearningDatabaseOffset(uint64_t offset)
+{
+  return (offset + learningDatabaseAlignment - 1) / learningDatabaseAlignment * learningDatabaseAlignment;
+}
+
+void padLearningDatabase(std::ofstream &file)
+{
+  uint64_t offset = static_cast<uint64_t>(file.tellp());
+  std::vector<char> padding(static_cast<size_t>(alignLearningDatabaseOffset(offset) - offset), 0);
+  if (!padding.empty()) {
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+  }
+}
+
+// Map a file in memory with copy-on-write pages, the mapping is released with the returned pointer
+std::shared_ptr<void> mapLearningDatabase(const std::string &filename, uint64_t &fileSize)
+{
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw vpException(vpException::ioError, "Cannot open the file: %s", filename.c_str());
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    throw vpException(vpException::ioError, "Cannot get the size of the file: %s", filename.c_str());
+  }
+  fileSize = static_cast<uint64_t>(size.QuadPart);
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    throw vpException(vpException::ioError, "Cannot map the file: %s", filename.c_str());
+  }
+  void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+  CloseHandle(mapping);
+  if (data == nullptr) {
+    throw vpException(vpException::ioError, "Cannot map the file: %s", filename.c_str());
+  }
+  return std::shared_ptr<void>(data, [](void *ptr) { UnmapViewOfFile(ptr); });
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw vpException(vpException::ioError, "Cannot open the file: %s", filename.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    throw vpException(vpException::ioError, "Cannot get the size of the file: %s", filename.c_str());
+  }
+  fileSize = static_cast<uint64_t>(st.st_size);
+  // Private writable mapping: pages are shared with the page cache until they are modified
+  void *data = mmap(nullptr, static_cast<size_t>(fileSize), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw vpException(vpException::ioError, "Cannot map the file: %s", filename.c_str());
+  }
+  size_t length = static_cast<size_t>(fileSize);
+  return std::shared_ptr<void>(data, [length](void *ptr) { munmap(ptr, length); });
+#endif
+}
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+// Allocator of the train descriptors that refer to a memory mapped learning database: the
+// mapping is released with the last cv::Mat that uses it (see wrapLearningDatabase())
+class LearningDatabaseAllocator : public cv::MatAllocator
+{
+public:
+  // cv::AccessFlag since OpenCV 4, int before
+  typedef std::conditional<std::is_same<decltype(cv::ACCESS_READ | cv::ACCESS_WRITE), decltype(cv::ACCESS_READ)>::value,
+                           decltype(cv::ACCESS_READ), int>::type AccessFlagType;
+
+  virtual cv::UMatData *allocate(int dims, const int *sizes, int type, void *data, size_t *step, AccessFlagType flags,
+                                 cv::UMatUsageFlags usageFlags) const
+  {
+    return cv::Mat::getDefaultAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+  }
+
+  virtual bool allocate(cv::UMatData *u, AccessFlagType accessFlags, cv::UMatUsageFlags usageFlags) const
+  {
+    return cv::Mat::getDefaultAllocator()->allocate(u, accessFlags, usageFlags);
+  }
+
+  virtual void deallocate(cv::UMatData *u) const
+  {
+    if (u) {
+      delete static_cast<std::shared_ptr<void> *>(u->userdata);
+      delete u;
+    }
+  }
+};
+
+const cv::MatAllocator *getLearningDatabaseAllocator()
+{
+  // Never destroyed, as the OpenCV default allocator, so that matrices released at exit remain valid
+  static const LearningDatabaseAllocator *allocator = new LearningDatabaseAllocator();
+  return allocator;
+}
+#endif
+
+// Matrix that uses in place the data of a memory mapped learning database, and that
+// keeps the mapping alive as long as the matrix or one of its copies exists
+cv::Mat wrapLearningDatabase(const std::shared_ptr<void> &mapping, uint64_t offset, int rows, int cols, int type)
+{
+  if (rows == 0) {
+    return cv::Mat(0, cols, type);
+  }
+
+  unsigned char *data = static_cast<unsigned char *>(mapping.get()) + offset;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  cv::Mat mat(rows, cols, type, data);
+  cv::UMatData *u = new cv::UMatData(getLearningDatabaseAllocator());
+  u->data = u->origdata = data;
+  u->size = mat.total() * mat.elemSize();
+  u->refcount = 1;
+  u->userdata = new std::shared_ptr<void>(mapping);
+  mat.u = u;
+  return mat;
+#else
+  // No custom allocator with OpenCV 2.4, the descriptors are copied
+  return cv::Mat(rows, cols, type, data).clone();
+#endif
+}
+
+// Check that a section of count elements of elemSize bytes starting at offset is aligned
+// and lies in the file, without overflow
+bool checkLearningDatabaseSection(uint64_t offset, uint64_t count, uint64_t elemSize, uint64_t fileSize)
+{
+  if (offset % learningDatabaseAlignment != 0 || offset > fileSize) {
+    return false;
+  }
+  if (elemSize != 0 && count > (fileSize - offset) / elemSize) {
+    return false;
+  }
+  return true;
+}
+
+// Run the stripes of parallelFor() in the OpenCV thread pool
+template <typename Func> class ParallelForBody : public cv::ParallelLoopBody
+{
+public:
+  ParallelForBody(size_t size, const Func &func) : m_size(size), m_func(func), m_nextIndex(0) { }
+
+  virtual void operator()(const cv::Range &) const
+  {
+    for (size_t i = m_nextIndex++; i < m_size; i = m_nextIndex++) {
+      m_func(i);
+    }
+  }
+
+private:
+  size_t m_size;
+  const Func &m_func;
+  mutable std::atomic<size_t> m_nextIndex;
+};
+
+// Call func(i) for each index i in [0, size) with up to nbThreads threads.
+// Indexes are dispatched on demand to balance work items with different costs.
+// The threads are those of the OpenCV pool, that are reused across calls; the
+// OpenCV parallel loops called by func (e.g. in detect() or compute()) then run
+// sequentially in each worker instead of oversubscribing the CPU.
+template <typename Func> void parallelFor(size_t size, unsigned int nbThreads, const Func &func)
+{
+  if (nbThreads <= 1 || size <= 1) {
+    for (size_t i = 0; i < size; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  int nbStripes = static_cast<int>(std::min(static_cast<size_t>(nbThreads), size));
+  cv::parallel_for_(cv::Range(0, nbStripes), ParallelForBody<Func>(size, func), nbStripes);
+}
+
+// Minimum number of descriptors per chunk, below which matching a chunk costs
+// less than dispatching it to a worker thread
+const int minRowsPerChunk = 256;
+
+// Split the rows of descriptors in at most nbChunks contiguous ranges of at least minRowsPerChunk rows
+std::vector<cv::Range> splitRows(int rows, unsigned int nbChunks)
+{
+  std::vector<cv::Range> ranges;
+  int maxChunks = std::max(1, rows / minRowsPerChunk);
+  int chunks = std::min(static_cast<int>(nbChunks), maxChunks);
+  int chunkSize = (rows + chunks - 1) / chunks;
+  for (int start = 0; start < rows; start += chunkSize) {
+    ranges.push_back(cv::Range(start, std::min(start + chunkSize, rows)));
+  }
+  return ranges;
+}
+
+// Match the query descriptors against the descriptors already added to the matcher,
+// the query descriptors being split in chunks matched in parallel.
+void parallelMatch(const cv::Ptr<cv::DescriptorMatcher> &matcher, const cv::Mat &queryDescriptors,
+                   unsigned int nbThreads, std::vector<cv::DMatch> &matches)
+{
+  // Train once (e.g. FLANN index) so that the concurrent queries are read-only
+  matcher->train();
+
+  std::vector<cv::Range> ranges = splitRows(queryDescriptors.rows, nbThreads);
+  std::vector<std::vector<cv::DMatch> > listOfMatches(ranges.size());
+  parallelFor(ranges.size(), nbThreads, [&](size_t i) {
+    matcher->match(queryDescriptors.rowRange(ranges[i]), listOfMatches[i]);
+    for (std::vector<cv::DMatch>::iterator it = listOfMatches[i].begin(); it != listOfMatches[i].end(); ++it) {
+      it->queryIdx += ranges[i].start;
+    }
+    });
+
+  matches.clear();
+  for (size_t i = 0; i < listOfMatches.size(); i++) {
+    matches.insert(matches.end(), listOfMatches[i].begin(), listOfMatches[i].end());
+  }
+}
+
+// Same as parallelMatch() but for the k nearest neighbors
+void parallelKnnMatch(const cv::Ptr<cv::DescriptorMatcher> &matcher, const cv::Mat &queryDescriptors, int k,
+                      unsigned int nbThreads, std::vector<std::vector<cv::DMatch> > &knnMatches)
+{
+  matcher->train();
+
+  std::vector<cv::Range> ranges = splitRows(queryDescriptors.rows, nbThreads);
+  std::vector<std::vector<std::vector<cv::DMatch> > > listOfKnnMatches(ranges.size());
+  parallelFor(ranges.size(), nbThreads, [&](size_t i) {
+    matcher->knnMatch(queryDescriptors.rowRange(ranges[i]), listOfKnnMatches[i], k);
+    for (size_t j = 0; j < listOfKnnMatches[i].size(); j++) {
+      for (size_t l = 0; l < listOfKnnMatches[i][j].size(); l++) {
+        listOfKnnMatches[i][j][l].queryIdx += ranges[i].start;
+      }
+    }
+    });
+
+  knnMatches.clear();
+  for (size_t i = 0; i < listOfKnnMatches.size(); i++) {
+    knnMatches.insert(knnMatches.end(), listOfKnnMatches[i].begin(), listOfKnnMatches[i].end());
+  }
+}
+
 } // namespace
 
 vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatureDescriptorType &descriptorType,
@@ -70,7 +371,8 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
   m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
   m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
   m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
-  m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
+  m_objectFilteredPoints(), m_parallelPipeline(false), m_parallelPipelineNbThreads(0), m_poseTime(0.),
+  m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
   m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
   m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
   m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(), m_useAffineDetection(false),
@@ -78,7 +380,8 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
   m_useBruteForceCrossCheck(true),
 #endif
   m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1), m_indexMaxChecks(512), m_indexNbTrees(4),
+  m_indexLeafMaxSize(64), m_indexBranching(16)
 {
   initFeatureNames();
 
@@ -96,7 +399,8 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
   m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
   m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
-  m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
+  m_objectFilteredPoints(), m_parallelPipeline(false), m_parallelPipelineNbThreads(0), m_poseTime(0.),
+  m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
   m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
   m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01),
   m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(), m_useAffineDetection(false),
@@ -104,7 +408,8 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   m_useBruteForceCrossCheck(true),
 #endif
   m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1), m_indexMaxChecks(512), m_indexNbTrees(4),
+  m_indexLeafMaxSize(64), m_indexBranching(16)
 {
   initFeatureNames();
 
@@ -122,7 +427,8 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
   m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
   m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
-  m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
+  m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_parallelPipeline(false),
+  m_parallelPipelineNbThreads(0), m_poseTime(0.), m_queryDescriptors(),
   m_queryFilteredKeyPoints(), m_queryKeyPoints(), m_ransacConsensusPercentage(20.0),
   m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(), m_ransacParallel(false),
   m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0), m_ransacThreshold(0.01), m_trainDescriptors(),
@@ -131,7 +437,8 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   m_useBruteForceCrossCheck(true),
 #endif
   m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1)
+  m_useSingleMatchFilter(true), m_I(), m_maxFeatures(-1), m_indexMaxChecks(512), m_indexNbTrees(4),
+  m_indexLeafMaxSize(64), m_indexBranching(16)
 {
   initFeatureNames();
   init();
@@ -264,6 +571,79 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
 
+unsigned int vpKeyPoint::buildReference(const std::vector<vpImage<unsigned char> > &listOfImages)
+{
+  // Reset variables used when dealing with 3D models
+  // So as no 3D point list is passed, we dont need this variables
+  m_trainPoints.clear();
+  m_mapOfImageId.clear();
+  m_mapOfImages.clear();
+  m_currentImageId = 0;
+
+  // Detect keypoints and extract descriptors on each training image
+  std::vector<std::vector<cv::KeyPoint> > listOfTrainKeyPoints(listOfImages.size());
+  std::vector<cv::Mat> listOfTrainDescriptors(listOfImages.size());
+  std::vector<double> listOfDetectionTimes(listOfImages.size(), 0.0), listOfExtractionTimes(listOfImages.size(), 0.0);
+
+  auto processTrainImage = [&](size_t i) {
+    if (m_useAffineDetection) {
+      std::vector<std::vector<cv::KeyPoint> > listOfAffineKeyPoints;
+      std::vector<cv::Mat> listOfAffineDescriptors;
+      double t = vpTime::measureTimeMs();
+      detectExtractAffine(listOfImages[i], listOfAffineKeyPoints, listOfAffineDescriptors);
+      listOfDetectionTimes[i] = vpTime::measureTimeMs() - t;
+
+      for (size_t j = 0; j < listOfAffineKeyPoints.size(); j++) {
+        listOfTrainKeyPoints[i].insert(listOfTrainKeyPoints[i].end(), listOfAffineKeyPoints[j].begin(),
+                                       listOfAffineKeyPoints[j].end());
+        listOfTrainDescriptors[i].push_back(listOfAffineDescriptors[j]);
+      }
+    }
+    else {
+      detect(listOfImages[i], listOfTrainKeyPoints[i], listOfDetectionTimes[i]);
+      extract(listOfImages[i], listOfTrainKeyPoints[i], listOfTrainDescriptors[i], listOfExtractionTimes[i]);
+    }
+  };
+
+  // When the affine detection is used, the parallelism is already done over the affine views
+  parallelFor(listOfImages.size(), m_useAffineDetection ? 1 : getParallelPipelineNbThreads(), processTrainImage);
+
+  m_trainKeyPoints.clear();
+  m_trainDescriptors = cv::Mat();
+  m_detectionTime = 0.0;
+  m_extractionTime = 0.0;
+  for (size_t i = 0; i < listOfImages.size(); i++) {
+    m_currentImageId++;
+
+    // The keypoint class_id is the index of the training image
+    for (std::vector<cv::KeyPoint>::iterator it = listOfTrainKeyPoints[i].begin(); it != listOfTrainKeyPoints[i].end();
+         ++it) {
+      it->class_id = static_cast<int>(i);
+    }
+    m_mapOfImageId[static_cast<int>(i)] = m_currentImageId;
+
+    // Save the image in a map at a specific image_id
+    m_mapOfImages[m_currentImageId] = listOfImages[i];
+
+    m_trainKeyPoints.insert(m_trainKeyPoints.end(), listOfTrainKeyPoints[i].begin(), listOfTrainKeyPoints[i].end());
+    m_trainDescriptors.push_back(listOfTrainDescriptors[i]);
+
+    m_detectionTime += listOfDetectionTimes[i];
+    m_extractionTime += listOfExtractionTimes[i];
+  }
+
+  // Convert OpenCV type to ViSP type for compatibility
+  vpConvert::convertFromOpenCV(m_trainKeyPoints, m_referenceImagePointsList);
+
+  m_reference_computed = true;
+
+  // Add train descriptors in matcher object
+  m_matcher->clear();
+  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+
+  return static_cast<unsigned int>(m_trainKeyPoints.size());
+}
+
 unsigned int vpKeyPoint::buildReference(const vpImage<vpRGBa> &I_color, const vpRect &rectangle)
 {
   vpImageConvert::convert(I_color, m_I);
@@ -2223,7 +2603,13 @@ void vpKeyPoint::initMatcher(const std::string &matcherName)
     }
   }
 
-  if (matcherName == "FlannBased") {
+  if (matcherName == "IndexBased") {
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+    m_matcher =
+      cv::makePtr<DescriptorIndexMatcher>(m_indexMaxChecks, m_indexNbTrees, m_indexLeafMaxSize, m_indexBranching);
+#endif
+  }
+  else if (matcherName == "FlannBased") {
     if (m_extractors.empty()) {
       std::cout << "Warning: No extractor initialized, by default use "
         "floating values (CV_32F) "
@@ -2264,6 +2650,25 @@ void vpKeyPoint::initMatcher(const std::string &matcherName)
   }
 }
 
+void vpKeyPoint::setIndexBasedMatcherParameters(unsigned int maxChecks, unsigned int nbTrees, unsigned int leafMaxSize,
+                                                unsigned int branching)
+{
+  if (maxChecks == 0 || nbTrees == 0 || leafMaxSize == 0 || branching < 2) {
+    throw vpException(vpException::badValue, "Invalid parameters for the IndexBased matcher");
+  }
+  m_indexMaxChecks = maxChecks;
+  m_indexNbTrees = nbTrees;
+  m_indexLeafMaxSize = leafMaxSize;
+  m_indexBranching = branching;
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  DescriptorIndexMatcher *matcher = dynamic_cast<DescriptorIndexMatcher *>(m_matcher.get());
+  if (matcher != nullptr) {
+    matcher->setParameters(maxChecks, nbTrees, leafMaxSize, branching);
+  }
+#endif
+}
+
 void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &IRef, const vpImage<unsigned char> &ICurrent,
                                      vpImage<unsigned char> &IMatching)
 {
@@ -2904,10 +3309,185 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
   m_currentImageId = (int)m_mapOfImages.size();
 }
 
+void vpKeyPoint::loadLearningDatabase(const std::string &filename, bool append)
+{
+#if defined(VISP_BIG_ENDIAN)
+  throw vpException(vpException::fatalError, "vpKeyPoint::loadLearningDatabase() needs a little endian platform");
+#endif
+  int startClassId = 0;
+  int startImageId = 0;
+  if (!append) {
+    m_trainKeyPoints.clear();
+    m_trainPoints.clear();
+    m_mapOfImageId.clear();
+    m_mapOfImages.clear();
+  }
+  else {
+    // In append case, find the max index of keypoint class Id
+    for (std::map<int, int>::const_iterator it = m_mapOfImageId.begin(); it != m_mapOfImageId.end(); ++it) {
+      if (startClassId < it->first) {
+        startClassId = it->first;
+      }
+    }
+
+    // In append case, find the max index of images Id
+    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
+         ++it) {
+      if (startImageId < it->first) {
+        startImageId = it->first;
+      }
+    }
+  }
+
+  // Get parent directory
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    parent += "/";
+  }
+
+  uint64_t fileSize = 0;
+  std::shared_ptr<void> mapping = mapLearningDatabase(filename, fileSize);
+  const char *data = static_cast<const char *>(mapping.get());
+
+  LearningDatabaseHeader header;
+  if (fileSize < sizeof(header)) {
+    throw vpException(vpException::ioError, "The file %s is not a learning database", filename.c_str());
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, learningDatabaseMagic, sizeof(header.magic)) != 0) {
+    throw vpException(vpException::ioError, "The file %s is not a learning database", filename.c_str());
+  }
+  if (header.version != learningDatabaseVersion || header.headerSize != sizeof(header)) {
+    throw vpException(vpException::ioError, "Unsupported learning database version %u in %s", header.version,
+                      filename.c_str());
+  }
+
+  if (header.nbKeyPoints < 0 || header.descriptorCols < 0 || header.nbImages < 0 || header.nbImageIds < 0 ||
+      header.fileSize != fileSize || (header.descriptorType != CV_8U && header.descriptorType != CV_32F)) {
+    throw vpException(vpException::ioError, "Corrupted learning database: %s", filename.c_str());
+  }
+  uint64_t nbKeyPoints = static_cast<uint64_t>(header.nbKeyPoints);
+  uint64_t descriptorRowSize =
+    static_cast<uint64_t>(header.descriptorCols) * static_cast<uint64_t>(CV_ELEM_SIZE(header.descriptorType));
+  if (!checkLearningDatabaseSection(header.imagesOffset, 0, 0, fileSize) ||
+      !checkLearningDatabaseSection(header.imageIdsOffset, static_cast<uint64_t>(header.nbImageIds),
+                                    2 * sizeof(int32_t), fileSize) ||
+      !checkLearningDatabaseSection(header.keyPointsOffset, nbKeyPoints, sizeof(LearningDatabaseKeyPoint), fileSize) ||
+      !checkLearningDatabaseSection(header.pointsOffset, header.have3DInfo != 0 ? nbKeyPoints : 0,
+                                    sizeof(cv::Point3f), fileSize) ||
+      !checkLearningDatabaseSection(header.descriptorsOffset, nbKeyPoints, descriptorRowSize, fileSize) ||
+      !checkLearningDatabaseSection(header.indexOffset, header.indexSize, 1, fileSize)) {
+    throw vpException(vpException::ioError, "Corrupted learning database: %s", filename.c_str());
+  }
+
+  // Read info about training images
+#if !defined(VISP_HAVE_MODULE_IO)
+  if (header.nbImages > 0) {
+    std::cout << "Warning: The learning database contains image data that will "
+      "not be loaded as visp_io module "
+      "is not available !"
+      << std::endl;
+  }
+#endif
+  uint64_t offset = header.imagesOffset;
+  for (int32_t i = 0; i < header.nbImages; i++) {
+    int32_t id = 0, length = 0;
+    if (offset > fileSize || fileSize - offset < 2 * sizeof(int32_t)) {
+      throw vpException(vpException::ioError, "Corrupted learning database: %s", filename.c_str());
+    }
+    std::memcpy(&id, data + offset, sizeof(id));
+    std::memcpy(&length, data + offset + sizeof(id), sizeof(length));
+    offset += 2 * sizeof(int32_t);
+    if (length < 0 || static_cast<uint64_t>(length) > fileSize - offset) {
+      throw vpException(vpException::ioError, "Corrupted learning database: %s", filename.c_str());
+    }
+    std::string path(data + offset, static_cast<size_t>(length));
+    offset += static_cast<uint64_t>(length);
+
+#ifdef VISP_HAVE_MODULE_IO
+    vpImage<unsigned char> I;
+    if (vpIoTools::isAbsolutePathname(path)) {
+      vpImageIo::read(I, path);
+    }
+    else {
+      vpImageIo::read(I, parent + path);
+    }
+
+    // Add the image previously loaded only if VISP_HAVE_MODULE_IO
+    m_mapOfImages[id + startImageId] = I;
+#else
+    (void)id;
+#endif
+  }
+
+  // Read the correspondence keypoint class_id with the training image_id
+#ifdef VISP_HAVE_MODULE_IO
+  const int32_t *imageIds = reinterpret_cast<const int32_t *>(data + header.imageIdsOffset);
+  for (int32_t i = 0; i < header.nbImageIds; i++) {
+    m_mapOfImageId[imageIds[2 * i] + startClassId] = imageIds[2 * i + 1] + startImageId;
+  }
+#endif
+
+  // Keypoints and 3D points
+  const LearningDatabaseKeyPoint *keyPoints =
+    reinterpret_cast<const LearningDatabaseKeyPoint *>(data + header.keyPointsOffset);
+  m_trainKeyPoints.reserve(m_trainKeyPoints.size() + nbKeyPoints);
+  for (uint64_t i = 0; i < nbKeyPoints; i++) {
+    const LearningDatabaseKeyPoint &kpt = keyPoints[i];
+    m_trainKeyPoints.push_back(cv::KeyPoint(cv::Point2f(kpt.u, kpt.v), kpt.size, kpt.angle, kpt.response,
+                                            kpt.octave, kpt.class_id + startClassId));
+  }
+
+  if (header.have3DInfo != 0) {
+    const cv::Point3f *points = reinterpret_cast<const cv::Point3f *>(data + header.pointsOffset);
+    m_trainPoints.insert(m_trainPoints.end(), points, points + nbKeyPoints);
+  }
+
+  // Descriptors are used in place in the memory mapped file, that stays mapped as long as
+  // the matrix (or a copy returned by getTrainDescriptors()) is used
+  cv::Mat trainDescriptorsTmp = wrapLearningDatabase(mapping, header.descriptorsOffset, header.nbKeyPoints,
+                                                     header.descriptorCols, header.descriptorType);
+  if (!append || m_trainDescriptors.empty()) {
+    m_trainDescriptors = trainDescriptorsTmp;
+  }
+  else {
+    cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
+  }
+
+  // Convert OpenCV type to ViSP type for compatibility
+  vpConvert::convertFromOpenCV(m_trainKeyPoints, m_referenceImagePointsList);
+  vpConvert::convertFromOpenCV(this->m_trainPoints, m_trainVpPoints);
+
+  // Add train descriptors in matcher object
+  m_matcher->clear();
+  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  // Restore the stored search trees instead of rebuilding them, only when the matcher is
+  // trained on exactly the descriptors of this file
+  DescriptorIndexMatcher *indexMatcher = dynamic_cast<DescriptorIndexMatcher *>(m_matcher.get());
+  if (indexMatcher != nullptr && header.indexSize > 0 && m_trainDescriptors.rows == header.nbKeyPoints) {
+    std::shared_ptr<vpDescriptorIndex> index = std::make_shared<vpDescriptorIndex>(
+      header.descriptorType == CV_8U ? vpDescriptorIndex::HAMMING_CLUSTERING_TREE : vpDescriptorIndex::L2_KD_FOREST,
+      static_cast<unsigned int>(header.descriptorCols));
+    index->loadTrees(data + header.descriptorsOffset, static_cast<unsigned int>(header.nbKeyPoints),
+                     data + header.indexOffset, static_cast<size_t>(header.indexSize));
+    indexMatcher->setIndex(index);
+  }
+#endif
+
+  // Set m_reference_computed to true as we load a learning database
+  m_reference_computed = true;
+
+  // Set m_currentImageId
+  m_currentImageId = (int)m_mapOfImages.size();
+}
+
 void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
                        std::vector<cv::DMatch> &matches, double &elapsedTime)
 {
   double t = vpTime::measureTimeMs();
+  unsigned int nbThreads = getParallelPipelineNbThreads();
 
   if (m_useKnn) {
     m_knnMatches.clear();
@@ -2917,7 +3497,13 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
 
       // Match train descriptors to query descriptors
       cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(true);
-      matcherTmp->knnMatch(trainDescriptors, queryDescriptors, knnMatchesTmp, 2);
+      if (nbThreads > 1) {
+        matcherTmp->add(std::vector<cv::Mat>(1, queryDescriptors));
+        parallelKnnMatch(matcherTmp, trainDescriptors, 2, nbThreads, knnMatchesTmp);
+      }
+      else {
+        matcherTmp->knnMatch(trainDescriptors, queryDescriptors, knnMatchesTmp, 2);
+      }
 
       for (std::vector<std::vector<cv::DMatch> >::const_iterator it1 = knnMatchesTmp.begin();
            it1 != knnMatchesTmp.end(); ++it1) {
@@ -2933,7 +3519,12 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
     }
     else {
    // Match query descriptors to train descriptors
-      m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      if (nbThreads > 1) {
+        parallelKnnMatch(m_matcher, queryDescriptors, 2, nbThreads, m_knnMatches);
+      }
+      else {
+        m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      }
       matches.resize(m_knnMatches.size());
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     }
@@ -2945,7 +3536,13 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       std::vector<cv::DMatch> matchesTmp;
       // Match train descriptors to query descriptors
       cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(true);
-      matcherTmp->match(trainDescriptors, queryDescriptors, matchesTmp);
+      if (nbThreads > 1) {
+        matcherTmp->add(std::vector<cv::Mat>(1, queryDescriptors));
+        parallelMatch(matcherTmp, trainDescriptors, nbThreads, matchesTmp);
+      }
+      else {
+        matcherTmp->match(trainDescriptors, queryDescriptors, matchesTmp);
+      }
 
       for (std::vector<cv::DMatch>::const_iterator it = matchesTmp.begin(); it != matchesTmp.end(); ++it) {
         matches.push_back(cv::DMatch(it->trainIdx, it->queryIdx, it->distance));
@@ -2953,7 +3550,12 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
     }
     else {
    // Match query descriptors to train descriptors
-      m_matcher->match(queryDescriptors, matches);
+      if (nbThreads > 1) {
+        parallelMatch(m_matcher, queryDescriptors, nbThreads, matches);
+      }
+      else {
+        m_matcher->match(queryDescriptors, matches);
+      }
     }
   }
   elapsedTime = vpTime::measureTimeMs() - t;
@@ -3517,24 +4119,21 @@ void vpKeyPoint::detectExtractAffine(const vpImage<unsigned char> &I,
     listOfAffineI->resize(listOfAffineParams.size());
   }
 
-#ifdef VISP_HAVE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int cpt = 0; cpt < static_cast<int>(listOfAffineParams.size()); cpt++) {
+  auto processAffineView = [&](size_t cpt) {
     std::vector<cv::KeyPoint> keypoints;
     cv::Mat descriptors;
 
     cv::Mat timg, mask, Ai;
     img.copyTo(timg);
 
-    affineSkew(listOfAffineParams[(size_t)cpt].first, listOfAffineParams[(size_t)cpt].second, timg, mask, Ai);
+    affineSkew(listOfAffineParams[cpt].first, listOfAffineParams[cpt].second, timg, mask, Ai);
 
     if (listOfAffineI != nullptr) {
       cv::Mat img_disp;
       bitwise_and(mask, timg, img_disp);
       vpImage<unsigned char> tI;
       vpImageConvert::convert(img_disp, tI);
-      (*listOfAffineI)[(size_t)cpt] = tI;
+      (*listOfAffineI)[cpt] = tI;
     }
 
 #if 0
@@ -3562,12 +4161,39 @@ void vpKeyPoint::detectExtractAffine(const vpImage<unsigned char> &I,
       keypoints[i].pt.y = kpt_t.at<float>(1, 0);
     }
 
-    listOfKeypoints[(size_t)cpt] = keypoints;
-    listOfDescriptors[(size_t)cpt] = descriptors;
+    listOfKeypoints[cpt] = keypoints;
+    listOfDescriptors[cpt] = descriptors;
+  };
+
+  if (m_parallelPipeline) {
+    parallelFor(listOfAffineParams.size(), getParallelPipelineNbThreads(), processAffineView);
+  }
+  else {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int cpt = 0; cpt < static_cast<int>(listOfAffineParams.size()); cpt++) {
+      processAffineView(static_cast<size_t>(cpt));
+    }
   }
 #endif
 }
 
+unsigned int vpKeyPoint::getParallelPipelineNbThreads() const
+{
+  if (!m_parallelPipeline) {
+    return 1;
+  }
+
+  if (m_parallelPipelineNbThreads > 0) {
+    return m_parallelPipelineNbThreads;
+  }
+
+  // Size of the OpenCV thread pool used by parallelFor()
+  int nbThreads = cv::getNumThreads();
+  return nbThreads > 1 ? static_cast<unsigned int>(nbThreads) : 1;
+}
+
 void vpKeyPoint::reset()
 {
   // vpBasicKeyPoint class
@@ -3596,6 +4222,10 @@ void vpKeyPoint::reset()
   m_mapOfImages.clear();
   m_matcher = cv::Ptr<cv::DescriptorMatcher>();
   m_matcherName = "BruteForce-Hamming";
+  m_indexMaxChecks = 512;
+  m_indexNbTrees = 4;
+  m_indexLeafMaxSize = 64;
+  m_indexBranching = 16;
   m_matches.clear();
   m_matchingFactorThreshold = 2.0;
   m_matchingRatioThreshold = 0.85;
@@ -3604,6 +4234,8 @@ void vpKeyPoint::reset()
   m_nbRansacIterations = 200;
   m_nbRansacMinInlierCount = 100;
   m_objectFilteredPoints.clear();
+  m_parallelPipeline = false;
+  m_parallelPipelineNbThreads = 0;
   m_poseTime = 0.0;
   m_queryDescriptors = cv::Mat();
   m_queryFilteredKeyPoints.clear();
@@ -3636,8 +4268,11 @@ void vpKeyPoint::reset()
   init();
 }
 
-void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode, bool saveTrainingImages)
+void vpKeyPoint::saveLearningDatabase(const std::string &filename, bool saveTrainingImages)
 {
+#if defined(VISP_BIG_ENDIAN)
+  throw vpException(vpException::fatalError, "vpKeyPoint::saveLearningDatabase() needs a little endian platform");
+#endif
   std::string parent = vpIoTools::getParent(filename);
   if (!parent.empty()) {
     vpIoTools::makeDirectory(parent);
@@ -3645,51 +4280,185 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
 
   std::map<int, std::string> mapOfImgPath;
   if (saveTrainingImages) {
-#ifdef VISP_HAVE_MODULE_IO
-    // Save the training image files in the same directory
-    unsigned int cpt = 0;
+    writeTrainingImages(parent, mapOfImgPath);
+  }
 
-    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
-         ++it, cpt++) {
-      if (cpt > 999) {
-        throw vpException(vpException::fatalError, "The number of training images to save is too big !");
-      }
+  bool have3DInfo = m_trainPoints.size() > 0;
+  if (have3DInfo && m_trainPoints.size() != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and list of 3D points have different size !");
+  }
+  if (static_cast<size_t>(m_trainDescriptors.rows) != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and train descriptors have different size !");
+  }
+  if (m_trainDescriptors.type() != CV_8U && m_trainDescriptors.type() != CV_32F) {
+    throw vpException(vpException::badValue, "The learning database only supports CV_8U or CV_32F descriptors");
+  }
 
-      std::stringstream ss;
-      ss << "train_image_" << std::setfill('0') << std::setw(3) << cpt;
+  std::ofstream file(filename.c_str(), std::ofstream::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot create the file.");
+  }
 
-      switch (m_imageFormat) {
-      case jpgImageFormat:
-        ss << ".jpg";
-        break;
+  LearningDatabaseHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, learningDatabaseMagic, sizeof(header.magic));
+  header.version = learningDatabaseVersion;
+  header.headerSize = sizeof(header);
+  header.nbKeyPoints = static_cast<int32_t>(m_trainKeyPoints.size());
+  header.descriptorCols = m_trainDescriptors.cols;
+  header.descriptorType = m_trainDescriptors.type();
+  header.have3DInfo = have3DInfo ? 1 : 0;
 
-      case pngImageFormat:
-        ss << ".png";
-        break;
+  // The header is written again at the end, when all the offsets are known
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  padLearningDatabase(file);
 
-      case ppmImageFormat:
-        ss << ".ppm";
-        break;
+  // Write info about training images
+  header.imagesOffset = static_cast<uint64_t>(file.tellp());
+  header.nbImages = static_cast<int32_t>(mapOfImgPath.size());
+  for (std::map<int, std::string>::const_iterator it = mapOfImgPath.begin(); it != mapOfImgPath.end(); ++it) {
+    int32_t id = it->first;
+    int32_t length = static_cast<int32_t>(it->second.length());
+    file.write(reinterpret_cast<const char *>(&id), sizeof(id));
+    file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    file.write(it->second.c_str(), length);
+  }
+  padLearningDatabase(file);
 
-      case pgmImageFormat:
-        ss << ".pgm";
-        break;
+  // Write the correspondence keypoint class_id with the training image_id
+  header.imageIdsOffset = static_cast<uint64_t>(file.tellp());
+  if (saveTrainingImages) {
+    std::vector<int32_t> imageIds;
+    for (std::map<int, int>::const_iterator it = m_mapOfImageId.begin(); it != m_mapOfImageId.end(); ++it) {
+      imageIds.push_back(it->first);
+      imageIds.push_back(it->second);
+    }
+    header.nbImageIds = static_cast<int32_t>(m_mapOfImageId.size());
+    file.write(reinterpret_cast<const char *>(imageIds.data()),
+               static_cast<std::streamsize>(imageIds.size() * sizeof(int32_t)));
+  }
+  padLearningDatabase(file);
+
+  // Write keypoints
+  header.keyPointsOffset = static_cast<uint64_t>(file.tellp());
+  std::vector<LearningDatabaseKeyPoint> keyPoints(m_trainKeyPoints.size());
+  for (size_t i = 0; i < m_trainKeyPoints.size(); i++) {
+    const cv::KeyPoint &kpt = m_trainKeyPoints[i];
+    LearningDatabaseKeyPoint record = { kpt.pt.x, kpt.pt.y, kpt.size, kpt.angle, kpt.response, kpt.octave,
+                                       kpt.class_id };
+    keyPoints[i] = record;
+  }
+  file.write(reinterpret_cast<const char *>(keyPoints.data()),
+             static_cast<std::streamsize>(keyPoints.size() * sizeof(LearningDatabaseKeyPoint)));
+  padLearningDatabase(file);
+
+  // Write 3D points
+  header.pointsOffset = static_cast<uint64_t>(file.tellp());
+  if (have3DInfo) {
+    file.write(reinterpret_cast<const char *>(m_trainPoints.data()),
+               static_cast<std::streamsize>(m_trainPoints.size() * sizeof(cv::Point3f)));
+  }
+  padLearningDatabase(file);
+
+  // Write descriptors as contiguous rows
+  header.descriptorsOffset = static_cast<uint64_t>(file.tellp());
+  std::streamsize descriptorRowSize =
+    static_cast<std::streamsize>(m_trainDescriptors.cols * m_trainDescriptors.elemSize());
+  for (int i = 0; i < m_trainDescriptors.rows; i++) {
+    file.write(m_trainDescriptors.ptr<char>(i), descriptorRowSize);
+  }
+  padLearningDatabase(file);
+
+  // Search trees of the IndexBased matcher, if they were built on the saved descriptors
+  header.indexOffset = static_cast<uint64_t>(file.tellp());
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  DescriptorIndexMatcher *indexMatcher = dynamic_cast<DescriptorIndexMatcher *>(m_matcher.get());
+  if (indexMatcher != nullptr && m_trainDescriptors.rows > 0) {
+    std::shared_ptr<vpDescriptorIndex> index = indexMatcher->getIndex();
+    bool sameDescriptors = index && index->size() == static_cast<unsigned int>(m_trainDescriptors.rows) &&
+      index->getDescriptorSize() == static_cast<unsigned int>(m_trainDescriptors.cols);
+    const size_t rowSize = static_cast<size_t>(descriptorRowSize);
+    for (int i = 0; i < m_trainDescriptors.rows && sameDescriptors; i++) {
+      const unsigned char *indexed = static_cast<const unsigned char *>(index->getDescriptors()) + i * rowSize;
+      sameDescriptors = std::memcmp(m_trainDescriptors.ptr(i), indexed, rowSize) == 0;
+    }
+    if (sameDescriptors) {
+      index->saveTrees(file);
+    }
+  }
+#endif
+  header.indexSize = static_cast<uint64_t>(file.tellp()) - header.indexOffset;
+  header.fileSize = static_cast<uint64_t>(file.tellp());
 
-      default:
-        ss << ".png";
-        break;
-      }
+  file.seekp(0);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (!file.good()) {
+    throw vpException(vpException::ioError, "Cannot write the learning database: %s", filename.c_str());
+  }
+  file.close();
+}
+
+void vpKeyPoint::writeTrainingImages(const std::string &parent, std::map<int, std::string> &mapOfImgPath) const
+{
+#ifdef VISP_HAVE_MODULE_IO
+  // Save the training image files in the same directory
+  unsigned int cpt = 0;
+
+  for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
+       ++it, cpt++) {
+    if (cpt > 999) {
+      throw vpException(vpException::fatalError, "The number of training images to save is too big !");
+    }
+
+    std::stringstream ss;
+    ss << "train_image_" << std::setfill('0') << std::setw(3) << cpt;
+
+    switch (m_imageFormat) {
+    case jpgImageFormat:
+      ss << ".jpg";
+      break;
+
+    case pngImageFormat:
+      ss << ".png";
+      break;
+
+    case ppmImageFormat:
+      ss << ".ppm";
+      break;
+
+    case pgmImageFormat:
+      ss << ".pgm";
+      break;
 
-      std::string imgFilename = ss.str();
-      mapOfImgPath[it->first] = imgFilename;
-      vpImageIo::write(it->second, parent + (!parent.empty() ? "/" : "") + imgFilename);
+    default:
+      ss << ".png";
+      break;
     }
+
+    std::string imgFilename = ss.str();
+    mapOfImgPath[it->first] = imgFilename;
+    vpImageIo::write(it->second, parent + (!parent.empty() ? "/" : "") + imgFilename);
+  }
 #else
-    std::cout << "Warning: in vpKeyPoint::saveLearningData() training images "
-      "are not saved because "
-      "visp_io module is not available !"
-      << std::endl;
+  (void)parent;
+  (void)mapOfImgPath;
+  std::cout << "Warning: in vpKeyPoint::saveLearningData() training images "
+    "are not saved because "
+    "visp_io module is not available !"
+    << std::endl;
 #endif
+}
+
+void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode, bool saveTrainingImages)
+{
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    vpIoTools::makeDirectory(parent);
+  }
+
+  std::map<int, std::string> mapOfImgPath;
+  if (saveTrainingImages) {
+    writeTrainingImages(parent, mapOfImgPath);
   }
 
   bool have3DInfo = m_trainPoints.size() > 0;
@@ -4213,6 +4982,229 @@ void vpKeyPoint::PyramidAdaptedFeatureDetector::detectImpl(const cv::Mat &image,
   if (!mask.empty())
     vpKeyPoint::KeyPointsFilter::runByPixelsMask(keypoints, mask);
 }
+
+vpKeyPoint::DescriptorIndexMatcher::DescriptorIndexMatcher(unsigned int maxChecks, unsigned int nbTrees,
+                                                           unsigned int leafMaxSize, unsigned int branching)
+  : m_index(), m_startIndexes(), m_modified(false), m_maxChecks(maxChecks), m_nbTrees(nbTrees),
+  m_leafMaxSize(leafMaxSize), m_branching(branching)
+{ }
+
+void vpKeyPoint::DescriptorIndexMatcher::add(cv::InputArrayOfArrays descriptors)
+{
+  cv::DescriptorMatcher::add(descriptors);
+  m_modified = true;
+}
+
+void vpKeyPoint::DescriptorIndexMatcher::clear()
+{
+  // The index is kept: if the same descriptors are added again, followed by new ones,
+  // only the new ones are inserted by train()
+  cv::DescriptorMatcher::clear();
+  m_modified = true;
+}
+
+cv::Ptr<cv::DescriptorMatcher> vpKeyPoint::DescriptorIndexMatcher::clone(bool emptyTrainData) const
+{
+  cv::Ptr<DescriptorIndexMatcher> matcher =
+    cv::makePtr<DescriptorIndexMatcher>(m_maxChecks, m_nbTrees, m_leafMaxSize, m_branching);
+  if (!emptyTrainData) {
+    for (size_t i = 0; i < trainDescCollection.size(); i++) {
+      matcher->trainDescCollection.push_back(trainDescCollection[i].clone());
+    }
+    if (m_index) {
+      matcher->m_index = std::make_shared<vpDescriptorIndex>(*m_index);
+    }
+    matcher->m_startIndexes = m_startIndexes;
+    matcher->m_modified = m_modified;
+  }
+  return matcher;
+}
+
+std::shared_ptr<vpDescriptorIndex> vpKeyPoint::DescriptorIndexMatcher::getIndex()
+{
+  train();
+  return m_index;
+}
+
+bool vpKeyPoint::DescriptorIndexMatcher::isMaskSupported() const { return false; }
+
+bool vpKeyPoint::DescriptorIndexMatcher::setIndex(const std::shared_ptr<vpDescriptorIndex> &index)
+{
+  // The index must have been built with the current parameters on all the train descriptors
+  if (!index || index->getNbTrees() != m_nbTrees || index->getLeafMaxSize() != m_leafMaxSize ||
+      index->getBranching() != m_branching) {
+    return false;
+  }
+  const int type = index->getType() == vpDescriptorIndex::HAMMING_CLUSTERING_TREE ? CV_8U : CV_32F;
+  std::vector<unsigned int> startIndexes;
+  unsigned int row = 0;
+  for (size_t i = 0; i < trainDescCollection.size(); i++) {
+    if (trainDescCollection[i].type() != type ||
+        static_cast<unsigned int>(trainDescCollection[i].cols) != index->getDescriptorSize()) {
+      return false;
+    }
+    startIndexes.push_back(row);
+    row += static_cast<unsigned int>(trainDescCollection[i].rows);
+  }
+  if (row != index->size()) {
+    return false;
+  }
+
+  m_index = index;
+  m_index->setMaxChecks(m_maxChecks);
+  m_startIndexes = startIndexes;
+  m_modified = false;
+  return true;
+}
+
+void vpKeyPoint::DescriptorIndexMatcher::setParameters(unsigned int maxChecks, unsigned int nbTrees,
+                                                       unsigned int leafMaxSize, unsigned int branching)
+{
+  if (nbTrees != m_nbTrees || leafMaxSize != m_leafMaxSize || branching != m_branching) {
+    // The trees must be built again
+    m_index.reset();
+    m_modified = true;
+  }
+  else if (m_index) {
+    m_index->setMaxChecks(maxChecks);
+  }
+  m_maxChecks = maxChecks;
+  m_nbTrees = nbTrees;
+  m_leafMaxSize = leafMaxSize;
+  m_branching = branching;
+}
+
+void vpKeyPoint::DescriptorIndexMatcher::train()
+{
+  // Called before each match, nothing is modified when the train descriptors did not change
+  // so that concurrent matching is possible
+  if (!m_modified) {
+    return;
+  }
+  m_modified = false;
+
+  if (trainDescCollection.empty()) {
+    m_index.reset();
+    m_startIndexes.clear();
+    return;
+  }
+
+  const int type = trainDescCollection[0].type();
+  const int cols = trainDescCollection[0].cols;
+  if (type != CV_8U && type != CV_32F) {
+    throw vpException(vpException::badValue, "The IndexBased matcher needs CV_8U or CV_32F descriptors");
+  }
+  unsigned int nbDescriptors = 0;
+  for (size_t i = 0; i < trainDescCollection.size(); i++) {
+    if (trainDescCollection[i].type() != type || trainDescCollection[i].cols != cols) {
+      throw vpException(vpException::badValue, "All the train descriptors must have the same type and size");
+    }
+    nbDescriptors += static_cast<unsigned int>(trainDescCollection[i].rows);
+  }
+
+  vpDescriptorIndex::vpDescriptorIndexType indexType =
+    type == CV_8U ? vpDescriptorIndex::HAMMING_CLUSTERING_TREE : vpDescriptorIndex::L2_KD_FOREST;
+  bool rebuild = !m_index || m_index->getType() != indexType ||
+    m_index->getDescriptorSize() != static_cast<unsigned int>(cols) || m_index->size() > nbDescriptors;
+
+  // The train descriptors are usually the previous ones followed by new ones (see
+  // vpKeyPoint::buildReference() with append), in that case only the new ones are inserted.
+  // This comparison is only done once after the train descriptors are modified.
+  if (!rebuild) {
+    const size_t rowSize = static_cast<size_t>(cols) * trainDescCollection[0].elemSize();
+    const unsigned char *indexed = static_cast<const unsigned char *>(m_index->getDescriptors());
+    unsigned int row = 0;
+    for (size_t i = 0; i < trainDescCollection.size() && row < m_index->size() && !rebuild; i++) {
+      for (int j = 0; j < trainDescCollection[i].rows && row < m_index->size(); j++, row++) {
+        if (std::memcmp(trainDescCollection[i].ptr(j), indexed + row * rowSize, rowSize) != 0) {
+          rebuild = true;
+          break;
+        }
+      }
+    }
+  }
+
+  if (rebuild) {
+    m_index = std::make_shared<vpDescriptorIndex>(indexType, static_cast<unsigned int>(cols));
+    m_index->setNbTrees(m_nbTrees);
+    m_index->setLeafMaxSize(m_leafMaxSize);
+    m_index->setBranching(m_branching);
+  }
+  m_index->setMaxChecks(m_maxChecks);
+
+  m_startIndexes.clear();
+  unsigned int row = 0;
+  for (size_t i = 0; i < trainDescCollection.size(); i++) {
+    const cv::Mat &descriptors = trainDescCollection[i];
+    m_startIndexes.push_back(row);
+    if (row + static_cast<unsigned int>(descriptors.rows) > m_index->size()) {
+      cv::Mat newDescriptors = descriptors.rowRange(static_cast<int>(m_index->size() - row), descriptors.rows);
+      if (!newDescriptors.isContinuous()) {
+        newDescriptors = newDescriptors.clone();
+      }
+      if (type == CV_8U) {
+        m_index->add(newDescriptors.ptr<unsigned char>(), static_cast<unsigned int>(newDescriptors.rows));
+      }
+      else {
+        m_index->add(newDescriptors.ptr<float>(), static_cast<unsigned int>(newDescriptors.rows));
+      }
+    }
+    row += static_cast<unsigned int>(descriptors.rows);
+  }
+}
+
+void vpKeyPoint::DescriptorIndexMatcher::knnMatchImpl(cv::InputArray queryDescriptors,
+                                                      std::vector<std::vector<cv::DMatch> > &matches, int k,
+                                                      cv::InputArrayOfArrays, bool)
+{
+  cv::Mat query = queryDescriptors.getMat();
+  matches.clear();
+  if (!m_index || query.empty()) {
+    return;
+  }
+  if (static_cast<unsigned int>(query.cols) != m_index->getDescriptorSize() ||
+      query.type() != (m_index->getType() == vpDescriptorIndex::HAMMING_CLUSTERING_TREE ? CV_8U : CV_32F)) {
+    throw vpException(vpException::badValue, "Query and train descriptors must have the same type and size");
+  }
+
+  matches.resize(static_cast<size_t>(query.rows));
+  std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+  for (int i = 0; i < query.rows; i++) {
+    if (query.type() == CV_8U) {
+      m_index->knnSearch(query.ptr<unsigned char>(i), static_cast<unsigned int>(k), neighbors);
+    }
+    else {
+      m_index->knnSearch(query.ptr<float>(i), static_cast<unsigned int>(k), neighbors);
+    }
+
+    matches[i].reserve(neighbors.size());
+    for (size_t j = 0; j < neighbors.size(); j++) {
+      // Convert the index of the descriptor into the image index and the row in this image
+      size_t imgIdx = static_cast<size_t>(std::upper_bound(m_startIndexes.begin(), m_startIndexes.end(),
+                                                           neighbors[j].index) - m_startIndexes.begin()) - 1;
+      matches[i].push_back(cv::DMatch(i, static_cast<int>(neighbors[j].index - m_startIndexes[imgIdx]),
+                                      static_cast<int>(imgIdx), neighbors[j].distance));
+    }
+  }
+}
+
+void vpKeyPoint::DescriptorIndexMatcher::radiusMatchImpl(cv::InputArray queryDescriptors,
+                                                         std::vector<std::vector<cv::DMatch> > &matches,
+                                                         float maxDistance, cv::InputArrayOfArrays masks,
+                                                         bool compactResult)
+{
+  // The neighbors are searched within the budget of descriptor comparisons of the index,
+  // at most maxChecks neighbors are returned
+  knnMatchImpl(queryDescriptors, matches, static_cast<int>(m_index ? m_index->getMaxChecks() : 1), masks,
+               compactResult);
+  for (size_t i = 0; i < matches.size(); i++) {
+    size_t nb = 0;
+    while (nb < matches[i].size() && matches[i][nb].distance <= maxDistance) {
+      nb++;
+    }
+    matches[i].resize(nb);
+  }
+}
 #endif
 #endif
 
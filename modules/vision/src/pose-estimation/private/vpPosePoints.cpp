@@ -0,0 +1,85 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Contiguous storage of the points used for pose computation.
+ */
+
+#include "vpPosePoints.h"
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+double vpPosePoints::computeResidual(const vpHomogeneousMatrix &cMo) const
+{
+  const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], tx = cMo[0][3];
+  const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], ty = cMo[1][3];
+  const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], tz = cMo[2][3];
+  const double *oX = m_oX.data(), *oY = m_oY.data(), *oZ = m_oZ.data(), *oW = m_oW.data();
+  const double *xm = m_x.data(), *ym = m_y.data();
+  const size_t n = m_x.size();
+
+  double squared_error = 0;
+  for (size_t i = 0; i < n; i++) {
+    double d = 1 / oW[i];
+    double X = (r00 * oX[i] + r01 * oY[i] + r02 * oZ[i] + tx * oW[i]) * d;
+    double Y = (r10 * oX[i] + r11 * oY[i] + r12 * oZ[i] + ty * oW[i]) * d;
+    double Z = (r20 * oX[i] + r21 * oY[i] + r22 * oZ[i] + tz * oW[i]) * d;
+    double invZ = 1 / Z;
+    double ex = xm[i] - X * invZ;
+    double ey = ym[i] - Y * invZ;
+    squared_error += ex * ex + ey * ey;
+  }
+  return squared_error;
+}
+
+void vpPosePoints::project(const vpHomogeneousMatrix &cMo, double *x, double *y, double *Z) const
+{
+  const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], tx = cMo[0][3];
+  const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], ty = cMo[1][3];
+  const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], tz = cMo[2][3];
+  const double *oX = m_oX.data(), *oY = m_oY.data(), *oZ = m_oZ.data(), *oW = m_oW.data();
+  const size_t n = m_x.size();
+
+  for (size_t i = 0; i < n; i++) {
+    double d = 1 / oW[i];
+    double cX = (r00 * oX[i] + r01 * oY[i] + r02 * oZ[i] + tx * oW[i]) * d;
+    double cY = (r10 * oX[i] + r11 * oY[i] + r12 * oZ[i] + ty * oW[i]) * d;
+    double cZ = (r20 * oX[i] + r21 * oY[i] + r22 * oZ[i] + tz * oW[i]) * d;
+    double invZ = 1 / cZ;
+    x[i] = cX * invZ;
+    y[i] = cY * invZ;
+  }
+  if (Z != nullptr) {
+    for (size_t i = 0; i < n; i++) {
+      Z[i] = (r20 * oX[i] + r21 * oY[i] + r22 * oZ[i] + tz * oW[i]) * (1 / oW[i]);
+    }
+  }
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
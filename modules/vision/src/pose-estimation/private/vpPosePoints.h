@@ -0,0 +1,97 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Contiguous storage of the points used for pose computation.
+ */
+
+#ifndef vpPosePoints_h
+#define vpPosePoints_h
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+ * Structure of arrays copy of a set of vpPoint: object frame coordinates and
+ * measured normalized coordinates are stored in separate contiguous arrays.
+ *
+ * Projecting all the points for a given pose is then a loop over plain arrays,
+ * without any vpPoint copy or memory allocation, that the compiler vectorizes.
+ * The computations are the same as vpPoint::track().
+ */
+class vpPosePoints
+{
+public:
+  template <typename Iterator> vpPosePoints(Iterator first, Iterator last)
+  {
+    for (Iterator it = first; it != last; ++it) {
+      m_oX.push_back(it->get_oX());
+      m_oY.push_back(it->get_oY());
+      m_oZ.push_back(it->get_oZ());
+      m_oW.push_back(it->get_oW());
+      m_x.push_back(it->get_x());
+      m_y.push_back(it->get_y());
+    }
+  }
+
+  /*!
+   * Sum of the squared distances between the measured normalized coordinates and the
+   * projection of the points with \e cMo.
+   */
+  double computeResidual(const vpHomogeneousMatrix &cMo) const;
+
+  //! Measured normalized x coordinates.
+  const double *get_x() const { return m_x.data(); }
+  //! Measured normalized y coordinates.
+  const double *get_y() const { return m_y.data(); }
+
+  /*!
+   * Project all the points with \e cMo.
+   *
+   * \param cMo : Pose of the object frame in the camera frame.
+   * \param x, y : Normalized coordinates of the projected points, size() elements.
+   * \param Z : If not null, depth of the points in the camera frame, size() elements.
+   */
+  void project(const vpHomogeneousMatrix &cMo, double *x, double *y, double *Z = nullptr) const;
+
+  //! Number of points.
+  unsigned int size() const { return static_cast<unsigned int>(m_x.size()); }
+
+private:
+  std::vector<double> m_oX, m_oY, m_oZ, m_oW;
+  std::vector<double> m_x, m_y;
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif
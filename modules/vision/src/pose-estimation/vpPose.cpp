@@ -46,8 +46,12 @@
 #include <visp3/vision/vpPose.h>
 #include <visp3/vision/vpPoseException.h>
 
+#include <algorithm>
 #include <cmath>  // std::fabs
 #include <limits> // numeric_limits
+#include <thread>
+
+#include "private/vpPosePoints.h"
 
 #define DEBUG_LEVEL1 0
 
@@ -284,18 +288,8 @@ bool vpPose::coplanar(int &coplanar_plane_type, double *p_a, double *p_b, double
 
 double vpPose::computeResidual(const vpHomogeneousMatrix &cMo) const
 {
-  double squared_error = 0;
-  vpPoint P;
-  for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it) {
-    P = *it;
-    double x = P.get_x();
-    double y = P.get_y();
-
-    P.track(cMo);
-
-    squared_error += vpMath::sqr(x - P.get_x()) + vpMath::sqr(y - P.get_y());
-  }
-  return (squared_error);
+  vpPosePoints points(listP.begin(), listP.end());
+  return points.computeResidual(cMo);
 }
 
 double vpPose::computeResidual(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam) const
@@ -307,24 +301,20 @@ double vpPose::computeResidual(const vpHomogeneousMatrix &cMo, const vpCameraPar
 double vpPose::computeResidual(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, vpColVector &residuals) const
 {
   double squared_error = 0;
-  residuals.resize(static_cast<unsigned int>(listP.size()));
-  vpPoint P;
-  unsigned int i = 0;
-  for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it) {
-    P = *it;
-    double x = P.get_x();
-    double y = P.get_y();
-
+  vpPosePoints points(listP.begin(), listP.end());
+  const unsigned int nb = points.size();
+  residuals.resize(nb);
+  std::vector<double> x(nb), y(nb);
+  points.project(cMo, x.data(), y.data());
+  for (unsigned int i = 0; i < nb; i++) {
     double u_initial = 0., v_initial = 0.;
-    vpMeterPixelConversion::convertPoint(cam, x, y, u_initial, v_initial);
-
-    P.track(cMo);
+    vpMeterPixelConversion::convertPoint(cam, points.get_x()[i], points.get_y()[i], u_initial, v_initial);
 
     double u_moved = 0., v_moved = 0.;
-    vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), u_moved, v_moved);
+    vpMeterPixelConversion::convertPoint(cam, x[i], y[i], u_moved, v_moved);
 
     double squaredResidual = vpMath::sqr(u_moved - u_initial) + vpMath::sqr(v_moved - v_initial);
-    residuals[i++] = squaredResidual;
+    residuals[i] = squaredResidual;
     squared_error += squaredResidual;
   }
   return (squared_error);
@@ -434,6 +424,52 @@ bool vpPose::computePose(vpPoseMethodType method, vpHomogeneousMatrix &cMo, bool
   return true;
 }
 
+std::vector<bool> vpPose::computePoses(vpPoseMethodType method, const std::vector<std::vector<vpPoint> > &points,
+                                       std::vector<vpHomogeneousMatrix> &cMo, unsigned int nbThreads) const
+{
+  const size_t nbProblems = points.size();
+  cMo.resize(nbProblems);
+  // std::vector<bool> cannot be written concurrently
+  std::vector<unsigned char> success(nbProblems, 0);
+
+  std::atomic<size_t> next(0);
+  auto solve = [&]() {
+    vpPose pose(*this);
+    for (size_t i = next++; i < nbProblems; i = next++) {
+      if (points[i].size() < 4) {
+        continue;
+      }
+      pose.clearPoint();
+      pose.addPoints(points[i]);
+      try {
+        success[i] = pose.computePose(method, cMo[i]) ? 1 : 0;
+      }
+      catch (...) {
+        success[i] = 0;
+      }
+    }
+  };
+
+  if (nbThreads == 0) {
+    nbThreads = std::max<unsigned int>(1, std::thread::hardware_concurrency());
+  }
+  nbThreads = static_cast<unsigned int>(std::min<size_t>(nbThreads, nbProblems));
+  if (nbThreads <= 1) {
+    solve();
+  }
+  else {
+    std::vector<std::thread> threadpool;
+    for (unsigned int i = 0; i < nbThreads; i++) {
+      threadpool.emplace_back(solve);
+    }
+    for (auto &th : threadpool) {
+      th.join();
+    }
+  }
+
+  return std::vector<bool>(success.begin(), success.end());
+}
+
 bool vpPose::computePoseDementhonLagrangeVVS(vpHomogeneousMatrix &cMo)
 {
   vpHomogeneousMatrix cMo_dementhon, cMo_lagrange;
@@ -51,6 +51,8 @@
 
 #include <thread>
 
+#include "private/vpPosePoints.h"
+
 #define eps 1e-6
 
 namespace
@@ -136,7 +138,10 @@ bool vpPose::vpRansacFunctor::poseRansacImpl()
   unsigned int nbMinRandom = 4;
   int nbTrials = 0;
 
-  vpPoint p; // Point used to project using the estimated pose
+  // Points stored in contiguous arrays, projected with the estimated pose for the consensus test
+  vpPosePoints points(m_listOfUniquePoints.begin(), m_listOfUniquePoints.end());
+  std::vector<double> xp(size), yp(size);
+  const double *xm = points.get_x(), *ym = points.get_y();
 
   bool foundSolution = false;
   while (nbTrials < m_ransacMaxTrials && m_nbInliers < m_ransacNbInlierConsensus) {
@@ -234,12 +239,10 @@ bool vpPose::vpRansacFunctor::poseRansacImpl()
       if (isPoseValid && r < m_ransacThreshold) {
         unsigned int nbInliersCur = 0;
         unsigned int iter = 0;
+        points.project(m_cMo, xp.data(), yp.data());
         for (std::vector<vpPoint>::const_iterator it = m_listOfUniquePoints.begin(); it != m_listOfUniquePoints.end();
              ++it, iter++) {
-          p.setWorldCoordinates(it->get_oX(), it->get_oY(), it->get_oZ());
-          p.track(m_cMo);
-
-          double error = sqrt(vpMath::sqr(p.get_x() - it->get_x()) + vpMath::sqr(p.get_y() - it->get_y()));
+          double error = sqrt(vpMath::sqr(xp[iter] - xm[iter]) + vpMath::sqr(yp[iter] - ym[iter]));
           if (error < m_ransacThreshold) {
             bool degenerate = false;
             if (m_checkDegeneratePoints) {
@@ -42,6 +42,8 @@
 #include <visp3/core/vpRobust.h>
 #include <visp3/vision/vpPose.h>
 
+#include "private/vpPosePoints.h"
+
 void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
 {
   try {
@@ -53,23 +55,19 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
 
     int iter = 0;
 
-    unsigned int nb = (unsigned int)listP.size();
+    // Points stored in contiguous arrays, projected at each iteration without any copy
+    vpPosePoints points(listP.begin(), listP.end());
+    unsigned int nb = points.size();
     vpMatrix L(2 * nb, 6);
     vpColVector err(2 * nb);
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
-
-    vpPoint P;
-    std::list<vpPoint> lP;
+    std::vector<double> xp(nb), yp(nb), Zp(nb);
 
     // create sd
-    unsigned int k = 0;
-    for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it) {
-      P = *it;
-      sd[2 * k] = P.get_x();
-      sd[2 * k + 1] = P.get_y();
-      lP.push_back(P);
-      k++;
+    for (unsigned int k = 0; k < nb; k++) {
+      sd[2 * k] = points.get_x()[k];
+      sd[2 * k + 1] = points.get_y()[k];
     }
 
     vpHomogeneousMatrix cMoPrev = cMo;
@@ -79,18 +77,16 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
     while (std::fabs(residu_1 - r) > vvsEpsilon) {
       residu_1 = r;
 
+      // forward projection of the 3D model for a given pose
+      // change frame coordinates
+      // perspective projection
+      points.project(cMo, xp.data(), yp.data(), Zp.data());
+
       // Compute the interaction matrix and the error
-      k = 0;
-      for (std::list<vpPoint>::const_iterator it = lP.begin(); it != lP.end(); ++it) {
-        P = *it;
-        // forward projection of the 3D model for a given pose
-        // change frame coordinates
-        // perspective projection
-        P.track(cMo);
-
-        double x = s[2 * k] = P.get_x(); /* point projected from cMo */
-        double y = s[2 * k + 1] = P.get_y();
-        double Z = P.get_Z();
+      for (unsigned int k = 0; k < nb; k++) {
+        double x = s[2 * k] = xp[k]; /* point projected from cMo */
+        double y = s[2 * k + 1] = yp[k];
+        double Z = Zp[k];
         L[2 * k][0] = -1 / Z;
         L[2 * k][1] = 0;
         L[2 * k][2] = x / Z;
@@ -104,8 +100,6 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
         L[2 * k + 1][3] = 1 + y * y;
         L[2 * k + 1][4] = -x * y;
         L[2 * k + 1][5] = -x;
-
-        k += 1;
       }
       err = s - sd;
 
@@ -153,23 +147,18 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
     robust.setMinMedianAbsoluteDeviation(0.00001);
     vpColVector w, res;
 
-    unsigned int nb = (unsigned int)listP.size();
+    vpPosePoints points(listP.begin(), listP.end());
+    unsigned int nb = points.size();
     vpMatrix L(2 * nb, 6);
     vpColVector error(2 * nb);
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
-
-    vpPoint P;
-    std::list<vpPoint> lP;
+    std::vector<double> xp(nb), yp(nb), Zp(nb);
 
     // create sd
-    unsigned int k_ = 0;
-    for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it) {
-      P = *it;
-      sd[2 * k_] = P.get_x();
-      sd[2 * k_ + 1] = P.get_y();
-      lP.push_back(P);
-      k_++;
+    for (unsigned int k_ = 0; k_ < nb; k_++) {
+      sd[2 * k_] = points.get_x()[k_];
+      sd[2 * k_ + 1] = points.get_y()[k_];
     }
     int iter = 0;
     res.resize(s.getRows() / 2);
@@ -181,18 +170,16 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
     while (std::fabs((residu_1 - r) * 1e12) > std::numeric_limits<double>::epsilon()) {
       residu_1 = r;
 
+      // forward projection of the 3D model for a given pose
+      // change frame coordinates
+      // perspective projection
+      points.project(cMo, xp.data(), yp.data(), Zp.data());
+
       // Compute the interaction matrix and the error
-      k_ = 0;
-      for (std::list<vpPoint>::const_iterator it = lP.begin(); it != lP.end(); ++it) {
-        P = *it;
-        // forward projection of the 3D model for a given pose
-        // change frame coordinates
-        // perspective projection
-        P.track(cMo);
-
-        double x = s[2 * k_] = P.get_x(); // point projected from cMo
-        double y = s[2 * k_ + 1] = P.get_y();
-        double Z = P.get_Z();
+      for (unsigned int k_ = 0; k_ < nb; k_++) {
+        double x = s[2 * k_] = xp[k_]; // point projected from cMo
+        double y = s[2 * k_ + 1] = yp[k_];
+        double Z = Zp[k_];
         L[2 * k_][0] = -1 / Z;
         L[2 * k_][1] = 0;
         L[2 * k_][2] = x / Z;
@@ -206,8 +193,6 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
         L[2 * k_ + 1][3] = 1 + y * y;
         L[2 * k_ + 1][4] = -x * y;
         L[2 * k_ + 1][5] = -x;
-
-        k_++;
       }
       error = s - sd;
 
@@ -31,8 +31,11 @@
  * Test saving / loading learning files for vpKeyPoint class.
  */
 
+#include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 
 #include <visp3/core/vpConfig.h>
 
@@ -374,6 +377,125 @@ template <typename Type> void run_test(const std::string &env_ipath, const std::
                                                  "binary without train images !");
     }
 
+    // Save in memory mappable learning database with training images
+    filename = vpIoTools::createFilePath(opath, "db_with_img");
+    vpIoTools::makeDirectory(filename);
+    filename = vpIoTools::createFilePath(filename, "test_save_in_db_with_img.db");
+    keyPoints.saveLearningDatabase(filename, true);
+
+    // Test if save is ok
+    if (!vpIoTools::checkFilename(filename)) {
+      std::stringstream ss;
+      ss << "Problem when saving file=" << filename;
+      throw vpException(vpException::ioError, ss.str().c_str());
+    }
+
+    // Test if read is ok
+    vpKeyPoint read_keypoint_db;
+    read_keypoint_db.loadLearningDatabase(filename);
+    trainKeyPoints_read.clear();
+    read_keypoint_db.getTrainKeyPoints(trainKeyPoints_read);
+    trainDescriptors_read = read_keypoint_db.getTrainDescriptors();
+
+    if (!compareKeyPoints(trainKeyPoints, trainKeyPoints_read)) {
+      throw vpException(vpException::fatalError, "Problem with trainKeyPoints when reading learning database !");
+    }
+
+    if (!compareDescriptors(trainDescriptors, trainDescriptors_read)) {
+      throw vpException(vpException::fatalError, "Problem with trainDescriptors when reading learning database !");
+    }
+
+    if (read_keypoint_db.getNbImages() != keyPoints.getNbImages()) {
+      throw vpException(vpException::fatalError, "Problem with training images when reading learning database !");
+    }
+
+    // The train descriptors refer to the memory mapped database and must stay valid after the
+    // vpKeyPoint is destroyed
+    {
+      cv::Mat trainDescriptors_outlive;
+      {
+        vpKeyPoint keypoint_db;
+        keypoint_db.loadLearningDatabase(filename);
+        trainDescriptors_outlive = keypoint_db.getTrainDescriptors();
+      }
+      if (!compareDescriptors(trainDescriptors, trainDescriptors_outlive)) {
+        throw vpException(vpException::fatalError,
+                          "Problem with trainDescriptors after the destruction of the learning database !");
+      }
+    }
+
+    // A database with a misaligned section must be rejected
+    {
+      std::ifstream file_in(filename.c_str(), std::ifstream::binary);
+      std::vector<char> buffer((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+      file_in.close();
+      const size_t keyPointsOffsetPos = 56; // see LearningDatabaseHeader
+      uint64_t keyPointsOffset = 0;
+      std::memcpy(&keyPointsOffset, &buffer[keyPointsOffsetPos], sizeof(keyPointsOffset));
+      keyPointsOffset += 4;
+      std::memcpy(&buffer[keyPointsOffsetPos], &keyPointsOffset, sizeof(keyPointsOffset));
+
+      std::string filename_corrupted = vpIoTools::createFilePath(opath, "db_corrupted.db");
+      std::ofstream file_out(filename_corrupted.c_str(), std::ofstream::binary);
+      file_out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      file_out.close();
+
+      bool rejected = false;
+      try {
+        vpKeyPoint keypoint_db;
+        keypoint_db.loadLearningDatabase(filename_corrupted);
+      }
+      catch (const vpException &) {
+        rejected = true;
+      }
+      if (!rejected) {
+        throw vpException(vpException::fatalError, "A corrupted learning database has been loaded !");
+      }
+    }
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+    // The search trees of the IndexBased matcher are stored in the database and restored on
+    // loading, matching with them must give the same result as with the original trees
+    {
+      vpKeyPoint keypoint_index;
+      keypoint_index.setDetector(keypointName);
+      keypoint_index.setExtractor(keypointName);
+      keypoint_index.setMatcher("IndexBased");
+      keypoint_index.buildReference(I);
+
+      std::string filename_index = vpIoTools::createFilePath(opath, "db_index.db");
+      keypoint_index.saveLearningDatabase(filename_index, false);
+
+      std::ifstream file_in(filename_index.c_str(), std::ifstream::binary);
+      std::vector<char> buffer((std::istreambuf_iterator<char>(file_in)), std::istreambuf_iterator<char>());
+      file_in.close();
+      const size_t indexSizePos = 88; // see LearningDatabaseHeader
+      uint64_t indexSize = 0;
+      std::memcpy(&indexSize, &buffer[indexSizePos], sizeof(indexSize));
+      if (indexSize == 0) {
+        throw vpException(vpException::fatalError, "The IndexBased matcher trees are not saved in the database !");
+      }
+
+      vpKeyPoint keypoint_index_read;
+      keypoint_index_read.setDetector(keypointName);
+      keypoint_index_read.setExtractor(keypointName);
+      keypoint_index_read.setMatcher("IndexBased");
+      keypoint_index_read.loadLearningDatabase(filename_index);
+
+      keypoint_index.matchPoint(I);
+      keypoint_index_read.matchPoint(I);
+      std::vector<cv::DMatch> matches = keypoint_index.getMatches();
+      std::vector<cv::DMatch> matches_read = keypoint_index_read.getMatches();
+      bool same = matches.size() == matches_read.size();
+      for (size_t i = 0; i < matches.size() && same; i++) {
+        same = matches[i].queryIdx == matches_read[i].queryIdx && matches[i].trainIdx == matches_read[i].trainIdx;
+      }
+      if (!same) {
+        throw vpException(vpException::fatalError, "Problem with the IndexBased trees read from the database !");
+      }
+    }
+#endif
+
 #if defined(VISP_HAVE_PUGYXML)
     // Save in xml with training images
     filename = vpIoTools::createFilePath(opath, "xml_with_img");
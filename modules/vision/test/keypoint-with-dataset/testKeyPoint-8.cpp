@@ -0,0 +1,285 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test keypoint matching with the IndexBased matcher.
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_FEATURES2D) &&                 \
+    (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpParseArgv.h>
+#include <visp3/vision/vpKeyPoint.h>
+
+// List of allowed command line options
+#define GETOPTARGS "cdh"
+
+void usage(const char *name, const char *badparam);
+bool getOptions(int argc, const char **argv);
+
+/*!
+
+  Print the program options.
+
+  \param name : Program name.
+  \param badparam : Bad parameter name.
+
+*/
+void usage(const char *name, const char *badparam)
+{
+  fprintf(stdout, "\n\
+          Test keypoints matching with the IndexBased matcher against the BruteForce-Hamming matcher.\n\
+          \n\
+          SYNOPSIS\n\
+          %s [-c] [-d] [-h]\n",
+          name);
+
+  fprintf(stdout, "\n\
+              OPTIONS:                                               \n\
+              \n\
+              -c\n\
+              Disable the mouse click. Not used, for compatibility with the other tests.\n\
+              \n\
+              -d \n\
+              Turn off the display. Not used, for compatibility with the other tests.\n\
+              \n\
+              -h\n\
+              Print the help.\n");
+
+  if (badparam)
+    fprintf(stdout, "\nERROR: Bad parameter [%s]\n", badparam);
+}
+
+/*!
+
+  Set the program options.
+
+  \param argc : Command line number of parameters.
+  \param argv : Array of command line parameters.
+  \return false if the program has to be stopped, true otherwise.
+
+*/
+bool getOptions(int argc, const char **argv)
+{
+  const char *optarg_;
+  int c;
+  while ((c = vpParseArgv::parse(argc, argv, GETOPTARGS, &optarg_)) > 1) {
+
+    switch (c) {
+    case 'c':
+    case 'd':
+      break;
+    case 'h':
+      usage(argv[0], nullptr);
+      return false;
+      break;
+
+    default:
+      usage(argv[0], optarg_);
+      return false;
+      break;
+    }
+  }
+
+  if ((c == 1) || (c == -1)) {
+    // standalone param or error
+    usage(argv[0], nullptr);
+    std::cerr << "ERROR: " << std::endl;
+    std::cerr << "  Bad argument " << optarg_ << std::endl << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+// Ratio of the matches found by the brute force matcher that are also found with the index
+double compareMatches(const std::vector<cv::DMatch> &matches, const std::vector<cv::DMatch> &matches_ref)
+{
+  if (matches_ref.empty()) {
+    return 1.0;
+  }
+
+  unsigned int nbCommon = 0;
+  for (size_t i = 0; i < matches_ref.size(); i++) {
+    for (size_t j = 0; j < matches.size(); j++) {
+      if (matches[j].queryIdx == matches_ref[i].queryIdx && matches[j].trainIdx == matches_ref[i].trainIdx) {
+        nbCommon++;
+        break;
+      }
+    }
+  }
+  return static_cast<double>(nbCommon) / matches_ref.size();
+}
+
+void checkMatching(vpKeyPoint &keypoints_bf, vpKeyPoint &keypoints_index, const vpImage<unsigned char> &I,
+                   const std::string &name)
+{
+  unsigned int nbMatches_bf = keypoints_bf.matchPoint(I);
+  unsigned int nbMatches_index = keypoints_index.matchPoint(I);
+  double ratio = compareMatches(keypoints_index.getMatches(), keypoints_bf.getMatches());
+  std::cout << name << ": " << nbMatches_index << " matches with IndexBased, " << nbMatches_bf
+            << " with BruteForce-Hamming, " << 100.0 * ratio << "% in common" << std::endl;
+
+  if (ratio < 0.9 || nbMatches_index < 0.9 * nbMatches_bf) {
+    throw vpException(vpException::fatalError, "IndexBased matching differs too much from brute force: %s",
+                      name.c_str());
+  }
+}
+
+int main(int argc, const char **argv)
+{
+  try {
+    if (getOptions(argc, argv) == false) {
+      return EXIT_FAILURE;
+    }
+
+    std::string env_ipath = vpIoTools::getViSPImagesDataPath();
+    if (env_ipath.empty()) {
+      std::cerr << "Please set the VISP_INPUT_IMAGE_PATH environment "
+        "variable value."
+        << std::endl;
+      return EXIT_FAILURE;
+    }
+
+#if VISP_HAVE_DATASET_VERSION >= 0x030600
+    std::string ext("png");
+#else
+    std::string ext("pgm");
+#endif
+    std::string dirname = vpIoTools::createFilePath(env_ipath, "mbt/cube");
+    std::vector<vpImage<unsigned char> > images(4);
+    for (size_t i = 0; i < images.size(); i++) {
+      char filename[FILENAME_MAX];
+      snprintf(filename, FILENAME_MAX, ("image%04d." + ext).c_str(), static_cast<int>(10 * i));
+      vpImageIo::read(images[i], vpIoTools::createFilePath(dirname, filename));
+    }
+
+    // kNN matching with the ratio test (default filtering method)
+    vpKeyPoint keypoints_bf("ORB", "ORB", "BruteForce-Hamming");
+    vpKeyPoint keypoints_index("ORB", "ORB", "IndexBased");
+    keypoints_index.setIndexBasedMatcherParameters(2048);
+    keypoints_bf.buildReference(images[0]);
+    keypoints_index.buildReference(images[0]);
+
+    for (size_t i = 1; i < images.size(); i++) {
+      std::stringstream ss;
+      ss << "image " << 10 * i;
+      checkMatching(keypoints_bf, keypoints_index, images[i], ss.str());
+    }
+
+    // Incremental insertion of the keypoints of a second training image
+    std::vector<cv::KeyPoint> trainKeyPoints;
+    cv::Mat trainDescriptors;
+    keypoints_bf.detect(images[1], trainKeyPoints);
+    keypoints_bf.extract(images[1], trainKeyPoints, trainDescriptors);
+    std::vector<cv::Point3f> points3f;
+    keypoints_bf.buildReference(images[1], trainKeyPoints, trainDescriptors, points3f, true, 1);
+    keypoints_index.buildReference(images[1], trainKeyPoints, trainDescriptors, points3f, true, 1);
+    for (size_t i = 2; i < images.size(); i++) {
+      std::stringstream ss;
+      ss << "image " << 10 * i << " after append";
+      checkMatching(keypoints_bf, keypoints_index, images[i], ss.str());
+    }
+
+    // Several train images in the matcher: the image index and the row in this image must be consistent
+    std::vector<cv::Mat> listOfTrainDescriptors;
+    for (size_t i = 0; i < 3; i++) {
+      std::vector<cv::KeyPoint> kpts;
+      cv::Mat descriptors;
+      keypoints_bf.detect(images[i], kpts);
+      keypoints_bf.extract(images[i], kpts, descriptors);
+      listOfTrainDescriptors.push_back(descriptors);
+    }
+    std::vector<cv::KeyPoint> queryKeyPoints;
+    cv::Mat queryDescriptors;
+    keypoints_bf.detect(images[3], queryKeyPoints);
+    keypoints_bf.extract(images[3], queryKeyPoints, queryDescriptors);
+
+    cv::Ptr<cv::DescriptorMatcher> matcher_index = keypoints_index.getMatcher()->clone(true);
+    cv::Ptr<cv::DescriptorMatcher> matcher_bf = keypoints_bf.getMatcher()->clone(true);
+    matcher_index->add(listOfTrainDescriptors);
+    matcher_bf->add(listOfTrainDescriptors);
+    std::vector<std::vector<cv::DMatch> > knnMatches_index, knnMatches_bf;
+    matcher_index->knnMatch(queryDescriptors, knnMatches_index, 2);
+    matcher_bf->knnMatch(queryDescriptors, knnMatches_bf, 2);
+    if (knnMatches_index.size() != knnMatches_bf.size()) {
+      throw vpException(vpException::fatalError, "Wrong number of kNN matches with IndexBased");
+    }
+
+    unsigned int nbSame = 0;
+    for (size_t i = 0; i < knnMatches_index.size(); i++) {
+      for (size_t j = 0; j < knnMatches_index[i].size(); j++) {
+        const cv::DMatch &m = knnMatches_index[i][j];
+        if (m.imgIdx < 0 || m.imgIdx >= static_cast<int>(listOfTrainDescriptors.size()) || m.trainIdx < 0 ||
+            m.trainIdx >= listOfTrainDescriptors[m.imgIdx].rows) {
+          throw vpException(vpException::fatalError, "Invalid image or train index with IndexBased");
+        }
+        double dist =
+          cv::norm(queryDescriptors.row(m.queryIdx), listOfTrainDescriptors[m.imgIdx].row(m.trainIdx), cv::NORM_HAMMING);
+        if (dist != m.distance) {
+          throw vpException(vpException::fatalError, "Inconsistent distance with IndexBased");
+        }
+      }
+      if (!knnMatches_index[i].empty() && !knnMatches_bf[i].empty() &&
+          knnMatches_index[i][0].distance == knnMatches_bf[i][0].distance) {
+        nbSame++;
+      }
+    }
+    std::cout << "Multiple train images: " << 100.0 * nbSame / knnMatches_bf.size()
+              << "% of nearest neighbors found" << std::endl;
+    if (nbSame < 0.9 * knnMatches_bf.size()) {
+      throw vpException(vpException::fatalError, "IndexBased nearest neighbors differ too much from brute force");
+    }
+  }
+  catch (const vpException &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "testKeyPoint-8 is ok !" << std::endl;
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cerr << "You need OpenCV library." << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+#endif
@@ -31,7 +31,9 @@
  * Test keypoint matching.
  */
 
+#include <cstdio>
 #include <iostream>
+#include <sstream>
 
 #include <visp3/core/vpConfig.h>
 
@@ -135,6 +137,80 @@ bool getOptions(int argc, const char **argv, bool &click_allowed, bool &display)
   return true;
 }
 
+void check_same_keypoints(const std::vector<cv::KeyPoint> &keypoints, const std::vector<cv::KeyPoint> &keypoints_ref,
+                          const cv::Mat &descriptors, const cv::Mat &descriptors_ref, const std::string &name)
+{
+  bool same = keypoints.size() == keypoints_ref.size() && descriptors.size() == descriptors_ref.size() &&
+    descriptors.type() == descriptors_ref.type();
+  for (size_t i = 0; same && i < keypoints.size(); i++) {
+    same = keypoints[i].pt == keypoints_ref[i].pt && keypoints[i].size == keypoints_ref[i].size &&
+      keypoints[i].angle == keypoints_ref[i].angle && keypoints[i].response == keypoints_ref[i].response &&
+      keypoints[i].octave == keypoints_ref[i].octave && keypoints[i].class_id == keypoints_ref[i].class_id;
+  }
+  if (same && !descriptors.empty()) {
+    same = cv::norm(descriptors, descriptors_ref, cv::NORM_L1) == 0.0;
+  }
+  if (!same) {
+    throw vpException(vpException::fatalError, "Different keypoints or descriptors with the parallel pipeline: %s",
+                      name.c_str());
+  }
+}
+
+// The multithreaded pipeline must give the same keypoints and descriptors than the sequential one
+void check_parallel_pipeline(const std::string &dirname, const std::string &ext)
+{
+  std::vector<vpImage<unsigned char> > listOfImages(3);
+  for (size_t i = 0; i < listOfImages.size(); i++) {
+    char filename[FILENAME_MAX];
+    snprintf(filename, FILENAME_MAX, ("image%04d." + ext).c_str(), static_cast<int>(10 * i));
+    vpImageIo::read(listOfImages[i], vpIoTools::createFilePath(dirname, filename));
+  }
+
+  // Reference built from multiple images
+  vpKeyPoint keypoints("ORB", "ORB", "BruteForce-Hamming");
+  vpKeyPoint keypoints_parallel("ORB", "ORB", "BruteForce-Hamming");
+  keypoints_parallel.setParallelPipeline(true);
+  keypoints_parallel.setParallelPipelineNbThreads(4);
+  keypoints.buildReference(listOfImages);
+  keypoints_parallel.buildReference(listOfImages);
+
+  std::vector<cv::KeyPoint> trainKeyPoints, trainKeyPoints_parallel;
+  keypoints.getTrainKeyPoints(trainKeyPoints);
+  keypoints_parallel.getTrainKeyPoints(trainKeyPoints_parallel);
+  check_same_keypoints(trainKeyPoints_parallel, trainKeyPoints, keypoints_parallel.getTrainDescriptors(),
+                       keypoints.getTrainDescriptors(), "buildReference() from multiple images");
+
+  // The multiple images reference is the concatenation of the detection and extraction in each image
+  std::vector<cv::KeyPoint> trainKeyPoints_seq;
+  cv::Mat trainDescriptors_seq;
+  for (size_t i = 0; i < listOfImages.size(); i++) {
+    std::vector<cv::KeyPoint> kpts;
+    cv::Mat descriptors;
+    keypoints.detect(listOfImages[i], kpts);
+    keypoints.extract(listOfImages[i], kpts, descriptors);
+    for (size_t j = 0; j < kpts.size(); j++) {
+      kpts[j].class_id = static_cast<int>(i);
+    }
+    trainKeyPoints_seq.insert(trainKeyPoints_seq.end(), kpts.begin(), kpts.end());
+    trainDescriptors_seq.push_back(descriptors);
+  }
+  check_same_keypoints(trainKeyPoints_parallel, trainKeyPoints_seq, keypoints_parallel.getTrainDescriptors(),
+                       trainDescriptors_seq, "buildReference() from multiple images vs detect() and extract()");
+
+  // Affine simulated views
+  std::vector<std::vector<cv::KeyPoint> > listOfKeypoints, listOfKeypoints_parallel;
+  std::vector<cv::Mat> listOfDescriptors, listOfDescriptors_parallel;
+  keypoints.detectExtractAffine(listOfImages[0], listOfKeypoints, listOfDescriptors);
+  keypoints_parallel.detectExtractAffine(listOfImages[0], listOfKeypoints_parallel, listOfDescriptors_parallel);
+  if (listOfKeypoints.size() != listOfKeypoints_parallel.size()) {
+    throw vpException(vpException::fatalError, "Different number of affine views with the parallel pipeline");
+  }
+  for (size_t i = 0; i < listOfKeypoints.size(); i++) {
+    check_same_keypoints(listOfKeypoints_parallel[i], listOfKeypoints[i], listOfDescriptors_parallel[i],
+                         listOfDescriptors[i], "detectExtractAffine()");
+  }
+}
+
 template <typename Type>
 void run_test(const std::string &env_ipath, bool opt_click_allowed, bool opt_display, vpImage<Type> &Iref,
               vpImage<Type> &Icur, vpImage<Type> &Imatch)
@@ -152,10 +228,18 @@ void run_test(const std::string &env_ipath, bool opt_click_allowed, bool opt_dis
   vpImageIo::read(Iref, filenameRef);
   std::string filenameCur = vpIoTools::createFilePath(dirname, "image%04d." + ext);
 
+  check_parallel_pipeline(dirname, ext);
+
   // Init keypoints
   vpKeyPoint keypoints("ORB", "ORB", "BruteForce-Hamming");
   std::cout << "Build " << keypoints.buildReference(Iref) << " reference points." << std::endl;
 
+  // Same pipeline in multithreaded mode, must give the same matches
+  vpKeyPoint keypoints_parallel("ORB", "ORB", "BruteForce-Hamming");
+  keypoints_parallel.setParallelPipeline(true);
+  keypoints_parallel.setParallelPipelineNbThreads(4);
+  keypoints_parallel.buildReference(Iref);
+
   vpVideoReader g;
   g.setFileName(filenameCur);
   g.open(Icur);
@@ -190,7 +274,14 @@ void run_test(const std::string &env_ipath, bool opt_click_allowed, bool opt_dis
     }
 
     // Match keypoints
-    keypoints.matchPoint(Icur);
+    unsigned int nbMatches = keypoints.matchPoint(Icur);
+    unsigned int nbMatchesParallel = keypoints_parallel.matchPoint(Icur);
+    if (nbMatches != nbMatchesParallel) {
+      std::stringstream ss;
+      ss << "Different number of matches with the parallel pipeline: " << nbMatchesParallel << " instead of "
+         << nbMatches;
+      throw vpException(vpException::fatalError, ss.str());
+    }
     // Display image with keypoints matched
     keypoints.displayMatching(Iref, Imatch);
 
@@ -0,0 +1,486 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark approximate nearest neighbor search of keypoint descriptors.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdint.h>
+#include <type_traits>
+#include <visp3/core/vpTime.h>
+#include <visp3/vision/vpDescriptorIndex.h>
+
+#if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_FEATURES2D)
+#include <opencv2/features2d/features2d.hpp>
+#endif
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_nbTrain = 10000;
+int g_nbQuery = 500;
+
+// Descriptors grouped around random centers, as descriptors of a textured scene seen from several viewpoints
+std::vector<unsigned char> generateBinaryDescriptors(unsigned int nb, unsigned int size, std::mt19937 &rng)
+{
+  const unsigned int nbClusters = 256, nbFlips = 12;
+  std::uniform_int_distribution<int> byteDist(0, 255);
+  std::vector<unsigned char> centers(nbClusters * size);
+  for (size_t i = 0; i < centers.size(); i++) {
+    centers[i] = static_cast<unsigned char>(byteDist(rng));
+  }
+
+  std::vector<unsigned char> descriptors(static_cast<size_t>(nb) * size);
+  std::uniform_int_distribution<unsigned int> clusterDist(0, nbClusters - 1), bitDist(0, 8 * size - 1);
+  for (unsigned int i = 0; i < nb; i++) {
+    unsigned int c = clusterDist(rng);
+    std::copy(&centers[c * size], &centers[c * size] + size, &descriptors[i * size]);
+    for (unsigned int j = 0; j < nbFlips; j++) {
+      unsigned int bit = bitDist(rng);
+      descriptors[i * size + bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+    }
+  }
+  return descriptors;
+}
+
+std::vector<float> generateFloatDescriptors(unsigned int nb, unsigned int size, std::mt19937 &rng)
+{
+  const unsigned int nbClusters = 256;
+  std::uniform_real_distribution<float> centerDist(0.f, 1.f);
+  std::normal_distribution<float> noiseDist(0.f, 0.05f);
+  std::vector<float> centers(nbClusters * size);
+  for (size_t i = 0; i < centers.size(); i++) {
+    centers[i] = centerDist(rng);
+  }
+
+  std::vector<float> descriptors(static_cast<size_t>(nb) * size);
+  std::uniform_int_distribution<unsigned int> clusterDist(0, nbClusters - 1);
+  for (unsigned int i = 0; i < nb; i++) {
+    unsigned int c = clusterDist(rng);
+    for (unsigned int j = 0; j < size; j++) {
+      descriptors[i * size + j] = centers[c * size + j] + noiseDist(rng);
+    }
+  }
+  return descriptors;
+}
+
+// Query descriptors are noisy observations of train descriptors, as when matching the same keypoints in a new image
+std::vector<unsigned char> generateBinaryQueries(const std::vector<unsigned char> &train, unsigned int nb,
+                                                 unsigned int size, std::mt19937 &rng)
+{
+  const unsigned int nbFlips = 4;
+  std::uniform_int_distribution<size_t> trainDist(0, train.size() / size - 1);
+  std::uniform_int_distribution<unsigned int> bitDist(0, 8 * size - 1);
+  std::vector<unsigned char> queries(static_cast<size_t>(nb) * size);
+  for (unsigned int i = 0; i < nb; i++) {
+    size_t t = trainDist(rng);
+    std::copy(&train[t * size], &train[t * size] + size, &queries[i * size]);
+    for (unsigned int j = 0; j < nbFlips; j++) {
+      unsigned int bit = bitDist(rng);
+      queries[i * size + bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+    }
+  }
+  return queries;
+}
+
+std::vector<float> generateFloatQueries(const std::vector<float> &train, unsigned int nb, unsigned int size,
+                                        std::mt19937 &rng)
+{
+  std::uniform_int_distribution<size_t> trainDist(0, train.size() / size - 1);
+  std::normal_distribution<float> noiseDist(0.f, 0.01f);
+  std::vector<float> queries(static_cast<size_t>(nb) * size);
+  for (unsigned int i = 0; i < nb; i++) {
+    size_t t = trainDist(rng);
+    for (unsigned int j = 0; j < size; j++) {
+      queries[i * size + j] = train[t * size + j] + noiseDist(rng);
+    }
+  }
+  return queries;
+}
+
+float distance(const unsigned char *a, const unsigned char *b, unsigned int size)
+{
+  size_t dist = 0;
+  unsigned int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t va, vb;
+    std::memcpy(&va, a + i, sizeof(va));
+    std::memcpy(&vb, b + i, sizeof(vb));
+    dist += std::bitset<64>(va ^ vb).count();
+  }
+  for (; i < size; i++) {
+    dist += std::bitset<8>(a[i] ^ b[i]).count();
+  }
+  return static_cast<float>(dist);
+}
+
+float distance(const float *a, const float *b, unsigned int size)
+{
+  float dist = 0.f;
+  for (unsigned int i = 0; i < size; i++) {
+    dist += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return std::sqrt(dist);
+}
+
+// Exact nearest neighbor distance by linear scan
+template <typename Type>
+float bruteForceSearch(const std::vector<Type> &train, const Type *query, unsigned int size)
+{
+  float best = std::numeric_limits<float>::max();
+  for (size_t i = 0; i < train.size() / size; i++) {
+    best = std::min(best, distance(&train[i * size], query, size));
+  }
+  return best;
+}
+
+// Ratio of queries for which the index finds a neighbor as close as the exact nearest neighbor
+template <typename Type>
+double computeRecall(const vpDescriptorIndex &index, const std::vector<Type> &train, const std::vector<Type> &query,
+                     unsigned int size)
+{
+  std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+  unsigned int nbFound = 0, nbQuery = static_cast<unsigned int>(query.size() / size);
+  for (unsigned int i = 0; i < nbQuery; i++) {
+    index.knnSearch(&query[i * size], 2, neighbors);
+    if (!neighbors.empty() && neighbors[0].distance <= bruteForceSearch(train, &query[i * size], size) + 1e-4f) {
+      nbFound++;
+    }
+  }
+  return static_cast<double>(nbFound) / nbQuery;
+}
+
+#if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_FEATURES2D)
+// Reference brute force matching: OpenCV vectorized BFMatcher with the Hamming or L2 norm
+template <typename Type> int getMatType() { return std::is_same<Type, float>::value ? CV_32F : CV_8U; }
+
+template <typename Type>
+cv::Ptr<cv::DescriptorMatcher> createBFMatcher(const std::vector<Type> &train, unsigned int size)
+{
+  int normType = std::is_same<Type, float>::value ? cv::NORM_L2 : cv::NORM_HAMMING;
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  cv::Ptr<cv::DescriptorMatcher> matcher = cv::makePtr<cv::BFMatcher>(normType);
+#else
+  cv::Ptr<cv::DescriptorMatcher> matcher = new cv::BFMatcher(normType);
+#endif
+  cv::Mat trainMat(static_cast<int>(train.size() / size), static_cast<int>(size), getMatType<Type>(),
+                   const_cast<Type *>(train.data()));
+  matcher->add(std::vector<cv::Mat>(1, trainMat.clone()));
+  matcher->train();
+  return matcher;
+}
+
+template <typename Type>
+std::vector<std::vector<cv::DMatch> > bfMatch(const cv::Ptr<cv::DescriptorMatcher> &matcher,
+                                              const std::vector<Type> &query, unsigned int size)
+{
+  cv::Mat queryMat(static_cast<int>(query.size() / size), static_cast<int>(size), getMatType<Type>(),
+                   const_cast<Type *>(query.data()));
+  std::vector<std::vector<cv::DMatch> > matches;
+  matcher->knnMatch(queryMat, matches, 2);
+  return matches;
+}
+#endif
+
+template <typename Type>
+void printThroughput(const std::string &name, const vpDescriptorIndex &index, const std::vector<Type> &train,
+                     const std::vector<Type> &query, unsigned int size)
+{
+  unsigned int nbQuery = static_cast<unsigned int>(query.size() / size);
+  std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+  double t = vpTime::measureTimeMs();
+  for (unsigned int i = 0; i < nbQuery; i++) {
+    index.knnSearch(&query[i * size], 2, neighbors);
+  }
+  double tIndex = vpTime::measureTimeMs() - t;
+
+  std::cout << name << " (" << index.size() << " train descriptors, maxChecks=" << index.getMaxChecks()
+            << "): recall=" << computeRecall(index, train, query, size) << " index=" << (1000.0 * nbQuery / tIndex)
+            << " queries/s";
+
+#if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_FEATURES2D)
+  cv::Ptr<cv::DescriptorMatcher> matcher = createBFMatcher(train, size);
+  t = vpTime::measureTimeMs();
+  std::vector<std::vector<cv::DMatch> > matches = bfMatch(matcher, query, size);
+  double tBruteForce = vpTime::measureTimeMs() - t;
+  std::cout << " cv::BFMatcher=" << (1000.0 * nbQuery / tBruteForce) << " queries/s (" << matches.size() << ")"
+            << std::endl;
+#else
+  // Without OpenCV, compare with a linear scan
+  t = vpTime::measureTimeMs();
+  float sum = 0.f;
+  for (unsigned int i = 0; i < nbQuery; i++) {
+    sum += bruteForceSearch(train, &query[i * size], size);
+  }
+  double tBruteForce = vpTime::measureTimeMs() - t;
+  std::cout << " linear scan=" << (1000.0 * nbQuery / tBruteForce) << " queries/s (" << sum << ")" << std::endl;
+#endif
+}
+} // namespace
+
+TEST_CASE("Hamming clustering tree", "[benchmark]")
+{
+  const unsigned int size = 32; // ORB descriptor
+  std::mt19937 rng(1);
+  std::vector<unsigned char> train = generateBinaryDescriptors(static_cast<unsigned int>(g_nbTrain), size, rng);
+  std::vector<unsigned char> query = generateBinaryQueries(train, static_cast<unsigned int>(g_nbQuery), size, rng);
+
+  vpDescriptorIndex index(vpDescriptorIndex::HAMMING_CLUSTERING_TREE, size);
+  index.add(train.data(), static_cast<unsigned int>(g_nbTrain));
+  REQUIRE(index.size() == static_cast<unsigned int>(g_nbTrain));
+
+  SECTION("Recall")
+  {
+    CHECK(computeRecall(index, train, query, size) > 0.8);
+    index.setMaxChecks(8 * index.getMaxChecks());
+    CHECK(computeRecall(index, train, query, size) > 0.9);
+  }
+
+  SECTION("Incremental insertion")
+  {
+    std::vector<unsigned char> extra = generateBinaryDescriptors(static_cast<unsigned int>(g_nbTrain) / 4, size, rng);
+    index.add(extra.data(), static_cast<unsigned int>(extra.size() / size));
+    train.insert(train.end(), extra.begin(), extra.end());
+    CHECK(computeRecall(index, train, query, size) > 0.8);
+
+    // A query identical to a train descriptor must find it
+    std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+    index.knnSearch(&extra[0], 1, neighbors);
+    REQUIRE(neighbors.size() == 1);
+    CHECK(neighbors[0].distance == 0.f);
+  }
+
+  SECTION("Save and load trees")
+  {
+    std::ostringstream oss;
+    index.saveTrees(oss);
+    std::string buffer = oss.str();
+    vpDescriptorIndex index_loaded(vpDescriptorIndex::HAMMING_CLUSTERING_TREE, size);
+    index_loaded.loadTrees(train.data(), index.size(), buffer.data(), buffer.size());
+    REQUIRE(index_loaded.size() == index.size());
+
+    std::vector<vpDescriptorIndex::vpNeighbor> neighbors, neighbors_loaded;
+    for (int i = 0; i < g_nbQuery; i++) {
+      index.knnSearch(&query[i * size], 2, neighbors);
+      index_loaded.knnSearch(&query[i * size], 2, neighbors_loaded);
+      REQUIRE(neighbors.size() == neighbors_loaded.size());
+      for (size_t j = 0; j < neighbors.size(); j++) {
+        CHECK(neighbors[j].index == neighbors_loaded[j].index);
+      }
+    }
+
+    // Truncated data must be rejected
+    vpDescriptorIndex index_truncated(vpDescriptorIndex::HAMMING_CLUSTERING_TREE, size);
+    CHECK_THROWS(index_truncated.loadTrees(train.data(), index.size(), buffer.data(), buffer.size() / 2));
+  }
+
+  if (g_runBenchmark) {
+    SECTION("Benchmark")
+    {
+      std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+      BENCHMARK("Hamming clustering tree - knnSearch")
+      {
+        for (int i = 0; i < g_nbQuery; i++) {
+          index.knnSearch(&query[i * size], 2, neighbors);
+        }
+        return neighbors;
+      };
+
+#if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_FEATURES2D)
+      cv::Ptr<cv::DescriptorMatcher> matcher = createBFMatcher(train, size);
+      BENCHMARK("Brute force - cv::BFMatcher Hamming")
+      {
+        return bfMatch(matcher, query, size);
+      };
+#else
+      BENCHMARK("Brute force - linear scan Hamming")
+      {
+        float sum = 0.f;
+        for (int i = 0; i < g_nbQuery; i++) {
+          sum += bruteForceSearch(train, &query[i * size], size);
+        }
+        return sum;
+      };
+#endif
+
+      BENCHMARK("Hamming clustering tree - build")
+      {
+        vpDescriptorIndex index_build(vpDescriptorIndex::HAMMING_CLUSTERING_TREE, size);
+        index_build.add(train.data(), static_cast<unsigned int>(train.size() / size));
+        return index_build.size();
+      };
+
+      printThroughput("Hamming clustering tree", index, train, query, size);
+    }
+  }
+}
+
+TEST_CASE("L2 kd-forest", "[benchmark]")
+{
+  const unsigned int size = 128; // SIFT descriptor
+  std::mt19937 rng(2);
+  std::vector<float> train = generateFloatDescriptors(static_cast<unsigned int>(g_nbTrain), size, rng);
+  std::vector<float> query = generateFloatQueries(train, static_cast<unsigned int>(g_nbQuery), size, rng);
+
+  vpDescriptorIndex index(vpDescriptorIndex::L2_KD_FOREST, size);
+  index.add(train.data(), static_cast<unsigned int>(g_nbTrain));
+  REQUIRE(index.size() == static_cast<unsigned int>(g_nbTrain));
+
+  SECTION("Recall")
+  {
+    CHECK(computeRecall(index, train, query, size) > 0.8);
+    index.setMaxChecks(8 * index.getMaxChecks());
+    CHECK(computeRecall(index, train, query, size) > 0.9);
+  }
+
+  SECTION("Incremental insertion")
+  {
+    std::vector<float> extra = generateFloatDescriptors(static_cast<unsigned int>(g_nbTrain) / 4, size, rng);
+    index.add(extra.data(), static_cast<unsigned int>(extra.size() / size));
+    train.insert(train.end(), extra.begin(), extra.end());
+    CHECK(computeRecall(index, train, query, size) > 0.8);
+
+    std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+    index.knnSearch(&extra[0], 1, neighbors);
+    REQUIRE(neighbors.size() == 1);
+    CHECK(neighbors[0].distance == 0.f);
+  }
+
+  SECTION("Save and load trees")
+  {
+    std::ostringstream oss;
+    index.saveTrees(oss);
+    std::string buffer = oss.str();
+    vpDescriptorIndex index_loaded(vpDescriptorIndex::L2_KD_FOREST, size);
+    index_loaded.loadTrees(train.data(), index.size(), buffer.data(), buffer.size());
+    REQUIRE(index_loaded.size() == index.size());
+
+    std::vector<vpDescriptorIndex::vpNeighbor> neighbors, neighbors_loaded;
+    for (int i = 0; i < g_nbQuery; i++) {
+      index.knnSearch(&query[i * size], 2, neighbors);
+      index_loaded.knnSearch(&query[i * size], 2, neighbors_loaded);
+      REQUIRE(neighbors.size() == neighbors_loaded.size());
+      for (size_t j = 0; j < neighbors.size(); j++) {
+        CHECK(neighbors[j].index == neighbors_loaded[j].index);
+      }
+    }
+
+    // Truncated data must be rejected
+    vpDescriptorIndex index_truncated(vpDescriptorIndex::L2_KD_FOREST, size);
+    CHECK_THROWS(index_truncated.loadTrees(train.data(), index.size(), buffer.data(), buffer.size() / 2));
+  }
+
+  if (g_runBenchmark) {
+    SECTION("Benchmark")
+    {
+      std::vector<vpDescriptorIndex::vpNeighbor> neighbors;
+      BENCHMARK("L2 kd-forest - knnSearch")
+      {
+        for (int i = 0; i < g_nbQuery; i++) {
+          index.knnSearch(&query[i * size], 2, neighbors);
+        }
+        return neighbors;
+      };
+
+#if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_FEATURES2D)
+      cv::Ptr<cv::DescriptorMatcher> matcher = createBFMatcher(train, size);
+      BENCHMARK("Brute force - cv::BFMatcher L2")
+      {
+        return bfMatch(matcher, query, size);
+      };
+#else
+      BENCHMARK("Brute force - linear scan L2")
+      {
+        float sum = 0.f;
+        for (int i = 0; i < g_nbQuery; i++) {
+          sum += bruteForceSearch(train, &query[i * size], size);
+        }
+        return sum;
+      };
+#endif
+
+      BENCHMARK("L2 kd-forest - build")
+      {
+        vpDescriptorIndex index_build(vpDescriptorIndex::L2_KD_FOREST, size);
+        index_build.add(train.data(), static_cast<unsigned int>(train.size() / size));
+        return index_build.size();
+      };
+
+      printThroughput("L2 kd-forest", index, train, query, size);
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_nbTrain, "nbTrain")["--nbTrain"]("Number of train descriptors")
+             | Opt(g_nbQuery, "nbQuery")["--nbQuery"]("Number of query descriptors");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
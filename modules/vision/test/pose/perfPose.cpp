@@ -0,0 +1,253 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2023 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Benchmark pose residual, virtual visual servoing and RANSAC on many points.
+ *
+*****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpPose.h>
+
+namespace
+{
+bool g_runBenchmark = false;
+int g_nbPoints = 5000;
+
+// Points in a box in front of the camera, with noisy projections and a ratio of outliers
+std::vector<vpPoint> generatePoints(const vpHomogeneousMatrix &cMo, unsigned int nb, double outlierRatio)
+{
+  vpUniRand rand(42);
+  vpGaussRand noise(0.0005, 0, 42);
+  std::vector<vpPoint> points;
+  for (unsigned int i = 0; i < nb; i++) {
+    vpPoint P(rand.uniform(-0.5, 0.5), rand.uniform(-0.5, 0.5), rand.uniform(-0.2, 0.2));
+    P.track(cMo);
+    if (rand.uniform(0.0, 1.0) < outlierRatio) {
+      P.set_x(rand.uniform(-0.5, 0.5));
+      P.set_y(rand.uniform(-0.5, 0.5));
+    }
+    else {
+      P.set_x(P.get_x() + noise());
+      P.set_y(P.get_y() + noise());
+    }
+    points.push_back(P);
+  }
+  return points;
+}
+
+// Reference residual computed point by point with vpPoint::track()
+double computeResidualReference(const std::vector<vpPoint> &points, const vpHomogeneousMatrix &cMo)
+{
+  double squared_error = 0;
+  for (size_t i = 0; i < points.size(); i++) {
+    vpPoint P = points[i];
+    P.track(cMo);
+    squared_error += vpMath::sqr(points[i].get_x() - P.get_x()) + vpMath::sqr(points[i].get_y() - P.get_y());
+  }
+  return squared_error;
+}
+} // namespace
+
+TEST_CASE("Pose from many points", "[benchmark]")
+{
+  const vpHomogeneousMatrix cMo_ref(0.05, -0.02, 1.5, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(20));
+  const vpHomogeneousMatrix cMo_init(0.07, -0.05, 1.45, vpMath::rad(12), vpMath::rad(-10), vpMath::rad(17));
+  std::vector<vpPoint> points = generatePoints(cMo_ref, static_cast<unsigned int>(g_nbPoints), 0);
+
+  vpPose pose(points);
+
+  SECTION("Residual")
+  {
+    double residual = pose.computeResidual(cMo_init);
+    double residual_ref = computeResidualReference(points, cMo_init);
+    CHECK(residual == Approx(residual_ref).epsilon(1e-12));
+
+    if (g_runBenchmark) {
+      BENCHMARK("vpPose::computeResidual()") { return pose.computeResidual(cMo_init); };
+      BENCHMARK("Residual with vpPoint::track()") { return computeResidualReference(points, cMo_init); };
+    }
+  }
+
+  SECTION("Virtual visual servoing")
+  {
+    vpHomogeneousMatrix cMo = cMo_init;
+    pose.poseVirtualVS(cMo);
+    for (unsigned int i = 0; i < 3; i++) {
+      CHECK(cMo[i][3] == Approx(cMo_ref[i][3]).margin(1e-3));
+    }
+    CHECK(pose.computeResidual(cMo) < pose.computeResidual(cMo_init));
+
+    if (g_runBenchmark) {
+      BENCHMARK("vpPose::poseVirtualVS()")
+      {
+        vpHomogeneousMatrix cMo_vvs = cMo_init;
+        pose.poseVirtualVS(cMo_vvs);
+        return cMo_vvs;
+      };
+    }
+  }
+}
+
+TEST_CASE("RANSAC pose from many points", "[benchmark]")
+{
+  const vpHomogeneousMatrix cMo_ref(0.05, -0.02, 1.5, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(20));
+  std::vector<vpPoint> points = generatePoints(cMo_ref, static_cast<unsigned int>(g_nbPoints), 0.3);
+
+  vpPose pose(points);
+  pose.setRansacNbInliersToReachConsensus(static_cast<unsigned int>(0.6 * g_nbPoints));
+  pose.setRansacThreshold(0.005);
+  pose.setRansacMaxTrials(500);
+
+  vpHomogeneousMatrix cMo;
+  REQUIRE(pose.computePose(vpPose::RANSAC, cMo));
+  CHECK(pose.getRansacNbInliers() >= static_cast<unsigned int>(0.6 * g_nbPoints));
+  for (unsigned int i = 0; i < 3; i++) {
+    CHECK(cMo[i][3] == Approx(cMo_ref[i][3]).margin(1e-2));
+  }
+
+  if (g_runBenchmark) {
+    BENCHMARK("vpPose::poseRansac()")
+    {
+      vpHomogeneousMatrix cMo_ransac;
+      pose.computePose(vpPose::RANSAC, cMo_ransac);
+      return cMo_ransac;
+    };
+  }
+}
+
+TEST_CASE("Batch of tag poses", "[benchmark]")
+{
+  // Corners of many 4 cm tags seen from different poses, as after an AprilTag detection
+  const unsigned int nbTags = 64;
+  const double s = 0.02;
+  vpUniRand rand(42);
+  std::vector<std::vector<vpPoint> > points(nbTags);
+  std::vector<vpHomogeneousMatrix> cMo_ref(nbTags);
+  for (unsigned int i = 0; i < nbTags; i++) {
+    cMo_ref[i].buildFrom(rand.uniform(-0.3, 0.3), rand.uniform(-0.2, 0.2), rand.uniform(0.4, 1.2),
+                         vpMath::rad(rand.uniform(-30.0, 30.0)), vpMath::rad(rand.uniform(-30.0, 30.0)),
+                         vpMath::rad(rand.uniform(-180.0, 180.0)));
+    const double corners[4][2] = { { -s, -s }, { s, -s }, { s, s }, { -s, s } };
+    for (unsigned int j = 0; j < 4; j++) {
+      vpPoint P(corners[j][0], corners[j][1], 0);
+      P.track(cMo_ref[i]);
+      points[i].push_back(P);
+    }
+  }
+  // A degenerate problem must be reported as a failure without stopping the others
+  points.push_back(std::vector<vpPoint>(points[0].begin(), points[0].begin() + 3));
+
+  vpPose pose;
+  std::vector<vpHomogeneousMatrix> cMo;
+  std::vector<bool> success = pose.computePoses(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, points, cMo, 4);
+  REQUIRE(success.size() == points.size());
+  REQUIRE(cMo.size() == points.size());
+  CHECK_FALSE(success.back());
+
+  for (unsigned int i = 0; i < nbTags; i++) {
+    vpPose pose_single(points[i]);
+    vpHomogeneousMatrix cMo_single;
+    bool success_single = pose_single.computePose(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, cMo_single);
+    CHECK(success[i] == success_single);
+    for (unsigned int j = 0; j < 12; j++) {
+      CHECK(cMo[i].data[j] == Approx(cMo_single.data[j]).margin(1e-12));
+    }
+    for (unsigned int j = 0; j < 3; j++) {
+      CHECK(cMo[i][j][3] == Approx(cMo_ref[i][j][3]).margin(5e-3));
+    }
+  }
+
+  if (g_runBenchmark) {
+    BENCHMARK("vpPose::computePose() on each tag")
+    {
+      std::vector<vpHomogeneousMatrix> cMo_loop(nbTags);
+      for (unsigned int i = 0; i < nbTags; i++) {
+        vpPose pose_single(points[i]);
+        pose_single.computePose(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, cMo_loop[i]);
+      }
+      return cMo_loop;
+    };
+
+    BENCHMARK("vpPose::computePoses() single thread")
+    {
+      std::vector<vpHomogeneousMatrix> cMo_batch;
+      pose.computePoses(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, points, cMo_batch, 1);
+      return cMo_batch;
+    };
+
+    BENCHMARK("vpPose::computePoses()")
+    {
+      std::vector<vpHomogeneousMatrix> cMo_batch;
+      pose.computePoses(vpPose::DEMENTHON_LAGRANGE_VIRTUAL_VS, points, cMo_batch);
+      return cMo_batch;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()         // Get Catch's composite command line parser
+             | Opt(g_runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark?")    // description string for the help output
+             | Opt(g_nbPoints, "nbPoints")["--nbPoints"]("Number of points");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif